@@ -408,6 +408,7 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
     HEADERS += \
         src/AnalyzeView/LogDownloadTest.h \
         src/Audio/AudioOutputTest.h \
+        src/FactSystem/FactGroupTest.h \
         src/FactSystem/FactSystemTestBase.h \
         src/FactSystem/FactSystemTestGeneric.h \
         src/FactSystem/FactSystemTestPX4.h \
@@ -420,18 +421,23 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/MissionManager/MissionManagerTest.h \
         src/MissionManager/MissionSettingsTest.h \
         src/MissionManager/PlanMasterControllerTest.h \
+        src/MissionManager/PolygonLineClipperTest.h \
         src/MissionManager/QGCMapPolygonTest.h \
         src/MissionManager/SectionTest.h \
         src/MissionManager/SimpleMissionItemTest.h \
         src/MissionManager/SpeedSectionTest.h \
         src/MissionManager/SurveyMissionItemTest.h \
+        src/MissionManager/TransectRouteOptimizerTest.h \
         src/MissionManager/VisualMissionItemTest.h \
+        src/QmlControls/QmlObjectListModelTest.h \
         src/qgcunittest/FileDialogTest.h \
         src/qgcunittest/FileManagerTest.h \
         src/qgcunittest/FlightGearTest.h \
         src/qgcunittest/GeoTest.h \
         src/qgcunittest/LinkManagerTest.h \
         src/qgcunittest/MainWindowTest.h \
+        src/qgcunittest/LinkMetricsTest.h \
+        src/qgcunittest/MAVLinkMessageStatisticsTest.h \
         src/qgcunittest/MavlinkLogTest.h \
         src/qgcunittest/MessageBoxTest.h \
         src/qgcunittest/MultiSignalSpy.h \
@@ -439,11 +445,15 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/qgcunittest/TCPLinkTest.h \
         src/qgcunittest/TCPLoopBackServer.h \
         src/qgcunittest/UnitTest.h \
+        src/Vehicle/MAVLinkLogProcessorTest.h \
         src/Vehicle/SendMavCommandTest.h \
+        src/Vehicle/TrajectoryPointsTest.h \
+        src/ui/linechart/TimeSeriesDataTest.h \
 
     SOURCES += \
         src/AnalyzeView/LogDownloadTest.cc \
         src/Audio/AudioOutputTest.cc \
+        src/FactSystem/FactGroupTest.cc \
         src/FactSystem/FactSystemTestBase.cc \
         src/FactSystem/FactSystemTestGeneric.cc \
         src/FactSystem/FactSystemTestPX4.cc \
@@ -456,18 +466,23 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/MissionManager/MissionManagerTest.cc \
         src/MissionManager/MissionSettingsTest.cc \
         src/MissionManager/PlanMasterControllerTest.cc \
+        src/MissionManager/PolygonLineClipperTest.cc \
         src/MissionManager/QGCMapPolygonTest.cc \
         src/MissionManager/SectionTest.cc \
         src/MissionManager/SimpleMissionItemTest.cc \
         src/MissionManager/SpeedSectionTest.cc \
         src/MissionManager/SurveyMissionItemTest.cc \
+        src/MissionManager/TransectRouteOptimizerTest.cc \
         src/MissionManager/VisualMissionItemTest.cc \
+        src/QmlControls/QmlObjectListModelTest.cc \
         src/qgcunittest/FileDialogTest.cc \
         src/qgcunittest/FileManagerTest.cc \
         src/qgcunittest/FlightGearTest.cc \
         src/qgcunittest/GeoTest.cc \
         src/qgcunittest/LinkManagerTest.cc \
         src/qgcunittest/MainWindowTest.cc \
+        src/qgcunittest/LinkMetricsTest.cc \
+        src/qgcunittest/MAVLinkMessageStatisticsTest.cc \
         src/qgcunittest/MavlinkLogTest.cc \
         src/qgcunittest/MessageBoxTest.cc \
         src/qgcunittest/MultiSignalSpy.cc \
@@ -476,7 +491,10 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/qgcunittest/TCPLoopBackServer.cc \
         src/qgcunittest/UnitTest.cc \
         src/qgcunittest/UnitTestList.cc \
+        src/Vehicle/MAVLinkLogProcessorTest.cc \
         src/Vehicle/SendMavCommandTest.cc \
+        src/Vehicle/TrajectoryPointsTest.cc \
+        src/ui/linechart/TimeSeriesDataTest.cc \
 } } } } } }
 
 # Main QGC Headers and Source files
@@ -517,6 +535,7 @@ HEADERS += \
     src/MissionManager/PlanElementController.h \
     src/MissionManager/PlanManager.h \
     src/MissionManager/PlanMasterController.h \
+    src/MissionManager/PolygonLineClipper.h \
     src/MissionManager/QGCFenceCircle.h \
     src/MissionManager/QGCFencePolygon.h \
     src/MissionManager/QGCMapCircle.h \
@@ -529,6 +548,7 @@ HEADERS += \
     src/MissionManager/SpeedSection.h \
     src/MissionManager/StructureScanComplexItem.h \
     src/MissionManager/SurveyMissionItem.h \
+    src/MissionManager/TransectRouteOptimizer.h \
     src/MissionManager/VisualMissionItem.h \
     src/PositionManager/PositionManager.h \
     src/PositionManager/SimulatedPosition.h \
@@ -545,6 +565,7 @@ HEADERS += \
     src/QGCQGeoCoordinate.h \
     src/QGCQmlWidgetHolder.h \
     src/QGCQuickWidget.h \
+    src/QGCStartupTrace.h \
     src/QGCTemporaryFile.h \
     src/QGCToolbox.h \
     src/QmlControls/AppMessages.h \
@@ -574,6 +595,8 @@ HEADERS += \
     src/comm/LinkConfiguration.h \
     src/comm/LinkInterface.h \
     src/comm/LinkManager.h \
+    src/comm/LinkMetrics.h \
+    src/comm/MAVLinkMessageStatistics.h \
     src/comm/MAVLinkProtocol.h \
     src/comm/ProtocolInterface.h \
     src/comm/QGCMAVLink.h \
@@ -583,6 +606,7 @@ HEADERS += \
     src/uas/UASInterface.h \
     src/uas/UASMessageHandler.h \
     src/AnalyzeView/LogDownloadController.h \
+    src/AnalyzeView/LogDownloadWriter.h \
 
 AndroidBuild {
 HEADERS += \
@@ -707,6 +731,7 @@ SOURCES += \
     src/MissionManager/PlanElementController.cc \
     src/MissionManager/PlanManager.cc \
     src/MissionManager/PlanMasterController.cc \
+    src/MissionManager/PolygonLineClipper.cc \
     src/MissionManager/QGCFenceCircle.cc \
     src/MissionManager/QGCFencePolygon.cc \
     src/MissionManager/QGCMapCircle.cc \
@@ -718,6 +743,7 @@ SOURCES += \
     src/MissionManager/SpeedSection.cc \
     src/MissionManager/StructureScanComplexItem.cc \
     src/MissionManager/SurveyMissionItem.cc \
+    src/MissionManager/TransectRouteOptimizer.cc \
     src/MissionManager/VisualMissionItem.cc \
     src/PositionManager/PositionManager.cpp \
     src/PositionManager/SimulatedPosition.cc \
@@ -733,6 +759,7 @@ SOURCES += \
     src/QGCQGeoCoordinate.cc \
     src/QGCQmlWidgetHolder.cpp \
     src/QGCQuickWidget.cc \
+    src/QGCStartupTrace.cc \
     src/QGCTemporaryFile.cc \
     src/QGCToolbox.cc \
     src/QmlControls/AppMessages.cc \
@@ -761,6 +788,8 @@ SOURCES += \
     src/comm/LinkConfiguration.cc \
     src/comm/LinkInterface.cc \
     src/comm/LinkManager.cc \
+    src/comm/LinkMetrics.cc \
+    src/comm/MAVLinkMessageStatistics.cc \
     src/comm/MAVLinkProtocol.cc \
     src/comm/QGCMAVLink.cc \
     src/comm/TCPLink.cc \
@@ -769,6 +798,7 @@ SOURCES += \
     src/uas/UAS.cc \
     src/uas/UASMessageHandler.cc \
     src/AnalyzeView/LogDownloadController.cc \
+    src/AnalyzeView/LogDownloadWriter.cc \
 
 DebugBuild {
 SOURCES += \
@@ -859,9 +889,11 @@ HEADERS+= \
     src/FirmwarePlugin/CameraMetaData.h \
     src/FirmwarePlugin/FirmwarePlugin.h \
     src/FirmwarePlugin/FirmwarePluginManager.h \
+    src/FirmwarePlugin/ParameterMetaDataBinaryCache.h \
     src/Vehicle/ADSBVehicle.h \
     src/Vehicle/MultiVehicleManager.h \
     src/Vehicle/GPSRTKFactGroup.h \
+    src/Vehicle/TrajectoryPoints.h \
     src/Vehicle/Vehicle.h \
     src/VehicleSetup/VehicleComponent.h \
 
@@ -885,9 +917,11 @@ SOURCES += \
     src/FirmwarePlugin/CameraMetaData.cc \
     src/FirmwarePlugin/FirmwarePlugin.cc \
     src/FirmwarePlugin/FirmwarePluginManager.cc \
+    src/FirmwarePlugin/ParameterMetaDataBinaryCache.cc \
     src/Vehicle/ADSBVehicle.cc \
     src/Vehicle/MultiVehicleManager.cc \
     src/Vehicle/GPSRTKFactGroup.cc \
+    src/Vehicle/TrajectoryPoints.cc \
     src/Vehicle/Vehicle.cc \
     src/VehicleSetup/VehicleComponent.cc \
 
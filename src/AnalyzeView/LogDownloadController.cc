@@ -32,14 +32,27 @@
 #define kGUIRateMilliseconds 17
 #define kTableBins           512
 #define kChunkSize           (kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)
+#define kMaxWindowChunks     16u    // Upper bound for the download window (~1.4MB)
+#define kWindowTargetMsecs   1000   // Window is sized to hold about this much data at the measured rate
+#define kMaxWindowLoss       0.02   // Window shrinks when more bins than this were lost
 
 QGC_LOGGING_CATEGORY(LogDownloadLog, "LogDownloadLog")
 
 //-----------------------------------------------------------------------------
+// The log is requested one window at a time. A window spans one or more kChunkSize
+// chunks and is requested with a single LOG_REQUEST_DATA so the vehicle can stream
+// it without waiting on a round trip per chunk. The window size adapts to the
+// throughput and loss measured over the previous window. Data is assembled in memory
+// and each completed window goes to the LogDownloadWriter as a single block.
 struct LogDownloadData {
     LogDownloadData(QGCLogEntry* entry);
-    QBitArray     chunk_table;
-    uint32_t      current_chunk;
+    QBitArray     window_table;     // One bit per MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bin in the current window
+    uint32_t      window_chunk;     // First chunk of the current window
+    uint32_t      window_chunks;    // Number of chunks to request in the next window
+    uint32_t      max_window_chunks;// Upper bound for window_chunks, lowered when vehicles share a link
+    uint32_t      window_lost;      // Number of bins which had to be requested again in the current window
+    QElapsedTimer window_elapsed;
+    QByteArray    window_buffer;    // Data received for the current window, handed to the writer once complete
     QFile         file;
     QString       filename;
     uint          ID;
@@ -49,36 +62,79 @@ struct LogDownloadData {
     qreal         rate_avg;
     QElapsedTimer elapsed;
 
-    void advanceChunk()
+    void startWindow()
     {
-           current_chunk++;
-           chunk_table = QBitArray(chunkBins(), false);
+        window_lost = 0;
+        window_table = QBitArray(windowBins(), false);
+        window_buffer = QByteArray(windowBytes(), 0);
+        window_elapsed.start();
     }
 
-    // The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
-    uint32_t chunkBins() const
+    void advanceWindow()
     {
-        return qMin(qCeil((entry->size() - current_chunk*kChunkSize)/static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)),
-                    kTableBins);
+        const uint32_t windowChunks = qCeil(window_table.size() / static_cast<qreal>(kTableBins));
+        const qreal    loss         = window_lost / static_cast<qreal>(window_table.size());
+
+        if (loss > kMaxWindowLoss) {
+            window_chunks = qMax<uint32_t>(window_chunks / 2, 1);
+        } else {
+            // Grow towards the amount of data the link moves in kWindowTargetMsecs, at most doubling each time
+            const qreal    msecs      = qMax<qint64>(window_elapsed.elapsed(), 1);
+            const qreal    throughput = (window_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) / (msecs / 1000.0);
+            const uint32_t target     = qCeil(throughput * (kWindowTargetMsecs / 1000.0) / kChunkSize);
+            window_chunks = qBound<uint32_t>(1, target, qMin<uint32_t>(window_chunks * 2, max_window_chunks));
+        }
+        qCDebug(LogDownloadLog) << "Window complete (chunk:" << window_chunk << "loss:" << loss << ") next window chunks:" << window_chunks;
+
+        window_chunk += windowChunks;
+        startWindow();
     }
 
-    // The number of kChunkSize chunks in the file
-    uint32_t numChunks() const
+    // The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the file
+    uint32_t fileBins() const
     {
-        return qCeil(entry->size() / static_cast<qreal>(kChunkSize));
+        return qCeil(entry->size() / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
     }
 
-    // True if all bins in the chunk have been set to val
-    bool chunkEquals(const bool val) const
+    // The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current window
+    uint32_t windowBins() const
     {
-        return chunk_table == QBitArray(chunk_table.size(), val);
+        const uint32_t firstBin = window_chunk * kTableBins;
+        return firstBin >= fileBins() ? 0 : qMin(fileBins() - firstBin, window_chunks * kTableBins);
     }
 
+    // The number of bytes in the current window
+    uint32_t windowBytes() const
+    {
+        return qMin<uint32_t>(window_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, entry->size() - windowOffset());
+    }
+
+    // File offset of the first byte in the current window
+    uint32_t windowOffset() const
+    {
+        return window_chunk * kChunkSize;
+    }
+
+    // True if all bins in the window have been received
+    bool windowComplete() const
+    {
+        return window_table.count(true) == window_table.size();
+    }
+
+    // True if the current window is the last one in the file
+    bool lastWindow() const
+    {
+        return window_chunk * kTableBins + window_table.size() >= fileBins();
+    }
 };
 
 //----------------------------------------------------------------------------------------
 LogDownloadData::LogDownloadData(QGCLogEntry* entry_)
-    : ID(entry_->id())
+    : window_chunk(0)
+    , window_chunks(1)
+    , max_window_chunks(kMaxWindowChunks)
+    , window_lost(0)
+    , ID(entry_->id())
     , entry(entry_)
     , written(0)
     , rate_bytes(0)
@@ -106,24 +162,38 @@ QGCLogEntry::sizeStr() const
 }
 
 //----------------------------------------------------------------------------------------
-LogDownloadController::LogDownloadController(void)
-    : _uas(NULL)
+LogDownloadSession::LogDownloadSession(Vehicle* vehicle, LogDownloadWriter* writer, QObject* parent)
+    : QObject(parent)
+    , _uas(vehicle->uas())
     , _downloadData(NULL)
-    , _vehicle(NULL)
+    , _vehicle(vehicle)
+    , _writer(writer)
     , _requestingLogEntries(false)
     , _downloadingLogs(false)
     , _retries(0)
     , _apmOneBased(0)
+    , _maxWindowChunks(kMaxWindowChunks)
+    , _downloadTotalBytes(0)
+    , _downloadCompletedBytes(0)
 {
-    MultiVehicleManager *manager = qgcApp()->toolbox()->multiVehicleManager();
-    connect(manager, &MultiVehicleManager::activeVehicleChanged, this, &LogDownloadController::_setActiveVehicle);
-    connect(&_timer, &QTimer::timeout, this, &LogDownloadController::_processDownload);
-    _setActiveVehicle(manager->activeVehicle());
+    connect(&_timer, &QTimer::timeout, this, &LogDownloadSession::_processDownload);
+    connect(_writer, &LogDownloadWriter::fileClosed, this, &LogDownloadSession::_writerFileClosed);
+    connect(_uas, &UASInterface::logEntry, this, &LogDownloadSession::_logEntry);
+    connect(_uas, &UASInterface::logData,  this, &LogDownloadSession::_logData);
+}
+
+//----------------------------------------------------------------------------------------
+LogDownloadSession::~LogDownloadSession()
+{
+    if(_downloadData) {
+        _writer->close(_downloadData->file.fileName(), true /* remove */);
+        delete _downloadData;
+    }
 }
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_processDownload()
+LogDownloadSession::_processDownload()
 {
     if(_requestingLogEntries) {
         _findMissingEntries();
@@ -132,27 +202,35 @@ LogDownloadController::_processDownload()
     }
 }
 
+//----------------------------------------------------------------------------------------
+qreal
+LogDownloadSession::downloadRate() const
+{
+    return _downloadData ? _downloadData->rate_avg : 0;
+}
+
+//----------------------------------------------------------------------------------------
+quint64
+LogDownloadSession::downloadedBytes() const
+{
+    return _downloadCompletedBytes + (_downloadData ? _downloadData->written : 0);
+}
+
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_setActiveVehicle(Vehicle* vehicle)
+LogDownloadSession::setMaxWindowChunks(uint32_t maxWindowChunks)
 {
-    if(_uas) {
-        _logEntriesModel.clear();
-        disconnect(_uas, &UASInterface::logEntry, this, &LogDownloadController::_logEntry);
-        disconnect(_uas, &UASInterface::logData,  this, &LogDownloadController::_logData);
-        _uas = NULL;
-    }
-    _vehicle = vehicle;
-    if(_vehicle) {
-        _uas = vehicle->uas();
-        connect(_uas, &UASInterface::logEntry, this, &LogDownloadController::_logEntry);
-        connect(_uas, &UASInterface::logData,  this, &LogDownloadController::_logData);
+    _maxWindowChunks = qMax<uint32_t>(maxWindowChunks, 1);
+    if(_downloadData) {
+        //-- Takes effect with the next window
+        _downloadData->max_window_chunks = _maxWindowChunks;
+        _downloadData->window_chunks = qMin(_downloadData->window_chunks, _maxWindowChunks);
     }
 }
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_logEntry(UASInterface* uas, uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t /*last_log_num*/)
+LogDownloadSession::_logEntry(UASInterface* uas, uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t /*last_log_num*/)
 {
     //-- Do we care?
     if(!_uas || uas != _uas || !_requestingLogEntries) {
@@ -202,7 +280,7 @@ LogDownloadController::_logEntry(UASInterface* uas, uint32_t time_utc, uint32_t
 
 //----------------------------------------------------------------------------------------
 bool
-LogDownloadController::_entriesComplete()
+LogDownloadSession::_entriesComplete()
 {
     //-- Iterate entries and look for a gap
     int num_logs = _logEntriesModel.count();
@@ -219,7 +297,7 @@ LogDownloadController::_entriesComplete()
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_resetSelection(bool canceled)
+LogDownloadSession::_resetSelection(bool canceled)
 {
     int num_logs = _logEntriesModel.count();
     for(int i = 0; i < num_logs; i++) {
@@ -238,7 +316,7 @@ LogDownloadController::_resetSelection(bool canceled)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_receivedAllEntries()
+LogDownloadSession::_receivedAllEntries()
 {
     _timer.stop();
     _setListing(false);
@@ -246,7 +324,7 @@ LogDownloadController::_receivedAllEntries()
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_findMissingEntries()
+LogDownloadSession::_findMissingEntries()
 {
     int start = -1;
     int end   = -1;
@@ -298,7 +376,7 @@ LogDownloadController::_findMissingEntries()
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, uint8_t count, const uint8_t* data)
+LogDownloadSession::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, uint8_t count, const uint8_t* data)
 {
     if(!_uas || uas != _uas || !_downloadData) {
         return;
@@ -318,26 +396,28 @@ LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, ui
     bool result = false;
     uint32_t timeout_time = kTimeOutMilliseconds;
     if(ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / kChunkSize;
-        if (chunk != _downloadData->current_chunk) {
-            qWarning() << "Ignored packet for out of order chunk" << chunk;
+        const uint32_t windowOffset = _downloadData->windowOffset();
+        if (ofs < windowOffset) {
+            // Left over from a request for a previous window
+            qCDebug(LogDownloadLog) << "Ignored packet before current window" << ofs;
             return;
         }
-        const uint16_t bin = (ofs - chunk*kChunkSize) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qWarning() << "Out of range bin received";
-        } else
-            _downloadData->chunk_table.setBit(bin);
-        if (_downloadData->file.pos() != ofs) {
-            // Seek to correct position
-            if (!_downloadData->file.seek(ofs)) {
-                qWarning() << "Error while seeking log file offset";
-                return;
-            }
+        const uint32_t bin = (ofs - windowOffset) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+        if (bin >= (uint32_t)_downloadData->window_table.size()) {
+            qWarning() << "Ignored packet beyond current window" << ofs;
+            return;
         }
+        if (_downloadData->window_table.testBit(bin)) {
+            // Duplicate from a superseded request, it is still proof the link is alive
+            _timer.start(timeout_time);
+            return;
+        }
+        const uint32_t bufferOffset = bin * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
 
-        //-- Write chunk to file
-        if(_downloadData->file.write((const char*)data, count)) {
+        //-- Copy into the window buffer, it is written to file once the window completes
+        if(bufferOffset + count <= (uint32_t)_downloadData->window_buffer.size()) {
+            memcpy(_downloadData->window_buffer.data() + bufferOffset, data, count);
+            _downloadData->window_table.setBit(bin);
             _downloadData->written += count;
             _downloadData->rate_bytes += count;
             if (_downloadData->elapsed.elapsed() >= kGUIRateMilliseconds) {
@@ -352,6 +432,7 @@ LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, ui
 
                 _downloadData->entry->setStatus(status);
                 _downloadData->elapsed.start();
+                emit progressChanged();
             }
             result = true;
             //-- reset retries
@@ -360,20 +441,18 @@ LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, ui
             _timer.start(timeout_time);
             //-- Do we have it all?
             if(_logComplete()) {
-                _downloadData->entry->setStatus(QString(tr("Downloaded")));
+                _downloadData->entry->setStatus(QString(tr("Saving")));
+                _closeDownloadFile(true);
                 //-- Check for more
                 _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk*kChunkSize,
-                                _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if (bin < _downloadData->chunk_table.size() - 1 && _downloadData->chunk_table.at(bin+1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
+            } else if (_windowComplete()) {
+                _advanceWindow();
+            } else if (bin == (uint32_t)_downloadData->window_table.size() - 1 || _downloadData->window_table.testBit(bin+1)) {
+                // Reached the end of the window or of a gap, go after what is still missing
                 _findMissingData();
             }
         } else {
-            qWarning() << "Error while writing log file chunk";
+            qWarning() << "Received log data overruns window buffer" << ofs << count;
         }
     } else {
         qWarning() << "Received log offset greater than expected";
@@ -386,75 +465,129 @@ LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, ui
 
 //----------------------------------------------------------------------------------------
 bool
-LogDownloadController::_chunkComplete() const
+LogDownloadSession::_windowComplete() const
 {
-    return _downloadData->chunkEquals(true);
+    return _downloadData->windowComplete();
 }
 
 //----------------------------------------------------------------------------------------
 bool
-LogDownloadController::_logComplete() const
+LogDownloadSession::_logComplete() const
 {
-    return _chunkComplete() && (_downloadData->current_chunk+1) == _downloadData->numChunks();
+    return _windowComplete() && _downloadData->lastWindow();
 }
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_receivedAllData()
+LogDownloadSession::_receivedAllData()
 {
     _timer.stop();
     //-- Anything queued up for download?
     if(_prepareLogDownload()) {
         //-- Request Log
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+        _requestWindow();
         _timer.start(kTimeOutMilliseconds);
     } else {
         _resetSelection();
-        _setDownloading(false);
+        if (_writingEntries.isEmpty()) {
+            _setDownloading(false);
+        }
     }
 }
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_findMissingData()
+LogDownloadSession::_findMissingData()
 {
     if (_logComplete()) {
          _receivedAllData();
          return;
-    } else if (_chunkComplete()) {
-        _downloadData->advanceChunk();
+    } else if (_windowComplete()) {
+        _advanceWindow();
+        return;
     }
 
     if(_retries++ > 2) {
         _downloadData->entry->setStatus(QString(tr("Timed Out")));
         //-- Give up
         qWarning() << "Too many errors retreiving log data. Giving up.";
+        _closeDownloadFile(false);
         _receivedAllData();
         return;
     }
 
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
+    uint32_t start = 0, end = 0;
+    const uint32_t size = _downloadData->window_table.size();
     for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
+        if (!_downloadData->window_table.testBit(start)) {
             break;
         }
     }
 
     for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
+        if (_downloadData->window_table.testBit(end)) {
             break;
         }
     }
 
-    const uint32_t pos = _downloadData->current_chunk*kChunkSize + start*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
+    _downloadData->window_lost += end - start;
+
+    const uint32_t pos = _downloadData->windowOffset() + start*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
                    len = (end - start)*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
     _requestLogData(_downloadData->ID, pos, len);
 }
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_requestLogData(uint16_t id, uint32_t offset, uint32_t count)
+LogDownloadSession::_advanceWindow()
+{
+    _writer->write(_downloadData->file.fileName(), _downloadData->windowOffset(), _downloadData->window_buffer);
+    _downloadData->advanceWindow();
+    _requestWindow();
+}
+
+//----------------------------------------------------------------------------------------
+/// Hands the remaining data of the current download to the writer and closes the file
+///     @param complete true: all data was received, the entry is marked as downloaded once the file is written
+void
+LogDownloadSession::_closeDownloadFile(bool complete)
+{
+    const QString fileName = _downloadData->file.fileName();
+    _writer->write(fileName, _downloadData->windowOffset(), _downloadData->window_buffer);
+    _writer->close(fileName, false /* remove */);
+    _downloadCompletedBytes += _downloadData->entry->size();
+    emit progressChanged();
+    if (complete) {
+        _writingEntries[fileName] = _downloadData->entry;
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadSession::_writerFileClosed(QString fileName, bool success)
+{
+    QPointer<QGCLogEntry> entry = _writingEntries.take(fileName);
+    if (entry) {
+        entry->setStatus(success ? QString(tr("Downloaded")) : QString(tr("Error")));
+    }
+    //-- The download is only over once everything is on disk
+    if (_writingEntries.isEmpty() && !_downloadData) {
+        _setDownloading(false);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadSession::_requestWindow()
+{
+    _requestLogData(_downloadData->ID,
+                    _downloadData->windowOffset(),
+                    _downloadData->window_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadSession::_requestLogData(uint16_t id, uint32_t offset, uint32_t count)
 {
     if(_vehicle) {
         //-- APM "Fix"
@@ -466,7 +599,7 @@ LogDownloadController::_requestLogData(uint16_t id, uint32_t offset, uint32_t co
                     qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
                     _vehicle->priorityLink()->mavlinkChannel(),
                     &msg,
-                    qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()->id(), qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()->defaultComponentId(),
+                    _vehicle->id(), _vehicle->defaultComponentId(),
                     id, offset, count);
         _vehicle->sendMessageOnLink(_vehicle->priorityLink(), msg);
     }
@@ -474,7 +607,7 @@ LogDownloadController::_requestLogData(uint16_t id, uint32_t offset, uint32_t co
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::refresh(void)
+LogDownloadSession::refresh(void)
 {
     _logEntriesModel.clear();
     //-- Get first 50 entries
@@ -483,7 +616,7 @@ LogDownloadController::refresh(void)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_requestLogList(uint32_t start, uint32_t end)
+LogDownloadSession::_requestLogList(uint32_t start, uint32_t end)
 {
     if(_vehicle && _uas) {
         qCDebug(LogDownloadLog) << "Request log entry list (" << start << "through" << end << ")";
@@ -506,26 +639,7 @@ LogDownloadController::_requestLogList(uint32_t start, uint32_t end)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::download(QString path)
-{
-    QString dir = path;
-#if defined(__mobile__)
-    if(dir.isEmpty()) {
-        dir = QDir::homePath();
-    }
-#else
-    if(dir.isEmpty()) {
-        dir = QGCQFileDialog::getExistingDirectory(
-                MainWindow::instance(),
-                tr("Log Download Directory"),
-                QDir::homePath(),
-                QGCQFileDialog::ShowDirsOnly | QGCQFileDialog::DontResolveSymlinks);
-    }
-#endif
-    downloadToDirectory(dir);
-}
-
-void LogDownloadController::downloadToDirectory(const QString& dir)
+LogDownloadSession::downloadToDirectory(const QString& dir)
 {
     //-- Stop listing just in case
     _receivedAllEntries();
@@ -539,12 +653,15 @@ void LogDownloadController::downloadToDirectory(const QString& dir)
         if(!_downloadPath.endsWith(QDir::separator()))
             _downloadPath += QDir::separator();
         //-- Iterate selected entries and shown them as waiting
+        _downloadTotalBytes = 0;
+        _downloadCompletedBytes = 0;
         int num_logs = _logEntriesModel.count();
         for(int i = 0; i < num_logs; i++) {
             QGCLogEntry* entry = _logEntriesModel[i];
             if(entry) {
                 if(entry->selected()) {
                    entry->setStatus(QString(tr("Waiting")));
+                   _downloadTotalBytes += entry->size();
                 }
             }
         }
@@ -557,7 +674,7 @@ void LogDownloadController::downloadToDirectory(const QString& dir)
 
 //----------------------------------------------------------------------------------------
 QGCLogEntry*
-LogDownloadController::_getNextSelected()
+LogDownloadSession::_getNextSelected()
 {
     //-- Iterate entries and look for a selected file
     int num_logs = _logEntriesModel.count();
@@ -574,7 +691,7 @@ LogDownloadController::_getNextSelected()
 
 //----------------------------------------------------------------------------------------
 bool
-LogDownloadController::_prepareLogDownload()
+LogDownloadSession::_prepareLogDownload()
 {
     if(_downloadData) {
         delete _downloadData;
@@ -614,7 +731,7 @@ LogDownloadController::_prepareLogDownload()
         QStringList filename_spl = _downloadData->filename.split('.');
         do {
             num_dups +=1;
-            _downloadData->file.setFileName(filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
+            _downloadData->file.setFileName(_downloadPath + filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
         } while( _downloadData->file.exists());
     }
     //-- Create file
@@ -625,8 +742,10 @@ LogDownloadController::_prepareLogDownload()
         if(!_downloadData->file.resize(entry->size())) {
             qWarning() << "Failed to allocate space for log file:" <<  _downloadData->filename;
         } else {
-            _downloadData->current_chunk = 0;
-            _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
+            //-- From here on the file is written by the LogDownloadWriter
+            _downloadData->file.close();
+            _downloadData->max_window_chunks = _maxWindowChunks;
+            _downloadData->startWindow();
             _downloadData->elapsed.start();
             result = true;
         }
@@ -644,7 +763,7 @@ LogDownloadController::_prepareLogDownload()
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_setDownloading(bool active)
+LogDownloadSession::_setDownloading(bool active)
 {
     if (_downloadingLogs != active) {
         _downloadingLogs = active;
@@ -655,7 +774,7 @@ LogDownloadController::_setDownloading(bool active)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::_setListing(bool active)
+LogDownloadSession::_setListing(bool active)
 {
     if (_requestingLogEntries != active) {
         _requestingLogEntries = active;
@@ -666,7 +785,7 @@ LogDownloadController::_setListing(bool active)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::eraseAll(void)
+LogDownloadSession::eraseAll(void)
 {
     if(_vehicle && _uas) {
         mavlink_message_t msg;
@@ -675,7 +794,7 @@ LogDownloadController::eraseAll(void)
                     qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
                     _vehicle->priorityLink()->mavlinkChannel(),
                     &msg,
-                    qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()->id(), qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()->defaultComponentId());
+                    _vehicle->id(), _vehicle->defaultComponentId());
         _vehicle->sendMessageOnLink(_vehicle->priorityLink(), msg);
         refresh();
     }
@@ -683,16 +802,12 @@ LogDownloadController::eraseAll(void)
 
 //----------------------------------------------------------------------------------------
 void
-LogDownloadController::cancel(void)
+LogDownloadSession::cancel(void)
 {
-    if(_uas){
-        _receivedAllEntries();
-    }
+    _receivedAllEntries();
     if(_downloadData) {
         _downloadData->entry->setStatus(QString(tr("Canceled")));
-        if (_downloadData->file.exists()) {
-            _downloadData->file.remove();
-        }
+        _writer->close(_downloadData->file.fileName(), true /* remove */);
         delete _downloadData;
         _downloadData = 0;
     }
@@ -700,6 +815,223 @@ LogDownloadController::cancel(void)
     _setDownloading(false);
 }
 
+//----------------------------------------------------------------------------------------
+LogDownloadController::LogDownloadController(void)
+    : _activeSession(NULL)
+{
+    MultiVehicleManager *manager = qgcApp()->toolbox()->multiVehicleManager();
+    connect(manager, &MultiVehicleManager::vehicleAdded,         this, &LogDownloadController::_vehicleAdded);
+    connect(manager, &MultiVehicleManager::vehicleRemoved,       this, &LogDownloadController::_vehicleRemoved);
+    connect(manager, &MultiVehicleManager::activeVehicleChanged, this, &LogDownloadController::_setActiveVehicle);
+    for(int i = 0; i < manager->vehicles()->count(); i++) {
+        _vehicleAdded(manager->vehicles()->value<Vehicle*>(i));
+    }
+    _setActiveVehicle(manager->activeVehicle());
+}
+
+//----------------------------------------------------------------------------------------
+LogDownloadController::~LogDownloadController()
+{
+    //-- Sessions must go before the writer they queue file operations on
+    qDeleteAll(_sessions);
+    _sessions.clear();
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_vehicleAdded(Vehicle* vehicle)
+{
+    if(!vehicle || vehicle->isOfflineEditingVehicle() || _sessions.contains(vehicle)) {
+        return;
+    }
+    LogDownloadSession* session = new LogDownloadSession(vehicle, &_writer);
+    connect(session, &LogDownloadSession::downloadingLogsChanged, this, &LogDownloadController::_sessionDownloadingChanged);
+    connect(session, &LogDownloadSession::progressChanged,        this, &LogDownloadController::aggregateProgressChanged);
+    _sessions[vehicle] = session;
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_vehicleRemoved(Vehicle* vehicle)
+{
+    LogDownloadSession* session = _sessions.take(vehicle);
+    if(session) {
+        if(session == _activeSession) {
+            _setActiveVehicle(NULL);
+        }
+        session->cancel();
+        delete session;
+        _sessionDownloadingChanged();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_setActiveVehicle(Vehicle* vehicle)
+{
+    LogDownloadSession* session = _sessions.value(vehicle, NULL);
+    if(session == _activeSession) {
+        return;
+    }
+    if(_activeSession) {
+        disconnect(_activeSession, &LogDownloadSession::requestingListChanged,  this, &LogDownloadController::requestingListChanged);
+        disconnect(_activeSession, &LogDownloadSession::downloadingLogsChanged, this, &LogDownloadController::downloadingLogsChanged);
+        disconnect(_activeSession, &LogDownloadSession::selectionChanged,       this, &LogDownloadController::selectionChanged);
+    }
+    _activeSession = session;
+    if(_activeSession) {
+        connect(_activeSession, &LogDownloadSession::requestingListChanged,  this, &LogDownloadController::requestingListChanged);
+        connect(_activeSession, &LogDownloadSession::downloadingLogsChanged, this, &LogDownloadController::downloadingLogsChanged);
+        connect(_activeSession, &LogDownloadSession::selectionChanged,       this, &LogDownloadController::selectionChanged);
+    }
+    emit modelChanged();
+    emit requestingListChanged();
+    emit downloadingLogsChanged();
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_sessionDownloadingChanged(void)
+{
+    _shareLinks();
+    emit aggregateProgressChanged();
+}
+
+//----------------------------------------------------------------------------------------
+/// Splits the download window evenly between the sessions downloading over the same link, so vehicles
+/// sharing a radio get a fair share of it instead of the largest window starving the others.
+void
+LogDownloadController::_shareLinks(void)
+{
+    QMap<LinkInterface*, int> downloadsPerLink;
+    foreach(LogDownloadSession* session, _sessions) {
+        if(session->downloadingLogs()) {
+            downloadsPerLink[session->vehicle()->priorityLink()]++;
+        }
+    }
+    foreach(LogDownloadSession* session, _sessions) {
+        const int sharing = qMax(downloadsPerLink.value(session->vehicle()->priorityLink(), 0), 1);
+        session->setMaxWindowChunks(kMaxWindowChunks / sharing);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+QGCLogModel*
+LogDownloadController::model()
+{
+    return _activeSession ? _activeSession->model() : &_emptyModel;
+}
+
+//----------------------------------------------------------------------------------------
+bool
+LogDownloadController::requestingList()
+{
+    return _activeSession ? _activeSession->requestingList() : false;
+}
+
+//----------------------------------------------------------------------------------------
+bool
+LogDownloadController::downloadingLogs()
+{
+    return _activeSession ? _activeSession->downloadingLogs() : false;
+}
+
+//----------------------------------------------------------------------------------------
+int
+LogDownloadController::downloadingVehicleCount() const
+{
+    int count = 0;
+    foreach(LogDownloadSession* session, _sessions) {
+        if(session->downloadingLogs()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------------------------
+double
+LogDownloadController::aggregateProgress() const
+{
+    quint64 total = 0;
+    quint64 downloaded = 0;
+    foreach(LogDownloadSession* session, _sessions) {
+        if(session->downloadingLogs()) {
+            total       += session->downloadTotalBytes();
+            downloaded  += session->downloadedBytes();
+        }
+    }
+    return total ? qMin(downloaded / static_cast<double>(total), 1.0) : 0.0;
+}
+
+//----------------------------------------------------------------------------------------
+QString
+LogDownloadController::aggregateRate() const
+{
+    qreal rate = 0;
+    foreach(LogDownloadSession* session, _sessions) {
+        rate += session->downloadRate();
+    }
+    return QString("%1/s").arg(QGCMapEngine::bigSizeToString(rate));
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::refresh(void)
+{
+    if(_activeSession) {
+        _activeSession->refresh();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::eraseAll(void)
+{
+    if(_activeSession) {
+        _activeSession->eraseAll();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::cancel(void)
+{
+    if(_activeSession) {
+        _activeSession->cancel();
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::download(QString path)
+{
+    QString dir = path;
+#if defined(__mobile__)
+    if(dir.isEmpty()) {
+        dir = QDir::homePath();
+    }
+#else
+    if(dir.isEmpty()) {
+        dir = QGCQFileDialog::getExistingDirectory(
+                MainWindow::instance(),
+                tr("Log Download Directory"),
+                QDir::homePath(),
+                QGCQFileDialog::ShowDirsOnly | QGCQFileDialog::DontResolveSymlinks);
+    }
+#endif
+    downloadToDirectory(dir);
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::downloadToDirectory(const QString& dir)
+{
+    if(_activeSession) {
+        _activeSession->downloadToDirectory(dir);
+    }
+}
+
 //-----------------------------------------------------------------------------
 QGCLogModel::QGCLogModel(QObject* parent)
     : QAbstractListModel(parent)
@@ -16,11 +16,14 @@
 #include <QAbstractListModel>
 #include <QLocale>
 #include <QElapsedTimer>
+#include <QPointer>
+#include <QMap>
 
 #include <memory>
 
 #include "UASInterface.h"
 #include "AutoPilotPlugin.h"
+#include "LogDownloadWriter.h"
 
 class  MultiVehicleManager;
 class  UASInterface;
@@ -109,44 +112,49 @@ private:
 };
 
 //-----------------------------------------------------------------------------
-class LogDownloadController : public QObject
+/// Log listing and download state for a single vehicle. Sessions for different vehicles run independently
+/// of each other, so logs can be downloaded from several vehicles at the same time.
+class LogDownloadSession : public QObject
 {
     Q_OBJECT
 
 public:
-    LogDownloadController(void);
-
-    Q_PROPERTY(QGCLogModel* model           READ model              NOTIFY modelChanged)
-    Q_PROPERTY(bool         requestingList  READ requestingList     NOTIFY requestingListChanged)
-    Q_PROPERTY(bool         downloadingLogs READ downloadingLogs    NOTIFY downloadingLogsChanged)
+    LogDownloadSession(Vehicle* vehicle, LogDownloadWriter* writer, QObject* parent = NULL);
+    ~LogDownloadSession();
 
+    Vehicle*        vehicle                 () { return _vehicle; }
     QGCLogModel*    model                   () { return &_logEntriesModel; }
-    bool            requestingList          () { return _requestingLogEntries; }
-    bool            downloadingLogs         () { return _downloadingLogs; }
+    bool            requestingList          () const { return _requestingLogEntries; }
+    bool            downloadingLogs         () const { return _downloadingLogs; }
+    qreal           downloadRate            () const;                               ///< Bytes/sec of the log currently downloading
+    quint64         downloadTotalBytes      () const { return _downloadTotalBytes; }///< Size of all logs queued by the last download request
+    quint64         downloadedBytes         () const;                               ///< Bytes received towards downloadTotalBytes
 
-    Q_INVOKABLE void refresh                ();
-    Q_INVOKABLE void download               (QString path = QString());
-    Q_INVOKABLE void eraseAll               ();
-    Q_INVOKABLE void cancel                 ();
+    /// Limits the download window, used to share a link between sessions
+    void        setMaxWindowChunks  (uint32_t maxWindowChunks);
+    uint32_t    maxWindowChunks     () const { return _maxWindowChunks; }
 
-    void downloadToDirectory(const QString& dir);
+    void refresh                (void);
+    void eraseAll               (void);
+    void cancel                 (void);
+    void downloadToDirectory    (const QString& dir);
 
 signals:
     void requestingListChanged  ();
     void downloadingLogsChanged ();
-    void modelChanged           ();
     void selectionChanged       ();
+    void progressChanged        ();
 
 private slots:
-    void _setActiveVehicle  (Vehicle* vehicle);
     void _logEntry          (UASInterface *uas, uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t last_log_num);
     void _logData           (UASInterface *uas, uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data);
     void _processDownload   ();
+    void _writerFileClosed  (QString fileName, bool success);
 
 private:
 
     bool _entriesComplete   ();
-    bool _chunkComplete     () const;
+    bool _windowComplete    () const;
     bool _logComplete       () const;
     void _findMissingEntries();
     void _receivedAllEntries();
@@ -155,6 +163,9 @@ private:
     void _findMissingData   ();
     void _requestLogList    (uint32_t start, uint32_t end);
     void _requestLogData    (uint16_t id, uint32_t offset = 0, uint32_t count = 0xFFFFFFFF);
+    void _requestWindow     ();
+    void _advanceWindow     ();
+    void _closeDownloadFile (bool complete);
     bool _prepareLogDownload();
     void _setDownloading    (bool active);
     void _setListing        (bool active);
@@ -166,11 +177,73 @@ private:
     QTimer              _timer;
     QGCLogModel         _logEntriesModel;
     Vehicle*            _vehicle;
+    LogDownloadWriter*  _writer;
     bool                _requestingLogEntries;
     bool                _downloadingLogs;
     int                 _retries;
     int                 _apmOneBased;
+    uint32_t            _maxWindowChunks;
+    quint64             _downloadTotalBytes;
+    quint64             _downloadCompletedBytes;    ///< Bytes of logs from the last download request which are done
     QString             _downloadPath;
+    QHash<QString, QPointer<QGCLogEntry> > _writingEntries;    ///< Completed downloads still being written to disk
+};
+
+//-----------------------------------------------------------------------------
+/// Manages a LogDownloadSession for each vehicle. The list and actions exposed to Qml apply to the active
+/// vehicle, while downloads started on other vehicles keep running in the background.
+class LogDownloadController : public QObject
+{
+    Q_OBJECT
+
+public:
+    LogDownloadController(void);
+    ~LogDownloadController();
+
+    Q_PROPERTY(QGCLogModel* model                   READ model                  NOTIFY modelChanged)
+    Q_PROPERTY(bool         requestingList          READ requestingList         NOTIFY requestingListChanged)
+    Q_PROPERTY(bool         downloadingLogs         READ downloadingLogs        NOTIFY downloadingLogsChanged)
+    Q_PROPERTY(int          downloadingVehicleCount READ downloadingVehicleCount NOTIFY aggregateProgressChanged)   ///< Number of vehicles with a download in progress
+    Q_PROPERTY(double       aggregateProgress       READ aggregateProgress      NOTIFY aggregateProgressChanged)    ///< 0.0-1.0 progress across all vehicles
+    Q_PROPERTY(QString      aggregateRate           READ aggregateRate          NOTIFY aggregateProgressChanged)    ///< Combined download rate across all vehicles
+
+    QGCLogModel*    model                   ();
+    bool            requestingList          ();
+    bool            downloadingLogs         ();
+    int             downloadingVehicleCount () const;
+    double          aggregateProgress       () const;
+    QString         aggregateRate           () const;
+
+    Q_INVOKABLE void refresh                ();
+    Q_INVOKABLE void download               (QString path = QString());
+    Q_INVOKABLE void eraseAll               ();
+    Q_INVOKABLE void cancel                 ();
+
+    void downloadToDirectory(const QString& dir);
+
+    /// @return Session for the specified vehicle, NULL if there is none
+    LogDownloadSession* session(Vehicle* vehicle) { return _sessions.value(vehicle, NULL); }
+
+signals:
+    void requestingListChanged      ();
+    void downloadingLogsChanged     ();
+    void modelChanged               ();
+    void selectionChanged           ();
+    void aggregateProgressChanged   ();
+
+private slots:
+    void _setActiveVehicle          (Vehicle* vehicle);
+    void _vehicleAdded              (Vehicle* vehicle);
+    void _vehicleRemoved            (Vehicle* vehicle);
+    void _sessionDownloadingChanged (void);
+
+private:
+    void _shareLinks(void);
+
+    LogDownloadWriter                       _writer;
+    QMap<Vehicle*, LogDownloadSession*>     _sessions;
+    LogDownloadSession*                     _activeSession;
+    QGCLogModel                             _emptyModel;        ///< Shown when there is no active vehicle
 };
 
 #endif
@@ -199,6 +199,13 @@ AnalyzePage {
                     enabled:    logController.requestingList || logController.downloadingLogs
                     onClicked:  logController.cancel()
                 }
+
+                QGCLabel {
+                    width:      _butttonWidth
+                    wrapMode:   Text.WordWrap
+                    visible:    logController.downloadingVehicleCount > 1
+                    text:       qsTr("%1 vehicles: %2% (%3)").arg(logController.downloadingVehicleCount).arg(Math.round(logController.aggregateProgress * 100)).arg(logController.aggregateRate)
+                }
             } // Column - Buttons
         } // RowLayout
     } // Component
@@ -9,9 +9,15 @@
 
 #include "LogDownloadTest.h"
 #include "LogDownloadController.h"
+#include "LogDownloadWriter.h"
 #include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "LinkManager.h"
+#include "ParameterManager.h"
+#include "QGCApplication.h"
 
 #include <QDir>
+#include <QTemporaryDir>
 
 LogDownloadTest::LogDownloadTest(void)
 {
@@ -20,9 +26,172 @@ LogDownloadTest::LogDownloadTest(void)
 
 void LogDownloadTest::downloadTest(void)
 {
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _downloadFirstLog();
+}
+
+void LogDownloadTest::downloadBenchmark(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    // A log large enough for the download window to open up, over a fast link with some loss
+    const uint32_t cFileSize = 4 * 1024 * 1024;
+    _mockLink->setLogDownloadFileSize(cFileSize);
+    _mockLink->setLogDownloadLinkSimulation(50 /* packetsPerTick */, 1 /* lossPercent */);
+
+    _downloadFirstLog();
+}
 
+void LogDownloadTest::downloadMultiVehicleTest(void)
+{
     _connectMockLink(MAV_AUTOPILOT_PX4);
 
+    MultiVehicleManager* manager = qgcApp()->toolbox()->multiVehicleManager();
+
+    // Bring up a second vehicle on its own link
+    QSignalSpy spyVehicleAdded(manager, SIGNAL(vehicleAdded(Vehicle*)));
+    MockLink* mockLink2 = MockLink::startPX4MockLink(false);
+    QVERIFY(spyVehicleAdded.wait(10000));
+    Vehicle* vehicle2 = spyVehicleAdded[0][0].value<Vehicle*>();
+    QVERIFY(vehicle2);
+    QCOMPARE(vehicle2->priorityLink(), (LinkInterface*)mockLink2);
+
+    _downloadTwoVehicles(vehicle2, mockLink2, false /* sharedLink */);
+
+    QSignalSpy spyLinkDeleted(_linkManager, SIGNAL(linkDeleted(LinkInterface*)));
+    _linkManager->disconnectLink(mockLink2);
+    QVERIFY(spyLinkDeleted.wait(1000));
+}
+
+void LogDownloadTest::downloadSharedLinkTest(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    MultiVehicleManager* manager = qgcApp()->toolbox()->multiVehicleManager();
+
+    // Bring up a second vehicle which shares the radio of the first one
+    QSignalSpy spyVehicleAdded(manager, SIGNAL(vehicleAdded(Vehicle*)));
+    MockLink* mockLink2 = MockLink::startPX4MockLinkOnRadio(_mockLink);
+    QVERIFY(spyVehicleAdded.wait(10000));
+    Vehicle* vehicle2 = spyVehicleAdded[0][0].value<Vehicle*>();
+    QVERIFY(vehicle2);
+    QCOMPARE(vehicle2->priorityLink(), (LinkInterface*)_mockLink);
+
+    _downloadTwoVehicles(vehicle2, mockLink2, true /* sharedLink */);
+
+    QSignalSpy spyLinkDeleted(_linkManager, SIGNAL(linkDeleted(LinkInterface*)));
+    _linkManager->disconnectLink(mockLink2);
+    QVERIFY(spyLinkDeleted.wait(1000));
+}
+
+/// Destroying the writer must not lose writes which are still queued to its thread
+void LogDownloadTest::writerShutdownTest(void)
+{
+    const int cBlocks =     64;
+    const int cBlockSize =  64 * 1024;
+
+    QTemporaryDir   logDir;
+    QString         fileName = QDir(logDir.path()).filePath("writer.bin");
+    QByteArray      expected;
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    LogDownloadWriter* writer = new LogDownloadWriter();
+    for (int i=0; i<cBlocks; i++) {
+        QByteArray block(cBlockSize, (char)i);
+        writer->write(fileName, expected.size(), block);
+        expected.append(block);
+    }
+    delete writer;
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.size(), (qint64)expected.size());
+    QVERIFY(file.readAll() == expected);
+}
+
+/// Downloads a log from the unit test vehicle and a second vehicle at the same time and verifies their contents
+///     @param sharedLink true: Both vehicles are on the same link, so they must split the download window
+void LogDownloadTest::_downloadTwoVehicles(Vehicle* vehicle2, MockLink* mockLink2, bool sharedLink)
+{
+    MultiVehicleManager* manager = qgcApp()->toolbox()->multiVehicleManager();
+
+    if (!vehicle2->parameterManager()->parametersReady()) {
+        QSignalSpy spyParams(vehicle2->parameterManager(), SIGNAL(parametersReadyChanged(bool)));
+        QVERIFY(spyParams.wait(10000));
+    }
+
+    Vehicle*    rgVehicle[2]    = { _vehicle, vehicle2 };
+    MockLink*   rgMockLink[2]   = { _mockLink, mockLink2 };
+    QString     rgDownloadDir[2];
+
+    LogDownloadController* controller = new LogDownloadController();
+
+    // Start a download on each vehicle, the first one must keep going while the second vehicle is active
+    uint32_t soloWindowChunks = 0;
+    for (int i=0; i<2; i++) {
+        rgMockLink[i]->setLogDownloadFileSize(1024 * 1024);
+        rgMockLink[i]->setLogDownloadLinkSimulation(4 /* packetsPerTick */, 0 /* lossPercent */);
+
+        if (manager->activeVehicle() != rgVehicle[i]) {
+            QSignalSpy spyActiveVehicle(manager, SIGNAL(activeVehicleChanged(Vehicle*)));
+            manager->setActiveVehicle(rgVehicle[i]);
+            QVERIFY(spyActiveVehicle.wait(5000));
+        }
+
+        QSignalSpy spyRequestingList(controller, SIGNAL(requestingListChanged()));
+        controller->refresh();
+        while (controller->requestingList()) {
+            QVERIFY(spyRequestingList.wait(10000));
+        }
+        QCOMPARE(controller->model()->count(), 1);
+        (*controller->model())[0]->setSelected(true);
+
+        rgDownloadDir[i] = QDir::current().filePath(QString("LogDownloadTest%1").arg(i));
+        QVERIFY(QDir().mkpath(rgDownloadDir[i]));
+        controller->downloadToDirectory(rgDownloadDir[i]);
+        QCOMPARE(controller->downloadingLogs(), true);
+
+        if (i == 0) {
+            soloWindowChunks = controller->session(_vehicle)->maxWindowChunks();
+        }
+    }
+    QCOMPARE(controller->downloadingVehicleCount(), 2);
+
+    // Vehicles on the same link get an even share of the window, vehicles on separate links the full window
+    uint32_t expectedWindowChunks = sharedLink ? soloWindowChunks / 2 : soloWindowChunks;
+    for (int i=0; i<2; i++) {
+        QCOMPARE(controller->session(rgVehicle[i])->maxWindowChunks(), expectedWindowChunks);
+    }
+
+    QSignalSpy spyProgress(controller, SIGNAL(aggregateProgressChanged()));
+    while (controller->downloadingVehicleCount() != 0) {
+        QVERIFY(spyProgress.wait(30000));
+        if (controller->downloadingVehicleCount() == 1) {
+            // The remaining download gets the whole link back
+            for (int i=0; i<2; i++) {
+                if (controller->session(rgVehicle[i])->downloadingLogs()) {
+                    QCOMPARE(controller->session(rgVehicle[i])->maxWindowChunks(), soloWindowChunks);
+                }
+            }
+        }
+    }
+
+    for (int i=0; i<2; i++) {
+        QDir downloadDir(rgDownloadDir[i]);
+        QStringList files = downloadDir.entryList(QDir::Files);
+        QCOMPARE(files.count(), 1);
+        QVERIFY(UnitTest::fileCompare(downloadDir.filePath(files[0]), rgMockLink[i]->logDownloadFile()));
+        downloadDir.removeRecursively();
+    }
+
+    delete controller;
+}
+
+/// Lists the logs on the vehicle, downloads the first one and verifies its contents
+void LogDownloadTest::_downloadFirstLog(void)
+{
     LogDownloadController* controller = new LogDownloadController();
 
     _rgLogDownloadControllerSignals[requestingListChangedSignalIndex] =     SIGNAL(requestingListChanged());
@@ -52,7 +221,7 @@ void LogDownloadTest::downloadTest(void)
     QVERIFY(_multiSpyLogDownloadController->waitForSignalByIndex(downloadingLogsChangedSignalIndex, 10000));
     _multiSpyLogDownloadController->clearAllSignals();
     if (controller->downloadingLogs()) {
-        QVERIFY(_multiSpyLogDownloadController->waitForSignalByIndex(downloadingLogsChangedSignalIndex, 10000));
+        QVERIFY(_multiSpyLogDownloadController->waitForSignalByIndex(downloadingLogsChangedSignalIndex, 60000));
         QCOMPARE(controller->downloadingLogs(), false);
     }
     _multiSpyLogDownloadController->clearAllSignals();
@@ -62,5 +231,7 @@ void LogDownloadTest::downloadTest(void)
 
     QFile::remove(downloadFile);
 
+    delete _multiSpyLogDownloadController;
+    _multiSpyLogDownloadController = NULL;
     delete controller;
 }
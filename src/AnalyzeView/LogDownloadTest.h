@@ -25,8 +25,15 @@ private slots:
     //void cleanup(void) { _cleanup(); }
 
     void downloadTest(void);
+    void downloadBenchmark(void);
+    void downloadMultiVehicleTest(void);
+    void downloadSharedLinkTest(void);
+    void writerShutdownTest(void);
 
 private:
+    void _downloadFirstLog(void);
+    void _downloadTwoVehicles(Vehicle* vehicle2, MockLink* mockLink2, bool sharedLink);
+
     // LogDownloadController signals
 
     enum {
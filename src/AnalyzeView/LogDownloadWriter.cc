@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LogDownloadWriter.h"
+#include "LogDownloadController.h"
+
+#include <QDebug>
+
+LogDownloadWriter::LogDownloadWriter(QObject* parent)
+    : QObject(parent)
+{
+    _worker = new LogDownloadWriterWorker(this);
+    Q_CHECK_PTR(_worker);
+
+    _workerThread = new QThread(this);
+    Q_CHECK_PTR(_workerThread);
+    _worker->moveToThread(_workerThread);
+
+    connect(_worker, &LogDownloadWriterWorker::fileClosed, this, &LogDownloadWriter::fileClosed);
+
+    _workerThread->start();
+}
+
+LogDownloadWriter::~LogDownloadWriter()
+{
+    // Quitting the thread directly would discard writes and closes which are still queued to the worker. The shutdown is
+    // queued behind them instead, so everything handed over prior to destruction reaches the disk.
+    QMetaObject::invokeMethod(_worker, "_closeAllAndQuit", Qt::QueuedConnection);
+    _workerThread->wait();
+
+    delete _worker;
+    delete _workerThread;
+}
+
+void LogDownloadWriter::write(const QString& fileName, qint64 offset, const QByteArray& data)
+{
+    emit _writeOnThread(fileName, offset, data);
+}
+
+void LogDownloadWriter::close(const QString& fileName, bool remove)
+{
+    emit _closeOnThread(fileName, remove);
+}
+
+LogDownloadWriterWorker::LogDownloadWriterWorker(LogDownloadWriter* writer)
+{
+    connect(writer, &LogDownloadWriter::_writeOnThread, this, &LogDownloadWriterWorker::_write);
+    connect(writer, &LogDownloadWriter::_closeOnThread, this, &LogDownloadWriterWorker::_close);
+}
+
+LogDownloadWriterWorker::~LogDownloadWriterWorker()
+{
+    qDeleteAll(_files);
+}
+
+void LogDownloadWriterWorker::_write(QString fileName, qint64 offset, QByteArray data)
+{
+    QFile* file = _files.value(fileName, NULL);
+
+    if (!file) {
+        file = new QFile(fileName);
+        // The file was created and preallocated by the controller, so it must not be truncated here
+        if (!file->open(QIODevice::ReadWrite)) {
+            qWarning() << "Failed to open log file for writing:" << fileName << file->errorString();
+            _failedFiles.insert(fileName);
+            delete file;
+            return;
+        }
+        _files[fileName] = file;
+    }
+
+    if (!file->seek(offset) || file->write(data) != data.size()) {
+        qWarning() << "Error while writing log file:" << fileName << file->errorString();
+        _failedFiles.insert(fileName);
+    } else {
+        qCDebug(LogDownloadLog) << "Wrote log data (offset:" << offset << "size:" << data.size() << ")";
+    }
+}
+
+/// Closes any files which are still open and stops the worker thread. Runs after all previously queued work.
+void LogDownloadWriterWorker::_closeAllAndQuit(void)
+{
+    foreach (QFile* file, _files) {
+        file->close();
+    }
+    qDeleteAll(_files);
+    _files.clear();
+
+    thread()->quit();
+}
+
+void LogDownloadWriterWorker::_close(QString fileName, bool remove)
+{
+    QFile* file = _files.take(fileName);
+    if (file) {
+        file->close();
+        delete file;
+    }
+
+    bool success = !_failedFiles.remove(fileName);
+    if (remove) {
+        QFile::remove(fileName);
+    }
+
+    emit fileClosed(fileName, success);
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QByteArray>
+
+class LogDownloadWriterWorker;
+
+/// Writes downloaded log data to disk on a background thread. Data is handed over in large blocks and written
+/// in the order it was queued, so the GUI thread never blocks on file I/O during a download.
+class LogDownloadWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    LogDownloadWriter(QObject* parent = NULL);
+    ~LogDownloadWriter();
+
+    /// Queues a block of data to be written at the specified offset. The file must already exist, it is
+    /// opened on the first write.
+    void write(const QString& fileName, qint64 offset, const QByteArray& data);
+
+    /// Queues a close of the file which will happen after all previously queued writes
+    ///     @param remove true: delete the file once it is closed
+    void close(const QString& fileName, bool remove);
+
+signals:
+    /// Signalled once a file has been closed
+    ///     @param success false: one or more writes to the file failed
+    void fileClosed(QString fileName, bool success);
+
+    // These signals are used to move calls over to the worker thread
+    void _writeOnThread(QString fileName, qint64 offset, QByteArray data);
+    void _closeOnThread(QString fileName, bool remove);
+
+private:
+    LogDownloadWriterWorker*    _worker;
+    QThread*                    _workerThread;
+};
+
+/// Used to run file writes on a separate thread. Clients should call the public methods of LogDownloadWriter.
+class LogDownloadWriterWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    LogDownloadWriterWorker(LogDownloadWriter* writer);
+    ~LogDownloadWriterWorker();
+
+signals:
+    void fileClosed(QString fileName, bool success);
+
+private slots:
+    void _write(QString fileName, qint64 offset, QByteArray data);
+    void _close(QString fileName, bool remove);
+    void _closeAllAndQuit(void);
+
+private:
+    QHash<QString, QFile*>  _files;         ///< Files currently open for writing
+    QSet<QString>           _failedFiles;   ///< Files which had a write failure since they were opened
+};
@@ -25,7 +25,8 @@ FactGroup::FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject*
     , _updateRateMSecs(updateRateMsecs)
 {
     _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    _nameToFactMetaDataMap = FactMetaData::sharedMapFromJsonFile(metaDataFile);
+    _sharedMetaDataFile = metaDataFile;
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject* parent)
@@ -35,6 +36,13 @@ FactGroup::FactGroup(int updateRateMsecs, QObject* parent)
     _setupTimer();
 }
 
+FactGroup::~FactGroup()
+{
+    if (!_sharedMetaDataFile.isEmpty()) {
+        FactMetaData::releaseSharedMapFromJsonFile(_sharedMetaDataFile);
+    }
+}
+
 void FactGroup::_loadFromJsonArray(const QJsonArray jsonArray)
 {
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonArray(jsonArray, this);
@@ -28,6 +28,7 @@ class FactGroup : public QObject
 public:
     FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject* parent = NULL);
     FactGroup(int updateRateMsecs, QObject* parent = NULL);
+    ~FactGroup();
 
     Q_PROPERTY(QStringList factNames        READ factNames      CONSTANT)
     Q_PROPERTY(QStringList factGroupNames   READ factGroupNames CONSTANT)
@@ -54,6 +55,7 @@ private slots:
 private:
     void _setupTimer();
     QTimer _updateTimer;
+    QString _sharedMetaDataFile;    ///< Json file the shared meta data in _nameToFactMetaDataMap came from, empty for none
 
 protected:
     QMap<QString, Fact*>            _nameToFactMap;
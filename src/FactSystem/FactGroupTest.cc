@@ -0,0 +1,74 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactGroupTest.h"
+#include "MultiVehicleManager.h"
+#include "LinkManager.h"
+#include "QGCApplication.h"
+#include "MockLink.h"
+
+#include <QPointer>
+
+FactGroupTestGroup::FactGroupTestGroup(QObject* parent)
+    : FactGroup(0, ":/json/Vehicle/VibrationFact.json", parent)
+    , _xAxisFact(0, "xAxis", FactMetaData::valueTypeDouble)
+{
+    _addFact(&_xAxisFact, "xAxis");
+}
+
+void FactGroupTest::_sharedMetaData(void)
+{
+    const char*             jsonFile = ":/json/Vehicle/VibrationFact.json";
+    QPointer<FactMetaData>  sharedMetaData;
+
+    {
+        FactGroupTestGroup group1;
+        FactGroupTestGroup group2;
+
+        // Both groups should use the same meta data instance
+        sharedMetaData = group1.getFact("xAxis")->metaData();
+        QVERIFY(sharedMetaData);
+        QCOMPARE(group1.getFact("xAxis")->metaData(), group2.getFact("xAxis")->metaData());
+        QCOMPARE(group1.getFact("xAxis")->metaData(), FactMetaData::sharedMapFromJsonFile(jsonFile).value("xAxis"));
+        FactMetaData::releaseSharedMapFromJsonFile(jsonFile);
+
+        // Still in use by the groups
+        QVERIFY(sharedMetaData);
+    }
+
+    // Deleted along with the last group which used it
+    QVERIFY(sharedMetaData.isNull());
+}
+
+/// Creates 50 vehicles through MockLink
+void FactGroupTest::_create50VehiclesBenchmark(void)
+{
+    const int               cVehicles = 50;
+    MultiVehicleManager*    vehicleMgr = qgcApp()->toolbox()->multiVehicleManager();
+    LinkManager*            linkMgr = qgcApp()->toolbox()->linkManager();
+
+    QSignalSpy spyVehicleAdded(vehicleMgr, SIGNAL(vehicleAdded(Vehicle*)));
+
+    QBENCHMARK_ONCE {
+        for (int i=0; i<cVehicles; i++) {
+            QVERIFY(MockLink::startPX4MockLink(false));
+        }
+        while (spyVehicleAdded.count() < cVehicles) {
+            QVERIFY(spyVehicleAdded.wait(10000));
+        }
+    }
+
+    QCOMPARE(vehicleMgr->vehicles()->count(), cVehicles);
+
+    QSignalSpy spyVehicleRemoved(vehicleMgr, SIGNAL(vehicleRemoved(Vehicle*)));
+    linkMgr->disconnectAll();
+    while (spyVehicleRemoved.count() < cVehicles) {
+        QVERIFY(spyVehicleRemoved.wait(10000));
+    }
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "FactGroup.h"
+
+/// Unit test for FactGroup meta data sharing
+class FactGroupTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sharedMetaData(void);
+    void _create50VehiclesBenchmark(void);
+};
+
+/// FactGroup which uses the shared meta data of a json file
+class FactGroupTestGroup : public FactGroup
+{
+    Q_OBJECT
+
+public:
+    FactGroupTestGroup(QObject* parent = NULL);
+
+    Fact _xAxisFact;
+};
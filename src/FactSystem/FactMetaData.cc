@@ -20,6 +20,8 @@
 #include <limits>
 #include <cmath>
 
+QMap<QString, FactMetaData::SharedJsonMetaData_s> FactMetaData::_sharedJsonMetaDataMap;
+
 // Conversion Constants
 // Time
 const qreal FactMetaData::UnitConsts_s::secondsPerHour = 3600.0;
@@ -1032,6 +1034,34 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
     return createMapFromJsonArray(jsonArray, metaDataParent);
 }
 
+const QMap<QString, FactMetaData*>& FactMetaData::sharedMapFromJsonFile(const QString& jsonFilename)
+{
+    if (!_sharedJsonMetaDataMap.contains(jsonFilename)) {
+        // Shared meta data has no parent, it is deleted when the last user releases it
+        SharedJsonMetaData_s& sharedMetaData = _sharedJsonMetaDataMap[jsonFilename];
+        sharedMetaData.metaDataMap = createMapFromJsonFile(jsonFilename, NULL /* metaDataParent */);
+        sharedMetaData.refCount = 0;
+    }
+
+    SharedJsonMetaData_s& sharedMetaData = _sharedJsonMetaDataMap[jsonFilename];
+    sharedMetaData.refCount++;
+    return sharedMetaData.metaDataMap;
+}
+
+void FactMetaData::releaseSharedMapFromJsonFile(const QString& jsonFilename)
+{
+    if (!_sharedJsonMetaDataMap.contains(jsonFilename)) {
+        qWarning() << "releaseSharedMapFromJsonFile: meta data not in use" << jsonFilename;
+        return;
+    }
+
+    SharedJsonMetaData_s& sharedMetaData = _sharedJsonMetaDataMap[jsonFilename];
+    if (--sharedMetaData.refCount == 0) {
+        qDeleteAll(sharedMetaData.metaDataMap);
+        _sharedJsonMetaDataMap.remove(jsonFilename);
+    }
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray jsonArray, QObject* metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
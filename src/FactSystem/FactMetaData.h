@@ -54,6 +54,15 @@ public:
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent);
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray jsonArray, QObject* metaDataParent);
 
+    /// Returns the meta data for the specified json file. The file is only parsed the first time it is requested, after that
+    /// the same meta data is returned to all callers. The returned meta data is shared and must not be modified, make a
+    /// copy if changes are needed. Each call must be matched by a call to releaseSharedMapFromJsonFile.
+    static const QMap<QString, FactMetaData*>& sharedMapFromJsonFile(const QString& jsonFilename);
+
+    /// Releases meta data returned by sharedMapFromJsonFile. Once the last user releases it the meta data is deleted, so
+    /// the next user parses the file again and picks up current settings such as units.
+    static void releaseSharedMapFromJsonFile(const QString& jsonFilename);
+
     static FactMetaData* createFromJsonObject(const QJsonObject& json, QObject* metaDataParent);
 
     const FactMetaData& operator=(const FactMetaData& other);
@@ -253,6 +262,13 @@ private:
 
     static const AppSettingsTranslation_s _rgAppSettingsTranslations[];
 
+    struct SharedJsonMetaData_s {
+        QMap<QString, FactMetaData*>    metaDataMap;
+        int                             refCount;       ///< Number of users which have not released the meta data yet
+    };
+
+    static QMap<QString, SharedJsonMetaData_s> _sharedJsonMetaDataMap;  ///< Key: json file name, Value: meta data shared by all users of the file
+
     static const char*  _nameJsonKey;
     static const char*  _decimalPlacesJsonKey;
     static const char*  _typeJsonKey;
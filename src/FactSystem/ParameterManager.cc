@@ -60,8 +60,11 @@ ParameterManager::ParameterManager(Vehicle* vehicle)
     , _prevWaitingWriteParamNameCount(0)
     , _initialRequestRetryCount(0)
     , _disableAllRetries(false)
-    , _indexBatchQueueActive(false)
     , _totalParamCount(0)
+    , _bulkWriteQueueing(false)
+    , _bulkWriteTotalCount(0)
+    , _bulkWriteCompleteCount(0)
+    , _bulkWriteRebootRequired(false)
 {
     _versionParam = vehicle->firmwarePlugin()->getVersionParam();
 
@@ -80,6 +83,10 @@ ParameterManager::ParameterManager(Vehicle* vehicle)
     _waitingParamTimeoutTimer.setInterval(3000);
     connect(&_waitingParamTimeoutTimer, &QTimer::timeout, this, &ParameterManager::_waitingParamTimeout);
 
+    _bulkWriteAckTimer.setSingleShot(false);
+    _bulkWriteAckTimer.setInterval(_bulkWriteAckTimeoutMsecs / 4);
+    connect(&_bulkWriteAckTimer, &QTimer::timeout, this, &ParameterManager::_bulkWriteAckTimeout);
+
     connect(_vehicle->uas(), &UASInterface::parameterUpdate, this, &ParameterManager::_parameterUpdate);
 
     // Ensure the cache directory exists
@@ -90,7 +97,7 @@ ParameterManager::ParameterManager(Vehicle* vehicle)
 
 ParameterManager::~ParameterManager()
 {
-    delete _parameterMetaData;
+    // _parameterMetaData is owned by the firmware plugin and shared with other vehicles
 }
 
 /// Called whenever a parameter is updated or first seen.
@@ -120,7 +127,7 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
     _initialRequestTimeoutTimer.stop();
 
 #if 0
-    if (!_initialLoadComplete && !_indexBatchQueueActive) {
+    if (!_initialLoadComplete && !_indexBatchQueueActiveComponents.contains(componentId)) {
         // Handy for testing retry logic
         static int counter = 0;
         if (counter++ & 0x8) {
@@ -170,6 +177,7 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
 
         qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Seeing component for first time - paramcount:" << parameterCount;
     }
+    _componentUpdateTimerMap[componentId].start();
 
     bool componentParamsComplete = false;
     if (_waitingReadParamIndexMap[componentId].count() == 1) {
@@ -186,11 +194,13 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
     // Remove this parameter from the waiting lists
     if (_waitingReadParamIndexMap[componentId].contains(parameterId)) {
         _waitingReadParamIndexMap[componentId].remove(parameterId);
-        _indexBatchQueue.removeOne(parameterId);
-        _fillIndexBatchQueue(false /* waitingParamTimeout */);
+        _indexBatchQueueMap[componentId].removeOne(parameterId);
+        _fillIndexBatchQueue(componentId, false /* waitingParamTimeout */);
     }
+    _retryStalledComponents(componentId);
     _waitingReadParamNameMap[componentId].remove(parameterName);
     _waitingWriteParamNameMap[componentId].remove(parameterName);
+    bool bulkWriteAck = _bulkWriteAckMap.contains(componentId) && _bulkWriteAckMap[componentId].remove(parameterName) != 0;
     if (_waitingReadParamIndexMap[componentId].count()) {
         qCDebug(ParameterManagerVerbose2Log) << _logVehiclePrefix(componentId) << "_waitingReadParamIndexMap:" << _waitingReadParamIndexMap[componentId];
     }
@@ -254,6 +264,7 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
     } else {
         _setLoadProgress((double)(_totalParamCount - readWaitingParamCount) / (double)_totalParamCount);
     }
+    emit componentLoadProgressChanged(componentId, componentLoadProgress(componentId));
 
     // Get parameter set version
     if (!_versionParam.isEmpty() && _versionParam == parameterName) {
@@ -333,6 +344,12 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
         _saveToEEPROM();
     }
 
+    if (bulkWriteAck) {
+        // Ack frees up a slot in the bulk write window
+        _bulkWriteCompleteCount++;
+        _bulkWriteSendNext();
+    }
+
     // Update param cache. The param cache is only used on PX4 Firmware since ArduPilot and Solo have volatile params
     // which invalidate the cache. The Solo also streams param updates in flight for things like gimbal values
     // which in turn causes a perf problem with all the param cache updates.
@@ -366,6 +383,26 @@ void ParameterManager::_valueUpdated(const QVariant& value)
     int componentId = fact->componentId();
     QString name = fact->name();
 
+    if (_bulkWriteQueueing) {
+        // Value will be sent through the bulk write window, value is read from the fact when the write is sent
+        foreach (const BulkWriteItem_t& queuedItem, _bulkWriteQueue) {
+            if (queuedItem.componentId == componentId && queuedItem.paramName == name) {
+                return;
+            }
+        }
+        BulkWriteItem_t bulkWriteItem;
+        bulkWriteItem.componentId = componentId;
+        bulkWriteItem.paramName = name;
+        bulkWriteItem.retryCount = 0;
+        _bulkWriteQueue.append(bulkWriteItem);
+        _saveRequired = true;
+        if (fact->rebootRequired()) {
+            _bulkWriteRebootRequired = true;
+        }
+        qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Queued bulk write - name:" << name << value;
+        return;
+    }
+
     _dataMutex.lock();
 
     if (_waitingWriteParamNameMap.contains(componentId)) {
@@ -529,72 +566,94 @@ const QMap<int, QMap<QString, QStringList> >& ParameterManager::getGroupMap(void
     return _mapGroup2ParameterName;
 }
 
-/// Requests missing index based parameters from the vehicle.
+/// Requests missing index based parameters for a single component from the vehicle.
+///     @param componentId: component to request missing parameters for
 ///     @param waitingParamTimeout: true: being called due to timeout, false: being called to re-fill the batch queue
 /// return true: Parameters were requested, false: No more requests needed
-bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
+bool ParameterManager::_fillIndexBatchQueue(int componentId, bool waitingParamTimeout)
 {
-    if (!_indexBatchQueueActive) {
+    if (!_indexBatchQueueActiveComponents.contains(componentId)) {
         return false;
     }
 
     const int maxBatchSize = 10;
+    QList<int>& indexBatchQueue = _indexBatchQueueMap[componentId];
 
     if (waitingParamTimeout) {
         // We timed out, clear the queue and try again
-        qCDebug(ParameterManagerLog) << "Refilling index based batch queue due to timeout";
-        _indexBatchQueue.clear();
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Refilling index based batch queue due to timeout";
+        indexBatchQueue.clear();
     } else {
-        qCDebug(ParameterManagerLog) << "Refilling index based batch queue due to received parameter";
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Refilling index based batch queue due to received parameter";
     }
 
-    foreach(int componentId, _waitingReadParamIndexMap.keys()) {
-        if (_waitingReadParamIndexMap[componentId].count()) {
-            qCDebug(ParameterManagerLog) << _logVehiclePrefix() << "_waitingReadParamIndexMap count" << _waitingReadParamIndexMap[componentId].count();
-            qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix() << "_waitingReadParamIndexMap" << _waitingReadParamIndexMap[componentId];
-        }
+    if (_waitingReadParamIndexMap[componentId].count()) {
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "_waitingReadParamIndexMap count" << _waitingReadParamIndexMap[componentId].count();
+        qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "_waitingReadParamIndexMap" << _waitingReadParamIndexMap[componentId];
+    }
 
-        foreach(int paramIndex, _waitingReadParamIndexMap[componentId].keys()) {
-            if (_indexBatchQueue.contains(paramIndex)) {
-                // Don't add more than once
-                continue;
-            }
+    foreach(int paramIndex, _waitingReadParamIndexMap[componentId].keys()) {
+        if (indexBatchQueue.contains(paramIndex)) {
+            // Don't add more than once
+            continue;
+        }
 
-            if (_indexBatchQueue.count() > maxBatchSize) {
-                break;
-            }
+        if (indexBatchQueue.count() > maxBatchSize) {
+            break;
+        }
 
-            _waitingReadParamIndexMap[componentId][paramIndex]++;   // Bump retry count
-            if (_disableAllRetries || _waitingReadParamIndexMap[componentId][paramIndex] > _maxInitialLoadRetrySingleParam) {
-                // Give up on this index
-                _failedReadParamIndexMap[componentId] << paramIndex;
-                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Giving up on (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
-                _waitingReadParamIndexMap[componentId].remove(paramIndex);
-            } else {
-                // Retry again
-                _indexBatchQueue.append(paramIndex);
-                _readParameterRaw(componentId, "", paramIndex);
-                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
-            }
+        _waitingReadParamIndexMap[componentId][paramIndex]++;   // Bump retry count
+        if (_disableAllRetries || _waitingReadParamIndexMap[componentId][paramIndex] > _maxInitialLoadRetrySingleParam) {
+            // Give up on this index
+            _failedReadParamIndexMap[componentId] << paramIndex;
+            qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Giving up on (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
+            _waitingReadParamIndexMap[componentId].remove(paramIndex);
+        } else {
+            // Retry again
+            indexBatchQueue.append(paramIndex);
+            _readParameterRaw(componentId, "", paramIndex);
+            qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
         }
     }
 
-    return _indexBatchQueue.count() != 0;
+    return indexBatchQueue.count() != 0;
+}
+
+/// Components load in parallel over the same link. The waiting param timeout only fires once all components go quiet, so
+/// a component which stops streaming while others are still streaming has its index based re-requests started here.
+///     @param updatedComponentId: component which just sent a parameter
+void ParameterManager::_retryStalledComponents(int updatedComponentId)
+{
+    foreach(int componentId, _waitingReadParamIndexMap.keys()) {
+        if (componentId == updatedComponentId || _waitingReadParamIndexMap[componentId].isEmpty()) {
+            continue;
+        }
+        if (_componentUpdateTimerMap[componentId].elapsed() < _componentStallTimeoutMsecs) {
+            continue;
+        }
+
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Component stalled while others are streaming, re-requesting missing indices";
+        _indexBatchQueueActiveComponents.insert(componentId);
+        _componentUpdateTimerMap[componentId].start();  // Wait a full stall period before re-requesting again
+        _fillIndexBatchQueue(componentId, true /* waitingParamTimeout */);
+    }
 }
 
 void ParameterManager::_waitingParamTimeout(void)
 {
     bool paramsRequested = false;
     const int maxBatchSize = 10;
-    int batchCount = 0;
 
     qCDebug(ParameterManagerLog) << _logVehiclePrefix() << "_waitingParamTimeout";
 
-    // Now that we have timed out for possibly the first time we can activate the index batch queue
-    _indexBatchQueueActive = true;
-
-    // First check for any missing parameters from the initial index based load
-    paramsRequested = _fillIndexBatchQueue(true /* waitingParamTimeout */);
+    // First check for any missing parameters from the initial index based load. Now that we have timed out we can activate the
+    // index batch queue for all components.
+    foreach(int componentId, _waitingReadParamIndexMap.keys()) {
+        _indexBatchQueueActiveComponents.insert(componentId);
+        if (_fillIndexBatchQueue(componentId, true /* waitingParamTimeout */)) {
+            paramsRequested = true;
+        }
+    }
 
     if (!paramsRequested && !_waitingForDefaultComponent && !_mapParameterName2Variant.contains(_vehicle->defaultComponentId())) {
         // Initial load is complete but we still don't have any default component params. Wait one more cycle to see if the
@@ -608,51 +667,59 @@ void ParameterManager::_waitingParamTimeout(void)
 
     _checkInitialLoadComplete();
 
-    if (!paramsRequested) {
-        foreach(int componentId, _waitingWriteParamNameMap.keys()) {
-            foreach(const QString &paramName, _waitingWriteParamNameMap[componentId].keys()) {
-                paramsRequested = true;
-                _waitingWriteParamNameMap[componentId][paramName]++;   // Bump retry count
-                if (_waitingWriteParamNameMap[componentId][paramName] <= _maxReadWriteRetry) {
-                    _writeParameterRaw(componentId, paramName, getParameter(componentId, paramName)->rawValue());
-                    qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Write resend for (paramName:" << paramName << "retryCount:" << _waitingWriteParamNameMap[componentId][paramName] << ")";
-                    if (++batchCount > maxBatchSize) {
-                        goto Out;
-                    }
-                } else {
-                    // Exceeded max retry count, notify user
-                    _waitingWriteParamNameMap[componentId].remove(paramName);
-                    QString errorMsg = tr("Parameter write failed: veh:%1 comp:%2 param:%3").arg(_vehicle->id()).arg(componentId).arg(paramName);
-                    qCDebug(ParameterManagerLog) << errorMsg;
-                    qgcApp()->showMessage(errorMsg);
-                }
+    // Named retries are batched per component so a component with many outstanding requests can't starve the others. A
+    // component which is still working through its index based load finishes that first.
+    foreach(int componentId, _waitingWriteParamNameMap.keys()) {
+        if (_indexBatchQueueMap[componentId].count()) {
+            continue;
+        }
+
+        int batchCount = 0;
+
+        foreach(const QString &paramName, _waitingWriteParamNameMap[componentId].keys()) {
+            if (batchCount > maxBatchSize) {
+                break;
+            }
+            paramsRequested = true;
+            _waitingWriteParamNameMap[componentId][paramName]++;   // Bump retry count
+            if (_waitingWriteParamNameMap[componentId][paramName] <= _maxReadWriteRetry) {
+                _writeParameterRaw(componentId, paramName, getParameter(componentId, paramName)->rawValue());
+                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Write resend for (paramName:" << paramName << "retryCount:" << _waitingWriteParamNameMap[componentId][paramName] << ")";
+                batchCount++;
+            } else {
+                // Exceeded max retry count, notify user
+                _waitingWriteParamNameMap[componentId].remove(paramName);
+                QString errorMsg = tr("Parameter write failed: veh:%1 comp:%2 param:%3").arg(_vehicle->id()).arg(componentId).arg(paramName);
+                qCDebug(ParameterManagerLog) << errorMsg;
+                qgcApp()->showMessage(errorMsg);
             }
         }
-    }
 
-    if (!paramsRequested) {
-        foreach(int componentId, _waitingReadParamNameMap.keys()) {
-            foreach(const QString &paramName, _waitingReadParamNameMap[componentId].keys()) {
-                paramsRequested = true;
-                _waitingReadParamNameMap[componentId][paramName]++;   // Bump retry count
-                if (_waitingReadParamNameMap[componentId][paramName] <= _maxReadWriteRetry) {
-                    _readParameterRaw(componentId, paramName, -1);
-                    qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramName:" << paramName << "retryCount:" << _waitingReadParamNameMap[componentId][paramName] << ")";
-                    if (++batchCount > maxBatchSize) {
-                        goto Out;
-                    }
-                } else {
-                    // Exceeded max retry count, notify user
-                    _waitingReadParamNameMap[componentId].remove(paramName);
-                    QString errorMsg = tr("Parameter read failed: veh:%1 comp:%2 param:%3").arg(_vehicle->id()).arg(componentId).arg(paramName);
-                    qCDebug(ParameterManagerLog) << errorMsg;
-                    qgcApp()->showMessage(errorMsg);
-                }
+        if (batchCount) {
+            // Writes go first, reads for this component wait for the next cycle
+            continue;
+        }
+
+        foreach(const QString &paramName, _waitingReadParamNameMap[componentId].keys()) {
+            if (batchCount > maxBatchSize) {
+                break;
+            }
+            paramsRequested = true;
+            _waitingReadParamNameMap[componentId][paramName]++;   // Bump retry count
+            if (_waitingReadParamNameMap[componentId][paramName] <= _maxReadWriteRetry) {
+                _readParameterRaw(componentId, paramName, -1);
+                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramName:" << paramName << "retryCount:" << _waitingReadParamNameMap[componentId][paramName] << ")";
+                batchCount++;
+            } else {
+                // Exceeded max retry count, notify user
+                _waitingReadParamNameMap[componentId].remove(paramName);
+                QString errorMsg = tr("Parameter read failed: veh:%1 comp:%2 param:%3").arg(_vehicle->id()).arg(componentId).arg(paramName);
+                qCDebug(ParameterManagerLog) << errorMsg;
+                qgcApp()->showMessage(errorMsg);
             }
         }
     }
 
-Out:
     if (paramsRequested) {
         qCDebug(ParameterManagerLog) << _logVehiclePrefix() << "Restarting _waitingParamTimeoutTimer - re-request";
         _waitingParamTimeoutTimer.start();
@@ -859,7 +926,8 @@ void ParameterManager::_saveToEEPROM(void)
 
 QString ParameterManager::readParametersFromStream(QTextStream& stream)
 {
-    QString errors;
+    QString                         errors;
+    QList<QPair<Fact*, QVariant> >  factValues;
 
     while (!stream.atEnd()) {
         QString line = stream.readLine();
@@ -894,11 +962,13 @@ QString ParameterManager::readParametersFromStream(QTextStream& stream)
                 }
 
                 qCDebug(ParameterManagerLog) << "Updating parameter" << componentId << paramName << valStr;
-                fact->setRawValue(valStr);
+                factValues.append(QPair<Fact*, QVariant>(fact, valStr));
             }
         }
     }
 
+    _bulkWriteFactValues(factValues);
+
     return errors;
 }
 
@@ -1422,6 +1492,8 @@ bool ParameterManager::loadFromJson(const QJsonObject& json, bool required, QStr
         return false;
     }
 
+    QList<QPair<Fact*, QVariant> > factValues;
+
     QJsonArray rgParams = json[_jsonParametersKey].toArray();
     for (int i=0; i<rgParams.count(); i++) {
         QJsonValueRef paramValue = rgParams[i];
@@ -1450,10 +1522,11 @@ bool ParameterManager::loadFromJson(const QJsonObject& json, bool required, QStr
             continue;
         }
 
-        Fact* fact = getParameter(compId, name);
-        fact->setRawValue(value);
+        factValues.append(QPair<Fact*, QVariant>(getParameter(compId, name), value));
     }
 
+    _bulkWriteFactValues(factValues);
+
     return true;
 }
 
@@ -1475,8 +1548,151 @@ QString ParameterManager::_logVehiclePrefix(int componentId)
     }
 }
 
+double ParameterManager::componentLoadProgress(int componentId)
+{
+    componentId = _actualComponentId(componentId);
+
+    int paramCount = _paramCountMap.value(componentId, 0);
+    if (paramCount == 0) {
+        return 0.0;
+    }
+
+    int waitingCount = _waitingReadParamIndexMap.value(componentId).count() + _waitingReadParamNameMap.value(componentId).count();
+    return (double)qMax(paramCount - waitingCount, 0) / (double)paramCount;
+}
+
 void ParameterManager::_setLoadProgress(double loadProgress)
 {
     _loadProgress = loadProgress;
     emit loadProgressChanged(loadProgress);
 }
+
+/// Updates the specified facts and writes the new values to the vehicle through the bulk write window
+void ParameterManager::_bulkWriteFactValues(const QList<QPair<Fact*, QVariant> >& factValues)
+{
+    int previousQueueCount = _bulkWriteQueue.count();
+
+    // Fact value changes now queue up instead of being sent
+    _bulkWriteQueueing = true;
+    for (int i=0; i<factValues.count(); i++) {
+        factValues[i].first->setRawValue(factValues[i].second);
+    }
+    _bulkWriteQueueing = false;
+
+    int newWriteCount = _bulkWriteQueue.count() - previousQueueCount;
+    if (newWriteCount == 0) {
+        return;
+    }
+
+    if (_bulkWriteTotalCount == 0) {
+        _bulkWriteCompleteCount = 0;
+        _bulkWriteFailedParams.clear();
+        _bulkWriteElapsedTimer.start();
+    }
+    _bulkWriteTotalCount += newWriteCount;
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix() << "Bulk write started - count:" << newWriteCount << "total:" << _bulkWriteTotalCount;
+
+    _bulkWriteSendNext();
+}
+
+int ParameterManager::_bulkWriteInFlightCount(void)
+{
+    int inFlightCount = 0;
+
+    foreach (int componentId, _bulkWriteAckMap.keys()) {
+        inFlightCount += _bulkWriteAckMap[componentId].count();
+    }
+
+    return inFlightCount;
+}
+
+/// Fills the bulk write window with queued writes
+void ParameterManager::_bulkWriteSendNext(void)
+{
+    if (_bulkWriteTotalCount == 0) {
+        return;
+    }
+
+    int inFlightCount = _bulkWriteInFlightCount();
+    while (inFlightCount < _bulkWriteWindowSize && !_bulkWriteQueue.isEmpty()) {
+        BulkWriteItem_t bulkWriteItem = _bulkWriteQueue.takeFirst();
+
+        bulkWriteItem.sentTimer.start();
+        _bulkWriteAckMap[bulkWriteItem.componentId][bulkWriteItem.paramName] = bulkWriteItem;
+        _writeParameterRaw(bulkWriteItem.componentId, bulkWriteItem.paramName, getParameter(bulkWriteItem.componentId, bulkWriteItem.paramName)->rawValue());
+        inFlightCount++;
+    }
+
+    if (inFlightCount == 0) {
+        _bulkWriteFinish();
+        return;
+    }
+
+    if (!_bulkWriteAckTimer.isActive()) {
+        _bulkWriteAckTimer.start();
+    }
+    _setLoadProgress((double)_bulkWriteCompleteCount / (double)_bulkWriteTotalCount);
+}
+
+/// Resends outstanding bulk writes which have not been acked within the timeout. Only the writes which timed
+/// out are resent, the rest of the window is left alone.
+void ParameterManager::_bulkWriteAckTimeout(void)
+{
+    foreach (int componentId, _bulkWriteAckMap.keys()) {
+        foreach (const QString& paramName, _bulkWriteAckMap[componentId].keys()) {
+            BulkWriteItem_t& bulkWriteItem = _bulkWriteAckMap[componentId][paramName];
+
+            if (bulkWriteItem.sentTimer.elapsed() < _bulkWriteAckTimeoutMsecs) {
+                continue;
+            }
+
+            if (_disableAllRetries || ++bulkWriteItem.retryCount > _maxReadWriteRetry) {
+                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Bulk write giving up on (paramName:" << paramName << ")";
+                _bulkWriteFailedParams.append(QString("%1:%2").arg(componentId).arg(paramName));
+                _bulkWriteAckMap[componentId].remove(paramName);
+                _bulkWriteCompleteCount++;
+            } else {
+                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Bulk write resend for (paramName:" << paramName << "retryCount:" << bulkWriteItem.retryCount << ")";
+                bulkWriteItem.sentTimer.start();
+                _writeParameterRaw(componentId, paramName, getParameter(componentId, paramName)->rawValue());
+            }
+        }
+    }
+
+    _bulkWriteSendNext();
+}
+
+void ParameterManager::_bulkWriteFinish(void)
+{
+    int elapsedMsecs = _bulkWriteElapsedTimer.elapsed();
+    int failedCount = _bulkWriteFailedParams.count();
+    int writeCount = _bulkWriteTotalCount - failedCount;
+
+    _bulkWriteAckTimer.stop();
+    _bulkWriteAckMap.clear();
+    _bulkWriteTotalCount = 0;
+    _bulkWriteCompleteCount = 0;
+    _setLoadProgress(0.0);
+
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix() << "Bulk write complete - written:" << writeCount << "failed:" << failedCount
+                                 << "msecs:" << elapsedMsecs
+                                 << "params/sec:" << (elapsedMsecs ? (writeCount * 1000.0) / elapsedMsecs : 0.0);
+
+    if (failedCount) {
+        QString errorMsg = tr("Parameter write failed: veh:%1 params:%2").arg(_vehicle->id()).arg(_bulkWriteFailedParams.join(QStringLiteral(", ")));
+        qCDebug(ParameterManagerLog) << errorMsg;
+        qgcApp()->showMessage(errorMsg);
+    }
+    _bulkWriteFailedParams.clear();
+
+    if (writeCount) {
+        _saveToEEPROM();
+    }
+
+    if (_bulkWriteRebootRequired && !qgcApp()->runningUnitTests()) {
+        qgcApp()->showMessage(tr("One or more of the loaded parameters requires a Vehicle reboot to take effect"));
+    }
+    _bulkWriteRebootRequired = false;
+
+    emit bulkWriteComplete(writeCount, failedCount, elapsedMsecs);
+}
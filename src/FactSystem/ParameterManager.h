@@ -18,6 +18,8 @@
 #include <QMutex>
 #include <QDir>
 #include <QJsonObject>
+#include <QElapsedTimer>
+#include <QSet>
 
 #include "FactSystem.h"
 #include "MAVLinkProtocol.h"
@@ -52,6 +54,10 @@ public:
     Q_PROPERTY(double loadProgress READ loadProgress NOTIFY loadProgressChanged)
     double loadProgress(void) const { return _loadProgress; }
 
+    /// Load progress for a single component. Components load in parallel so each has its own progress.
+    ///     @return Progress [0.0,1.0], 0.0 if component has not been seen yet
+    Q_INVOKABLE double componentLoadProgress(int componentId);
+
     /// @return Directory of parameter caches
     static QDir parameterCacheDir();
 
@@ -119,10 +125,20 @@ public:
 
     Vehicle* vehicle(void) { return _vehicle; }
 
+    /// true: A bulk write from a parameter file is in progress
+    bool bulkWriteInProgress(void) const { return _bulkWriteTotalCount != 0; }
+
 signals:
     void parametersReadyChanged(bool parametersReady);
     void missingParametersChanged(bool missingParameters);
     void loadProgressChanged(float value);
+    void componentLoadProgressChanged(int componentId, double value);
+
+    /// Signalled when all writes queued by readParametersFromStream/loadFromJson have been acked or have failed
+    ///     @param writeCount Number of parameters written successfully
+    ///     @param failedCount Number of parameters which could not be written after max retries
+    ///     @param elapsedMsecs Time from first PARAM_SET to completion
+    void bulkWriteComplete(int writeCount, int failedCount, int elapsedMsecs);
     
 protected:
     Vehicle*            _vehicle;
@@ -147,12 +163,18 @@ private:
     void _loadOfflineEditingParams(void);
     QString _logVehiclePrefix(int componentId = -1);
     void _setLoadProgress(double loadProgress);
-    bool _fillIndexBatchQueue(bool waitingParamTimeout);
+    bool _fillIndexBatchQueue(int componentId, bool waitingParamTimeout);
+    void _retryStalledComponents(int updatedComponentId);
 
     MAV_PARAM_TYPE _factTypeToMavType(FactMetaData::ValueType_t factType);
     FactMetaData::ValueType_t _mavTypeToFactType(MAV_PARAM_TYPE mavType);
     void _saveToEEPROM(void);
     void _checkInitialLoadComplete(void);
+    void _bulkWriteFactValues(const QList<QPair<Fact*, QVariant> >& factValues);
+    void _bulkWriteSendNext(void);
+    void _bulkWriteAckTimeout(void);
+    void _bulkWriteFinish(void);
+    int  _bulkWriteInFlightCount(void);
 
     /// First mapping is by component id
     /// Second mapping is parameter name, to Fact* in QVariant
@@ -173,7 +195,7 @@ private:
     bool        _logReplay;                     ///< true: running with log replay link
     QString     _versionParam;                  ///< Parameter which contains parameter set version
     int         _parameterSetMajorVersion;      ///< Version for parameter set, -1 if not known
-    QObject*    _parameterMetaData;             ///< Opaque data from FirmwarePlugin::loadParameterMetaDataCall
+    QObject*    _parameterMetaData;             ///< Opaque data from FirmwarePlugin::loadParameterMetaDataCall, owned by plugin
 
     // Wait counts from previous parameter update cycle
     int         _prevWaitingReadParamIndexCount;
@@ -186,8 +208,13 @@ private:
     static const int    _maxReadWriteRetry = 5;                 ///< Maximum retries read/write
     bool                _disableAllRetries;                     ///< true: Don't retry any requests (used for testing)
 
-    bool        _indexBatchQueueActive; ///< true: we are actively batching re-requests for missing index base params, false: index based re-request has not yet started
-    QList<int>  _indexBatchQueue;       ///< The current queue of index re-requests
+    // Each component runs its own index based load. Retries for a component start either on the global waiting param
+    // timeout or when the component stops streaming while other components are still streaming.
+    QSet<int>                   _indexBatchQueueActiveComponents;   ///< Components which are actively batching re-requests for missing index based params
+    QMap<int, QList<int> >      _indexBatchQueueMap;                ///< Key: Component id, Value: current queue of index re-requests
+    QMap<int, QElapsedTimer>    _componentUpdateTimerMap;           ///< Key: Component id, Value: time since last param received from component
+
+    static const int _componentStallTimeoutMsecs = 1000;    ///< Component which has been silent this long while others stream is re-requested
 
     QMap<int, int>                  _paramCountMap;             ///< Key: Component id, Value: count of parameters in this component
     QMap<int, QMap<int, int> >      _waitingReadParamIndexMap;  ///< Key: Component id, Value: Map { Key: parameter index still waiting for, Value: retry count }
@@ -199,6 +226,28 @@ private:
     
     QTimer _initialRequestTimeoutTimer;
     QTimer _waitingParamTimeoutTimer;
+
+    // Bulk write support. Writes queued from parameter files are sent through a sliding window of outstanding PARAM_SET
+    // messages instead of all at once. Each outstanding write is tracked in the ack table and retried on its own timeout.
+    typedef struct {
+        int             componentId;
+        QString         paramName;
+        int             retryCount;
+        QElapsedTimer   sentTimer;
+    } BulkWriteItem_t;
+
+    bool                                        _bulkWriteQueueing;         ///< true: Fact value changes are queued for bulk write instead of sent immediately
+    QList<BulkWriteItem_t>                      _bulkWriteQueue;            ///< Writes which have not been sent yet
+    QMap<int, QMap<QString, BulkWriteItem_t> >  _bulkWriteAckMap;           ///< Key: Component id, Value: Map { Key: parameter name, Value: outstanding write }
+    int                                         _bulkWriteTotalCount;       ///< Total number of writes in current bulk write, 0 for none active
+    int                                         _bulkWriteCompleteCount;    ///< Number of writes acked or failed so far
+    QStringList                                 _bulkWriteFailedParams;
+    bool                                        _bulkWriteRebootRequired;   ///< true: One of the queued writes requires a reboot
+    QElapsedTimer                               _bulkWriteElapsedTimer;
+    QTimer                                      _bulkWriteAckTimer;
+
+    static const int _bulkWriteWindowSize =         10;     ///< Maximum number of outstanding PARAM_SET messages
+    static const int _bulkWriteAckTimeoutMsecs =    1000;   ///< Time to wait for PARAM_VALUE ack before retrying a single write
     
     QMutex _dataMutex;
     
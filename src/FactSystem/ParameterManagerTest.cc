@@ -138,3 +138,83 @@ void ParameterManagerTest::_requestListMissingParamFail(void)
     // User should have been notified
     checkExpectedMessageBox();
 }
+
+// Load a parameter file which changes every float parameter while MockLink drops some of the PARAM_SET messages.
+// The bulk write window should resend the lost writes and complete with all values written.
+void ParameterManagerTest::_bulkWriteAckLoss(void)
+{
+    Q_ASSERT(!_mockLink);
+    _mockLink = MockLink::startPX4MockLink(false, MockConfiguration::FailParamSetAckLoss);
+
+    MultiVehicleManager* vehicleMgr = qgcApp()->toolbox()->multiVehicleManager();
+    QVERIFY(vehicleMgr);
+
+    // Wait for the Vehicle to get created and the params to load
+    QSignalSpy spyParamsReady(vehicleMgr, SIGNAL(parameterReadyVehicleAvailableChanged(bool)));
+    QCOMPARE(spyParamsReady.wait(60000), true);
+
+    Vehicle* vehicle = vehicleMgr->activeVehicle();
+    QVERIFY(vehicle);
+    ParameterManager* paramMgr = vehicle->parameterManager();
+
+    // Build a parameter file with all float values changed
+    QString     savedParams;
+    QTextStream saveStream(&savedParams);
+    paramMgr->writeParametersToStream(saveStream);
+    saveStream.flush();
+
+    QString     changedParams;
+    QTextStream changedStream(&changedParams);
+    int         changedCount = 0;
+    foreach (const QString& line, savedParams.split("\n", QString::SkipEmptyParts)) {
+        QStringList columns = line.split("\t");
+        if (!line.startsWith("#") && columns.count() == 5 && columns[4].toUInt() == MAV_PARAM_TYPE_REAL32) {
+            columns[3] = QString::number(columns[3].toDouble() + 1.0, 'g', 9);
+            changedCount++;
+        }
+        changedStream << columns.join("\t") << "\n";
+    }
+    changedStream.flush();
+    QVERIFY(changedCount > 10);   // More than a single write window
+
+    QSignalSpy  spyBulkWrite(paramMgr, SIGNAL(bulkWriteComplete(int,int,int)));
+    QTextStream loadStream(&changedParams);
+    QCOMPARE(paramMgr->readParametersFromStream(loadStream), QString());
+    QCOMPARE(paramMgr->bulkWriteInProgress(), true);
+
+    QCOMPARE(spyBulkWrite.wait(30000), true);
+    QList<QVariant> arguments = spyBulkWrite.takeFirst();
+    QCOMPARE(arguments.count(), 3);
+    QCOMPARE(arguments[0].toInt(), changedCount);
+    QCOMPARE(arguments[1].toInt(), 0);
+    QCOMPARE(paramMgr->bulkWriteInProgress(), false);
+}
+
+// MockLink streams a second component alongside the autopilot and stops it part way through the initial load. The stalled
+// component should be re-requested while the autopilot is still streaming, and the load should complete with all params.
+void ParameterManagerTest::_componentStall(void)
+{
+    Q_ASSERT(!_mockLink);
+    _mockLink = MockLink::startAPMArduCopterMockLink(false, MockConfiguration::FailParamComponentStall);
+
+    MultiVehicleManager* vehicleMgr = qgcApp()->toolbox()->multiVehicleManager();
+    QVERIFY(vehicleMgr);
+
+    QSignalSpy spyParamsReady(vehicleMgr, SIGNAL(parameterReadyVehicleAvailableChanged(bool)));
+    QCOMPARE(spyParamsReady.wait(60000), true);
+    QList<QVariant> arguments = spyParamsReady.takeFirst();
+    QCOMPARE(arguments.count(), 1);
+    QCOMPARE(arguments.at(0).toBool(), true);
+
+    Vehicle* vehicle = vehicleMgr->activeVehicle();
+    QVERIFY(vehicle);
+    ParameterManager* paramMgr = vehicle->parameterManager();
+
+    // Retries for the stalled component must not wait for the autopilot to finish
+    QVERIFY(_mockLink->stallComponentReadCount() > 0);
+    QVERIFY(_mockLink->stallComponentReadDuringListCount() > 0);
+
+    QCOMPARE(paramMgr->missingParameters(), false);
+    QCOMPARE(paramMgr->componentLoadProgress(MockLink::stallComponentId), 1.0);
+    QCOMPARE(paramMgr->parameterNames(MockLink::stallComponentId).count(), MockLink::stallComponentParamCount);
+}
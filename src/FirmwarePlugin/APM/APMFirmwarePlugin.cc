@@ -653,6 +653,12 @@ bool APMFirmwarePlugin::sendHomePositionToVehicle(void)
     return true;
 }
 
+int APMFirmwarePlugin::missionReadWindow(void) const
+{
+    // ArduPilot answers each MISSION_REQUEST independently of the ones before it
+    return 4;
+}
+
 void APMFirmwarePlugin::addMetaDataToFact(QObject* parameterMetaData, Fact* fact, MAV_TYPE vehicleType)
 {
     APMParameterMetaData* apmMetaData = qobject_cast<APMParameterMetaData*>(parameterMetaData);
@@ -732,10 +738,16 @@ QString APMFirmwarePlugin::missionCommandOverrides(MAV_TYPE vehicleType) const
 
 QObject* APMFirmwarePlugin::loadParameterMetaData(const QString& metaDataFile)
 {
-    Q_UNUSED(metaDataFile);
+    // Meta data is shared between all vehicles which use the same meta data file contents
+    QString sourceKey = ParameterMetaDataBinaryCache::sourceKey(metaDataFile);
+    if (_parameterMetaDataMap.contains(sourceKey)) {
+        return _parameterMetaDataMap[sourceKey];
+    }
 
     APMParameterMetaData* metaData = new APMParameterMetaData();
+    metaData->setParent(this);
     metaData->loadParameterFactMetaDataFile(metaDataFile);
+    _parameterMetaDataMap[sourceKey] = metaData;
     return metaData;
 }
 
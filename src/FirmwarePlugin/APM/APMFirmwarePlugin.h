@@ -93,6 +93,7 @@ public:
     void                adjustOutgoingMavlinkMessage    (Vehicle* vehicle, LinkInterface* outgoingLink, mavlink_message_t* message) override;
     void                initializeVehicle               (Vehicle* vehicle) override;
     bool                sendHomePositionToVehicle       (void) override;
+    int                 missionReadWindow               (void) const override;
     void                addMetaDataToFact               (QObject* parameterMetaData, Fact* fact, MAV_TYPE vehicleType) override;
     QString             missionCommandOverrides         (MAV_TYPE vehicleType) const override;
     QString             getVersionParam                 (void) override { return QStringLiteral("SYSID_SW_MREV"); }
@@ -130,6 +131,8 @@ private:
 
     QList<APMCustomMode>    _supportedModes;
 
+    QMap<QString, APMParameterMetaData*> _parameterMetaDataMap;    ///< Loaded parameter meta data keyed by ParameterMetaDataBinaryCache::sourceKey
+
     static const char*      _artooIP;
     static const int        _artooVideoHandshakePort;
 };
@@ -17,6 +17,7 @@
 #include <QDir>
 #include <QDebug>
 #include <QStack>
+#include <QDataStream>
 
 static const char* kInvalidConverstion = "Internal Error: No support for string parameters";
 
@@ -29,6 +30,13 @@ APMParameterMetaData::APMParameterMetaData(void)
 
 }
 
+APMParameterMetaData::~APMParameterMetaData()
+{
+    foreach (const ParameterNametoFactMetaDataMap& parameterMap, _vehicleTypeToParametersMap) {
+        qDeleteAll(parameterMap);
+    }
+}
+
 /// Converts a string to a typed QVariant
 ///     @param string String to convert
 ///     @param type Type for Fact which dictates the QVariant type as well
@@ -133,6 +141,20 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
+    if (_binaryCache.open(metaDataFile)) {
+        qCDebug(APMParameterMetaDataLog) << "Using binary cache for parameter meta data:" << metaDataFile << "count:" << _binaryCache.count();
+        return;
+    }
+
+    if (_loadXmlFile(metaDataFile)) {
+        _saveBinaryCache(metaDataFile);
+    }
+}
+
+/// Parses the xml meta data file into raw meta data
+/// @return true: file fully parsed
+bool APMParameterMetaData::_loadXmlFile(const QString& metaDataFile)
+{
     QRegExp parameterCategories = QRegExp("ArduCopter|ArduPlane|APMrover2|ArduSub|AntennaTracker");
     QString currentCategory;
 
@@ -149,7 +171,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     xmlFile.close();
     if (xml.hasError()) {
         qCWarning(APMParameterMetaDataLog) << "Badly formed XML, reading failed: " << xml.errorString();
-        return;
+        return false;
     }
 
     QString             errorString;
@@ -176,13 +198,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "vehicles") {
                 if (xmlState.top() != XmlstateParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, vehicles matched";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlStateFoundVehicles);
             } else if (elementName == "libraries") {
                 if (xmlState.top() != XmlstateParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, libraries matched";
-                    return;
+                    return false;
                 }
                 currentCategory = "libraries";
                 xmlState.push(XmlStateFoundLibraries);
@@ -190,7 +212,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState.top() != XmlStateFoundVehicles && xmlState.top() != XmlStateFoundLibraries) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameters matched"
                                                        << "but we don't have proper vehicle or libraries yet";
-                    return;
+                    return false;
                 }
 
                 if (xml.attributes().hasAttribute("name")) {
@@ -207,7 +229,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                         qCDebug(APMParameterMetaDataVerboseLog) << "not interested in this block of parameters, skipping:" << nameValue;
                         if (skipXMLBlock(xml, "parameters")) {
                             qCWarning(APMParameterMetaDataLog) << "something wrong with the xml, skip of the xml failed";
-                            return;
+                            return false;
                         }
                         xml.readNext();
                         continue;
@@ -217,13 +239,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState.top() != XmlStateFoundParameters) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, element param matched"
                                                        << "while we are not yet in parameters";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlStateFoundParameter);
 
                 if (!xml.attributes().hasAttribute("name")) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameter attribute name missing";
-                    return;
+                    return false;
                 }
 
                 QString name = xml.attributes().value("name").toString();
@@ -261,12 +283,12 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 // We should be getting meta data now
                 if (xmlState.top() != XmlStateFoundParameter) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, while reading parameter fields wrong state";
-                    return;
+                    return false;
                 }
                 if (!badMetaData) {
                     if (!parseParameterAttributes(xml, rawMetaData)) {
                         qCDebug(APMParameterMetaDataLog) << "Badly formed XML, failed to read parameter attributes";
-                        return;
+                        return false;
                     }
                     continue;
                 }
@@ -293,6 +315,8 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         }
         xml.readNext();
     }
+
+    return true;
 }
 
 void APMParameterMetaData::correctGroupMemberships(ParameterNametoFactMetaDataMap& parameterToFactMetaDataMap,
@@ -412,16 +436,92 @@ bool APMParameterMetaData::parseParameterAttributes(QXmlStreamReader& xml, APMFa
     return true;
 }
 
+static QDataStream& operator<<(QDataStream& stream, const APMFactMetaDataRaw& rawMetaData)
+{
+    stream << rawMetaData.name
+           << rawMetaData.group
+           << rawMetaData.shortDescription
+           << rawMetaData.longDescription
+           << rawMetaData.min
+           << rawMetaData.max
+           << rawMetaData.incrementSize
+           << rawMetaData.units
+           << rawMetaData.rebootRequired
+           << rawMetaData.values
+           << rawMetaData.bitmask;
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, APMFactMetaDataRaw& rawMetaData)
+{
+    stream >> rawMetaData.name
+           >> rawMetaData.group
+           >> rawMetaData.shortDescription
+           >> rawMetaData.longDescription
+           >> rawMetaData.min
+           >> rawMetaData.max
+           >> rawMetaData.incrementSize
+           >> rawMetaData.units
+           >> rawMetaData.rebootRequired
+           >> rawMetaData.values
+           >> rawMetaData.bitmask;
+    return stream;
+}
+
+void APMParameterMetaData::_saveBinaryCache(const QString& metaDataFile)
+{
+    QMap<QString, QByteArray> records;
+
+    foreach (const QString& category, _vehicleTypeToParametersMap.keys()) {
+        const ParameterNametoFactMetaDataMap& parameterMap = _vehicleTypeToParametersMap[category];
+
+        foreach (const QString& name, parameterMap.keys()) {
+            QByteArray  record;
+            QDataStream stream(&record, QIODevice::WriteOnly);
+            stream.setVersion(QDataStream::Qt_5_0);
+            stream << *parameterMap[name];
+            records[QString("%1:%2").arg(category).arg(name)] = record;
+        }
+    }
+
+    ParameterMetaDataBinaryCache::save(metaDataFile, records);
+}
+
+/// Returns the raw meta data for the specified parameter. If the meta data was loaded from the binary cache the
+/// record is deserialized on first use.
+/// @return NULL: no meta data available
+APMFactMetaDataRaw* APMParameterMetaData::_rawMetaData(const QString& category, const QString& name)
+{
+    if (_vehicleTypeToParametersMap.contains(category) && _vehicleTypeToParametersMap[category].contains(name)) {
+        return _vehicleTypeToParametersMap[category][name];
+    }
+
+    QString key = QString("%1:%2").arg(category).arg(name);
+    if (_binaryCache.contains(key)) {
+        APMFactMetaDataRaw* rawMetaData = new APMFactMetaDataRaw();
+
+        QDataStream stream(_binaryCache.record(key));
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream >> *rawMetaData;
+        if (stream.status() == QDataStream::Ok) {
+            _vehicleTypeToParametersMap[category][name] = rawMetaData;
+            return rawMetaData;
+        }
+        qCWarning(APMParameterMetaDataLog) << "Corrupt binary cache record:" << key;
+        delete rawMetaData;
+    }
+
+    return NULL;
+}
+
 void APMParameterMetaData::addMetaDataToFact(Fact* fact, MAV_TYPE vehicleType)
 {
     const QString mavTypeString = mavTypeToString(vehicleType);
-    APMFactMetaDataRaw* rawMetaData = NULL;
 
     // check if we have metadata for fact, use generic otherwise
-    if (_vehicleTypeToParametersMap[mavTypeString].contains(fact->name())) {
-        rawMetaData = _vehicleTypeToParametersMap[mavTypeString][fact->name()];
-    } else if (_vehicleTypeToParametersMap["libraries"].contains(fact->name())) {
-        rawMetaData = _vehicleTypeToParametersMap["libraries"][fact->name()];
+    APMFactMetaDataRaw* rawMetaData = _rawMetaData(mavTypeString, fact->name());
+    if (!rawMetaData) {
+        rawMetaData = _rawMetaData(QStringLiteral("libraries"), fact->name());
     }
 
     FactMetaData *metaData = new FactMetaData(fact->type(), fact);
@@ -20,6 +20,7 @@
 #include "FactSystem.h"
 #include "AutoPilotPlugin.h"
 #include "Vehicle.h"
+#include "ParameterMetaDataBinaryCache.h"
 
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataLog)
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataVerboseLog)
@@ -55,6 +56,7 @@ class APMParameterMetaData : public QObject
     
 public:
     APMParameterMetaData(void);
+    ~APMParameterMetaData();
 
     void addMetaDataToFact(Fact* fact, MAV_TYPE vehicleType);
     void loadParameterFactMetaDataFile(const QString& metaDataFile);
@@ -79,9 +81,13 @@ private:
     bool parseParameterAttributes(QXmlStreamReader& xml, APMFactMetaDataRaw *rawMetaData);
     void correctGroupMemberships(ParameterNametoFactMetaDataMap& parameterToFactMetaDataMap, QMap<QString,QStringList>& groupMembers);
     QString mavTypeToString(MAV_TYPE vehicleTypeEnum);
+    bool _loadXmlFile(const QString& metaDataFile);
+    void _saveBinaryCache(const QString& metaDataFile);
+    APMFactMetaDataRaw* _rawMetaData(const QString& category, const QString& name);
 
     bool _parameterMetaDataLoaded;   ///< true: parameter meta data already loaded
     QMap<QString, ParameterNametoFactMetaDataMap> _vehicleTypeToParametersMap; ///< Maps from a vehicle type to paramametertoFactMeta map>
+    ParameterMetaDataBinaryCache _binaryCache; ///< Used instead of xml parse results when valid, records are keyed by "category:name"
 };
 
 #endif
@@ -181,6 +181,12 @@ bool FirmwarePlugin::sendHomePositionToVehicle(void)
     return false;
 }
 
+int FirmwarePlugin::missionReadWindow(void) const
+{
+    // Stop-and-wait is the only read sequence the mavlink spec guarantees
+    return 1;
+}
+
 QList<MAV_CMD> FirmwarePlugin::supportedMissionCommands(void)
 {
     // Generic supports all commands
@@ -201,6 +201,11 @@ public:
     ///     false: Do not send first item to vehicle, sequence numbers must be adjusted
     virtual bool sendHomePositionToVehicle(void);
 
+    /// Returns the maximum number of MISSION_REQUESTs which can be outstanding while reading a mission from the vehicle.
+    /// A value of 1 is the strict stop-and-wait sequence which all firmware supports. Larger values should only be returned
+    /// by firmware which answers requests for any item in any order.
+    virtual int missionReadWindow(void) const;
+
     /// Returns the parameter which is used to identify the version number of parameter set
     virtual QString getVersionParam(void) { return QString(); }
 
@@ -211,8 +216,8 @@ public:
     virtual QString internalParameterMetaDataFile(Vehicle* vehicle) { Q_UNUSED(vehicle); return QString(); }
 
     /// Loads the specified parameter meta data file.
-    /// @return Opaque parameter meta data information which must be stored with Vehicle. Vehicle is responsible to
-    ///         call deleteParameterMetaData when no longer needed.
+    /// @return Opaque parameter meta data information which must be stored with Vehicle. The returned object is owned by
+    ///         the plugin and may be shared with other vehicles using the same meta data file, so it must not be deleted.
     virtual QObject* loadParameterMetaData(const QString& metaDataFile) { Q_UNUSED(metaDataFile); return NULL; }
 
     /// Adds the parameter meta data to the Fact
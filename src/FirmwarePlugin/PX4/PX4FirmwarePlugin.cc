@@ -312,10 +312,18 @@ QString PX4FirmwarePlugin::missionCommandOverrides(MAV_TYPE vehicleType) const
 
 QObject* PX4FirmwarePlugin::loadParameterMetaData(const QString& metaDataFile)
 {
+    // Meta data is shared between all vehicles which use the same meta data file contents
+    QString sourceKey = ParameterMetaDataBinaryCache::sourceKey(metaDataFile);
+    if (_parameterMetaDataMap.contains(sourceKey)) {
+        return _parameterMetaDataMap[sourceKey];
+    }
+
     PX4ParameterMetaData* metaData = new PX4ParameterMetaData;
+    metaData->setParent(this);
     if (!metaDataFile.isEmpty()) {
         metaData->loadParameterFactMetaDataFile(metaDataFile);
     }
+    _parameterMetaDataMap[sourceKey] = metaData;
     return metaData;
 }
 
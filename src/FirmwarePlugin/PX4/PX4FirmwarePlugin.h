@@ -110,6 +110,8 @@ private:
 
     // Any instance data here must be global to all vehicles
     // Vehicle specific data should go into PX4FirmwarePluginInstanceData
+
+    QMap<QString, PX4ParameterMetaData*> _parameterMetaDataMap;    ///< Loaded parameter meta data keyed by ParameterMetaDataBinaryCache::sourceKey
 };
 
 class PX4FirmwarePluginInstanceData : public QObject
@@ -19,6 +19,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QDebug>
+#include <QDataStream>
 
 static const char* kInvalidConverstion = "Internal Error: No support for string parameters";
 
@@ -87,32 +88,45 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
+    if (_binaryCache.open(metaDataFile)) {
+        qCDebug(PX4ParameterMetaDataLog) << "Using binary cache for parameter meta data:" << metaDataFile << "count:" << _binaryCache.count();
+        return;
+    }
+
+    if (_loadXmlFile(metaDataFile)) {
+        _saveBinaryCache(metaDataFile);
+    }
+}
+
+/// Parses the xml meta data file into raw meta data
+/// @return true: file fully parsed, false: file is bad or can't be used
+bool PX4ParameterMetaData::_loadXmlFile(const QString& metaDataFile)
+{
     qCDebug(PX4ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
     QFile xmlFile(metaDataFile);
 
     if (!xmlFile.exists()) {
         qWarning() << "Internal error: metaDataFile mission" << metaDataFile;
-        return;
+        return false;
     }
     
     if (!xmlFile.open(QIODevice::ReadOnly)) {
         qWarning() << "Internal error: Unable to open parameter file:" << metaDataFile << xmlFile.errorString();
-        return;
+        return false;
     }
     
     QXmlStreamReader xml(xmlFile.readAll());
     xmlFile.close();
     if (xml.hasError()) {
         qWarning() << "Badly formed XML" << xml.errorString();
-        return;
+        return false;
     }
     
-    QString         factGroup;
-    QString         errorString;
-    FactMetaData*   metaData = NULL;
-    int             xmlState = XmlStateNone;
-    bool            badMetaData = true;
+    QString             factGroup;
+    PX4FactMetaDataRaw* rawMetaData = NULL;
+    int                 xmlState = XmlStateNone;
+    bool                badMetaData = true;
     
     while (!xml.atEnd()) {
         if (xml.isStartElement()) {
@@ -121,14 +135,14 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             if (elementName == "parameters") {
                 if (xmlState != XmlStateNone) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameters;
                 
             } else if (elementName == "version") {
                 if (xmlState != XmlStateFoundParameters) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundVersion;
                 
@@ -137,12 +151,12 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 int intVersion = strVersion.toInt(&convertOk);
                 if (!convertOk) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 if (intVersion <= 2) {
                     // We can't read these old files
                     qDebug() << "Parameter version stamp too old, skipping load. Found:" << intVersion << "Want: 3 File:" << metaDataFile;
-                    return;
+                    return false;
                 }
                 
             } else if (elementName == "parameter_version_major") {
@@ -154,13 +168,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState != XmlStateFoundVersion) {
                     // We didn't get a version stamp, assume older version we can't read
                     qDebug() << "Parameter version stamp not found, skipping load" << metaDataFile;
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundGroup;
                 
                 if (!xml.attributes().hasAttribute("name")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 factGroup = xml.attributes().value("name").toString();
                 qCDebug(PX4ParameterMetaDataLog) << "Found group: " << factGroup;
@@ -168,13 +182,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "parameter") {
                 if (xmlState != XmlStateFoundGroup) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameter;
                 
                 if (!xml.attributes().hasAttribute("name") || !xml.attributes().hasAttribute("type")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 
                 QString name = xml.attributes().value("name").toString();
@@ -188,32 +202,28 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 FactMetaData::ValueType_t foundType = FactMetaData::stringToType(type, unknownType);
                 if (unknownType) {
                     qWarning() << "Parameter meta data with bad type:" << type << " name:" << name;
-                    return;
+                    return false;
                 }
                 
-                // Now that we know type we can create meta data object and add it to the system
+                // Now that we know type we can create the raw meta data and add it to the system
                 
-                metaData = new FactMetaData(foundType);
-                Q_CHECK_PTR(metaData);
-                if (_mapParameterName2FactMetaData.contains(name)) {
+                bool duplicate = _mapParameterName2RawMetaData.contains(name);
+                rawMetaData = &_mapParameterName2RawMetaData[name];
+                *rawMetaData = PX4FactMetaDataRaw();
+                rawMetaData->type = foundType;
+                if (duplicate) {
                     // We can't trust the meta dafa since we have dups
                     qCWarning(PX4ParameterMetaDataLog) << "Duplicate parameter found:" << name;
                     badMetaData = true;
                     // Reset to default meta data
-                    _mapParameterName2FactMetaData[name] = metaData;
+                    rawMetaData->duplicate = true;
                 } else {
-                    _mapParameterName2FactMetaData[name] = metaData;
-                    metaData->setName(name);
-                    metaData->setGroup(factGroup);
+                    rawMetaData->name = name;
+                    rawMetaData->group = factGroup;
                     
                     if (xml.attributes().hasAttribute("default") && !strDefault.isEmpty()) {
-                        QVariant varDefault;
-                        
-                        if (metaData->convertAndValidateRaw(strDefault, false, varDefault, errorString)) {
-                            metaData->setRawDefaultValue(varDefault);
-                        } else {
-                            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << name << " type:" << type << " default:" << strDefault << " error:" << errorString;
-                        }
+                        rawMetaData->hasDefault = true;
+                        rawMetaData->defaultValue = strDefault;
                     }
                 }
                 
@@ -221,67 +231,48 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 // We should be getting meta data now
                 if (xmlState != XmlStateFoundParameter) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
 
                 if (!badMetaData) {
-                    if (metaData) {
+                    if (rawMetaData) {
                         if (elementName == "short_desc") {
                             QString text = xml.readElementText();
                             text = text.replace("\n", " ");
                             qCDebug(PX4ParameterMetaDataLog) << "Short description:" << text;
-                            metaData->setShortDescription(text);
+                            rawMetaData->shortDescription = text;
 
                         } else if (elementName == "long_desc") {
                             QString text = xml.readElementText();
                             text = text.replace("\n", " ");
                             qCDebug(PX4ParameterMetaDataLog) << "Long description:" << text;
-                            metaData->setLongDescription(text);
+                            rawMetaData->longDescription = text;
 
                         } else if (elementName == "min") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "Min:" << text;
-
-                            QVariant varMin;
-                            if (metaData->convertAndValidateRaw(text, true /* convertOnly */, varMin, errorString)) {
-                                metaData->setRawMin(varMin);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << metaData->name() << " type:" << metaData->type() << " min:" << text << " error:" << errorString;
-                            }
+                            rawMetaData->min = text;
 
                         } else if (elementName == "max") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "Max:" << text;
-
-                            QVariant varMax;
-                            if (metaData->convertAndValidateRaw(text, true /* convertOnly */, varMax, errorString)) {
-                                metaData->setRawMax(varMax);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << metaData->name() << " type:" << metaData->type() << " max:" << text << " error:" << errorString;
-                            }
+                            rawMetaData->max = text;
 
                         } else if (elementName == "unit") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "Unit:" << text;
-                            metaData->setRawUnits(text);
+                            rawMetaData->units = text;
 
                         } else if (elementName == "decimal") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "Decimal:" << text;
-
-                            bool convertOk;
-                            QVariant varDecimals = QVariant(text).toUInt(&convertOk);
-                            if (convertOk) {
-                                metaData->setDecimalPlaces(varDecimals.toInt());
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << metaData->name() << " type:" << metaData->type() << " decimals:" << text << " error: invalid number";
-                            }
+                            rawMetaData->decimalPlaces = text;
 
                         } else if (elementName == "reboot_required") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "RebootRequired:" << text;
                             if (text.compare("true", Qt::CaseInsensitive) == 0) {
-                                metaData->setRebootRequired(true);
+                                rawMetaData->rebootRequired = true;
                             }
 
                         } else if (elementName == "values") {
@@ -292,59 +283,26 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                             QString enumString = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
                                                              << "value desc:" << enumString << "code:" << enumValueStr;
+                            rawMetaData->values.append(QPair<QString, QString>(enumValueStr, enumString));
 
-                            QVariant    enumValue;
-                            QString     errorString;
-                            if (metaData->convertAndValidateRaw(enumValueStr, false /* validate */, enumValue, errorString)) {
-                                metaData->addEnumInfo(enumString, enumValue);
-                            } else {
-                                qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << metaData->name()
-                                                                 << " type:" << metaData->type() << " value:" << enumValueStr
-                                                                 << " error:" << errorString;
-                            }
                         } else if (elementName == "increment") {
-                            double  increment;
-                            bool    ok;
-                            QString text = xml.readElementText();
-                            increment = text.toDouble(&ok);
-                            if (ok) {
-                                metaData->setIncrement(increment);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << metaData->name() << " increment:" << text;
-                            }
+                            rawMetaData->increment = xml.readElementText();
 
                         } else if (elementName == "boolean") {
-                            QVariant    enumValue;
-                            metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Enabled"), enumValue);
-                            metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Disabled"), enumValue);
+                            rawMetaData->boolean = true;
 
                         } else if (elementName == "bitmask") {
                             // doing nothing individual bits will follow anyway. May be used for sanity checking.
 
                         } else if (elementName == "bit") {
                             bool ok = false;
-                            unsigned char bit = xml.attributes().value("index").toString().toUInt(&ok);
+                            QString bitIndex = xml.attributes().value("index").toString();
+                            bitIndex.toUInt(&ok);
                             if (ok) {
                                 QString bitDescription = xml.readElementText();
                                 qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
-                                                                 << "index:" << bit << "description:" << bitDescription;
-
-                                if (bit < 31) {
-                                    QVariant bitmaskRawValue = 1 << bit;
-                                    QVariant bitmaskValue;
-                                    QString errorString;
-                                    if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
-                                        metaData->addBitmaskInfo(bitDescription, bitmaskValue);
-                                    } else {
-                                        qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << metaData->name()
-                                                                         << " type:" << metaData->type() << " value:" << bitmaskValue
-                                                                         << " error:" << errorString;
-                                    }
-                                } else {
-                                    qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask, bit:" << bit;
-                                }
+                                                                 << "index:" << bitIndex << "description:" << bitDescription;
+                                rawMetaData->bitmask.append(QPair<QString, QString>(bitIndex, bitDescription));
                             }
                         } else {
                             qCDebug(PX4ParameterMetaDataLog) << "Unknown element in XML: " << elementName;
@@ -358,17 +316,8 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             QString elementName = xml.name().toString();
 
             if (elementName == "parameter") {
-                // Done loading this parameter, validate default value
-                if (metaData->defaultValueAvailable()) {
-                    QVariant var;
-
-                    if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
-                        qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << metaData->name() << " type:" << metaData->type() << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
-                    }
-                }
-
                 // Reset for next parameter
-                metaData = NULL;
+                rawMetaData = NULL;
                 badMetaData = false;
                 xmlState = XmlStateFoundGroup;
             } else if (elementName == "group") {
@@ -379,15 +328,243 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         }
         xml.readNext();
     }
+
+    return true;
+}
+
+static QDataStream& operator<<(QDataStream& stream, const PX4FactMetaDataRaw& rawMetaData)
+{
+    stream << static_cast<qint32>(rawMetaData.type)
+           << rawMetaData.duplicate
+           << rawMetaData.name
+           << rawMetaData.group
+           << rawMetaData.hasDefault
+           << rawMetaData.defaultValue
+           << rawMetaData.shortDescription
+           << rawMetaData.longDescription
+           << rawMetaData.min
+           << rawMetaData.max
+           << rawMetaData.units
+           << rawMetaData.decimalPlaces
+           << rawMetaData.increment
+           << rawMetaData.rebootRequired
+           << rawMetaData.boolean
+           << rawMetaData.values
+           << rawMetaData.bitmask;
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, PX4FactMetaDataRaw& rawMetaData)
+{
+    qint32 type;
+
+    stream >> type
+           >> rawMetaData.duplicate
+           >> rawMetaData.name
+           >> rawMetaData.group
+           >> rawMetaData.hasDefault
+           >> rawMetaData.defaultValue
+           >> rawMetaData.shortDescription
+           >> rawMetaData.longDescription
+           >> rawMetaData.min
+           >> rawMetaData.max
+           >> rawMetaData.units
+           >> rawMetaData.decimalPlaces
+           >> rawMetaData.increment
+           >> rawMetaData.rebootRequired
+           >> rawMetaData.boolean
+           >> rawMetaData.values
+           >> rawMetaData.bitmask;
+    rawMetaData.type = static_cast<FactMetaData::ValueType_t>(type);
+    return stream;
+}
+
+void PX4ParameterMetaData::_saveBinaryCache(const QString& metaDataFile)
+{
+    QMap<QString, QByteArray> records;
+
+    QMapIterator<QString, PX4FactMetaDataRaw> iter(_mapParameterName2RawMetaData);
+    while (iter.hasNext()) {
+        iter.next();
+
+        QByteArray  record;
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << iter.value();
+        records[iter.key()] = record;
+    }
+
+    ParameterMetaDataBinaryCache::save(metaDataFile, records);
+}
+
+/// Returns the raw meta data for the specified parameter from either the xml parse results or the binary cache
+/// @return false: no meta data available for parameter
+bool PX4ParameterMetaData::_rawMetaData(const QString& name, PX4FactMetaDataRaw& rawMetaData)
+{
+    if (_mapParameterName2RawMetaData.contains(name)) {
+        rawMetaData = _mapParameterName2RawMetaData[name];
+        return true;
+    }
+
+    if (_binaryCache.contains(name)) {
+        QDataStream stream(_binaryCache.record(name));
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream >> rawMetaData;
+        if (stream.status() == QDataStream::Ok) {
+            return true;
+        }
+        qCWarning(PX4ParameterMetaDataLog) << "Corrupt binary cache record:" << name;
+    }
+
+    return false;
+}
+
+/// Creates the FactMetaData object from the raw meta data, validating all values against the type
+FactMetaData* PX4ParameterMetaData::_createFactMetaData(const PX4FactMetaDataRaw& rawMetaData)
+{
+    QString         errorString;
+    FactMetaData*   metaData = new FactMetaData(rawMetaData.type, this);
+
+    if (rawMetaData.duplicate) {
+        return metaData;
+    }
+
+    metaData->setName(rawMetaData.name);
+    metaData->setGroup(rawMetaData.group);
+
+    if (rawMetaData.hasDefault) {
+        QVariant varDefault;
+
+        if (metaData->convertAndValidateRaw(rawMetaData.defaultValue, false, varDefault, errorString)) {
+            metaData->setRawDefaultValue(varDefault);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << rawMetaData.name << " type:" << rawMetaData.type << " default:" << rawMetaData.defaultValue << " error:" << errorString;
+        }
+    }
+
+    if (!rawMetaData.shortDescription.isEmpty()) {
+        metaData->setShortDescription(rawMetaData.shortDescription);
+    }
+
+    if (!rawMetaData.longDescription.isEmpty()) {
+        metaData->setLongDescription(rawMetaData.longDescription);
+    }
+
+    if (!rawMetaData.min.isEmpty()) {
+        QVariant varMin;
+        if (metaData->convertAndValidateRaw(rawMetaData.min, true /* convertOnly */, varMin, errorString)) {
+            metaData->setRawMin(varMin);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << metaData->name() << " type:" << metaData->type() << " min:" << rawMetaData.min << " error:" << errorString;
+        }
+    }
+
+    if (!rawMetaData.max.isEmpty()) {
+        QVariant varMax;
+        if (metaData->convertAndValidateRaw(rawMetaData.max, true /* convertOnly */, varMax, errorString)) {
+            metaData->setRawMax(varMax);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << metaData->name() << " type:" << metaData->type() << " max:" << rawMetaData.max << " error:" << errorString;
+        }
+    }
+
+    if (!rawMetaData.units.isEmpty()) {
+        metaData->setRawUnits(rawMetaData.units);
+    }
+
+    if (!rawMetaData.decimalPlaces.isEmpty()) {
+        bool convertOk;
+        QVariant varDecimals = QVariant(rawMetaData.decimalPlaces).toUInt(&convertOk);
+        if (convertOk) {
+            metaData->setDecimalPlaces(varDecimals.toInt());
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << metaData->name() << " type:" << metaData->type() << " decimals:" << rawMetaData.decimalPlaces << " error: invalid number";
+        }
+    }
+
+    metaData->setRebootRequired(rawMetaData.rebootRequired);
+
+    for (int i=0; i<rawMetaData.values.count(); i++) {
+        const QPair<QString, QString>& enumPair = rawMetaData.values[i];
+
+        QVariant    enumValue;
+        QString     errorString;
+        if (metaData->convertAndValidateRaw(enumPair.first, false /* validate */, enumValue, errorString)) {
+            metaData->addEnumInfo(enumPair.second, enumValue);
+        } else {
+            qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << metaData->name()
+                                             << " type:" << metaData->type() << " value:" << enumPair.first
+                                             << " error:" << errorString;
+        }
+    }
+
+    if (!rawMetaData.increment.isEmpty()) {
+        bool    ok;
+        double  increment = rawMetaData.increment.toDouble(&ok);
+        if (ok) {
+            metaData->setIncrement(increment);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << metaData->name() << " increment:" << rawMetaData.increment;
+        }
+    }
+
+    if (rawMetaData.boolean) {
+        QVariant    enumValue;
+        metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Enabled"), enumValue);
+        metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Disabled"), enumValue);
+    }
+
+    for (int i=0; i<rawMetaData.bitmask.count(); i++) {
+        const QPair<QString, QString>& bitPair = rawMetaData.bitmask[i];
+
+        unsigned char bit = bitPair.first.toUInt();
+        if (bit < 31) {
+            QVariant bitmaskRawValue = 1 << bit;
+            QVariant bitmaskValue;
+            QString errorString;
+            if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
+                metaData->addBitmaskInfo(bitPair.second, bitmaskValue);
+            } else {
+                qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << metaData->name()
+                                                 << " type:" << metaData->type() << " value:" << bitmaskValue
+                                                 << " error:" << errorString;
+            }
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask, bit:" << bit;
+        }
+    }
+
+    // Validate default value now that min/max are known
+    if (metaData->defaultValueAvailable()) {
+        QVariant var;
+
+        if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << metaData->name() << " type:" << metaData->type() << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
+        }
+    }
+
+    return metaData;
 }
 
 void PX4ParameterMetaData::addMetaDataToFact(Fact* fact, MAV_TYPE vehicleType)
 {
     Q_UNUSED(vehicleType)
 
-    if (_mapParameterName2FactMetaData.contains(fact->name())) {
-        fact->setMetaData(_mapParameterName2FactMetaData[fact->name()]);
+    FactMetaData* metaData = _mapParameterName2FactMetaData.value(fact->name(), NULL);
+
+    if (!metaData) {
+        PX4FactMetaDataRaw rawMetaData;
+
+        if (!_rawMetaData(fact->name(), rawMetaData)) {
+            return;
+        }
+        metaData = _createFactMetaData(rawMetaData);
+        _mapParameterName2FactMetaData[fact->name()] = metaData;
     }
+
+    fact->setMetaData(metaData);
 }
 
 void PX4ParameterMetaData::getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion)
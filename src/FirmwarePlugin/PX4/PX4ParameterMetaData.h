@@ -19,13 +19,48 @@
 #include "FactSystem.h"
 #include "AutoPilotPlugin.h"
 #include "Vehicle.h"
+#include "ParameterMetaDataBinaryCache.h"
 
 /// @file
 ///     @author Don Gagne <don@thegagnes.com>
 
 Q_DECLARE_LOGGING_CATEGORY(PX4ParameterMetaDataLog)
 
-/// Loads and holds parameter fact meta data for PX4 stack
+/// Unprocessed meta data for a single parameter as read from the xml file. FactMetaData objects are created
+/// from this on first use.
+class PX4FactMetaDataRaw
+{
+public:
+    PX4FactMetaDataRaw(void)
+        : type(FactMetaData::valueTypeInt32)
+        , duplicate(false)
+        , hasDefault(false)
+        , rebootRequired(false)
+        , boolean(false)
+    { }
+
+    FactMetaData::ValueType_t type;
+    bool    duplicate;          ///< true: Parameter was found more than once, meta data can't be trusted
+    QString name;
+    QString group;
+    bool    hasDefault;
+    QString defaultValue;
+    QString shortDescription;
+    QString longDescription;
+    QString min;
+    QString max;
+    QString units;
+    QString decimalPlaces;
+    QString increment;
+    bool    rebootRequired;
+    bool    boolean;
+    QList<QPair<QString, QString> > values;     ///< code, description
+    QList<QPair<QString, QString> > bitmask;    ///< bit index, description
+};
+
+/// Loads and holds parameter fact meta data for PX4 stack. A single instance is shared by all vehicles which
+/// use the same meta data file. FactMetaData objects are only created for parameters which are actually
+/// requested and are then shared read-only between vehicles.
 class PX4ParameterMetaData : public QObject
 {
     Q_OBJECT
@@ -48,10 +83,16 @@ private:
         XmlStateDone
     };    
 
-    QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
+    QVariant        _stringToTypedVariant   (const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
+    bool            _loadXmlFile            (const QString& metaDataFile);
+    void            _saveBinaryCache        (const QString& metaDataFile);
+    bool            _rawMetaData            (const QString& name, PX4FactMetaDataRaw& rawMetaData);
+    FactMetaData*   _createFactMetaData     (const PX4FactMetaDataRaw& rawMetaData);
 
-    bool _parameterMetaDataLoaded;   ///< true: parameter meta data already loaded
-    QMap<QString, FactMetaData*> _mapParameterName2FactMetaData; ///< Maps from a parameter name to FactMetaData
+    bool                                _parameterMetaDataLoaded;       ///< true: parameter meta data already loaded
+    QMap<QString, PX4FactMetaDataRaw>   _mapParameterName2RawMetaData;  ///< Raw meta data from xml parse, empty if loaded from binary cache
+    ParameterMetaDataBinaryCache        _binaryCache;
+    QMap<QString, FactMetaData*>        _mapParameterName2FactMetaData; ///< FactMetaData which has been created so far
 };
 
 #endif
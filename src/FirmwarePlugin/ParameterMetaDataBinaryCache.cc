@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataBinaryCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataBinaryCacheLog, "ParameterMetaDataBinaryCacheLog")
+
+const quint32 ParameterMetaDataBinaryCache::_magic =            0x51504D44; // "QPMD"
+const quint32 ParameterMetaDataBinaryCache::_formatVersion =    1;
+
+ParameterMetaDataBinaryCache::ParameterMetaDataBinaryCache(void)
+    : _mappedData(NULL)
+    , _mappedSize(0)
+    , _recordsOffset(0)
+{
+
+}
+
+ParameterMetaDataBinaryCache::~ParameterMetaDataBinaryCache()
+{
+    close();
+}
+
+QDir ParameterMetaDataBinaryCache::cacheDir(void)
+{
+    QDir settingsDir = QFileInfo(QSettings().fileName()).dir();
+    settingsDir.mkdir("ParamMetaDataCache");
+    return settingsDir.filePath("ParamMetaDataCache");
+}
+
+QString ParameterMetaDataBinaryCache::_cacheFileName(const QString& metaDataFile)
+{
+    QByteArray pathHash = QCryptographicHash::hash(metaDataFile.toUtf8(), QCryptographicHash::Md5).toHex();
+    return cacheDir().filePath(QString("%1.bin").arg(QString(pathHash)));
+}
+
+QString ParameterMetaDataBinaryCache::sourceKey(const QString& metaDataFile)
+{
+    QFileInfo fileInfo(metaDataFile);
+    return QString("%1|%2|%3|%4").arg(metaDataFile)
+            .arg(fileInfo.size())
+            .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+            .arg(QCoreApplication::applicationVersion());
+}
+
+bool ParameterMetaDataBinaryCache::open(const QString& metaDataFile)
+{
+    close();
+
+    if (metaDataFile.isEmpty()) {
+        return false;
+    }
+
+    _file.setFileName(_cacheFileName(metaDataFile));
+    if (!_file.exists()) {
+        qCDebug(ParameterMetaDataBinaryCacheLog) << "No binary cache for" << metaDataFile;
+        return false;
+    }
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(ParameterMetaDataBinaryCacheLog) << "Unable to open binary cache" << _file.fileName() << _file.errorString();
+        return false;
+    }
+
+    _mappedSize = _file.size();
+    _mappedData = _file.map(0, _mappedSize);
+    if (!_mappedData) {
+        qCWarning(ParameterMetaDataBinaryCacheLog) << "Unable to map binary cache" << _file.fileName() << _file.errorString();
+        close();
+        return false;
+    }
+
+    QByteArray  header = QByteArray::fromRawData(reinterpret_cast<const char*>(_mappedData), static_cast<int>(_mappedSize));
+    QDataStream stream(header);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, formatVersion, recordCount;
+    QString cachedSourceKey;
+
+    stream >> magic >> formatVersion >> cachedSourceKey >> recordCount;
+    if (stream.status() != QDataStream::Ok || magic != _magic || formatVersion != _formatVersion) {
+        qCDebug(ParameterMetaDataBinaryCacheLog) << "Binary cache has bad header, ignoring" << _file.fileName();
+        close();
+        return false;
+    }
+    if (cachedSourceKey != sourceKey(metaDataFile)) {
+        qCDebug(ParameterMetaDataBinaryCacheLog) << "Binary cache out of date" << metaDataFile;
+        close();
+        return false;
+    }
+
+    _index.reserve(recordCount);
+    for (quint32 i=0; i<recordCount; i++) {
+        QString key;
+        quint32 offset, length;
+
+        stream >> key >> offset >> length;
+        _index[key] = RecordLocation_t(offset, length);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(ParameterMetaDataBinaryCacheLog) << "Binary cache index truncated" << _file.fileName();
+        close();
+        return false;
+    }
+
+    _recordsOffset = stream.device()->pos();
+    foreach (const RecordLocation_t& location, _index) {
+        if (_recordsOffset + location.first + location.second > _mappedSize) {
+            qCWarning(ParameterMetaDataBinaryCacheLog) << "Binary cache records truncated" << _file.fileName();
+            close();
+            return false;
+        }
+    }
+
+    qCDebug(ParameterMetaDataBinaryCacheLog) << "Mapped binary cache" << metaDataFile << "records:" << recordCount;
+    return true;
+}
+
+void ParameterMetaDataBinaryCache::close(void)
+{
+    if (_mappedData) {
+        _file.unmap(_mappedData);
+        _mappedData = NULL;
+    }
+    _mappedSize = 0;
+    _recordsOffset = 0;
+    _index.clear();
+    _file.close();
+}
+
+QByteArray ParameterMetaDataBinaryCache::record(const QString& key) const
+{
+    if (!_mappedData || !_index.contains(key)) {
+        return QByteArray();
+    }
+
+    const RecordLocation_t& location = _index[key];
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(_mappedData + _recordsOffset + location.first), location.second);
+}
+
+bool ParameterMetaDataBinaryCache::save(const QString& metaDataFile, const QMap<QString, QByteArray>& records)
+{
+    if (metaDataFile.isEmpty()) {
+        return false;
+    }
+
+    QSaveFile file(_cacheFileName(metaDataFile));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(ParameterMetaDataBinaryCacheLog) << "Unable to create binary cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << _magic << _formatVersion << sourceKey(metaDataFile) << static_cast<quint32>(records.count());
+
+    quint32 offset = 0;
+    QMapIterator<QString, QByteArray> indexIter(records);
+    while (indexIter.hasNext()) {
+        indexIter.next();
+        quint32 length = indexIter.value().length();
+        stream << indexIter.key() << offset << length;
+        offset += length;
+    }
+
+    QMapIterator<QString, QByteArray> recordIter(records);
+    while (recordIter.hasNext()) {
+        recordIter.next();
+        stream.writeRawData(recordIter.value().constData(), recordIter.value().length());
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(ParameterMetaDataBinaryCacheLog) << "Failed writing binary cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    qCDebug(ParameterMetaDataBinaryCacheLog) << "Saved binary cache" << metaDataFile << "records:" << records.count();
+    return true;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QFile>
+#include <QDir>
+#include <QHash>
+#include <QMap>
+#include <QByteArray>
+#include <QStringList>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterMetaDataBinaryCacheLog)
+
+/// Binary cache for parsed parameter meta data xml files.
+///
+/// The first time a meta data xml file is parsed the firmware plugin serializes each parameter into a record and
+/// saves the records to a binary cache file next to the parameter cache. On subsequent loads the cache file is
+/// memory mapped read-only and only the index is read up front. Individual records are deserialized on demand
+/// when a Fact actually needs its meta data. The cache is keyed by the source file signature (path, size,
+/// modification time and QGC version) so a changed source file or QGC upgrade invalidates it automatically.
+class ParameterMetaDataBinaryCache
+{
+public:
+    ParameterMetaDataBinaryCache(void);
+    ~ParameterMetaDataBinaryCache();
+
+    /// Maps the binary cache associated with the specified meta data file.
+    /// @return false: No valid cache available, caller must parse the source file and call save
+    bool open(const QString& metaDataFile);
+
+    bool        isOpen      (void) const { return _mappedData != NULL; }
+    bool        contains    (const QString& key) const { return _index.contains(key); }
+    QStringList keys        (void) const { return _index.keys(); }
+    int         count       (void) const { return _index.count(); }
+
+    /// Returns the serialized record for the specified key, empty array if not found. The returned array
+    /// references the mapped file directly and must not be used after the cache is closed.
+    QByteArray record(const QString& key) const;
+
+    void close(void);
+
+    /// Writes a new binary cache for the specified meta data file
+    ///     @param records Serialized records keyed by lookup key
+    static bool save(const QString& metaDataFile, const QMap<QString, QByteArray>& records);
+
+    /// Returns a string which changes whenever the contents of the meta data file change. Used to share loaded
+    /// meta data between vehicles which use the same file.
+    static QString sourceKey(const QString& metaDataFile);
+
+    /// Directory which binary caches are stored in
+    static QDir cacheDir(void);
+
+private:
+    static QString _cacheFileName(const QString& metaDataFile);
+
+    typedef QPair<quint32, quint32> RecordLocation_t;   ///< offset, length within mapped records block
+
+    QFile                               _file;
+    uchar*                              _mappedData;
+    qint64                              _mappedSize;
+    qint64                              _recordsOffset; ///< Start of records block within mapped data
+    QHash<QString, RecordLocation_t>    _index;
+
+    static const quint32 _magic;
+    static const quint32 _formatVersion;
+};
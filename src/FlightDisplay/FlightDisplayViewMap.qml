@@ -163,18 +163,26 @@ FlightMap {
         property real leftToolWidth:    toolStrip.x + toolStrip.width
     }
 
-    // Add trajectory points to the map
-    MapItemView {
-        model: _mainIsMap ? _activeVehicle ? _activeVehicle.trajectoryPoints : 0 : 0
-
-        delegate: MapPolyline {
-            line.width: 3
-            line.color: "red"
-            z:          QGroundControl.zOrderTrajectoryLines
-            path: [
-                object.coordinate1,
-                object.coordinate2,
-            ]
+    // Add the vehicle trajectory to the map as a single line
+    MapPolyline {
+        id:         trajectoryPolyline
+        line.width: 3
+        line.color: "red"
+        z:          QGroundControl.zOrderTrajectoryLines
+        visible:    _mainIsMap
+
+        property var _trajectoryPoints: _activeVehicle ? _activeVehicle.trajectoryPoints : null
+
+        on_TrajectoryPointsChanged: path = _trajectoryPoints ? _trajectoryPoints.list() : []
+
+        // Change handlers do not fire for the initial value of the binding
+        Component.onCompleted: path = _trajectoryPoints ? _trajectoryPoints.list() : []
+
+        Connections {
+            target:             trajectoryPolyline._trajectoryPoints
+            onPointAdded:       trajectoryPolyline.addCoordinate(coordinate)
+            onPointsReplaced:   trajectoryPolyline.path = trajectoryPolyline._trajectoryPoints.list()
+            onPointsCleared:    trajectoryPolyline.path = []
         }
     }
 
@@ -47,6 +47,7 @@ public:
 
     // Override from QGCTool
     virtual void setToolbox(QGCToolbox *toolbox);
+    virtual void deferredInit(void) { init(); }
 
 public slots:
     void init();
@@ -242,13 +242,17 @@ void GeoFenceController::_setFenceFromManager(const QList<QGCFencePolygon>& poly
     _polygons.clearAndDeleteContents();
     _circles.clearAndDeleteContents();
 
+    QList<QObject*> newPolygons;
     for (int i=0; i<polygons.count(); i++) {
-        _polygons.append(new QGCFencePolygon(polygons[i], this));
+        newPolygons.append(new QGCFencePolygon(polygons[i], this));
     }
+    _polygons.append(newPolygons);
 
+    QList<QObject*> newCircles;
     for (int i=0; i<circles.count(); i++) {
-        _circles.append(new QGCFenceCircle(circles[i], this));
+        newCircles.append(new QGCFenceCircle(circles[i], this));
     }
+    _circles.append(newCircles);
 
     setDirty(false);
 }
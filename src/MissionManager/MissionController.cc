@@ -30,6 +30,10 @@
 #include "PlanMasterController.h"
 #include "KML.h"
 
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtConcurrent>
+
 #ifndef __mobile__
 #include "MainWindow.h"
 #include "QGCQFileDialog.h"
@@ -52,6 +56,7 @@ const char* MissionController::_jsonComplexItemsKey =           "complexItems";
 const char* MissionController::_jsonMavAutopilotKey =           "MAV_AUTOPILOT";
 
 const int   MissionController::_missionFileVersion =            2;
+const int   MissionController::_minParseChunkSize =             256;
 
 MissionController::MissionController(PlanMasterController* masterController, QObject *parent)
     : PlanElementController(masterController, parent)
@@ -67,6 +72,8 @@ MissionController::MissionController(PlanMasterController* masterController, QOb
     , _progressPct(0)
     , _currentPlanViewIndex(-1)
     , _currentPlanViewItem(NULL)
+    , _flightStatusMinAltSeen(0)
+    , _flightStatusMaxAltSeen(0)
 {
     _resetMissionFlightStatus();
     managerVehicleChanged(_managerVehicle);
@@ -172,10 +179,19 @@ void MissionController::_newMissionItemsAvailableFromVehicle(bool removeAllReque
             i = 1;
         }
 
+        QElapsedTimer   createTimer;
+        QList<QObject*> simpleItems;
+        createTimer.start();
+        simpleItems.reserve(newMissionItems.count());
         for (; i<newMissionItems.count(); i++) {
             const MissionItem* missionItem = newMissionItems[i];
-            newControllerMissionItems->append(new SimpleMissionItem(_controllerVehicle, *missionItem, this));
+            simpleItems.append(new SimpleMissionItem(_controllerVehicle, *missionItem, this));
         }
+        newControllerMissionItems->append(simpleItems);
+        qCDebug(MissionControllerLog) << "loading from vehicle: items:msecs" << simpleItems.count() << createTimer.elapsed();
+
+        // The visual items now hold their own copies, so the manager only needs its compact item store
+        _missionManager->releaseMissionItems();
 
         _deinitAllVisualItems();
         _visualItems->deleteLater();
@@ -354,7 +370,7 @@ int MissionController::insertSimpleMissionItem(QGeoCoordinate coordinate, int i)
     }
     _visualItems->insert(i, newItem);
 
-    _recalcAll();
+    _recalcAllFromIndex(i);
 
     return newItem->sequenceNumber();
 }
@@ -378,7 +394,7 @@ int MissionController::insertROIMissionItem(QGeoCoordinate coordinate, int i)
     }
     _visualItems->insert(i, newItem);
 
-    _recalcAll();
+    _recalcAllFromIndex(i);
 
     return newItem->sequenceNumber();
 }
@@ -423,7 +439,7 @@ int MissionController::insertComplexMissionItem(QString itemName, QGeoCoordinate
 
     _visualItems->insert(i, newItem);
 
-    _recalcAll();
+    _recalcAllFromIndex(i);
 
     return newItem->sequenceNumber();
 }
@@ -469,7 +485,7 @@ void MissionController::removeMissionItem(int index)
         }
     }
 
-    _recalcAll();
+    _recalcAllFromIndex(index);
     setDirty(true);
 }
 
@@ -627,115 +643,198 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
     visualItems->insert(0, settingsItem);
     qCDebug(MissionControllerLog) << "plannedHomePosition" << homeCoordinate;
 
-    // Read mission items
+    // Mission items are loaded in phases:
+    //  - Parse: json is converted to plain structs off the main thread
+    //  - Create: visual items are created from the parsed items and added to the model with a single row insertion
+    //  - Fixup: DO_JUMP sequence numbers are resolved
 
-    int nextSequenceNumber = 1; // Start with 1 since home is in 0
-    const QJsonArray rgMissionItems(json[_jsonItemsKey].toArray());
-    for (int i=0; i<rgMissionItems.count(); i++) {
+    QElapsedTimer               phaseTimer;
+    QVector<ParsedJsonItem_t>   parsedItems;
+
+    phaseTimer.start();
+    if (!_parseJsonItems(json[_jsonItemsKey].toArray(), parsedItems, errorString)) {
+        return false;
+    }
+    qint64 parseMsecs = phaseTimer.restart();
+
+    int                         nextSequenceNumber = 1; // Start with 1 since home is in 0
+    QList<QObject*>             loadedItems;
+    QList<SimpleMissionItem*>   simpleItems;
+
+    loadedItems.reserve(parsedItems.count());
+    for (int i=0; i<parsedItems.count(); i++) {
+        const ParsedJsonItem_t& parsedItem = parsedItems[i];
+
+        if (parsedItem.simpleItem) {
+            SimpleMissionItem* simpleItem = new SimpleMissionItem(_controllerVehicle, visualItems);
+            simpleItem->load(parsedItem.jsonItem, nextSequenceNumber);
+            qCDebug(MissionControllerLog) << "Loading simple item: nextSequenceNumber:command" << nextSequenceNumber << simpleItem->command();
+            nextSequenceNumber = simpleItem->lastSequenceNumber() + 1;
+            loadedItems.append(simpleItem);
+            simpleItems.append(simpleItem);
+            continue;
+        }
+
+        const QJsonObject& itemObject = parsedItem.complexJson;
+
+        QList<JsonHelper::KeyValidateInfo> complexItemKeyInfoList = {
+            { ComplexMissionItem::jsonComplexItemTypeKey,  QJsonValue::String, true },
+        };
+        if (!JsonHelper::validateKeys(itemObject, complexItemKeyInfoList, errorString)) {
+            return false;
+        }
+        QString complexItemType = itemObject[ComplexMissionItem::jsonComplexItemTypeKey].toString();
+
+        if (complexItemType == SurveyMissionItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Survey: nextSequenceNumber" << nextSequenceNumber;
+            SurveyMissionItem* surveyItem = new SurveyMissionItem(_controllerVehicle, visualItems);
+            if (!surveyItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = surveyItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Survey load complete: nextSequenceNumber" << nextSequenceNumber;
+            loadedItems.append(surveyItem);
+        } else if (complexItemType == FixedWingLandingComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Fixed Wing Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
+            FixedWingLandingComplexItem* landingItem = new FixedWingLandingComplexItem(_controllerVehicle, visualItems);
+            if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "FW Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
+            loadedItems.append(landingItem);
+        } else if (complexItemType == StructureScanComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Structure Scan: nextSequenceNumber" << nextSequenceNumber;
+            StructureScanComplexItem* structureItem = new StructureScanComplexItem(_controllerVehicle, visualItems);
+            if (!structureItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = structureItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Structure Scan load complete: nextSequenceNumber" << nextSequenceNumber;
+            loadedItems.append(structureItem);
+        } else if (complexItemType == MissionSettingsItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Mission Settings: nextSequenceNumber" << nextSequenceNumber;
+            MissionSettingsItem* settingsItem = new MissionSettingsItem(_controllerVehicle, visualItems);
+            if (!settingsItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = settingsItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Mission Settings load complete: nextSequenceNumber" << nextSequenceNumber;
+            loadedItems.append(settingsItem);
+        } else {
+            errorString = tr("Unsupported complex item type: %1").arg(complexItemType);
+        }
+    }
+    visualItems->append(loadedItems);
+    qint64 createMsecs = phaseTimer.restart();
+
+    // Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId. The first item
+    // with a given doJumpId wins.
+    QHash<int, int> doJumpIdToSequenceNumber;
+    doJumpIdToSequenceNumber.reserve(simpleItems.count());
+    for (int i=0; i<simpleItems.count(); i++) {
+        int doJumpId = simpleItems[i]->missionItem().doJumpId();
+        if (!doJumpIdToSequenceNumber.contains(doJumpId)) {
+            doJumpIdToSequenceNumber[doJumpId] = simpleItems[i]->sequenceNumber();
+        }
+    }
+    for (int i=0; i<simpleItems.count(); i++) {
+        SimpleMissionItem* doJumpItem = simpleItems[i];
+        if ((MAV_CMD)doJumpItem->command() == MAV_CMD_DO_JUMP) {
+            int findDoJumpId = doJumpItem->missionItem().param1();
+            if (!doJumpIdToSequenceNumber.contains(findDoJumpId)) {
+                errorString = tr("Could not find doJumpId: %1").arg(findDoJumpId);
+                return false;
+            }
+            doJumpItem->missionItem().setParam1(doJumpIdToSequenceNumber[findDoJumpId]);
+        }
+    }
+    qint64 fixupMsecs = phaseTimer.elapsed();
+
+    qCDebug(MissionControllerLog) << "_loadJsonMissionFileV2 items:parse:create:fixup msecs" << parsedItems.count() << parseMsecs << createMsecs << fixupMsecs;
+
+    return true;
+}
+
+MissionController::ParsedJsonItemRange_t MissionController::_parseJsonItemRange(const QJsonArray& rgJsonItems, int first, int count)
+{
+    ParsedJsonItemRange_t range;
+
+    range.items.reserve(count);
+    for (int i=first; i<first+count; i++) {
         // Convert to QJsonObject
-        const QJsonValue& itemValue = rgMissionItems[i];
+        const QJsonValue& itemValue = rgJsonItems[i];
         if (!itemValue.isObject()) {
-            errorString = tr("Mission item %1 is not an object").arg(i);
-            return false;
+            range.errorString = tr("Mission item %1 is not an object").arg(i);
+            return range;
         }
         const QJsonObject itemObject = itemValue.toObject();
 
-        // Load item based on type
-
         QList<JsonHelper::KeyValidateInfo> itemKeyInfoList = {
             { VisualMissionItem::jsonTypeKey,  QJsonValue::String, true },
         };
-        if (!JsonHelper::validateKeys(itemObject, itemKeyInfoList, errorString)) {
-            return false;
+        if (!JsonHelper::validateKeys(itemObject, itemKeyInfoList, range.errorString)) {
+            return range;
         }
         QString itemType = itemObject[VisualMissionItem::jsonTypeKey].toString();
 
+        ParsedJsonItem_t parsedItem;
         if (itemType == VisualMissionItem::jsonTypeSimpleItemValue) {
-            SimpleMissionItem* simpleItem = new SimpleMissionItem(_controllerVehicle, visualItems);
-            if (simpleItem->load(itemObject, nextSequenceNumber, errorString)) {
-                qCDebug(MissionControllerLog) << "Loading simple item: nextSequenceNumber:command" << nextSequenceNumber << simpleItem->command();
-                nextSequenceNumber = simpleItem->lastSequenceNumber() + 1;
-                visualItems->append(simpleItem);
-            } else {
-                return false;
+            parsedItem.simpleItem = true;
+            if (!MissionItem::parseJson(itemObject, parsedItem.jsonItem, range.errorString)) {
+                return range;
             }
         } else if (itemType == VisualMissionItem::jsonTypeComplexItemValue) {
-            QList<JsonHelper::KeyValidateInfo> complexItemKeyInfoList = {
-                { ComplexMissionItem::jsonComplexItemTypeKey,  QJsonValue::String, true },
-            };
-            if (!JsonHelper::validateKeys(itemObject, complexItemKeyInfoList, errorString)) {
-                return false;
-            }
-            QString complexItemType = itemObject[ComplexMissionItem::jsonComplexItemTypeKey].toString();
-
-            if (complexItemType == SurveyMissionItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Survey: nextSequenceNumber" << nextSequenceNumber;
-                SurveyMissionItem* surveyItem = new SurveyMissionItem(_controllerVehicle, visualItems);
-                if (!surveyItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = surveyItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Survey load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(surveyItem);
-            } else if (complexItemType == FixedWingLandingComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Fixed Wing Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
-                FixedWingLandingComplexItem* landingItem = new FixedWingLandingComplexItem(_controllerVehicle, visualItems);
-                if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "FW Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(landingItem);
-            } else if (complexItemType == StructureScanComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Structure Scan: nextSequenceNumber" << nextSequenceNumber;
-                StructureScanComplexItem* structureItem = new StructureScanComplexItem(_controllerVehicle, visualItems);
-                if (!structureItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = structureItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Structure Scan load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(structureItem);
-            } else if (complexItemType == MissionSettingsItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Mission Settings: nextSequenceNumber" << nextSequenceNumber;
-                MissionSettingsItem* settingsItem = new MissionSettingsItem(_controllerVehicle, visualItems);
-                if (!settingsItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = settingsItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Mission Settings load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(settingsItem);
-            } else {
-                errorString = tr("Unsupported complex item type: %1").arg(complexItemType);
-            }
+            // Complex items create QObjects while loading so they are loaded on the main thread
+            parsedItem.simpleItem = false;
+            parsedItem.complexJson = itemObject;
         } else {
-            errorString = tr("Unknown item type: %1").arg(itemType);
+            range.errorString = tr("Unknown item type: %1").arg(itemType);
+            return range;
+        }
+        range.items.append(parsedItem);
+    }
+
+    return range;
+}
+
+/// Parses the json mission items. Large missions are split into chunks which are parsed on the worker thread pool.
+///     @return false: Parse failed, errorString is set to the error for the first failing item
+bool MissionController::_parseJsonItems(const QJsonArray& rgJsonItems, QVector<ParsedJsonItem_t>& parsedItems, QString& errorString)
+{
+    int itemCount =     rgJsonItems.count();
+    int chunkCount =    qMin(QThread::idealThreadCount(), itemCount / _minParseChunkSize);
+
+    if (chunkCount <= 1) {
+        ParsedJsonItemRange_t range = _parseJsonItemRange(rgJsonItems, 0, itemCount);
+        if (!range.errorString.isEmpty()) {
+            errorString = range.errorString;
             return false;
         }
+        parsedItems = range.items;
+        return true;
     }
 
-    // Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId
-    for (int i=0; i<visualItems->count(); i++) {
-        if (visualItems->value<VisualMissionItem*>(i)->isSimpleItem()) {
-            SimpleMissionItem* doJumpItem = visualItems->value<SimpleMissionItem*>(i);
-            if ((MAV_CMD)doJumpItem->command() == MAV_CMD_DO_JUMP) {
-                bool found = false;
-                int findDoJumpId = doJumpItem->missionItem().param1();
-                for (int j=0; j<visualItems->count(); j++) {
-                    if (visualItems->value<VisualMissionItem*>(j)->isSimpleItem()) {
-                        SimpleMissionItem* targetItem = visualItems->value<SimpleMissionItem*>(j);
-                        if (targetItem->missionItem().doJumpId() == findDoJumpId) {
-                            doJumpItem->missionItem().setParam1(targetItem->sequenceNumber());
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if (!found) {
-                    errorString = tr("Could not find doJumpId: %1").arg(findDoJumpId);
-                    return false;
-                }
+    QList<QFuture<ParsedJsonItemRange_t>>   futures;
+    int                                     chunkSize = (itemCount + chunkCount - 1) / chunkCount;
+
+    for (int first=0; first<itemCount; first+=chunkSize) {
+        futures.append(QtConcurrent::run(&MissionController::_parseJsonItemRange, rgJsonItems, first, qMin(chunkSize, itemCount - first)));
+    }
+
+    parsedItems.clear();
+    parsedItems.reserve(itemCount);
+    for (int i=0; i<futures.count(); i++) {
+        // Chunks are checked in order so the reported error is for the first bad item
+        const ParsedJsonItemRange_t range = futures[i].result();
+        if (!range.errorString.isEmpty()) {
+            errorString = range.errorString;
+            for (int j=i+1; j<futures.count(); j++) {
+                futures[j].waitForFinished();
             }
+            return false;
         }
+        parsedItems += range.items;
     }
 
     return true;
@@ -861,12 +960,15 @@ bool MissionController::loadJsonFile(QFile& file, QString& errorString)
     QString         errorStr;
     QString         errorMessage = tr("Mission: %1");
     QJsonDocument   jsonDoc;
+    QElapsedTimer   parseTimer;
     QByteArray      bytes = file.readAll();
 
+    parseTimer.start();
     if (!JsonHelper::isJsonFile(bytes, jsonDoc, errorStr)) {
         errorString = errorMessage.arg(errorStr);
         return false;
     }
+    qCDebug(MissionControllerLog) << "loadJsonFile bytes:document parse msecs" << bytes.count() << parseTimer.elapsed();
 
     QJsonObject json = jsonDoc.object();
     QmlObjectListModel* loadedVisualItems = new QmlObjectListModel(this);
@@ -982,7 +1084,7 @@ double MissionController::_calcDistanceToHome(VisualMissionItem* currentItem, Vi
     return distanceOk ? homeCoord.distanceTo(currentCoord) : 0.0;
 }
 
-void MissionController::_addWaypointLineSegment(CoordVectHashTable& prevItemPairHashTable, VisualItemPair& pair)
+CoordinateVector* MissionController::_addWaypointLineSegment(CoordVectHashTable& prevItemPairHashTable, VisualItemPair& pair)
 {
     if (prevItemPairHashTable.contains(pair)) {
         // Pair already exists and connected, just re-use
@@ -998,24 +1100,33 @@ void MissionController::_addWaypointLineSegment(CoordVectHashTable& prevItemPair
         connect(pair.second,    endNotifier,    linevect, &CoordinateVector::setCoordinate2);
 
         // FIXME: We should ideally have signals for 2D position change, alt change, and 3D position change
-        // Not optimal, but still pretty fast, do a full update of range/bearing/altitudes
-        connect(pair.second, &VisualMissionItem::coordinateChanged, this, &MissionController::_recalcMissionFlightStatus);
+        // Range/bearing/altitudes are only updated from the moved item onwards
+        connect(pair.second, &VisualMissionItem::coordinateChanged, this, &MissionController::_recalcMissionFlightStatusFromSender);
         _linesTable[pair] = linevect;
     }
+
+    return _linesTable[pair];
 }
 
 void MissionController::_recalcWaypointLines(void)
+{
+    _rebuildWaypointLines();
+    _recalcMissionFlightStatus();
+
+    emit waypointLinesChanged();
+}
+
+void MissionController::_rebuildWaypointLines(void)
 {
     bool                firstCoordinateItem =   true;
     VisualMissionItem*  lastCoordinateItem =    qobject_cast<VisualMissionItem*>(_visualItems->get(0));
 
     bool showHomePosition = _settingsItem->coordinate().isValid();
 
-    qCDebug(MissionControllerLog) << "_recalcWaypointLines showHomePosition" << showHomePosition;
+    qCDebug(MissionControllerLog) << "_rebuildWaypointLines showHomePosition" << showHomePosition;
 
-    CoordVectHashTable old_table = _linesTable;
-    _linesTable.clear();
-    _waypointLines.clear();
+    QVector<VisualItemPair> pairs;
+    pairs.reserve(_waypointLinePairs.count() + 1);
 
     bool linkEndToHome;
     SimpleMissionItem* lastItem = _visualItems->value<SimpleMissionItem*>(_visualItems->count() - 1);
@@ -1043,35 +1154,47 @@ void MissionController::_recalcWaypointLines(void)
                 firstCoordinateItem = false;
                 VisualItemPair pair(lastCoordinateItem, item);
                 if (lastCoordinateItem != _settingsItem || (showHomePosition && linkStartToHome)) {
-                    _addWaypointLineSegment(old_table, pair);
+                    pairs.append(pair);
                 }
                 lastCoordinateItem = item;
             }
         }
     }
     if (linkEndToHome && lastCoordinateItem != _settingsItem && showHomePosition) {
-        VisualItemPair pair(lastCoordinateItem, _settingsItem);
-        _addWaypointLineSegment(old_table, pair);
+        pairs.append(VisualItemPair(lastCoordinateItem, _settingsItem));
     }
 
-    {
-        // Create a temporary QObjectList and replace the model data
-        QObjectList objs;
-        objs.reserve(_linesTable.count());
-        foreach(CoordinateVector *vect, _linesTable.values()) {
-            objs.append(vect);
-        }
+    // Lines before and after the change are left alone, only the lines in between are spliced into the model
+    int firstChanged = 0;
+    while (firstChanged < pairs.count() && firstChanged < _waypointLinePairs.count() && pairs[firstChanged] == _waypointLinePairs[firstChanged]) {
+        firstChanged++;
+    }
+    int unchangedAfter = 0;
+    while (unchangedAfter < pairs.count() - firstChanged && unchangedAfter < _waypointLinePairs.count() - firstChanged &&
+           pairs[pairs.count() - 1 - unchangedAfter] == _waypointLinePairs[_waypointLinePairs.count() - 1 - unchangedAfter]) {
+        unchangedAfter++;
+    }
+    int removeCount = _waypointLinePairs.count() - firstChanged - unchangedAfter;
+    int insertCount = pairs.count() - firstChanged - unchangedAfter;
+
+    qCDebug(MissionControllerLog) << "_rebuildWaypointLines first:removed:inserted" << firstChanged << removeCount << insertCount;
 
-        // We don't delete here because many links may still be valid
-        _waypointLines.swapObjectList(objs);
+    CoordVectHashTable old_table;
+    for (int i=firstChanged; i<firstChanged + removeCount; i++) {
+        old_table[_waypointLinePairs[i]] = _linesTable.take(_waypointLinePairs[i]);
     }
+    _waypointLines.removeRange(firstChanged, removeCount);
+
+    QObjectList objs;
+    objs.reserve(insertCount);
+    for (int i=firstChanged; i<firstChanged + insertCount; i++) {
+        objs.append(_addWaypointLineSegment(old_table, pairs[i]));
+    }
+    _waypointLines.insert(firstChanged, objs);
+    _waypointLinePairs = pairs;
 
     // Anything left in the old table is an obsolete line object that can go
     qDeleteAll(old_table);
-
-    _recalcMissionFlightStatus();
-
-    emit waypointLinesChanged();
 }
 
 void MissionController::_updateBatteryInfo(int waypointIndex)
@@ -1151,7 +1274,22 @@ void MissionController::_addTimeDistance(bool vtolInHover, double hoverTime, dou
     }
 }
 
-void MissionController::_recalcMissionFlightStatus()
+void MissionController::_recalcMissionFlightStatus(void)
+{
+    _recalcMissionFlightStatusFromIndex(0);
+}
+
+/// Restarts the flight status walk from the visual item which signalled the change
+void MissionController::_recalcMissionFlightStatusFromSender(void)
+{
+    VisualMissionItem* item = qobject_cast<VisualMissionItem*>(sender());
+
+    _recalcMissionFlightStatusFromIndex(item ? _visualItems->indexOf(item) : 0);
+}
+
+/// Recalculates distance/time/battery values for all items from the specified index onwards. The walk state saved
+/// prior to startIndex from the previous walk is used as the starting point so items before it are not touched.
+void MissionController::_recalcMissionFlightStatusFromIndex(int startIndex)
 {
     if (!_visualItems->count()) {
         return;
@@ -1162,28 +1300,59 @@ void MissionController::_recalcMissionFlightStatus()
 
     bool showHomePosition = _settingsItem->coordinate().isValid();
 
-    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus";
+    if (startIndex < 0 || startIndex >= _flightStatusWalkStates.count()) {
+        startIndex = 0;
+    }
+
+    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus startIndex:count" << startIndex << _visualItems->count();
 
     // If home position is valid we can calculate distances between all waypoints.
     // If home position is not valid we can only calculate distances between waypoints which are
     // both relative altitude.
 
-    // No values for first item
-    lastCoordinateItem->setAltDifference(0.0);
-    lastCoordinateItem->setAzimuth(0.0);
-    lastCoordinateItem->setDistance(0.0);
-
     double minAltSeen = 0.0;
     double maxAltSeen = 0.0;
     const double homePositionAltitude = _settingsItem->coordinate().altitude();
-    minAltSeen = maxAltSeen = _settingsItem->coordinate().altitude();
-
-    _resetMissionFlightStatus();
 
     bool vtolInHover = true;
     bool linkStartToHome = false;
     bool linkEndToHome = false;
 
+    if (startIndex == 0) {
+        // No values for first item
+        lastCoordinateItem->setAltDifference(0.0);
+        lastCoordinateItem->setAzimuth(0.0);
+        lastCoordinateItem->setDistance(0.0);
+
+        minAltSeen = maxAltSeen = _settingsItem->coordinate().altitude();
+
+        _resetMissionFlightStatus();
+    } else {
+        const FlightStatusWalkState_t& walkState = _flightStatusWalkStates[startIndex];
+
+        _missionFlightStatus =  walkState.missionFlightStatus;
+        lastCoordinateItem =    walkState.lastCoordinateItem;
+        firstCoordinateItem =   walkState.firstCoordinateItem;
+        vtolInHover =           walkState.vtolInHover;
+        linkStartToHome =       walkState.linkStartToHome;
+        minAltSeen =            walkState.minAltSeen;
+        maxAltSeen =            walkState.maxAltSeen;
+    }
+    _flightStatusWalkStates.resize(startIndex);
+    _flightStatusWalkStates.reserve(_visualItems->count() + 1);
+
+    auto saveWalkState = [&]() {
+        FlightStatusWalkState_t walkState;
+        walkState.missionFlightStatus = _missionFlightStatus;
+        walkState.lastCoordinateItem =  lastCoordinateItem;
+        walkState.firstCoordinateItem = firstCoordinateItem;
+        walkState.vtolInHover =         vtolInHover;
+        walkState.linkStartToHome =     linkStartToHome;
+        walkState.minAltSeen =          minAltSeen;
+        walkState.maxAltSeen =          maxAltSeen;
+        _flightStatusWalkStates.append(walkState);
+    };
+
     if (showHomePosition) {
         SimpleMissionItem* lastItem = _visualItems->value<SimpleMissionItem*>(_visualItems->count() - 1);
         if (lastItem && (int)lastItem->command() == MAV_CMD_NAV_RETURN_TO_LAUNCH) {
@@ -1193,11 +1362,13 @@ void MissionController::_recalcMissionFlightStatus()
         }
     }
 
-    for (int i=0; i<_visualItems->count(); i++) {
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
         SimpleMissionItem* simpleItem = qobject_cast<SimpleMissionItem*>(item);
         ComplexMissionItem* complexItem = qobject_cast<ComplexMissionItem*>(item);
 
+        saveWalkState();
+
         // Assume the worst
         item->setAzimuth(0.0);
         item->setDistance(0.0);
@@ -1332,6 +1503,10 @@ void MissionController::_recalcMissionFlightStatus()
             lastCoordinateItem = item;
         }
     }
+
+    // Save the state following the last item as well so items appended to the end do not require a full walk
+    saveWalkState();
+
     lastCoordinateItem->setMissionVehicleYaw(_missionFlightStatus.vehicleYaw);
 
     if (linkEndToHome && lastCoordinateItem != _settingsItem) {
@@ -1359,9 +1534,17 @@ void MissionController::_recalcMissionFlightStatus()
     emit batteryChangePointChanged(_missionFlightStatus.batteryChangePoint);
     emit batteriesRequiredChanged(_missionFlightStatus.batteriesRequired);
 
-    // Walk the list again calculating altitude percentages
+    // Walk the list again calculating altitude percentages. Items prior to the start index only need updating if the
+    // altitude range changed.
+    int altPercentStartIndex = startIndex;
+    if (minAltSeen != _flightStatusMinAltSeen || maxAltSeen != _flightStatusMaxAltSeen) {
+        altPercentStartIndex = 0;
+    }
+    _flightStatusMinAltSeen = minAltSeen;
+    _flightStatusMaxAltSeen = maxAltSeen;
+
     double altRange = maxAltSeen - minAltSeen;
-    for (int i=0; i<_visualItems->count(); i++) {
+    for (int i=altPercentStartIndex; i<_visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
 
         if (item->specifiesCoordinate()) {
@@ -1385,10 +1568,17 @@ void MissionController::_recalcMissionFlightStatus()
 // This will update the sequence numbers to be sequential starting from 0
 void MissionController::_recalcSequence(void)
 {
-    // Setup ascending sequence numbers for all visual items
+    _recalcSequenceFromIndex(0);
+}
+
+// Sequence numbers prior to the start index are left as is
+void MissionController::_recalcSequenceFromIndex(int startIndex)
+{
+    // Setup ascending sequence numbers for all visual items from startIndex on
 
-    int sequenceNumber = 0;
-    for (int i=0; i<_visualItems->count(); i++) {
+    startIndex = qBound(0, startIndex, _visualItems->count());
+    int sequenceNumber = startIndex > 0 ? _visualItems->value<VisualMissionItem*>(startIndex - 1)->lastSequenceNumber() + 1 : 0;
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
 
         item->setSequenceNumber(sequenceNumber);
@@ -1399,7 +1589,8 @@ void MissionController::_recalcSequence(void)
 // This will update the child item hierarchy
 void MissionController::_recalcChildItems(void)
 {
-    VisualMissionItem* currentParentItem = qobject_cast<VisualMissionItem*>(_visualItems->get(0));
+    VisualMissionItem*  currentParentItem = qobject_cast<VisualMissionItem*>(_visualItems->get(0));
+    QList<QObject*>     currentChildItems;
 
     currentParentItem->childItems()->clear();
 
@@ -1408,12 +1599,50 @@ void MissionController::_recalcChildItems(void)
 
         // Set up non-coordinate item child hierarchy
         if (item->specifiesCoordinate()) {
+            currentParentItem->childItems()->append(currentChildItems);
+            currentChildItems.clear();
+            item->childItems()->clear();
+            currentParentItem = item;
+        } else if (item->isSimpleItem()) {
+            currentChildItems.append(item);
+        }
+    }
+    currentParentItem->childItems()->append(currentChildItems);
+}
+
+// Updates the child item hierarchy after an item was inserted or removed at the specified index. Only the coordinate
+// item prior to the change and coordinate items up to the first one following the change can have different children.
+void MissionController::_recalcChildItemsFromIndex(int changedIndex)
+{
+    int parentIndex = qMin(changedIndex, _visualItems->count()) - 1;
+    while (parentIndex > 0 && !_visualItems->value<VisualMissionItem*>(parentIndex)->specifiesCoordinate()) {
+        parentIndex--;
+    }
+    // Same as _recalcChildItems, the settings item is the parent of anything prior to the first coordinate item
+    parentIndex = qMax(parentIndex, 0);
+
+    VisualMissionItem*  currentParentItem = _visualItems->value<VisualMissionItem*>(parentIndex);
+    QList<QObject*>     currentChildItems;
+
+    currentParentItem->childItems()->clear();
+
+    for (int i=parentIndex + 1; i<_visualItems->count(); i++) {
+        VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
+
+        if (item->specifiesCoordinate()) {
+            currentParentItem->childItems()->append(currentChildItems);
+            currentChildItems.clear();
+            if (i > changedIndex) {
+                // Children from here on are unchanged
+                return;
+            }
             item->childItems()->clear();
             currentParentItem = item;
         } else if (item->isSimpleItem()) {
-            currentParentItem->childItems()->append(item);
+            currentChildItems.append(item);
         }
     }
+    currentParentItem->childItems()->append(currentChildItems);
 }
 
 void MissionController::_setPlannedHomePositionFromFirstCoordinate(void)
@@ -1443,9 +1672,32 @@ void MissionController::_recalcAll(void)
     _recalcWaypointLines();
 }
 
+/// Same as _recalcAll but used when an item has been inserted or removed at the specified index. Sequence numbers,
+/// child items and flight status for the items prior to the change are unaffected so they are only updated from the
+/// change onwards. Only the waypoint lines which changed are replaced.
+void MissionController::_recalcAllFromIndex(int changedIndex)
+{
+    if (_editMode) {
+        _setPlannedHomePositionFromFirstCoordinate();
+    }
+    _recalcSequenceFromIndex(changedIndex);
+    _recalcChildItemsFromIndex(changedIndex);
+    _rebuildWaypointLines();
+    _recalcMissionFlightStatusFromIndex(changedIndex);
+
+    emit waypointLinesChanged();
+}
+
 /// Initializes a new set of mission items
 void MissionController::_initAllVisualItems(void)
 {
+    // Saved flight status walk state and waypoint lines refer to the previous set of items
+    _flightStatusWalkStates.clear();
+    _waypointLines.clear();
+    qDeleteAll(_linesTable);
+    _linesTable.clear();
+    _waypointLinePairs.clear();
+
     // Setup home position at index 0
 
     _settingsItem = qobject_cast<MissionSettingsItem*>(_visualItems->get(0));
@@ -1502,9 +1754,9 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
     connect(visualItem, &VisualMissionItem::specifiesCoordinateChanged,                 this, &MissionController::_recalcWaypointLines);
     connect(visualItem, &VisualMissionItem::coordinateHasRelativeAltitudeChanged,       this, &MissionController::_recalcWaypointLines);
     connect(visualItem, &VisualMissionItem::exitCoordinateHasRelativeAltitudeChanged,   this, &MissionController::_recalcWaypointLines);
-    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, &MissionController::_recalcMissionFlightStatus);
-    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, &MissionController::_recalcMissionFlightStatus);
-    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, &MissionController::_recalcMissionFlightStatus);
+    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, &MissionController::_recalcMissionFlightStatusFromSender);
+    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, &MissionController::_recalcMissionFlightStatusFromSender);
+    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, &MissionController::_recalcMissionFlightStatusFromSender);
     connect(visualItem, &VisualMissionItem::lastSequenceNumberChanged,                  this, &MissionController::_recalcSequence);
 
     if (visualItem->isSimpleItem()) {
@@ -1518,9 +1770,15 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
     } else {
         ComplexMissionItem* complexItem = qobject_cast<ComplexMissionItem*>(visualItem);
         if (complexItem) {
-            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, &MissionController::_recalcMissionFlightStatus);
-            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, &MissionController::_recalcMissionFlightStatus);
-            connect(complexItem, &ComplexMissionItem::additionalTimeDelayChanged,   this, &MissionController::_recalcMissionFlightStatus);
+            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, &MissionController::_recalcMissionFlightStatusFromSender);
+            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, &MissionController::_recalcMissionFlightStatusFromSender);
+            connect(complexItem, &ComplexMissionItem::additionalTimeDelayChanged,   this, &MissionController::_recalcMissionFlightStatusFromSender);
+
+            // Keep the ui responsive while large surveys are being edited
+            SurveyMissionItem* surveyItem = qobject_cast<SurveyMissionItem*>(complexItem);
+            if (surveyItem && _editMode) {
+                surveyItem->setGenerateGridInBackground(true);
+            }
         } else {
             qWarning() << "ComplexMissionItem not found";
         }
@@ -16,12 +16,15 @@
 #include "Vehicle.h"
 #include "QGCLoggingCategory.h"
 #include "MavlinkQmlSingleton.h"
+#include "MissionItem.h"
 
 #include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QVector>
 
 class CoordinateVector;
 class VisualMissionItem;
-class MissionItem;
 class MissionSettingsItem;
 class AppSettings;
 class MissionManager;
@@ -196,6 +199,7 @@ private slots:
     void _currentMissionIndexChanged(int sequenceNumber);
     void _recalcWaypointLines(void);
     void _recalcMissionFlightStatus(void);
+    void _recalcMissionFlightStatusFromSender(void);
     void _updateContainsItems(void);
     void _progressPctChanged(double progressPct);
     void _visualItemsDirtyChanged(bool dirty);
@@ -205,8 +209,13 @@ private slots:
 private:
     void _init(void);
     void _recalcSequence(void);
+    void _recalcSequenceFromIndex(int startIndex);
     void _recalcChildItems(void);
+    void _recalcChildItemsFromIndex(int changedIndex);
     void _recalcAll(void);
+    void _recalcAllFromIndex(int changedIndex);
+    void _rebuildWaypointLines(void);
+    void _recalcMissionFlightStatusFromIndex(int startIndex);
     void _initAllVisualItems(void);
     void _deinitAllVisualItems(void);
     void _initVisualItem(VisualMissionItem* item);
@@ -232,19 +241,51 @@ private:
     void _updateBatteryInfo(int waypointIndex);
     bool _loadItemsFromJson(const QJsonObject& json, QmlObjectListModel* visualItems, QString& errorString);
     void _initLoadedVisualItems(QmlObjectListModel* loadedVisualItems);
-    void _addWaypointLineSegment(CoordVectHashTable& prevItemPairHashTable, VisualItemPair& pair);
+    CoordinateVector* _addWaypointLineSegment(CoordVectHashTable& prevItemPairHashTable, VisualItemPair& pair);
     void _addCommandTimeDelay(SimpleMissionItem* simpleItem, bool vtolInHover);
     void _addTimeDistance(bool vtolInHover, double hoverTime, double cruiseTime, double extraTime, double distance, int seqNum);
 
+    /// Json mission item parsed off the main thread. Simple items are fully parsed, complex items are only type checked
+    /// since they must be loaded on the main thread.
+    typedef struct {
+        bool                    simpleItem;
+        MissionItem::JsonItem_t jsonItem;       ///< Only valid for simple items
+        QJsonObject             complexJson;    ///< Only valid for complex items
+    } ParsedJsonItem_t;
+
+    typedef struct {
+        QVector<ParsedJsonItem_t>   items;
+        QString                     errorString;    ///< Empty if all items parsed
+    } ParsedJsonItemRange_t;
+
+    static ParsedJsonItemRange_t _parseJsonItemRange(const QJsonArray& rgJsonItems, int first, int count);
+    static bool _parseJsonItems(const QJsonArray& rgJsonItems, QVector<ParsedJsonItem_t>& parsedItems, QString& errorString);
+
+    /// State of the _recalcMissionFlightStatus walk prior to processing a visual item. Saved for each item so the walk
+    /// can be restarted from the first changed item instead of from the start of the mission.
+    typedef struct {
+        MissionFlightStatus_t   missionFlightStatus;
+        VisualMissionItem*      lastCoordinateItem;
+        bool                    firstCoordinateItem;
+        bool                    vtolInHover;
+        bool                    linkStartToHome;
+        double                  minAltSeen;
+        double                  maxAltSeen;
+    } FlightStatusWalkState_t;
+
 private:
     MissionManager*         _missionManager;
     QmlObjectListModel*     _visualItems;
     MissionSettingsItem*    _settingsItem;
     QmlObjectListModel      _waypointLines;
     CoordVectHashTable      _linesTable;
+    QVector<VisualItemPair> _waypointLinePairs;     ///< Item pair of each line in _waypointLines, in mission order
     bool                    _firstItemsFromVehicle;
     bool                    _itemsRequested;
     MissionFlightStatus_t   _missionFlightStatus;
+    QVector<FlightStatusWalkState_t> _flightStatusWalkStates;   ///< Walk state prior to each visual item, only valid prefix is kept
+    double                  _flightStatusMinAltSeen;
+    double                  _flightStatusMaxAltSeen;
     QString                 _surveyMissionItemName;
     QString                 _fwLandingMissionItemName;
     QString                 _structureScanMissionItemName;
@@ -270,6 +311,11 @@ private:
     static const char*  _jsonComplexItemsKey;
 
     static const int    _missionFileVersion;
+    static const int    _minParseChunkSize;     ///< Minimum number of json items parsed by each worker thread
+
+#ifdef UNITTEST_BUILD
+    friend class MissionControllerTest;
+#endif
 };
 
 #endif
@@ -17,6 +17,9 @@
 #include "SettingsManager.h"
 #include "AppSettings.h"
 
+#include <QJsonArray>
+#include <QJsonObject>
+
 MissionControllerTest::MissionControllerTest(void)
     : _multiSpyMissionController(NULL)
     , _multiSpyMissionItem(NULL)
@@ -248,3 +251,149 @@ void MissionControllerTest::_testLoadJsonSectionAvailable(void)
 
     }
 }
+
+/// Flight status totals, per item values, sequence numbers, child item counts and waypoint lines of the mission
+QList<double> MissionControllerTest::_recalcSnapshot(void)
+{
+    QList<double> snapshot;
+
+    snapshot << _missionController->missionDistance() << _missionController->missionTime()
+             << _missionController->missionHoverDistance() << _missionController->missionHoverTime()
+             << _missionController->missionCruiseDistance() << _missionController->missionCruiseTime()
+             << _missionController->missionMaxTelemetry()
+             << _missionController->batteryChangePoint() << _missionController->batteriesRequired();
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    for (int i=0; i<visualItems->count(); i++) {
+        VisualMissionItem* item = visualItems->value<VisualMissionItem*>(i);
+        snapshot << item->sequenceNumber() << item->distance() << item->azimuth() << item->altDifference() << item->altPercent()
+                 << item->childItems()->count();
+    }
+
+    QmlObjectListModel* waypointLines = _missionController->waypointLines();
+    for (int i=0; i<waypointLines->count(); i++) {
+        QGeoCoordinate coordinate1 = waypointLines->get(i)->property("coordinate1").value<QGeoCoordinate>();
+        QGeoCoordinate coordinate2 = waypointLines->get(i)->property("coordinate2").value<QGeoCoordinate>();
+        snapshot << coordinate1.latitude() << coordinate1.longitude() << coordinate1.altitude()
+                 << coordinate2.latitude() << coordinate2.longitude() << coordinate2.altitude();
+    }
+
+    return snapshot;
+}
+
+/// Builds a 2000 item mission and then inserts, removes and moves items at pseudo random positions. After each change
+/// the incrementally recalculated mission must match a full recalc.
+void MissionControllerTest::_testIncrementalRecalc(void)
+{
+    const int cItems =   2000;
+    const int cChanges = 60;
+
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    QGeoCoordinate      coord(47.6, 8.5);
+    for (int i=1; i<=cItems; i++) {
+        _missionController->insertSimpleMissionItem(coord.atDistanceAndAzimuth(i * 10, 90), i);
+
+        // Varying altitudes so the altitude range changes as items come and go
+        SimpleMissionItem*  item = visualItems->value<SimpleMissionItem*>(i);
+        QGeoCoordinate      itemCoord = item->coordinate();
+        itemCoord.setAltitude(20 + (i * 37) % 100);
+        item->setCoordinate(itemCoord);
+
+        // Items without a coordinate become children of the waypoint before them
+        if (i % 25 == 0) {
+            item->setCommand(MavlinkQmlSingleton::MAV_CMD_DO_CHANGE_SPEED);
+        }
+    }
+    QCOMPARE(visualItems->count(), cItems + 1);
+
+    qsrand(1234);
+    for (int i=0; i<cChanges; i++) {
+        int             index = 1 + qrand() % (visualItems->count() - 1);
+        QGeoCoordinate  changeCoord = coord.atDistanceAndAzimuth(qrand() % 20000, qrand() % 360);
+        changeCoord.setAltitude(10 + qrand() % 150);
+
+        switch (i % 5) {
+        case 0:
+            _missionController->insertSimpleMissionItem(changeCoord, index);
+            break;
+        case 1:
+            _missionController->insertROIMissionItem(changeCoord, index);
+            break;
+        case 2:
+            _missionController->removeMissionItem(index);
+            break;
+        case 3:
+            visualItems->value<VisualMissionItem*>(index)->setCoordinate(changeCoord);
+            break;
+        case 4:
+            // Removing the last item and appending again takes the shortest path through the recalc
+            _missionController->removeMissionItem(visualItems->count() - 1);
+            _missionController->insertSimpleMissionItem(changeCoord, visualItems->count());
+            break;
+        }
+
+        QList<double> incrementalSnapshot = _recalcSnapshot();
+        _missionController->_recalcAll();
+        QList<double> fullSnapshot = _recalcSnapshot();
+
+        QCOMPARE(incrementalSnapshot.count(), fullSnapshot.count());
+        for (int j=0; j<incrementalSnapshot.count(); j++) {
+            QVERIFY2(qAbs(incrementalSnapshot[j] - fullSnapshot[j]) < 1e-6, qPrintable(QString("change:%1 value:%2").arg(i).arg(j)));
+        }
+    }
+}
+
+/// Loads a large mission from json and verifies that DO_JUMP targets are resolved against the loaded sequence numbers.
+void MissionControllerTest::_testLoadLargeJsonBenchmark(void)
+{
+    const int cItems =          5000;
+    const int cDoJumpIdOffset = 1000;
+
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    QGeoCoordinate  coord(47.6, 8.5, 50);
+    QJsonArray      rgItems;
+    for (int i=1; i<=cItems; i++) {
+        QGeoCoordinate  itemCoord = coord.atDistanceAndAzimuth(i * 10, 90);
+        QJsonObject     itemObject;
+
+        itemObject["type"] =            "SimpleItem";
+        itemObject["command"] =         MAV_CMD_NAV_WAYPOINT;
+        itemObject["frame"] =           MAV_FRAME_GLOBAL_RELATIVE_ALT;
+        itemObject["autoContinue"] =    true;
+        itemObject["doJumpId"] =        i + cDoJumpIdOffset;
+        itemObject["params"] =          QJsonArray({ 0, 0, 0, 0, itemCoord.latitude(), itemCoord.longitude(), 50 });
+        rgItems.append(itemObject);
+    }
+    QJsonObject doJumpObject;
+    doJumpObject["type"] =          "SimpleItem";
+    doJumpObject["command"] =       MAV_CMD_DO_JUMP;
+    doJumpObject["frame"] =         MAV_FRAME_MISSION;
+    doJumpObject["autoContinue"] =  true;
+    doJumpObject["params"] =        QJsonArray({ (cItems / 2) + cDoJumpIdOffset, 1, 0, 0, 0, 0, 0 });
+    rgItems.append(doJumpObject);
+
+    QJsonObject json;
+    json["firmwareType"] =          MAV_AUTOPILOT_PX4;
+    json["plannedHomePosition"] =   QJsonArray({ coord.latitude(), coord.longitude(), coord.altitude() });
+    json["items"] =                 rgItems;
+
+    QString errorString;
+    QVERIFY(_missionController->load(json, errorString));
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    QCOMPARE(visualItems->count(), cItems + 2);
+
+    SimpleMissionItem* doJumpItem = visualItems->value<SimpleMissionItem*>(visualItems->count() - 1);
+    QVERIFY(doJumpItem);
+    QCOMPARE((int)doJumpItem->command(), (int)MAV_CMD_DO_JUMP);
+    QCOMPARE((int)doJumpItem->missionItem().param1(), cItems / 2);
+
+    // A DO_JUMP to a missing doJumpId must fail the load
+    doJumpObject["params"] = QJsonArray({ cItems + cDoJumpIdOffset + 1, 1, 0, 0, 0, 0, 0 });
+    rgItems[rgItems.count() - 1] = doJumpObject;
+    json["items"] = rgItems;
+    QVERIFY(!_missionController->load(json, errorString));
+}
@@ -38,6 +38,8 @@ private slots:
     void _testEmptyVehiclePX4(void);
     void _testAddWayppointAPM(void);
     void _testAddWayppointPX4(void);
+    void _testIncrementalRecalc(void);
+    void _testLoadLargeJsonBenchmark(void);
 
 private:
 #if 0
@@ -53,6 +55,7 @@ private:
     void _testOfflineToOnlineWorker(MAV_AUTOPILOT firmwareType);
 #endif
     void _setupVisualItemSignals(VisualMissionItem* visualItem);
+    QList<double> _recalcSnapshot(void);
 
     // MissiomItems signals
 
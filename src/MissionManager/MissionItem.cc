@@ -259,6 +259,18 @@ bool MissionItem::_convertJsonV2ToV3(QJsonObject& json, QString& errorString)
 }
 
 bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& errorString)
+{
+    JsonItem_t jsonItem;
+
+    if (!parseJson(json, jsonItem, errorString)) {
+        return false;
+    }
+    load(jsonItem, sequenceNumber);
+
+    return true;
+}
+
+bool MissionItem::parseJson(const QJsonObject& json, JsonItem_t& jsonItem, QString& errorString)
 {
     QJsonObject convertedJson;
     if (!_convertJsonV1ToV2(json, convertedJson, errorString)) {
@@ -298,29 +310,40 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
         }
     }
 
-    // Make sure to set these first since they can signal other changes
-    setFrame((MAV_FRAME)convertedJson[_jsonFrameKey].toInt());
-    setCommand((MAV_CMD)convertedJson[_jsonCommandKey].toInt());
-
-    _doJumpId = -1;
+    jsonItem.frame =        (MAV_FRAME)convertedJson[_jsonFrameKey].toInt();
+    jsonItem.command =      (MAV_CMD)convertedJson[_jsonCommandKey].toInt();
+    jsonItem.autoContinue = convertedJson[_jsonAutoContinueKey].toBool();
+    jsonItem.doJumpId =     -1;
     if (convertedJson.contains(_jsonDoJumpIdKey)) {
-        _doJumpId = convertedJson[_jsonDoJumpIdKey].toInt();
+        jsonItem.doJumpId = convertedJson[_jsonDoJumpIdKey].toInt();
+    }
+    for (int i=0; i<7; i++) {
+        jsonItem.params[i] = JsonHelper::possibleNaNJsonValue(rgParams[i]);
     }
-    setIsCurrentItem(false);
-    setSequenceNumber(sequenceNumber);
-    setAutoContinue(convertedJson[_jsonAutoContinueKey].toBool());
-
-    setParam1(JsonHelper::possibleNaNJsonValue(rgParams[0]));
-    setParam2(JsonHelper::possibleNaNJsonValue(rgParams[1]));
-    setParam3(JsonHelper::possibleNaNJsonValue(rgParams[2]));
-    setParam4(JsonHelper::possibleNaNJsonValue(rgParams[3]));
-    setParam5(JsonHelper::possibleNaNJsonValue(rgParams[4]));
-    setParam6(JsonHelper::possibleNaNJsonValue(rgParams[5]));
-    setParam7(JsonHelper::possibleNaNJsonValue(rgParams[6]));
 
     return true;
 }
 
+void MissionItem::load(const JsonItem_t& jsonItem, int sequenceNumber)
+{
+    // Make sure to set these first since they can signal other changes
+    setFrame(jsonItem.frame);
+    setCommand(jsonItem.command);
+
+    _doJumpId = jsonItem.doJumpId;
+    setIsCurrentItem(false);
+    setSequenceNumber(sequenceNumber);
+    setAutoContinue(jsonItem.autoContinue);
+
+    setParam1(jsonItem.params[0]);
+    setParam2(jsonItem.params[1]);
+    setParam3(jsonItem.params[2]);
+    setParam4(jsonItem.params[3]);
+    setParam5(jsonItem.params[4]);
+    setParam6(jsonItem.params[5]);
+    setParam7(jsonItem.params[6]);
+}
+
 
 void MissionItem::setSequenceNumber(int sequenceNumber)
 {
@@ -96,10 +96,27 @@ public:
     void setParam7          (double param7);
     void setCoordinate      (const QGeoCoordinate& coordinate);
     
+    /// Plain representation of a json mission item
+    typedef struct {
+        MAV_CMD     command;
+        MAV_FRAME   frame;
+        double      params[7];
+        bool        autoContinue;
+        int         doJumpId;
+    } JsonItem_t;
+
     void save(QJsonObject& json) const;
     bool load(QTextStream &loadStream);
     bool load(const QJsonObject& json, int sequenceNumber, QString& errorString);
 
+    /// Loads from a json item previously validated by parseJson
+    void load(const JsonItem_t& jsonItem, int sequenceNumber);
+
+    /// Validates and converts a json mission item to its plain representation. Does not touch any QObjects so it is
+    /// safe to call from a worker thread.
+    ///     @return false: json is invalid, errorString set
+    static bool parseJson(const QJsonObject& json, JsonItem_t& jsonItem, QString& errorString);
+
     bool relativeAltitude(void) const { return frame() == MAV_FRAME_GLOBAL_RELATIVE_ALT; }
 
 signals:
@@ -113,8 +130,8 @@ private slots:
     void _param3Changed         (QVariant value);
 
 private:
-    bool _convertJsonV1ToV2(const QJsonObject& json, QJsonObject& v2Json, QString& errorString);
-    bool _convertJsonV2ToV3(QJsonObject& json, QString& errorString);
+    static bool _convertJsonV1ToV2(const QJsonObject& json, QJsonObject& v2Json, QString& errorString);
+    static bool _convertJsonV2ToV3(QJsonObject& json, QString& errorString);
 
     int     _sequenceNumber;
     int     _doJumpId;
@@ -85,8 +85,10 @@ void MissionManager::generateResumeMission(int resumeIndex)
         return;
     }
 
-    for (int i=0; i<_missionItems.count(); i++) {
-        MissionItem* item = _missionItems[i];
+    const QList<MissionItem*>& rgMissionItems = missionItems();
+
+    for (int i=0; i<rgMissionItems.count(); i++) {
+        MissionItem* item = rgMissionItems[i];
         if (item->command() == MAV_CMD_DO_JUMP) {
             qgcApp()->showMessage(tr("Unable to generate resume mission due to MAV_CMD_DO_JUMP command."));
             return;
@@ -94,14 +96,14 @@ void MissionManager::generateResumeMission(int resumeIndex)
     }
 
     // Be anal about crap input
-    resumeIndex = qMax(0, qMin(resumeIndex, _missionItems.count() - 1));
+    resumeIndex = qMax(0, qMin(resumeIndex, rgMissionItems.count() - 1));
 
     // Adjust resume index to be a location based command
-    const MissionCommandUIInfo* uiInfo = qgcApp()->toolbox()->missionCommandTree()->getUIInfo(_vehicle, _missionItems[resumeIndex]->command());
+    const MissionCommandUIInfo* uiInfo = qgcApp()->toolbox()->missionCommandTree()->getUIInfo(_vehicle, rgMissionItems[resumeIndex]->command());
     if (!uiInfo || uiInfo->isStandaloneCoordinate() || !uiInfo->specifiesCoordinate()) {
         // We have to back up to the last command which the vehicle flies through
         while (--resumeIndex > 0) {
-            uiInfo = qgcApp()->toolbox()->missionCommandTree()->getUIInfo(_vehicle, _missionItems[resumeIndex]->command());
+            uiInfo = qgcApp()->toolbox()->missionCommandTree()->getUIInfo(_vehicle, rgMissionItems[resumeIndex]->command());
             if (uiInfo && (uiInfo->specifiesCoordinate() && !uiInfo->isStandaloneCoordinate())) {
                 // Found it
                 break;
@@ -135,8 +137,8 @@ void MissionManager::generateResumeMission(int resumeIndex)
     bool addHomePosition = _vehicle->firmwarePlugin()->sendHomePositionToVehicle();
 
     int prefixCommandCount = 0;
-    for (int i=0; i<_missionItems.count(); i++) {
-        MissionItem* oldItem = _missionItems[i];
+    for (int i=0; i<rgMissionItems.count(); i++) {
+        MissionItem* oldItem = rgMissionItems[i];
         if ((i == 0 && addHomePosition) || i >= resumeIndex || includedResumeCommands.contains(oldItem->command())) {
             if (i < resumeIndex) {
                 prefixCommandCount++;
@@ -327,3 +327,182 @@ void MissionManagerTest::_testReadFailureHandlingPX4(void)
     _initForFirmwareType(MAV_AUTOPILOT_PX4);
     _testReadFailureHandlingWorker();
 }
+
+/// Writes a mission with the specified number of waypoints to the vehicle over the normal fast link. First item is home
+/// position which is not sent to PX4.
+///     @param innerAltitude Altitude for all but the first and last waypoint sent to the vehicle
+void MissionManagerTest::_writeWaypoints(int count, double innerAltitude)
+{
+    QList<MissionItem*> missionItems;
+    for (int i=0; i<=count; i++) {
+        MissionItem* missionItem = new MissionItem(this);
+        missionItem->setCommand(MAV_CMD_NAV_WAYPOINT);
+        missionItem->setFrame(MAV_FRAME_GLOBAL_RELATIVE_ALT);
+        missionItem->setCoordinate(QGeoCoordinate(47.3769 + (i * 0.0001), 8.549444, i > 1 && i < count ? innerAltitude : 50));
+        missionItem->setSequenceNumber(i);
+        missionItems.append(missionItem);
+    }
+    _missionManager->writeMissionItems(missionItems);
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    _multiSpyMissionManager->clearAllSignals();
+}
+
+void MissionManagerTest::_testPipelinedReadBenchmark(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    // Make sure every read goes to the vehicle
+    _missionManager->setPlanCacheEnabled(false);
+
+    const int cItems = 200;
+    _writeWaypoints(cItems);
+
+    // Read it back over a slow link, stop-and-wait versus pipelined
+    static const int rgReadWindow[] = { 1, 8 };
+    int rgRequestCount[2];
+    int rgMaxOutstanding[2];
+
+    _mockLink->setMissionItemLinkSimulation(10 /* latencyMsecs */, 0 /* readItemLossPercent */);
+    for (int i=0; i<2; i++) {
+        int startRequestCount = _mockLink->missionItemReadRequestCount();
+
+        _missionManager->setReadWindow(rgReadWindow[i]);
+        _missionManager->loadFromVehicle();
+        QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, 60 * 1000));
+        QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+        QCOMPARE(_missionManager->missionItems().count(), cItems);
+        _multiSpyMissionManager->clearAllSignals();
+
+        rgRequestCount[i] = _mockLink->missionItemReadRequestCount() - startRequestCount;
+        rgMaxOutstanding[i] = _mockLink->missionItemMaxReadRequestsOutstanding();
+    }
+
+    // Stop-and-wait never has more than one request in flight, the pipelined read must keep several in flight and stay
+    // within its window. Neither may request an item more than once on a link without loss.
+    QCOMPARE(rgMaxOutstanding[0], 1);
+    QVERIFY(rgMaxOutstanding[1] > 1);
+    QVERIFY(rgMaxOutstanding[1] <= rgReadWindow[1]);
+    QCOMPARE(rgRequestCount[1], rgRequestCount[0]);
+
+    // Lost items must be requested again and the items must still come back in order
+    _mockLink->setMissionItemLinkSimulation(10 /* latencyMsecs */, 5 /* readItemLossPercent */);
+    int startRequestCount = _mockLink->missionItemReadRequestCount();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, 60 * 1000));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+    for (int i=0; i<cItems; i++) {
+        QCOMPARE(_missionManager->missionItems()[i]->sequenceNumber(), i);
+    }
+    QVERIFY(_mockLink->missionItemReadRequestCount() - startRequestCount > rgRequestCount[1]);
+
+    _mockLink->setMissionItemLinkSimulation(0, 0);
+}
+
+void MissionManagerTest::_testPlanCacheRead(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    // Writing updates the plan cache
+    const int cSampledItems = PlanManager::_minPlanCacheCount;
+    const int cItems = 2 + (cSampledItems * PlanManager::_planCacheSampleStride);
+    _writeWaypoints(cItems);
+
+    // Count and sampled items match the cache so only the first, last and sampled items should be requested
+    int startRequestCount = _mockLink->missionItemReadRequestCount();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_mockLink->missionItemReadRequestCount() - startRequestCount, 2 + cSampledItems);
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+    for (int i=0; i<cItems; i++) {
+        MissionItem* item = _missionManager->missionItems()[i];
+        QCOMPARE(item->sequenceNumber(), i);
+        QCOMPARE((int)item->command(), (int)MAV_CMD_NAV_WAYPOINT);
+    }
+    _multiSpyMissionManager->clearAllSignals();
+
+    // Plan with a different count must be read in full
+    _missionManager->setPlanCacheEnabled(false);
+    _writeWaypoints(cItems + 1);
+    _missionManager->setPlanCacheEnabled(true);
+    startRequestCount = _mockLink->missionItemReadRequestCount();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_mockLink->missionItemReadRequestCount() - startRequestCount, cItems + 1);
+    QCOMPARE(_missionManager->missionItems().count(), cItems + 1);
+}
+
+void MissionManagerTest::_testPlanCacheMismatch(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    const int cSampledItems = PlanManager::_minPlanCacheCount;
+    const int cItems = 2 + (cSampledItems * PlanManager::_planCacheSampleStride);
+    _writeWaypoints(cItems, 50);
+
+    // Change all but the first and last item on the vehicle without updating the cache. Count, first and last item
+    // still match the cache, the sampled items do not so the read must fall back to reading all items.
+    _missionManager->setPlanCacheEnabled(false);
+    _writeWaypoints(cItems, 75);
+    _missionManager->setPlanCacheEnabled(true);
+
+    int startRequestCount = _mockLink->missionItemReadRequestCount();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_mockLink->missionItemReadRequestCount() - startRequestCount, 2 + cSampledItems + cItems);
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+    for (int i=0; i<cItems; i++) {
+        MissionItem* item = _missionManager->missionItems()[i];
+        QCOMPARE(item->sequenceNumber(), i);
+        QCOMPARE(item->param7(), i > 0 && i < cItems - 1 ? 75.0 : 50.0);
+    }
+    _multiSpyMissionManager->clearAllSignals();
+
+    // The full read updated the cache so the next read is verified by the samples alone
+    startRequestCount = _mockLink->missionItemReadRequestCount();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_mockLink->missionItemReadRequestCount() - startRequestCount, 2 + cSampledItems);
+}
+
+void MissionManagerTest::_testMissionItemStore(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+    _missionManager->setPlanCacheEnabled(false);
+
+    // Items are available from the store right after a write
+    const int cItems = 20;
+    _writeWaypoints(cItems);
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+
+    _missionManager->loadFromVehicle();
+    QVERIFY(_multiSpyMissionManager->waitForSignalByIndex(newMissionItemsAvailableSignalIndex, _missionManagerSignalWaitTime));
+    QCOMPARE(_multiSpyMissionManager->checkNoSignalByMask(errorSignalMask), true);
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+
+    QList<QGeoCoordinate> rgCoordinates;
+    for (int i=0; i<cItems; i++) {
+        rgCoordinates.append(_missionManager->missionItems()[i]->coordinate());
+    }
+    MissionItem* firstItem = _missionManager->missionItems()[0];
+    QVERIFY(firstItem->isCurrentItem());
+
+    // Released items are recreated from the store with the same values
+    _missionManager->releaseMissionItems();
+    QCOMPARE(_missionManager->missionItems().count(), cItems);
+    QVERIFY(_missionManager->missionItems()[0] != firstItem);
+    QVERIFY(_missionManager->missionItems()[0]->isCurrentItem());
+    for (int i=0; i<cItems; i++) {
+        MissionItem* item = _missionManager->missionItems()[i];
+        QCOMPARE(item->sequenceNumber(), i);
+        QCOMPARE((int)item->command(), (int)MAV_CMD_NAV_WAYPOINT);
+        QCOMPARE(item->coordinate(), rgCoordinates[i]);
+    }
+
+    _missionManager->setPlanCacheEnabled(true);
+}
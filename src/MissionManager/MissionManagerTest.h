@@ -31,10 +31,15 @@ private slots:
     void _testWriteFailureHandlingAPM(void);
     void _testReadFailureHandlingPX4(void);
     void _testReadFailureHandlingAPM(void);
+    void _testPipelinedReadBenchmark(void);
+    void _testPlanCacheRead(void);
+    void _testPlanCacheMismatch(void);
+    void _testMissionItemStore(void);
 
 private:
     void _roundTripItems(MockLinkMissionItemHandler::FailureMode_t failureMode, bool shouldFail);
     void _writeItems(MockLinkMissionItemHandler::FailureMode_t failureMode, bool shouldFail);
+    void _writeWaypoints(int count, double innerAltitude = 50);
     void _testWriteFailureHandlingWorker(void);
     void _testReadFailureHandlingWorker(void);
     
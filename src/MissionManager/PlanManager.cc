@@ -18,9 +18,20 @@
 #include "QGCApplication.h"
 #include "MissionCommandTree.h"
 #include "MissionCommandUIInfo.h"
+#include "QGC.h"
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QTemporaryDir>
 
 QGC_LOGGING_CATEGORY(PlanManagerLog, "PlanManagerLog")
 
+const quint32 PlanManager::_planCacheMagic =    0x51504C4E; // "QPLN"
+const quint32 PlanManager::_planCacheVersion =  1;
+
 PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
     : _vehicle(vehicle)
     , _planType(planType)
@@ -30,6 +41,16 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
     , _transactionInProgress(TransactionNone)
     , _resumeMission(false)
     , _lastMissionRequest(-1)
+    , _readCount(0)
+    , _itemsReceivedCount(0)
+    , _nextReadIndex(0)
+    , _readWindow(1)
+    , _readWindowOverride(-1)
+    , _pipelinedReadFailed(false)
+    , _staleReadResponses(0)
+    , _verifyingPlanCache(false)
+    , _planCacheEnabled(true)
+    , _missionItemsMaterialized(true)
     , _currentMissionIndex(-1)
     , _lastCurrentIndex(-1)
 {
@@ -45,6 +66,22 @@ PlanManager::~PlanManager()
 
 }
 
+const QList<MissionItem*>& PlanManager::missionItems(void)
+{
+    // The item store is only partially filled while a read is in progress
+    if (!_missionItemsMaterialized && _transactionInProgress != TransactionRead) {
+        _materializeMissionItems();
+    }
+    return _missionItems;
+}
+
+void PlanManager::releaseMissionItems(void)
+{
+    if (_missionItemsMaterialized) {
+        _clearAndDeleteMissionItems();
+    }
+}
+
 void PlanManager::_writeMissionItemsWorker(void)
 {
     _lastMissionRequest = -1;
@@ -150,7 +187,6 @@ void PlanManager::_requestList(void)
 
     mavlink_message_t message;
 
-    _itemIndicesToRead.clear();
     _clearMissionItems();
 
     _dedicatedLink = _vehicle->priorityLink();
@@ -194,8 +230,17 @@ void PlanManager::_ackTimeout(void)
             _sendError(VehicleError, tr("Mission read failed, maximum retries exceeded."));
             _finishTransaction(false);
         } else {
+            if (_readWindow > 1 && _retryCount > 0) {
+                // Second timeout in a row, the vehicle is likely ignoring requests it did not expect
+                _fallbackToStopAndWait();
+            }
             _retryCount++;
             qCDebug(PlanManagerLog) << tr("Retrying %1 MISSION_REQUEST retry Count").arg(_planTypeString()) << _retryCount;
+
+            // Anything still outstanding was lost, start requesting again from the first missing item
+            _outstandingReads.clear();
+            _nextReadIndex = 0;
+            _staleReadResponses = 0;
             _requestNextMissionItem();
         }
         break;
@@ -272,7 +317,13 @@ bool PlanManager::_checkForExpectedAck(AckType_t receivedAck)
 void PlanManager::_readTransactionComplete(void)
 {
     qCDebug(PlanManagerLog) << "_readTransactionComplete read sequence complete";
-    
+
+    _savePlanCache();
+
+    // Items are stored by sequence number so out of order pipelined reads need no fixup here. The MissionItem objects
+    // are created from the store when they are first asked for.
+    _missionItemsMaterialized = false;
+
     mavlink_message_t message;
     
     mavlink_msg_mission_ack_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
@@ -313,22 +364,69 @@ void PlanManager::_handleMissionCount(const mavlink_message_t& message)
     if (missionCount.count == 0) {
         _readTransactionComplete();
     } else {
-        // Prime read list
-        for (int i=0; i<missionCount.count; i++) {
-            _itemIndicesToRead << i;
+        // Prime read state
+        _readCount = missionCount.count;
+        _itemsReceived.fill(false, _readCount);
+        _itemsReceivedCount = 0;
+        _outstandingReads.clear();
+        _nextReadIndex = 0;
+        _staleReadResponses = 0;
+        _vehicleItems.resize(_readCount);
+        if (_pipelinedReadFailed) {
+            _readWindow = 1;
+        } else {
+            _readWindow = qMax(1, _readWindowOverride != -1 ? _readWindowOverride : _vehicle->firmwarePlugin()->missionReadWindow());
+        }
+        qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 read window").arg(_planTypeString()) << _readWindow;
+
+        if (_planCacheEnabled && _readCount >= _minPlanCacheCount && _loadPlanCache(_cachedItems) && _cachedItems.count() == _readCount) {
+            // Count matches the cached plan. Read the first and last items plus every _planCacheSampleStride'th item in between
+            // to verify the cache, the rest comes from the cache. The sample starts at a random offset so that over repeated
+            // reads every item is checked against the vehicle.
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 verifying plan cache").arg(_planTypeString());
+            _verifyingPlanCache = true;
+            int sampleIndex = 1 + (qrand() % _planCacheSampleStride);
+            for (int i=1; i<_readCount-1; i++) {
+                if (i == sampleIndex) {
+                    sampleIndex += _planCacheSampleStride;
+                    continue;
+                }
+                _itemsReceived.setBit(i);
+                _itemsReceivedCount++;
+                _vehicleItems[i] = _cachedItems[i];
+            }
         }
+
         _requestNextMissionItem();
     }
 }
 
+/// Requests items from the vehicle until the read window is full. With a read window of 1 this is the standard
+/// stop-and-wait sequence.
 void PlanManager::_requestNextMissionItem(void)
 {
-    if (_itemIndicesToRead.count() == 0) {
+    if (_itemsReceivedCount >= _readCount) {
         _sendError(InternalError, "Internal Error: Call to Vehicle _requestNextMissionItem with no more indices to read");
         return;
     }
 
-    qCDebug(PlanManagerLog) << QStringLiteral("_requestNextMissionItem %1 sequenceNumber:retry").arg(_planTypeString()) << _itemIndicesToRead[0] << _retryCount;
+    while (_outstandingReads.count() < _readWindow) {
+        while (_nextReadIndex < _readCount && (_itemsReceived.testBit(_nextReadIndex) || _outstandingReads.contains(_nextReadIndex))) {
+            _nextReadIndex++;
+        }
+        if (_nextReadIndex >= _readCount) {
+            break;
+        }
+        _outstandingReads.append(_nextReadIndex);
+        _sendMissionRequest(_nextReadIndex++);
+    }
+
+    _startAckTimeout(AckMissionItem);
+}
+
+void PlanManager::_sendMissionRequest(int sequenceNumber)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_sendMissionRequest %1 sequenceNumber:retry").arg(_planTypeString()) << sequenceNumber << _retryCount;
 
     mavlink_message_t message;
     if (_vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_MISSION_INT) {
@@ -338,7 +436,7 @@ void PlanManager::_requestNextMissionItem(void)
                                                   &message,
                                                   _vehicle->id(),
                                                   MAV_COMP_ID_MISSIONPLANNER,
-                                                  _itemIndicesToRead[0],
+                                                  sequenceNumber,
                 _planType);
     } else {
         mavlink_msg_mission_request_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
@@ -347,12 +445,20 @@ void PlanManager::_requestNextMissionItem(void)
                                               &message,
                                               _vehicle->id(),
                                               MAV_COMP_ID_MISSIONPLANNER,
-                                              _itemIndicesToRead[0],
+                                              sequenceNumber,
                 _planType);
     }
     
     _vehicle->sendMessageOnLink(_dedicatedLink, message);
-    _startAckTimeout(AckMissionItem);
+}
+
+/// Switches the current and all future read sequences to stop-and-wait
+void PlanManager::_fallbackToStopAndWait(void)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_fallbackToStopAndWait %1 vehicle did not handle pipelined reads").arg(_planTypeString());
+
+    _pipelinedReadFailed = true;
+    _readWindow = 1;
 }
 
 void PlanManager::_handleMissionItem(const mavlink_message_t& message, bool missionItemInt)
@@ -430,29 +536,41 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message, bool miss
         return;
     }
     
-    if (_itemIndicesToRead.contains(seq)) {
-        _itemIndicesToRead.removeOne(seq);
-
-        MissionItem* item = new MissionItem(seq,
-                                            command,
-                                            frame,
-                                            param1,
-                                            param2,
-                                            param3,
-                                            param4,
-                                            param5,
-                                            param6,
-                                            param7,
-                                            autoContinue,
-                                            isCurrentItem,
-                                            this);
-
-        if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
-            // Home is in position 0
-            item->setParam1((int)item->param1() + 1);
+    if (seq >= 0 && seq < _readCount && !_itemsReceived.testBit(seq)) {
+        _itemsReceived.setBit(seq);
+        _itemsReceivedCount++;
+
+        int outstandingIndex = _outstandingReads.indexOf(seq);
+        if (outstandingIndex == -1) {
+            if (_staleReadResponses > 0) {
+                _staleReadResponses--;
+            }
+        } else {
+            // The vehicle answers requests in the order they were sent. Anything requested ahead of this item which has
+            // not arrived was lost, so request it again now instead of waiting for the ack timeout.
+            QList<int> lostReads = _outstandingReads.mid(0, outstandingIndex);
+            _outstandingReads.erase(_outstandingReads.begin(), _outstandingReads.begin() + outstandingIndex + 1);
+            foreach (int lostSeq, lostReads) {
+                qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 requesting lost item again:").arg(_planTypeString()) << lostSeq;
+                _outstandingReads.append(lostSeq);
+                _sendMissionRequest(lostSeq);
+            }
         }
 
-        _missionItems.append(item);
+        VehicleItem_t vehicleItem;
+        vehicleItem.command =       command;
+        vehicleItem.frame =         frame;
+        vehicleItem.params[0] =     param1;
+        vehicleItem.params[1] =     param2;
+        vehicleItem.params[2] =     param3;
+        vehicleItem.params[3] =     param4;
+        vehicleItem.params[4] =     param5;
+        vehicleItem.params[5] =     param6;
+        vehicleItem.params[6] =     param7;
+        vehicleItem.autoContinue =  autoContinue;
+        vehicleItem.isCurrentItem = isCurrentItem;
+
+        _vehicleItems[seq] = vehicleItem;
     } else {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 mission item received item index which was not requested, disregrarding:").arg(_planTypeString()) << seq;
         // We have to put the ack timeout back since it was removed above
@@ -460,10 +578,32 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message, bool miss
         return;
     }
 
-    emit progressPct((double)seq / (double)_missionItems.count());
+    emit progressPct((double)_itemsReceivedCount / (double)_readCount);
     
     _retryCount = 0;
-    if (_itemIndicesToRead.count() == 0) {
+    if (_itemsReceivedCount == _readCount) {
+        if (_verifyingPlanCache) {
+            _verifyingPlanCache = false;
+            // Items filled from the cache match trivially, so this only checks the items read from the vehicle
+            bool cacheMatches = true;
+            for (int i=0; i<_readCount; i++) {
+                if (_vehicleItemHash(_vehicleItems[i], 0) != _vehicleItemHash(_cachedItems[i], 0)) {
+                    cacheMatches = false;
+                    break;
+                }
+            }
+            if (!cacheMatches) {
+                qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 plan cache out of date, reading all items").arg(_planTypeString());
+                _clearAndDeleteMissionItems();
+                _itemsReceived.fill(false);
+                _itemsReceivedCount = 0;
+                _outstandingReads.clear();
+                _nextReadIndex = 0;
+                _requestNextMissionItem();
+                return;
+            }
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 plan cache hit").arg(_planTypeString());
+        }
         _readTransactionComplete();
     } else {
         _requestNextMissionItem();
@@ -472,7 +612,14 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message, bool miss
 
 void PlanManager::_clearMissionItems(void)
 {
-    _itemIndicesToRead.clear();
+    _readCount = 0;
+    _itemsReceived.clear();
+    _itemsReceivedCount = 0;
+    _outstandingReads.clear();
+    _nextReadIndex = 0;
+    _vehicleItems.clear();
+    _cachedItems.clear();
+    _verifyingPlanCache = false;
     _clearAndDeleteMissionItems();
 }
 
@@ -597,8 +744,23 @@ void PlanManager::_handleMissionAck(const mavlink_message_t& message)
         break;
     case AckMissionItem:
         // MISSION_ITEM expected
-        _sendError(VehicleError, tr("Vehicle returned error: %1.").arg(_missionResultToString((MAV_MISSION_RESULT)missionAck.type)));
-        _finishTransaction(false);
+        if (_staleReadResponses > 0) {
+            // Response to a request abandoned when falling back to stop-and-wait
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck %1 ignoring error for abandoned pipelined request").arg(_planTypeString());
+            _staleReadResponses--;
+            _startAckTimeout(AckMissionItem);
+        } else if (_readWindow > 1) {
+            // The vehicle may have rejected a request it did not expect. Abandon the outstanding requests and
+            // retry the missing items using stop-and-wait.
+            _fallbackToStopAndWait();
+            _staleReadResponses = _outstandingReads.count() - 1;
+            _outstandingReads.clear();
+            _nextReadIndex = 0;
+            _requestNextMissionItem();
+        } else {
+            _sendError(VehicleError, tr("Vehicle returned error: %1.").arg(_missionResultToString((MAV_MISSION_RESULT)missionAck.type)));
+            _finishTransaction(false);
+        }
         break;
     case AckMissionRequest:
         // MISSION_REQUEST is expected, or MISSION_ACK to end sequence
@@ -798,8 +960,10 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     emit progressPct(1);
     _disconnectFromMavlink();
 
-    _itemIndicesToRead.clear();
+    _outstandingReads.clear();
     _itemIndicesToWrite.clear();
+    _cachedItems.clear();
+    _verifyingPlanCache = false;
 
     // First thing we do is clear the transaction. This way inProgesss is off when we signal transaction complete.
     TransactionType_t currentTransactionType = _transactionInProgress;
@@ -814,6 +978,7 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     case TransactionRead:
         if (!success) {
             // Read from vehicle failed, clear partial list
+            _vehicleItems.clear();
             _clearAndDeleteMissionItems();
         }
         emit newMissionItemsAvailable(false);
@@ -830,10 +995,13 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
                     emit lastCurrentIndexChanged(-1);
                 }
                 _clearAndDeleteMissionItems();
+                _vehicleItems.clear();
+                _vehicleItems.reserve(_writeMissionItems.count());
                 for (int i=0; i<_writeMissionItems.count(); i++) {
-                    _missionItems.append(_writeMissionItems[i]);
+                    _vehicleItems.append(_toVehicleItem(*_writeMissionItems[i]));
                 }
-                _writeMissionItems.clear();
+                _savePlanCache();
+                _clearAndDeleteWriteMissionItems();
             } else {
                 // Write failed, throw out the write list
                 _clearAndDeleteWriteMissionItems();
@@ -842,6 +1010,10 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
         }
         break;
     case TransactionRemoveAll:
+        if (success) {
+            _vehicleItems.clear();
+            _savePlanCache();
+        }
         emit removeAllComplete(!success /* error */);
         break;
     default:
@@ -892,6 +1064,7 @@ void PlanManager::removeAll(void)
 
     qCDebug(PlanManagerLog) << QStringLiteral("removeAll %1").arg(_planTypeString());
 
+    _vehicleItems.clear();
     _clearAndDeleteMissionItems();
 
     if (_planType == MAV_MISSION_TYPE_MISSION) {
@@ -914,6 +1087,23 @@ void PlanManager::_clearAndDeleteMissionItems(void)
         _missionItems[i]->deleteLater();
     }
     _missionItems.clear();
+    _missionItemsMaterialized = false;
+}
+
+void PlanManager::_materializeMissionItems(void)
+{
+    QElapsedTimer timer;
+
+    timer.start();
+    _clearAndDeleteMissionItems();
+    _missionItems.reserve(_vehicleItems.count());
+    for (int i=0; i<_vehicleItems.count(); i++) {
+        _missionItems.append(_createMissionItem(i, _vehicleItems[i]));
+    }
+    _missionItemsMaterialized = true;
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_materializeMissionItems %1 count:msecs:storeBytesPerItem").arg(_planTypeString())
+                            << _missionItems.count() << timer.elapsed() << sizeof(VehicleItem_t);
 }
 
 
@@ -949,3 +1139,182 @@ QString PlanManager::_planTypeString(void)
         return QStringLiteral("T:Unknown");
     }
 }
+
+MissionItem* PlanManager::_createMissionItem(int sequenceNumber, const VehicleItem_t& vehicleItem)
+{
+    MissionItem* item = new MissionItem(sequenceNumber,
+                                        vehicleItem.command,
+                                        vehicleItem.frame,
+                                        vehicleItem.params[0],
+                                        vehicleItem.params[1],
+                                        vehicleItem.params[2],
+                                        vehicleItem.params[3],
+                                        vehicleItem.params[4],
+                                        vehicleItem.params[5],
+                                        vehicleItem.params[6],
+                                        vehicleItem.autoContinue,
+                                        vehicleItem.isCurrentItem,
+                                        this);
+
+    if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
+        // Home is in position 0
+        item->setParam1((int)item->param1() + 1);
+    }
+
+    return item;
+}
+
+PlanManager::VehicleItem_t PlanManager::_toVehicleItem(const MissionItem& item)
+{
+    VehicleItem_t vehicleItem;
+
+    vehicleItem.command =       item.command();
+    vehicleItem.frame =         item.frame();
+    vehicleItem.params[0] =     item.param1();
+    vehicleItem.params[1] =     item.param2();
+    vehicleItem.params[2] =     item.param3();
+    vehicleItem.params[3] =     item.param4();
+    vehicleItem.params[4] =     item.param5();
+    vehicleItem.params[5] =     item.param6();
+    vehicleItem.params[6] =     item.param7();
+    vehicleItem.autoContinue =  item.autoContinue();
+    vehicleItem.isCurrentItem = item.isCurrentItem();
+
+    return vehicleItem;
+}
+
+/// Params are hashed at float precision since that is what MISSION_ITEM carries. This way the items written by QGC
+/// and the same items read back from the vehicle produce the same hash.
+quint32 PlanManager::_vehicleItemHash(const VehicleItem_t& vehicleItem, quint32 crc)
+{
+    qint32  command =       vehicleItem.command;
+    qint32  frame =         vehicleItem.frame;
+    quint8  autoContinue =  vehicleItem.autoContinue;
+
+    crc = QGC::crc32((const quint8*)&command, sizeof(command), crc);
+    crc = QGC::crc32((const quint8*)&frame, sizeof(frame), crc);
+    for (int i=0; i<7; i++) {
+        float param = vehicleItem.params[i];
+        crc = QGC::crc32((const quint8*)&param, sizeof(param), crc);
+    }
+    return QGC::crc32(&autoContinue, sizeof(autoContinue), crc);
+}
+
+QDir PlanManager::planCacheDir(void)
+{
+    if (qgcApp()->runningUnitTests()) {
+        // Keep unit test caches out of the user's settings directory, removed on exit
+        static QTemporaryDir unitTestCacheDir;
+        return unitTestCacheDir.path();
+    }
+
+    const QString spath(QFileInfo(QSettings().fileName()).dir().absolutePath());
+    return spath + QDir::separator() + "PlanCache";
+}
+
+/// @return Plan cache file for this vehicle, empty if the vehicle has no uid to identify it by
+QString PlanManager::_planCacheFile(void)
+{
+    // System ids are not unique across vehicles, so without a uid a cache could be matched against some other vehicle's plan
+    quint64 uid = _vehicle->vehicleUID();
+    if (uid == 0) {
+        return QString();
+    }
+
+    return planCacheDir().filePath(QString("%1_%2").arg(QString::number(uid, 16)).arg(_planType));
+}
+
+bool PlanManager::_loadPlanCache(QVector<VehicleItem_t>& cachedItems)
+{
+    cachedItems.clear();
+
+    QString fileName = _planCacheFile();
+    if (fileName.isEmpty()) {
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(PlanManagerLog) << "Unable to open plan cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version, savedCrc;
+    qint32  count;
+
+    stream >> magic >> version >> count >> savedCrc;
+    if (stream.status() != QDataStream::Ok || magic != _planCacheMagic || version != _planCacheVersion || count < 0) {
+        qCDebug(PlanManagerLog) << "Plan cache has bad header, ignoring" << file.fileName();
+        return false;
+    }
+
+    quint32 crc = 0;
+    cachedItems.reserve(count);
+    for (int i=0; i<count; i++) {
+        VehicleItem_t   vehicleItem;
+        qint32          command, frame;
+
+        stream >> command >> frame;
+        for (int j=0; j<7; j++) {
+            stream >> vehicleItem.params[j];
+        }
+        stream >> vehicleItem.autoContinue;
+        vehicleItem.command =       (MAV_CMD)command;
+        vehicleItem.frame =         (MAV_FRAME)frame;
+        vehicleItem.isCurrentItem = false;
+
+        crc = _vehicleItemHash(vehicleItem, crc);
+        cachedItems.append(vehicleItem);
+    }
+    if (stream.status() != QDataStream::Ok || crc != savedCrc) {
+        qCWarning(PlanManagerLog) << "Plan cache corrupt, ignoring" << file.fileName();
+        cachedItems.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void PlanManager::_savePlanCache(void)
+{
+    QString fileName = _planCacheFile();
+    if (!_planCacheEnabled || fileName.isEmpty()) {
+        return;
+    }
+
+    planCacheDir().mkpath(".");
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(PlanManagerLog) << "Unable to create plan cache" << file.fileName() << file.errorString();
+        return;
+    }
+
+    quint32 crc = 0;
+    for (int i=0; i<_vehicleItems.count(); i++) {
+        crc = _vehicleItemHash(_vehicleItems[i], crc);
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << _planCacheMagic << _planCacheVersion << (qint32)_vehicleItems.count() << crc;
+    for (int i=0; i<_vehicleItems.count(); i++) {
+        const VehicleItem_t& vehicleItem = _vehicleItems[i];
+
+        stream << (qint32)vehicleItem.command << (qint32)vehicleItem.frame;
+        for (int j=0; j<7; j++) {
+            stream << vehicleItem.params[j];
+        }
+        stream << vehicleItem.autoContinue;
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(PlanManagerLog) << "Failed writing plan cache" << file.fileName() << file.errorString();
+    }
+}
@@ -13,6 +13,9 @@
 #include <QObject>
 #include <QLoggingCategory>
 #include <QTimer>
+#include <QBitArray>
+#include <QDir>
+#include <QVector>
 
 #include "MissionItem.h"
 #include "QGCMAVLink.h"
@@ -33,8 +36,25 @@ public:
     PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType);
     ~PlanManager();
     
+    /// Mission item as it is stored on the vehicle. The plan is held as a contiguous array of these, MissionItem
+    /// objects are only created from it when missionItems is called.
+    typedef struct {
+        MAV_CMD     command;
+        MAV_FRAME   frame;
+        double      params[7];
+        bool        autoContinue;
+        bool        isCurrentItem;  ///< Not saved to the plan cache
+    } VehicleItem_t;
+
     bool inProgress(void) const;
-    const QList<MissionItem*>& missionItems(void) { return _missionItems; }
+
+    /// Returns the mission items on the vehicle. The MissionItem objects are created from the compact item store on
+    /// first use after the plan changes.
+    const QList<MissionItem*>& missionItems(void);
+
+    /// Deletes the MissionItem objects created by missionItems. Call this once the items have been copied elsewhere
+    /// so a large plan is not held twice. They are recreated on the next call to missionItems.
+    void releaseMissionItems(void);
 
     /// Current mission item as reported by MISSION_CURRENT
     int currentIndex(void) const { return _currentMissionIndex; }
@@ -55,6 +75,18 @@ public:
     ///     Signals removeAllComplete when done
     void removeAll(void);
 
+    /// Overrides the firmware plugin read window for subsequent reads. Mainly used by unit tests to exercise both the
+    /// stop-and-wait and pipelined read sequences.
+    ///     @param readWindow Maximum number of outstanding MISSION_REQUESTs, -1 to use the firmware plugin value
+    void setReadWindow(int readWindow) { _readWindowOverride = readWindow; }
+
+    /// Enables use of the local plan cache to shorten reads. Mainly used by unit tests to force full reads. The cache is
+    /// never used for vehicles which do not report a uid.
+    void setPlanCacheEnabled(bool planCacheEnabled) { _planCacheEnabled = planCacheEnabled; }
+
+    /// Directory which holds the local plan caches, a temporary directory when running unit tests
+    static QDir planCacheDir(void);
+
     /// Error codes returned in error signal
     typedef enum {
         InternalError,
@@ -71,6 +103,9 @@ public:
     // These values are public so the unit test can set appropriate signal wait times
     static const int _ackTimeoutMilliseconds = 1000;
     static const int _maxRetryCount = 5;
+
+    static const int _minPlanCacheCount = 10;       ///< Plans with fewer items are always read in full
+    static const int _planCacheSampleStride = 4;    ///< Every n'th item is read from the vehicle to verify the plan cache
     
 signals:
     void newMissionItemsAvailable   (bool removeAllRequested);
@@ -113,6 +148,15 @@ protected:
     void _handleMissionRequest(const mavlink_message_t& message, bool missionItemInt);
     void _handleMissionAck(const mavlink_message_t& message);
     void _requestNextMissionItem(void);
+    void _sendMissionRequest(int sequenceNumber);
+    void _fallbackToStopAndWait(void);
+    MissionItem* _createMissionItem(int sequenceNumber, const VehicleItem_t& vehicleItem);
+    void _materializeMissionItems(void);
+    QString _planCacheFile(void);
+    bool _loadPlanCache(QVector<VehicleItem_t>& cachedItems);
+    void _savePlanCache(void);
+    static VehicleItem_t _toVehicleItem(const MissionItem& item);
+    static quint32 _vehicleItemHash(const VehicleItem_t& vehicleItem, quint32 crc);
     void _clearMissionItems(void);
     void _sendError(ErrorCode_t errorCode, const QString& errorMsg);
     QString _ackTypeToString(AckType_t ackType);
@@ -141,10 +185,27 @@ protected:
     TransactionType_t   _transactionInProgress;
     bool                _resumeMission;
     QList<int>          _itemIndicesToWrite;    ///< List of mission items which still need to be written to vehicle
-    QList<int>          _itemIndicesToRead;     ///< List of mission items which still need to be requested from vehicle
+    int                 _readCount;             ///< Number of items in current read sequence
+    QBitArray           _itemsReceived;         ///< Bit set for each item received during current read sequence
+    int                 _itemsReceivedCount;
+    QList<int>          _outstandingReads;      ///< Items requested from vehicle but not yet received, in request order
+    int                 _nextReadIndex;         ///< Where to continue looking for items which still need to be requested
+    int                 _readWindow;            ///< Maximum outstanding MISSION_REQUESTs for current read sequence, 1 is stop-and-wait
+    int                 _readWindowOverride;    ///< -1 to use firmware plugin read window
+    bool                _pipelinedReadFailed;   ///< true: Vehicle did not handle pipelined reads, always use stop-and-wait
+    int                 _staleReadResponses;    ///< Responses still expected for requests abandoned by falling back to stop-and-wait
+
+    QVector<VehicleItem_t>  _vehicleItems;          ///< Items as stored on the vehicle, source of truth for _missionItems and saved to the plan cache
+    QVector<VehicleItem_t>  _cachedItems;           ///< Plan cache being verified by the current read sequence
+    bool                    _verifyingPlanCache;    ///< true: Only a sample of items is being read, remainder comes from the plan cache
+    bool                    _planCacheEnabled;
+
+    static const quint32 _planCacheMagic;
+    static const quint32 _planCacheVersion;
     int                 _lastMissionRequest;    ///< Index of item last requested by MISSION_REQUEST
     
-    QList<MissionItem*> _missionItems;          ///< Set of mission items on vehicle
+    QList<MissionItem*> _missionItems;          ///< Set of mission items on vehicle, created on demand from _vehicleItems
+    bool                _missionItemsMaterialized;  ///< true: _missionItems is up to date with _vehicleItems
     QList<MissionItem*> _writeMissionItems;     ///< Set of mission items currently being written to vehicle
     int                 _currentMissionIndex;
     int                 _lastCurrentIndex;
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PolygonLineClipper.h"
+
+#include <QPair>
+#include <QVector>
+#include <QtMath>
+
+#include <algorithm>
+
+bool PolygonLineClipper::_sweepEdgeLessThan(const SweepEdge_t& edge1, const SweepEdge_t& edge2)
+{
+    return edge1.sMin < edge2.sMin;
+}
+
+void PolygonLineClipper::clipParallelLines(const QList<QLineF>& lines, const QPolygonF& polygon, QList<QList<QLineF>>& clippedLines)
+{
+    QList<QPolygonF> rings;
+
+    rings.append(polygon);
+    clipParallelLines(lines, rings, clippedLines);
+}
+
+void PolygonLineClipper::clipParallelLines(const QList<QLineF>& lines, const QList<QPolygonF>& rings, QList<QList<QLineF>>& clippedLines)
+{
+    clippedLines.clear();
+    for (int i=0; i<lines.count(); i++) {
+        clippedLines.append(QList<QLineF>());
+    }
+
+    // Find the first line with a usable direction to set up the sweep coordinate system
+    QPointF direction;
+    for (int i=0; i<lines.count(); i++) {
+        if (lines[i].length() > 0) {
+            direction = (lines[i].p2() - lines[i].p1()) / lines[i].length();
+            break;
+        }
+    }
+    if (direction.isNull()) {
+        return;
+    }
+    QPointF normal(-direction.y(), direction.x());
+
+    // Convert polygon edges to sweep coordinates. Edges parallel to the lines never produce a crossing and are dropped.
+    QVector<SweepEdge_t> edges;
+    for (int ringIndex=0; ringIndex<rings.count(); ringIndex++) {
+        const QPolygonF& ring = rings[ringIndex];
+
+        for (int i=0; i<ring.count(); i++) {
+            const QPointF& p1 = ring[i];
+            const QPointF& p2 = ring[(i + 1) % ring.count()];
+
+            double s1 = QPointF::dotProduct(p1, normal);
+            double s2 = QPointF::dotProduct(p2, normal);
+            if (s1 == s2) {
+                continue;
+            }
+            double t1 = QPointF::dotProduct(p1, direction);
+            double t2 = QPointF::dotProduct(p2, direction);
+
+            SweepEdge_t edge;
+            edge.tSlope = (t2 - t1) / (s2 - s1);
+            if (s1 < s2) {
+                edge.sMin =     s1;
+                edge.sMax =     s2;
+                edge.tAtSMin =  t1;
+            } else {
+                edge.sMin =     s2;
+                edge.sMax =     s1;
+                edge.tAtSMin =  t2;
+            }
+            edges.append(edge);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), _sweepEdgeLessThan);
+
+    // Process the lines in sweep order
+    QVector<QPair<double, int>> lineOrder;
+    lineOrder.reserve(lines.count());
+    for (int i=0; i<lines.count(); i++) {
+        lineOrder.append(qMakePair(QPointF::dotProduct(lines[i].p1(), normal), i));
+    }
+    std::sort(lineOrder.begin(), lineOrder.end());
+
+    QVector<SweepEdge_t>    activeEdges;
+    QVector<double>         crossings;
+    int                     nextEdge = 0;
+
+    for (int i=0; i<lineOrder.count(); i++) {
+        double          s =         lineOrder[i].first;
+        int             lineIndex = lineOrder[i].second;
+        const QLineF&   line =      lines[lineIndex];
+
+        // Edges span [sMin, sMax) so a vertex shared by two edges is only counted once
+        while (nextEdge < edges.count() && edges[nextEdge].sMin <= s) {
+            activeEdges.append(edges[nextEdge++]);
+        }
+        crossings.clear();
+        for (int j=activeEdges.count() - 1; j>=0; j--) {
+            const SweepEdge_t& edge = activeEdges[j];
+            if (edge.sMax <= s) {
+                activeEdges.remove(j);
+            } else {
+                crossings.append(edge.tAtSMin + ((s - edge.sMin) * edge.tSlope));
+            }
+        }
+        if (crossings.count() < 2) {
+            continue;
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        double  tLine1 =    QPointF::dotProduct(line.p1(), direction);
+        double  tLine2 =    QPointF::dotProduct(line.p2(), direction);
+        bool    reversed =  tLine2 < tLine1;
+        double  tMin =      qMin(tLine1, tLine2);
+        double  tMax =      qMax(tLine1, tLine2);
+
+        QList<QLineF>& segments = clippedLines[lineIndex];
+        for (int j=0; j+1<crossings.count(); j+=2) {
+            double tStart = qMax(crossings[j], tMin);
+            double tEnd =   qMin(crossings[j + 1], tMax);
+            if (tStart >= tEnd) {
+                continue;
+            }
+
+            QPointF start = (direction * tStart) + (normal * s);
+            QPointF end =   (direction * tEnd) + (normal * s);
+            if (reversed) {
+                segments.prepend(QLineF(end, start));
+            } else {
+                segments.append(QLineF(start, end));
+            }
+        }
+    }
+}
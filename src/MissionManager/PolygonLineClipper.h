@@ -0,0 +1,48 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QList>
+#include <QLineF>
+#include <QPolygonF>
+
+/// Clips sets of parallel lines against polygons using a sweep across the lines.
+///
+/// Polygon edges are sorted by where they start in the sweep direction. Lines are then processed in sweep order while
+/// maintaining the set of edges which span the current line, so each line is only intersected against the edges which
+/// can actually cross it. This makes clipping O((lines + edges) log edges) plus output size instead of testing every
+/// line against every edge. Concave polygons and holes are supported using the even-odd rule, so a single line can
+/// produce multiple inside segments.
+class PolygonLineClipper
+{
+public:
+    /// Clips parallel lines against the area enclosed by the specified rings.
+    ///     @param lines Parallel lines to clip
+    ///     @param rings Polygon rings. Normally the first ring is the outer boundary and any additional rings are holes.
+    ///                  The closing vertex is optional.
+    ///     @param[out] clippedLines For each input line the inside segments, ordered and oriented from P1 to P2 of the
+    ///                  input line. Lines which miss the polygon produce an empty list.
+    static void clipParallelLines(const QList<QLineF>& lines, const QList<QPolygonF>& rings, QList<QList<QLineF>>& clippedLines);
+
+    /// Convenience version for a single ring with no holes
+    static void clipParallelLines(const QList<QLineF>& lines, const QPolygonF& polygon, QList<QList<QLineF>>& clippedLines);
+
+private:
+    /// Polygon edge in sweep coordinates. s is the distance along the sweep direction (perpendicular to the lines),
+    /// t is the distance along the lines.
+    typedef struct {
+        double sMin;
+        double sMax;
+        double tAtSMin;
+        double tSlope;      ///< Change in t per unit s
+    } SweepEdge_t;
+
+    static bool _sweepEdgeLessThan(const SweepEdge_t& edge1, const SweepEdge_t& edge2);
+};
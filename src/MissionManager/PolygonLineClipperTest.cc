@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PolygonLineClipperTest.h"
+#include "PolygonLineClipper.h"
+
+#include <QtMath>
+
+void PolygonLineClipperTest::_testConvex(void)
+{
+    QPolygonF square;
+    square << QPointF(0, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10);
+
+    QList<QLineF> lines;
+    lines << QLineF(5, -5, 5, 15) << QLineF(20, -5, 20, 15) << QLineF(2, 15, 2, -5);
+
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lines, square, clippedLines);
+
+    QCOMPARE(clippedLines.count(), 3);
+    QCOMPARE(clippedLines[0].count(), 1);
+    QCOMPARE(clippedLines[0][0], QLineF(5, 0, 5, 10));
+
+    // Line misses polygon
+    QCOMPARE(clippedLines[1].count(), 0);
+
+    // Reversed line produces a reversed segment
+    QCOMPARE(clippedLines[2].count(), 1);
+    QCOMPARE(clippedLines[2][0], QLineF(2, 10, 2, 0));
+}
+
+void PolygonLineClipperTest::_testConcave(void)
+{
+    // U shape open at the top
+    QPolygonF uShape;
+    uShape << QPointF(0, 0) << QPointF(30, 0) << QPointF(30, 30) << QPointF(20, 30) << QPointF(20, 10) << QPointF(10, 10) << QPointF(10, 30) << QPointF(0, 30);
+
+    QList<QLineF> lines;
+    lines << QLineF(-5, 20, 35, 20) << QLineF(-5, 5, 35, 5);
+
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lines, uShape, clippedLines);
+
+    QCOMPARE(clippedLines[0].count(), 2);
+    QCOMPARE(clippedLines[0][0], QLineF(0, 20, 10, 20));
+    QCOMPARE(clippedLines[0][1], QLineF(20, 20, 30, 20));
+    QCOMPARE(clippedLines[1].count(), 1);
+    QCOMPARE(clippedLines[1][0], QLineF(0, 5, 30, 5));
+}
+
+void PolygonLineClipperTest::_testHole(void)
+{
+    QPolygonF outer;
+    outer << QPointF(0, 0) << QPointF(30, 0) << QPointF(30, 30) << QPointF(0, 30);
+    QPolygonF hole;
+    hole << QPointF(10, 10) << QPointF(20, 10) << QPointF(20, 20) << QPointF(10, 20) << QPointF(10, 10);
+
+    QList<QPolygonF> rings;
+    rings << outer << hole;
+
+    QList<QLineF> lines;
+    lines << QLineF(15, -5, 15, 35);
+
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lines, rings, clippedLines);
+
+    QCOMPARE(clippedLines[0].count(), 2);
+    QCOMPARE(clippedLines[0][0], QLineF(15, 0, 15, 10));
+    QCOMPARE(clippedLines[0][1], QLineF(15, 20, 15, 30));
+}
+
+void PolygonLineClipperTest::_testVertexCrossing(void)
+{
+    // Line passes exactly through the left and right vertices of a diamond
+    QPolygonF diamond;
+    diamond << QPointF(0, 10) << QPointF(10, 0) << QPointF(20, 10) << QPointF(10, 20);
+
+    QList<QLineF> lines;
+    lines << QLineF(-5, 10, 25, 10);
+
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lines, diamond, clippedLines);
+
+    QCOMPARE(clippedLines[0].count(), 1);
+    QCOMPARE(clippedLines[0][0], QLineF(0, 10, 20, 10));
+}
+
+/// Clips against a 500+ vertex concave polygon
+void PolygonLineClipperTest::_testLargePolygonBenchmark(void)
+{
+    const int       cVertices = 1000;
+    const double    radius = 1000;
+    QPolygonF       star;
+
+    // Star shaped polygon, every other vertex is pulled in to make it concave
+    for (int i=0; i<cVertices; i++) {
+        double angle = (2 * M_PI * i) / cVertices;
+        double vertexRadius = (i & 1) ? radius / 2 : radius;
+        star << QPointF(qCos(angle) * vertexRadius, qSin(angle) * vertexRadius);
+    }
+
+    QList<QLineF> lines;
+    for (double x=-radius; x<=radius; x+=2) {
+        lines << QLineF(x, -radius * 2, x, radius * 2);
+    }
+
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lines, star, clippedLines);
+
+    int segmentCount = 0;
+    for (int i=0; i<clippedLines.count(); i++) {
+        segmentCount += clippedLines[i].count();
+    }
+
+    QCOMPARE(clippedLines.count(), lines.count());
+    QVERIFY(segmentCount > lines.count());
+}
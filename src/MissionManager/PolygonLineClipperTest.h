@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for PolygonLineClipper
+class PolygonLineClipperTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testConvex(void);
+    void _testConcave(void);
+    void _testHole(void);
+    void _testVertexCrossing(void);
+    void _testLargePolygonBenchmark(void);
+};
@@ -294,6 +294,12 @@ bool SimpleMissionItem::load(const QJsonObject& json, int sequenceNumber, QStrin
     return success;
 }
 
+void SimpleMissionItem::load(const MissionItem::JsonItem_t& jsonItem, int sequenceNumber)
+{
+    _missionItem.load(jsonItem, sequenceNumber);
+    _updateOptionalSections();
+}
+
 bool SimpleMissionItem::isStandaloneCoordinate(void) const
 {
     const MissionCommandUIInfo* uiInfo = _commandTree->getUIInfo(_vehicle, (MAV_CMD)command());
@@ -81,6 +81,7 @@ public:
 
     bool load(QTextStream &loadStream);
     bool load(const QJsonObject& json, int sequenceNumber, QString& errorString);
+    void load(const MissionItem::JsonItem_t& jsonItem, int sequenceNumber);
 
     bool relativeAltitude(void) { return _missionItem.frame() == MAV_FRAME_GLOBAL_RELATIVE_ALT; }
 
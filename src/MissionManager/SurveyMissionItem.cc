@@ -16,8 +16,11 @@
 #include "QGCQGeoCoordinate.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
+#include "PolygonLineClipper.h"
+#include "TransectRouteOptimizer.h"
 
 #include <QPolygonF>
+#include <QtConcurrent>
 
 QGC_LOGGING_CATEGORY(SurveyMissionItemLog, "SurveyMissionItemLog")
 
@@ -88,6 +91,7 @@ SurveyMissionItem::SurveyMissionItem(Vehicle* vehicle, QObject* parent)
     , _cameraShots(0)
     , _coveredArea(0.0)
     , _timeBetweenShots(0.0)
+    , _generateGridInBackground(false)
     , _metaDataMap(FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/Survey.SettingsGroup.json"), this))
     , _manualGridFact                   (settingsGroup, _metaDataMap[manualGridName])
     , _gridAltitudeFact                 (settingsGroup, _metaDataMap[gridAltitudeName])
@@ -153,6 +157,17 @@ SurveyMissionItem::SurveyMissionItem(Vehicle* vehicle, QObject* parent)
 
     connect(&_mapPolygon, &QGCMapPolygon::dirtyChanged, this, &SurveyMissionItem::_polygonDirtyChanged);
     connect(&_mapPolygon, &QGCMapPolygon::pathChanged,  this, &SurveyMissionItem::_generateGrid);
+
+    _generateGridTimer.setSingleShot(true);
+    _generateGridTimer.setInterval(_generateGridCoalesceMsecs);
+    connect(&_generateGridTimer,    &QTimer::timeout,                           this, &SurveyMissionItem::_startBackgroundGrid);
+    connect(&_gridFutureWatcher,    &QFutureWatcher<GridResult_t>::finished,    this, &SurveyMissionItem::_backgroundGridFinished);
+}
+
+SurveyMissionItem::~SurveyMissionItem()
+{
+    // Worker only references its own copy of the inputs, so there is no need to wait for it
+    _cancelBackgroundGrid();
 }
 
 void SurveyMissionItem::_setSurveyDistance(double surveyDistance)
@@ -220,6 +235,10 @@ void SurveyMissionItem::setDirty(bool dirty)
 
 void SurveyMissionItem::save(QJsonArray&  missionItems)
 {
+    if (gridGenerationPending()) {
+        _generateGridNow();
+    }
+
     QJsonObject saveObject;
 
     saveObject[JsonHelper::jsonVersionKey] =                    3;
@@ -419,7 +438,7 @@ bool SurveyMissionItem::load(const QJsonObject& complexObject, int sequenceNumbe
     }
 
     _ignoreRecalc = false;
-    _generateGrid();
+    _generateGridNow();
 
     return true;
 }
@@ -527,78 +546,14 @@ void SurveyMissionItem::_optimizeTransectsForShortestDistance(const QGeoCoordina
     }
 }
 
-void SurveyMissionItem::_appendGridPointsFromTransects(QList<QList<QGeoCoordinate>>& rgTransectSegments)
+void SurveyMissionItem::_appendGridPointsFromTransects(QList<QList<QGeoCoordinate>>& rgTransectSegments, QVariantList& simpleGridPoints)
 {
     qCDebug(SurveyMissionItemLog) << "Entry point _appendGridPointsFromTransects" << rgTransectSegments.first().first();
 
     for (int i=0; i<rgTransectSegments.count(); i++) {
-        _simpleGridPoints.append(QVariant::fromValue(rgTransectSegments[i].first()));
-        _simpleGridPoints.append(QVariant::fromValue(rgTransectSegments[i].last()));
-    }
-}
-
-qreal SurveyMissionItem::_ccw(QPointF pt1, QPointF pt2, QPointF pt3)
-{
-    return (pt2.x()-pt1.x())*(pt3.y()-pt1.y()) - (pt2.y()-pt1.y())*(pt3.x()-pt1.x());
-}
-
-qreal SurveyMissionItem::_dp(QPointF pt1, QPointF pt2)
-{
-    return (pt2.x()-pt1.x())/qSqrt((pt2.x()-pt1.x())*(pt2.x()-pt1.x()) + (pt2.y()-pt1.y())*(pt2.y()-pt1.y()));
-}
-
-void SurveyMissionItem::_swapPoints(QList<QPointF>& points, int index1, int index2)
-{
-    QPointF temp = points[index1];
-    points[index1] = points[index2];
-    points[index2] = temp;
-}
-
-QList<QPointF> SurveyMissionItem::_convexPolygon(const QList<QPointF>& polygon)
-{
-    // We use the Graham scan algorithem to convert the possibly concave polygon to a convex polygon
-    // https://en.wikipedia.org/wiki/Graham_scan
-
-    QList<QPointF> workPolygon(polygon);
-
-    // First point must be lowest y-coordinate point
-    for (int i=1; i<workPolygon.count(); i++) {
-        if (workPolygon[i].y() < workPolygon[0].y()) {
-            _swapPoints(workPolygon, i, 0);
-        }
-    }
-
-    // Sort the points by angle with first point
-    for (int i=1; i<workPolygon.count(); i++) {
-        qreal angle = _dp(workPolygon[0], workPolygon[i]);
-        for (int j=i+1; j<workPolygon.count(); j++) {
-            if (_dp(workPolygon[0], workPolygon[j]) > angle) {
-                _swapPoints(workPolygon, i, j);
-                angle = _dp(workPolygon[0], workPolygon[j]);
-            }
-        }
+        simpleGridPoints.append(QVariant::fromValue(rgTransectSegments[i].first()));
+        simpleGridPoints.append(QVariant::fromValue(rgTransectSegments[i].last()));
     }
-
-    // Perform the the Graham scan
-
-    workPolygon.insert(0, workPolygon.last());  // Sentinel for algo stop
-    int convexCount = 1;                        // Number of points on the convex hull.
-
-    for (int i=2; i<=polygon.count(); i++) {
-        while (_ccw(workPolygon[convexCount-1], workPolygon[convexCount], workPolygon[i]) <= 0) {
-            if (convexCount > 1) {
-                convexCount -= 1;
-            } else if (i == polygon.count()) {
-                break;
-            } else {
-                i++;
-            }
-        }
-        convexCount++;
-        _swapPoints(workPolygon, convexCount, i);
-    }
-
-    return workPolygon.mid(1, convexCount);
 }
 
 /// Returns true if the current grid angle generates north/south oriented transects
@@ -609,13 +564,12 @@ bool SurveyMissionItem::_gridAngleIsNorthSouthTransects()
     return gridAngle < 45.0 || (gridAngle > 360.0 - 45.0) || (gridAngle > 90.0 + 45.0 && gridAngle < 270.0 - 45.0);
 }
 
-void SurveyMissionItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects)
+void SurveyMissionItem::_adjustTransectsToEntryPointLocation(int entryLocation, QList<QList<QGeoCoordinate>>& transects)
 {
     if (transects.count() == 0) {
         return;
     }
 
-    int entryLocation = _gridEntryLocationFact.rawValue().toInt();
     bool reversePoints = false;
     bool reverseTransects = false;
 
@@ -644,25 +598,113 @@ void SurveyMissionItem::_generateGrid(void)
         return;
     }
 
+    if (_generateGridInBackground) {
+        // Coalesce rapid changes such as vertex drags into a single generation
+        _generateGridTimer.start();
+    } else {
+        _generateGridNow();
+    }
+}
+
+/// Generates the grid synchronously, cancelling any outstanding background generation
+void SurveyMissionItem::_generateGridNow(void)
+{
+    _cancelBackgroundGrid();
+
     if (_mapPolygon.count() < 3 || _gridSpacingFact.rawValue().toDouble() <= 0) {
         _clearInternal();
         return;
     }
 
-    _simpleGridPoints.clear();
-    _transectSegments.clear();
-    _reflyTransectSegments.clear();
-    _additionalFlightDelaySeconds = 0;
+    _applyGridResult(generateGrid(_gridParams()));
+}
+
+void SurveyMissionItem::_startBackgroundGrid(void)
+{
+    _cancelBackgroundGrid();
+
+    if (_mapPolygon.count() < 3 || _gridSpacingFact.rawValue().toDouble() <= 0) {
+        _clearInternal();
+        return;
+    }
+
+    QSharedPointer<QAtomicInt>  cancelled(new QAtomicInt(0));
+    GridParams_t                params = _gridParams();
+
+    _gridCancelled = cancelled;
+    _gridFutureWatcher.setFuture(QtConcurrent::run([params, cancelled]() {
+        return generateGrid(params, cancelled.data());
+    }));
+}
+
+void SurveyMissionItem::_backgroundGridFinished(void)
+{
+    if (_gridCancelled.isNull()) {
+        // Generation was cancelled after it completed, results are stale
+        return;
+    }
+    _gridCancelled.clear();
+
+    GridResult_t result = _gridFutureWatcher.result();
+    if (result.valid) {
+        _applyGridResult(result);
+    }
+}
+
+void SurveyMissionItem::_cancelBackgroundGrid(void)
+{
+    _generateGridTimer.stop();
+    if (!_gridCancelled.isNull()) {
+        _gridCancelled->storeRelease(1);
+        _gridCancelled.clear();
+    }
+}
+
+void SurveyMissionItem::setGenerateGridInBackground(bool generateGridInBackground)
+{
+    if (_generateGridInBackground != generateGridInBackground) {
+        if (!generateGridInBackground && gridGenerationPending()) {
+            _generateGridNow();
+        }
+        _generateGridInBackground = generateGridInBackground;
+    }
+}
+
+SurveyMissionItem::GridParams_t SurveyMissionItem::_gridParams(void) const
+{
+    GridParams_t params;
+
+    params.polygon =            _mapPolygon.coordinateList();
+    params.gridAngle =          _gridAngleFact.rawValue().toDouble();
+    params.gridSpacing =        _gridSpacingFact.rawValue().toDouble();
+    params.gridEntryLocation =  _gridEntryLocationFact.rawValue().toInt();
+    params.turnaroundDistance = _turnaroundDistance();
+    params.triggerDistance =    _triggerDistance();
+    params.imagesEverywhere =   _imagesEverywhere();
+    params.hoverAndCapture =    _hoverAndCaptureEnabled();
+    params.refly90Degrees =     _refly90Degrees;
+
+    return params;
+}
+
+SurveyMissionItem::GridResult_t SurveyMissionItem::generateGrid(const GridParams_t& params, const QAtomicInt* cancelled)
+{
+    GridResult_t result;
+
+    result.valid =          false;
+    result.coveredArea =    0;
+    result.surveyDistance = 0;
+    result.cameraShots =    0;
 
     QList<QPointF>          polygonPoints;
     QList<QList<QPointF>>   transectSegments;
 
     // Convert polygon to NED
-    QGeoCoordinate tangentOrigin = _mapPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
+    QGeoCoordinate tangentOrigin = params.polygon[0];
     qCDebug(SurveyMissionItemLog) << "Convert polygon to NED - tangentOrigin" << tangentOrigin;
-    for (int i=0; i<_mapPolygon.count(); i++) {
+    for (int i=0; i<params.polygon.count(); i++) {
         double y, x, down;
-        QGeoCoordinate vertex = _mapPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
+        const QGeoCoordinate& vertex = params.polygon[i];
         if (i == 0) {
             // This avoids a nan calculation that comes out of convertGeoToNed
             x = y = 0;
@@ -673,8 +715,6 @@ void SurveyMissionItem::_generateGrid(void)
         qCDebug(SurveyMissionItemLog) << "vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
     }
 
-    polygonPoints = _convexPolygon(polygonPoints);
-
     double coveredArea = 0.0;
     for (int i=0; i<polygonPoints.count(); i++) {
         if (i != 0) {
@@ -683,42 +723,71 @@ void SurveyMissionItem::_generateGrid(void)
             coveredArea += polygonPoints.last().x() * polygonPoints[i].y() - polygonPoints[i].x() * polygonPoints.last().y();
         }
     }
-    _setCoveredArea(0.5 * fabs(coveredArea));
+    result.coveredArea = 0.5 * fabs(coveredArea);
 
     // Generate grid
     int cameraShots = 0;
-    cameraShots += _gridGenerator(polygonPoints, transectSegments, false /* refly */);
-    _convertTransectToGeo(transectSegments, tangentOrigin, _transectSegments);
-    _adjustTransectsToEntryPointLocation(_transectSegments);
-    _appendGridPointsFromTransects(_transectSegments);
-    if (_refly90Degrees) {
-        QVariantList reflyPointsGeo;
-
+    bool splitTransects;
+    cameraShots += _gridGenerator(params, polygonPoints, transectSegments, false /* refly */, splitTransects, cancelled);
+    if (cancelled && cancelled->loadAcquire()) {
+        return result;
+    }
+    _convertTransectToGeo(transectSegments, tangentOrigin, result.transectSegments);
+    _adjustTransectsToEntryPointLocation(params.gridEntryLocation, result.transectSegments);
+    // Transects split by a concave polygon can leave long dead legs in the simple back and forth ordering. Without a split
+    // the back and forth ordering is already the shortest.
+    if (splitTransects) {
+        TransectRouteOptimizer::optimize(QGeoCoordinate(), result.transectSegments, _routeOptimizeMaxEvaluations);
+    }
+    _appendGridPointsFromTransects(result.transectSegments, result.simpleGridPoints);
+    if (params.refly90Degrees) {
         transectSegments.clear();
-        cameraShots += _gridGenerator(polygonPoints, transectSegments, true /* refly */);
-        _convertTransectToGeo(transectSegments, tangentOrigin, _reflyTransectSegments);
-        _optimizeTransectsForShortestDistance(_transectSegments.last().last(), _reflyTransectSegments);
-        _appendGridPointsFromTransects(_reflyTransectSegments);
+        cameraShots += _gridGenerator(params, polygonPoints, transectSegments, true /* refly */, splitTransects, cancelled);
+        if (cancelled && cancelled->loadAcquire()) {
+            return result;
+        }
+        _convertTransectToGeo(transectSegments, tangentOrigin, result.reflyTransectSegments);
+        _optimizeTransectsForShortestDistance(result.transectSegments.last().last(), result.reflyTransectSegments);
+        if (splitTransects) {
+            TransectRouteOptimizer::optimize(result.transectSegments.last().last(), result.reflyTransectSegments, _routeOptimizeMaxEvaluations);
+        }
+        _appendGridPointsFromTransects(result.reflyTransectSegments, result.simpleGridPoints);
     }
 
     // Calc survey distance
     double surveyDistance = 0.0;
-    for (int i=1; i<_simpleGridPoints.count(); i++) {
-        QGeoCoordinate coord1 = _simpleGridPoints[i-1].value<QGeoCoordinate>();
-        QGeoCoordinate coord2 = _simpleGridPoints[i].value<QGeoCoordinate>();
+    for (int i=1; i<result.simpleGridPoints.count(); i++) {
+        QGeoCoordinate coord1 = result.simpleGridPoints[i-1].value<QGeoCoordinate>();
+        QGeoCoordinate coord2 = result.simpleGridPoints[i].value<QGeoCoordinate>();
         surveyDistance += coord1.distanceTo(coord2);
     }
-    _setSurveyDistance(surveyDistance);
+    result.surveyDistance = surveyDistance;
 
-    if (cameraShots == 0 && _triggerCamera()) {
-        cameraShots = (int)floor(surveyDistance / _triggerDistance());
+    if (cameraShots == 0 && params.triggerDistance > 0) {
+        cameraShots = (int)floor(surveyDistance / params.triggerDistance);
         // Take into account immediate camera trigger at waypoint entry
         cameraShots++;
     }
-    _setCameraShots(cameraShots);
+    result.cameraShots = cameraShots;
+    result.valid = true;
+
+    return result;
+}
+
+/// Swaps in newly generated grid results and updates everything which depends on them
+void SurveyMissionItem::_applyGridResult(const GridResult_t& result)
+{
+    _simpleGridPoints =         result.simpleGridPoints;
+    _transectSegments =         result.transectSegments;
+    _reflyTransectSegments =    result.reflyTransectSegments;
+    _additionalFlightDelaySeconds = 0;
+
+    _setCoveredArea(result.coveredArea);
+    _setSurveyDistance(result.surveyDistance);
+    _setCameraShots(result.cameraShots);
 
     if (_hoverAndCaptureEnabled()) {
-        _additionalFlightDelaySeconds = cameraShots * _hoverAndCaptureDelaySeconds;
+        _additionalFlightDelaySeconds = result.cameraShots * _hoverAndCaptureDelaySeconds;
     }
     emit additionalTimeDelayChanged(_additionalFlightDelaySeconds);
 
@@ -830,58 +899,6 @@ void SurveyMissionItem::_intersectLinesWithRect(const QList<QLineF>& lineList, c
     }
 }
 
-void SurveyMissionItem::_intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines)
-{
-    resultLines.clear();
-    for (int i=0; i<lineList.count(); i++) {
-        int foundCount = 0;
-        QLineF intersectLine;
-        const QLineF& line = lineList[i];
-
-        for (int j=0; j<polygon.count()-1; j++) {
-            QPointF intersectPoint;
-            QLineF polygonLine = QLineF(polygon[j], polygon[j+1]);
-            if (line.intersect(polygonLine, &intersectPoint) == QLineF::BoundedIntersection) {
-                if (foundCount == 0) {
-                    foundCount++;
-                    intersectLine.setP1(intersectPoint);
-                } else {
-                    foundCount++;
-                    intersectLine.setP2(intersectPoint);
-                    break;
-                }
-            }
-        }
-
-        if (foundCount == 2) {
-            resultLines += intersectLine;
-        }
-    }
-}
-
-/// Adjust the line segments such that they are all going the same direction with respect to going from P1->P2
-void SurveyMissionItem::_adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines)
-{
-    qreal firstAngle = 0;
-    for (int i=0; i<lineList.count(); i++) {
-        const QLineF& line = lineList[i];
-        QLineF adjustedLine;
-
-        if (i == 0) {
-            firstAngle = line.angle();
-        }
-
-        if (qAbs(line.angle() - firstAngle) > 1.0) {
-            adjustedLine.setP1(line.p2());
-            adjustedLine.setP2(line.p1());
-        } else {
-            adjustedLine = line;
-        }
-
-        resultLines += adjustedLine;
-    }
-}
-
 double SurveyMissionItem::_clampGridAngle90(double gridAngle)
 {
     // Clamp grid angle to -90<->90. This prevents transects from being rotated to a reversed order.
@@ -893,12 +910,14 @@ double SurveyMissionItem::_clampGridAngle90(double gridAngle)
     return gridAngle;
 }
 
-int SurveyMissionItem::_gridGenerator(const QList<QPointF>& polygonPoints,  QList<QList<QPointF>>& transectSegments, bool refly)
+int SurveyMissionItem::_gridGenerator(const GridParams_t& params, const QList<QPointF>& polygonPoints,  QList<QList<QPointF>>& transectSegments, bool refly, bool& splitTransects, const QAtomicInt* cancelled)
 {
     int cameraShots = 0;
 
-    double gridAngle = _gridAngleFact.rawValue().toDouble();
-    double gridSpacing = _gridSpacingFact.rawValue().toDouble();
+    splitTransects = false;
+
+    double gridAngle = params.gridAngle;
+    double gridSpacing = params.gridSpacing;
 
     gridAngle = _clampGridAngle90(gridAngle);
     gridAngle += refly ? 90 : 0;
@@ -941,39 +960,61 @@ int SurveyMissionItem::_gridGenerator(const QList<QPointF>& polygonPoints,  QLis
         transectX += gridSpacing;
     }
 
-    // Now intersect the lines with the polygon
-    QList<QLineF> intersectLines;
-#if 1
-    _intersectLinesWithPolygon(lineList, polygon, intersectLines);
-#else
-    // This is handy for debugging grid problems, not for release
-    intersectLines = lineList;
-#endif
+    // Now clip the lines against the polygon. Lines crossing a concave part of the polygon produce multiple segments.
+    QList<QList<QLineF>> clippedLines;
+    PolygonLineClipper::clipParallelLines(lineList, polygon, clippedLines);
+
+    int intersectCount = 0;
+    for (int i=0; i<clippedLines.count(); i++) {
+        if (clippedLines[i].count()) {
+            intersectCount++;
+        }
+    }
 
     // Less than two transects intersected with the polygon:
     //      Create a single transect which goes through the center of the polygon
     //      Intersect it with the polygon
-    if (intersectLines.count() < 2) {
-        _mapPolygon.center();
+    if (intersectCount < 2) {
         QLineF firstLine = lineList.first();
         QPointF lineCenter = firstLine.pointAt(0.5);
         QPointF centerOffset = boundingCenter - lineCenter;
         firstLine.translate(centerOffset);
         lineList.clear();
         lineList.append(firstLine);
-        intersectLines = lineList;
-        _intersectLinesWithPolygon(lineList, polygon, intersectLines);
+        PolygonLineClipper::clipParallelLines(lineList, polygon, clippedLines);
     }
 
-    // Make sure all lines are going to same direction. Polygon intersection leads to line which
-    // can be in varied directions depending on the order of the intesecting sides.
+    // Alternate the direction of each transect line so the vehicle flies back and forth. The segments of a line
+    // which was split by the polygon are flown in order along the line.
     QList<QLineF> resultLines;
-    _adjustLineDirection(intersectLines, resultLines);
+    bool reverseLine = false;
+    for (int i=0; i<clippedLines.count(); i++) {
+        const QList<QLineF>& segments = clippedLines[i];
+
+        if (segments.isEmpty()) {
+            continue;
+        }
+        if (segments.count() > 1) {
+            splitTransects = true;
+        }
+        for (int j=0; j<segments.count(); j++) {
+            if (reverseLine) {
+                const QLineF& segment = segments[segments.count() - 1 - j];
+                resultLines.append(QLineF(segment.p2(), segment.p1()));
+            } else {
+                resultLines.append(segments[j]);
+            }
+        }
+        reverseLine = !reverseLine;
+    }
+
+    bool triggerCamera = params.triggerDistance > 0;
+    bool hasTurnaround = params.turnaroundDistance > 0;
 
     // Calc camera shots here if there are no images in turnaround
-    if (_triggerCamera() && !_imagesEverywhere()) {
+    if (triggerCamera && !params.imagesEverywhere) {
         for (int i=0; i<resultLines.count(); i++) {
-            cameraShots += (int)floor(resultLines[i].length() / _triggerDistance());
+            cameraShots += (int)floor(resultLines[i].length() / params.triggerDistance);
             // Take into account immediate camera trigger at waypoint entry
             cameraShots++;
         }
@@ -981,21 +1022,18 @@ int SurveyMissionItem::_gridGenerator(const QList<QPointF>& polygonPoints,  QLis
 
     // Turn into a path
     for (int i=0; i<resultLines.count(); i++) {
-        QLineF          transectLine;
         QList<QPointF>  transectPoints;
-        const QLineF&   line = resultLines[i];
-
-        float turnaroundPosition = _turnaroundDistance() / line.length();
+        const QLineF&   transectLine = resultLines[i];
 
-        if (i & 1) {
-            transectLine = QLineF(line.p2(), line.p1());
-        } else {
-            transectLine = QLineF(line.p1(), line.p2());
+        if (cancelled && cancelled->loadAcquire()) {
+            break;
         }
 
+        float turnaroundPosition = params.turnaroundDistance / transectLine.length();
+
         // Build the points along the transect
 
-        if (_hasTurnaround()) {
+        if (hasTurnaround) {
             transectPoints.append(transectLine.pointAt(-turnaroundPosition));
         }
 
@@ -1003,11 +1041,11 @@ int SurveyMissionItem::_gridGenerator(const QList<QPointF>& polygonPoints,  QLis
         transectPoints.append(transectLine.p1());
 
         // For hover and capture we need points for each camera location
-        if (_triggerCamera() && _hoverAndCaptureEnabled()) {
-            if (_triggerDistance() < transectLine.length()) {
-                int innerPoints = floor(transectLine.length() / _triggerDistance());
+        if (triggerCamera && params.hoverAndCapture) {
+            if (params.triggerDistance < transectLine.length()) {
+                int innerPoints = floor(transectLine.length() / params.triggerDistance);
                 qCDebug(SurveyMissionItemLog) << "innerPoints" << innerPoints;
-                float transectPositionIncrement = _triggerDistance() / transectLine.length();
+                float transectPositionIncrement = params.triggerDistance / transectLine.length();
                 for (int i=0; i<innerPoints; i++) {
                     transectPoints.append(transectLine.pointAt(transectPositionIncrement * (i + 1)));
                 }
@@ -1017,7 +1055,7 @@ int SurveyMissionItem::_gridGenerator(const QList<QPointF>& polygonPoints,  QLis
         // Polygon exit point
         transectPoints.append(transectLine.p2());
 
-        if (_hasTurnaround()) {
+        if (hasTurnaround) {
             transectPoints.append(transectLine.pointAt(1 + turnaroundPosition));
         }
 
@@ -1202,6 +1240,10 @@ bool SurveyMissionItem::_appendMissionItemsWorker(QList<MissionItem*>& items, QO
 
 void SurveyMissionItem::appendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent)
 {
+    if (gridGenerationPending()) {
+        _generateGridNow();
+    }
+
     int seqNum = _sequenceNumber;
 
     if (!_appendMissionItemsWorker(items, missionItemParent, seqNum, _refly90Degrees, false /* buildRefly */)) {
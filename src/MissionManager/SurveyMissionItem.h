@@ -17,6 +17,11 @@
 #include "QGCLoggingCategory.h"
 #include "QGCMapPolygon.h"
 
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QTimer>
+
 Q_DECLARE_LOGGING_CATEGORY(SurveyMissionItemLog)
 
 class SurveyMissionItem : public ComplexMissionItem
@@ -25,6 +30,7 @@ class SurveyMissionItem : public ComplexMissionItem
 
 public:
     SurveyMissionItem(Vehicle* vehicle, QObject* parent = NULL);
+    ~SurveyMissionItem();
 
     Q_PROPERTY(Fact*                gridAltitude                READ gridAltitude                   CONSTANT)
     Q_PROPERTY(Fact*                gridAltitudeRelative        READ gridAltitudeRelative           CONSTANT)
@@ -93,6 +99,42 @@ public:
 
     void setRefly90Degrees(bool refly90Degrees);
 
+    /// Inputs to grid generation. Captured on the gui thread so the grid can be generated on a worker thread.
+    typedef struct {
+        QList<QGeoCoordinate>   polygon;
+        double                  gridAngle;
+        double                  gridSpacing;
+        int                     gridEntryLocation;
+        double                  turnaroundDistance;
+        double                  triggerDistance;
+        bool                    imagesEverywhere;
+        bool                    hoverAndCapture;        ///< true: hover and capture is enabled
+        bool                    refly90Degrees;
+    } GridParams_t;
+
+    /// Output from grid generation
+    typedef struct {
+        bool                            valid;          ///< false: generation was cancelled
+        QVariantList                    simpleGridPoints;
+        QList<QList<QGeoCoordinate>>    transectSegments;
+        QList<QList<QGeoCoordinate>>    reflyTransectSegments;
+        double                          coveredArea;
+        double                          surveyDistance;
+        int                             cameraShots;
+    } GridResult_t;
+
+    /// Generates the grid for the specified inputs. Does not touch any item state so it is safe to call from any thread.
+    ///     @param cancelled Generation stops early with an invalid result if this is set non-zero, NULL for not cancellable
+    static GridResult_t generateGrid(const GridParams_t& params, const QAtomicInt* cancelled = NULL);
+
+    /// When enabled, polygon and grid value changes are coalesced and the grid is regenerated on a worker thread. The
+    /// previous grid stays visible until the new one is complete. Stale generations are cancelled.
+    void setGenerateGridInBackground(bool generateGridInBackground);
+    bool generateGridInBackground   (void) const { return _generateGridInBackground; }
+
+    /// @return true: A background grid generation is queued or running
+    bool gridGenerationPending(void) const { return _generateGridTimer.isActive() || !_gridCancelled.isNull(); }
+
     // Overrides from ComplexMissionItem
 
     double              complexDistance     (void) const final { return _surveyDistance; }
@@ -180,6 +222,8 @@ private slots:
     void _setDirty(void);
     void _polygonDirtyChanged(bool dirty);
     void _clearInternal(void);
+    void _startBackgroundGrid(void);
+    void _backgroundGridFinished(void);
 
 private:
     enum CameraTriggerCode {
@@ -191,12 +235,14 @@ private:
 
     void _setExitCoordinate(const QGeoCoordinate& coordinate);
     void _generateGrid(void);
+    void _generateGridNow(void);
+    void _cancelBackgroundGrid(void);
+    GridParams_t _gridParams(void) const;
+    void _applyGridResult(const GridResult_t& result);
     void _updateCoordinateAltitude(void);
-    int _gridGenerator(const QList<QPointF>& polygonPoints, QList<QList<QPointF>>& transectSegments, bool refly);
-    QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
+    static int _gridGenerator(const GridParams_t& params, const QList<QPointF>& polygonPoints, QList<QList<QPointF>>& transectSegments, bool refly, bool& splitTransects, const QAtomicInt* cancelled);
+    static QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
     void _intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines);
-    void _intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
-    void _adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines);
     void _setSurveyDistance(double surveyDistance);
     void _setCameraShots(int cameraShots);
     void _setCoveredArea(double coveredArea);
@@ -209,19 +255,15 @@ private:
     bool _hoverAndCaptureEnabled(void) const;
     bool _hasTurnaround(void) const;
     double _turnaroundDistance(void) const;
-    void _convertTransectToGeo(const QList<QList<QPointF>>& transectSegmentsNED, const QGeoCoordinate& tangentOrigin, QList<QList<QGeoCoordinate>>& transectSegmentsGeo);
+    static void _convertTransectToGeo(const QList<QList<QPointF>>& transectSegmentsNED, const QGeoCoordinate& tangentOrigin, QList<QList<QGeoCoordinate>>& transectSegmentsGeo);
     bool _appendMissionItemsWorker(QList<MissionItem*>& items, QObject* missionItemParent, int& seqNum, bool hasRefly, bool buildRefly);
-    void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
-    void _appendGridPointsFromTransects(QList<QList<QGeoCoordinate>>& rgTransectSegments);
-    qreal _ccw(QPointF pt1, QPointF pt2, QPointF pt3);
-    qreal _dp(QPointF pt1, QPointF pt2);
-    void _swapPoints(QList<QPointF>& points, int index1, int index2);
-    QList<QPointF> _convexPolygon(const QList<QPointF>& polygon);
-    void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
-    void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
-    void _adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects);
+    static void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
+    static void _appendGridPointsFromTransects(QList<QList<QGeoCoordinate>>& rgTransectSegments, QVariantList& simpleGridPoints);
+    static void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
+    static void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
+    static void _adjustTransectsToEntryPointLocation(int entryLocation, QList<QList<QGeoCoordinate>>& transects);
     bool _gridAngleIsNorthSouthTransects();
-    double _clampGridAngle90(double gridAngle);
+    static double _clampGridAngle90(double gridAngle);
 
     int                             _sequenceNumber;
     bool                            _dirty;
@@ -244,6 +286,11 @@ private:
     double          _timeBetweenShots;
     double          _cruiseSpeed;
 
+    bool                                _generateGridInBackground;
+    QTimer                              _generateGridTimer;     ///< Coalesces rapid changes into a single background generation
+    QFutureWatcher<GridResult_t>        _gridFutureWatcher;
+    QSharedPointer<QAtomicInt>          _gridCancelled;         ///< Cancel flag for the running background generation, NULL if none running
+
     QMap<QString, FactMetaData*> _metaDataMap;
 
     SettingsFact    _manualGridFact;
@@ -295,6 +342,8 @@ private:
     static const char* _jsonRefly90DegreesKey;
 
     static const int _hoverAndCaptureDelaySeconds = 1;
+    static const int _generateGridCoalesceMsecs = 25;
+    static const int _routeOptimizeMaxEvaluations = 100000;
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include "SurveyMissionItemTest.h"
 #include "QGCApplication.h"
 
+
 SurveyMissionItemTest::SurveyMissionItemTest(void)
     : _offlineVehicle(NULL)
 {
@@ -251,3 +252,92 @@ void SurveyMissionItemTest::_testEntryLocation(void)
         rgSeenEntryCoords.clear();
     }
 }
+
+void SurveyMissionItemTest::_testBackgroundGrid(void)
+{
+    QGCMapPolygon* mapPolygon = _surveyItem->mapPolygon();
+
+    for (int i=0; i<_polyPoints.count(); i++) {
+        mapPolygon->appendVertex(_polyPoints[i]);
+    }
+    QVERIFY(_surveyItem->gridPoints().count() > 0);
+    QGeoCoordinate syncEntryCoord = _surveyItem->coordinate();
+
+    _surveyItem->setGenerateGridInBackground(true);
+    _multiSpy->clearAllSignals();
+
+    // A burst of changes should be coalesced into a single generation, previous grid stays until it completes
+    for (int i=1; i<=10; i++) {
+        _surveyItem->gridAngle()->setRawValue(i * 5);
+    }
+    QVERIFY(_surveyItem->gridGenerationPending());
+    QCOMPARE(_surveyItem->coordinate(), syncEntryCoord);
+    QVERIFY(_multiSpy->checkNoSignalByMask(gridPointsChangedMask));
+
+    QVERIFY(_multiSpy->waitForSignalByIndex(gridPointsChangedIndex, 10000));
+    QVERIFY(!_surveyItem->gridGenerationPending());
+    QCOMPARE(_multiSpy->getSpyByIndex(gridPointsChangedIndex)->count(), 1);
+    QVERIFY(_surveyItem->coordinate() != syncEntryCoord);
+
+    // Background results must match synchronous generation for the same inputs
+    QGeoCoordinate  backgroundEntryCoord = _surveyItem->coordinate();
+    QGeoCoordinate  backgroundExitCoord = _surveyItem->exitCoordinate();
+    int             backgroundPointCount = _surveyItem->gridPoints().count();
+    _surveyItem->setGenerateGridInBackground(false);
+    _surveyItem->gridAngle()->setRawValue(0);
+    _surveyItem->gridAngle()->setRawValue(50);
+    QCOMPARE(_surveyItem->coordinate(), backgroundEntryCoord);
+    QCOMPARE(_surveyItem->exitCoordinate(), backgroundExitCoord);
+    QCOMPARE(_surveyItem->gridPoints().count(), backgroundPointCount);
+
+    // Pending generation is flushed when mission items are requested
+    _surveyItem->setGenerateGridInBackground(true);
+    _surveyItem->gridAngle()->setRawValue(20);
+    QVERIFY(_surveyItem->gridGenerationPending());
+    QList<MissionItem*> items;
+    _surveyItem->appendMissionItems(items, this);
+    QVERIFY(!_surveyItem->gridGenerationPending());
+    QVERIFY(_surveyItem->coordinate() != backgroundEntryCoord);
+    qDeleteAll(items);
+}
+
+/// Generates grids for a range of polygon sizes and grid spacings. Also validates cancellation.
+void SurveyMissionItemTest::_testGridGenerationBenchmark(void)
+{
+    QList<int>      rgVertexCounts;
+    QList<double>   rgGridSpacings;
+
+    rgVertexCounts << 4 << 50 << 500;
+    rgGridSpacings << 50 << 10 << 2;
+
+    SurveyMissionItem::GridParams_t params;
+    params.gridAngle =          30;
+    params.gridEntryLocation =  SurveyMissionItem::EntryLocationTopLeft;
+    params.turnaroundDistance = 10;
+    params.triggerDistance =    25;
+    params.imagesEverywhere =   false;
+    params.hoverAndCapture =    false;
+    params.refly90Degrees =     false;
+
+    QGeoCoordinate  center(47.633550640000003, -122.08982199);
+
+    foreach (int vertexCount, rgVertexCounts) {
+        params.polygon.clear();
+        for (int i=0; i<vertexCount; i++) {
+            params.polygon.append(center.atDistanceAndAzimuth(1000, (360.0 / vertexCount) * i));
+        }
+
+        foreach (double gridSpacing, rgGridSpacings) {
+            params.gridSpacing = gridSpacing;
+
+            SurveyMissionItem::GridResult_t result = SurveyMissionItem::generateGrid(params);
+
+            QVERIFY(result.valid);
+            QVERIFY(result.transectSegments.count() > 0);
+        }
+    }
+
+    QAtomicInt cancelled(1);
+    SurveyMissionItem::GridResult_t result = SurveyMissionItem::generateGrid(params, &cancelled);
+    QVERIFY(!result.valid);
+}
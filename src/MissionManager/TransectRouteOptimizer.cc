@@ -0,0 +1,270 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TransectRouteOptimizer.h"
+#include "QGCGeo.h"
+
+#include <QtMath>
+
+QGC_LOGGING_CATEGORY(TransectRouteOptimizerLog, "TransectRouteOptimizerLog")
+
+const double TransectRouteOptimizer::_minImprovement = 1.0;
+
+TransectRouteOptimizer::TransectRouteOptimizer(const QPointF& start, const QVector<QPointF>& entryPoints, const QVector<QPointF>& exitPoints, bool fixFirst)
+    : _start        (start)
+    , _entryPoints  (entryPoints)
+    , _exitPoints   (exitPoints)
+    , _fixFirst     (fixFirst)
+{
+
+}
+
+double TransectRouteOptimizer::_distance(const QPointF& point1, const QPointF& point2)
+{
+    return qSqrt(((point2.x() - point1.x()) * (point2.x() - point1.x())) + ((point2.y() - point1.y()) * (point2.y() - point1.y())));
+}
+
+double TransectRouteOptimizer::_routeDistance(const Route_t& route) const
+{
+    double distance = 0;
+
+    for (int i=0; i<route.order.count(); i++) {
+        distance += _distance(_prevOut(route, i), _in(route, i));
+    }
+
+    return distance;
+}
+
+void TransectRouteOptimizer::_nearestNeighbor(Route_t& route) const
+{
+    int             count = _entryPoints.count();
+    QVector<bool>   visited(count, false);
+    QPointF         current = _start;
+
+    route.order.clear();
+    route.reversed.clear();
+
+    if (_fixFirst) {
+        route.order.append(0);
+        route.reversed.append(false);
+        visited[0] = true;
+        current = _exitPoints[0];
+    }
+
+    while (route.order.count() < count) {
+        int     nearestIndex =      -1;
+        bool    nearestReversed =   false;
+        double  nearestDistance =   0;
+
+        for (int i=0; i<count; i++) {
+            if (visited[i]) {
+                continue;
+            }
+            double entryDistance =  _distance(current, _entryPoints[i]);
+            double exitDistance =   _distance(current, _exitPoints[i]);
+            if (nearestIndex == -1 || entryDistance < nearestDistance) {
+                nearestIndex =      i;
+                nearestReversed =   false;
+                nearestDistance =   entryDistance;
+            }
+            if (exitDistance < nearestDistance) {
+                nearestIndex =      i;
+                nearestReversed =   true;
+                nearestDistance =   exitDistance;
+            }
+        }
+
+        route.order.append(nearestIndex);
+        route.reversed.append(nearestReversed);
+        visited[nearestIndex] = true;
+        current = nearestReversed ? _entryPoints[nearestIndex] : _exitPoints[nearestIndex];
+    }
+}
+
+/// Reverses runs of transects (flipping the direction of each) where that shortens the route
+///     @return true: route was improved
+bool TransectRouteOptimizer::_twoOptPass(Route_t& route, int& evaluationsLeft) const
+{
+    int     count =     route.order.count();
+    bool    improved =  false;
+
+    for (int i=_fixFirst ? 1 : 0; i<count - 1 && evaluationsLeft > 0; i++) {
+        for (int j=i+1; j<count && evaluationsLeft > 0; j++, evaluationsLeft--) {
+            const QPointF& prevOut = _prevOut(route, i);
+
+            double before = _distance(prevOut, _in(route, i));
+            double after =  _distance(prevOut, _out(route, j));
+            if (j + 1 < count) {
+                before +=   _distance(_out(route, j), _in(route, j + 1));
+                after +=    _distance(_in(route, i), _in(route, j + 1));
+            }
+
+            if (before - after > _minImprovement) {
+                for (int low=i, high=j; low<=high; low++, high--) {
+                    int     lowOrder =      route.order[low];
+                    bool    lowReversed =   route.reversed[low];
+
+                    route.order[low] =      route.order[high];
+                    route.reversed[low] =   !route.reversed[high];
+                    route.order[high] =     lowOrder;
+                    route.reversed[high] =  !lowReversed;
+                }
+                improved = true;
+            }
+        }
+    }
+
+    return improved;
+}
+
+/// Moves single transects to a different position in the route, in either direction, where that shortens the route
+///     @return true: route was improved
+bool TransectRouteOptimizer::_orOptPass(Route_t& route, int& evaluationsLeft) const
+{
+    int     count =     route.order.count();
+    int     first =     _fixFirst ? 1 : 0;
+    bool    improved =  false;
+
+    for (int k=first; k<count && evaluationsLeft > 0; k++) {
+        // Distance saved by removing the transect from its current position
+        double removeGain = _distance(_prevOut(route, k), _in(route, k));
+        if (k + 1 < count) {
+            removeGain += _distance(_out(route, k), _in(route, k + 1)) - _distance(_prevOut(route, k), _in(route, k + 1));
+        }
+
+        int     transectIndex = route.order[k];
+        int     bestPosition =  -1;
+        bool    bestReversed =  false;
+        double  bestGain =      _minImprovement;
+
+        // Try inserting in front of each other position. Positions k and k + 1 are where the transect already is, skipping
+        // them also means neither neighbor of an insert position is the transect being moved.
+        for (int q=first; q<=count; q++) {
+            if (q == k || q == k + 1) {
+                continue;
+            }
+            evaluationsLeft--;
+
+            const QPointF&  prevOut = _prevOut(route, q);
+            bool            hasNext = q < count;
+
+            for (int reversed=0; reversed<2; reversed++) {
+                const QPointF& in =     reversed ? _exitPoints[transectIndex] : _entryPoints[transectIndex];
+                const QPointF& out =    reversed ? _entryPoints[transectIndex] : _exitPoints[transectIndex];
+
+                double insertCost = _distance(prevOut, in);
+                if (hasNext) {
+                    insertCost += _distance(out, _in(route, q)) - _distance(prevOut, _in(route, q));
+                }
+
+                double gain = removeGain - insertCost;
+                if (gain > bestGain) {
+                    bestGain =      gain;
+                    bestPosition =  q;
+                    bestReversed =  reversed;
+                }
+            }
+        }
+
+        if (bestPosition != -1) {
+            route.order.remove(k);
+            route.reversed.remove(k);
+            int insertPosition = bestPosition > k ? bestPosition - 1 : bestPosition;
+            route.order.insert(insertPosition, transectIndex);
+            route.reversed.insert(insertPosition, bestReversed);
+            improved = true;
+        }
+    }
+
+    return improved;
+}
+
+TransectRouteOptimizer::Stats_t TransectRouteOptimizer::optimize(const QGeoCoordinate& startCoord, QList<QList<QGeoCoordinate>>& transects, int maxEvaluations)
+{
+    QElapsedTimer   timer;
+    Stats_t         stats;
+
+    timer.start();
+    stats.originalDistance =    0;
+    stats.optimizedDistance =   0;
+    stats.elapsedMsecs =        0;
+    stats.evaluations =         0;
+    stats.changed =             false;
+
+    if (transects.count() < 2) {
+        return stats;
+    }
+
+    // Work in a local tangent plane so distance calculations are cheap
+    QGeoCoordinate      tangentOrigin = transects.first().first();
+    QVector<QPointF>    entryPoints;
+    QVector<QPointF>    exitPoints;
+    for (int i=0; i<transects.count(); i++) {
+        double x, y, z;
+
+        convertGeoToNed(transects[i].first(), tangentOrigin, &x, &y, &z);
+        entryPoints.append(QPointF(x, y));
+        convertGeoToNed(transects[i].last(), tangentOrigin, &x, &y, &z);
+        exitPoints.append(QPointF(x, y));
+    }
+
+    bool    fixFirst = !startCoord.isValid();
+    QPointF start;
+    if (fixFirst) {
+        start = entryPoints.first();
+    } else {
+        double x, y, z;
+        convertGeoToNed(startCoord, tangentOrigin, &x, &y, &z);
+        start = QPointF(x, y);
+    }
+
+    TransectRouteOptimizer optimizer(start, entryPoints, exitPoints, fixFirst);
+
+    Route_t originalRoute;
+    for (int i=0; i<transects.count(); i++) {
+        originalRoute.order.append(i);
+        originalRoute.reversed.append(false);
+    }
+    stats.originalDistance = optimizer._routeDistance(originalRoute);
+
+    Route_t route;
+    optimizer._nearestNeighbor(route);
+
+    bool    improved =          true;
+    int     evaluationsLeft =   maxEvaluations;
+    while (improved && evaluationsLeft > 0) {
+        improved = optimizer._twoOptPass(route, evaluationsLeft);
+        improved |= optimizer._orOptPass(route, evaluationsLeft);
+    }
+    stats.evaluations = maxEvaluations - qMax(evaluationsLeft, 0);
+    stats.optimizedDistance = optimizer._routeDistance(route);
+
+    if (stats.originalDistance - stats.optimizedDistance > _minImprovement) {
+        QList<QList<QGeoCoordinate>> optimizedTransects;
+
+        for (int i=0; i<route.order.count(); i++) {
+            QList<QGeoCoordinate> transect = transects[route.order[i]];
+            if (route.reversed[i]) {
+                for (int low=0, high=transect.count()-1; low<high; low++, high--) {
+                    transect.swap(low, high);
+                }
+            }
+            optimizedTransects.append(transect);
+        }
+        transects = optimizedTransects;
+        stats.changed = true;
+    } else {
+        stats.optimizedDistance = stats.originalDistance;
+    }
+
+    stats.elapsedMsecs = timer.elapsed();
+    qCDebug(TransectRouteOptimizerLog) << "transects:original:optimized:saved:evaluations:msecs" << transects.count() << stats.originalDistance << stats.optimizedDistance << stats.originalDistance - stats.optimizedDistance << stats.evaluations << stats.elapsedMsecs;
+
+    return stats;
+}
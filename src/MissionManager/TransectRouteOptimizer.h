@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+
+#include <QElapsedTimer>
+#include <QGeoCoordinate>
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+Q_DECLARE_LOGGING_CATEGORY(TransectRouteOptimizerLog)
+
+/// Reorders survey transects to minimize the dead leg distance flown between them.
+///
+/// Each transect can be flown in either direction. An initial route is built by repeatedly flying to the nearest
+/// transect end. The route is then refined with 2-opt (reverse a run of transects) and Or-opt (move a single transect
+/// elsewhere in the route, in either direction) until no further improvement is found or the evaluation budget runs out.
+/// The budget counts candidate moves rather than time, so the result for a given input does not depend on machine load.
+class TransectRouteOptimizer
+{
+public:
+    typedef struct {
+        double  originalDistance;   ///< Dead leg distance between transects prior to optimization
+        double  optimizedDistance;  ///< Dead leg distance between transects after optimization
+        qint64  elapsedMsecs;       ///< Time spent optimizing
+        int     evaluations;        ///< Number of candidate moves evaluated during refinement
+        bool    changed;            ///< true: Transects were reordered
+    } Stats_t;
+
+    /// Optimizes the order and direction of the specified transects. The transects are only changed if the
+    /// optimized route is shorter.
+    ///     @param startCoord Coordinate the vehicle is at prior to flying the transects. If not valid the first
+    ///                       transect and its direction are kept as is.
+    ///     @param transects Transects to reorder, first and last coordinate of each transect are its end points
+    ///     @param maxEvaluations Maximum number of candidate moves to evaluate during refinement
+    static Stats_t optimize(const QGeoCoordinate& startCoord, QList<QList<QGeoCoordinate>>& transects, int maxEvaluations);
+
+private:
+    /// Route through the transects. Transect order[i] is flown reversed if reversed[i] is true.
+    typedef struct {
+        QVector<int>    order;
+        QVector<bool>   reversed;
+    } Route_t;
+
+    TransectRouteOptimizer(const QPointF& start, const QVector<QPointF>& entryPoints, const QVector<QPointF>& exitPoints, bool fixFirst);
+
+    double  _routeDistance  (const Route_t& route) const;
+    void    _nearestNeighbor(Route_t& route) const;
+    bool    _twoOptPass     (Route_t& route, int& evaluationsLeft) const;
+    bool    _orOptPass      (Route_t& route, int& evaluationsLeft) const;
+
+    /// Point the route arrives at when flying into position i
+    const QPointF& _in(const Route_t& route, int i) const { return route.reversed[i] ? _exitPoints[route.order[i]] : _entryPoints[route.order[i]]; }
+
+    /// Point the route leaves from when flying out of position i
+    const QPointF& _out(const Route_t& route, int i) const { return route.reversed[i] ? _entryPoints[route.order[i]] : _exitPoints[route.order[i]]; }
+
+    /// Point the route leaves from prior to position i
+    const QPointF& _prevOut(const Route_t& route, int i) const { return i == 0 ? _start : _out(route, i - 1); }
+
+    static double _distance(const QPointF& point1, const QPointF& point2);
+
+    QPointF             _start;
+    QVector<QPointF>    _entryPoints;
+    QVector<QPointF>    _exitPoints;
+    bool                _fixFirst;      ///< true: First route position is not changed by refinement
+
+    static const double _minImprovement;
+};
@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TransectRouteOptimizerTest.h"
+#include "TransectRouteOptimizer.h"
+
+const double TransectRouteOptimizerTest::_transectSpacing = 20;
+const double TransectRouteOptimizerTest::_transectLength =  200;
+
+/// Generates north/south transects spaced out to the east. When not shuffled they are in back and forth order.
+QList<QList<QGeoCoordinate>> TransectRouteOptimizerTest::_parallelTransects(int count, bool shuffle)
+{
+    QGeoCoordinate                  origin(47.633550640000003, -122.08982199);
+    QList<QList<QGeoCoordinate>>    transects;
+
+    for (int i=0; i<count; i++) {
+        // 7 is coprime to the counts used so this visits every transect
+        int     transectIndex = shuffle ? (i * 7) % count : i;
+        bool    northbound = transectIndex & 1;
+
+        if (shuffle) {
+            northbound = i & 1;
+        }
+
+        QGeoCoordinate          south = origin.atDistanceAndAzimuth(transectIndex * _transectSpacing, 90);
+        QGeoCoordinate          north = south.atDistanceAndAzimuth(_transectLength, 0);
+        QList<QGeoCoordinate>   transect;
+
+        if (northbound) {
+            transect << south << north;
+        } else {
+            transect << north << south;
+        }
+        transects.append(transect);
+    }
+
+    return transects;
+}
+
+/// Validates that the optimized transects are the original transects, each used once and flown in either direction
+void TransectRouteOptimizerTest::_verifyTransects(const QList<QList<QGeoCoordinate>>& originalTransects, const QList<QList<QGeoCoordinate>>& optimizedTransects)
+{
+    QCOMPARE(optimizedTransects.count(), originalTransects.count());
+
+    QVector<bool> used(originalTransects.count(), false);
+    for (int i=0; i<optimizedTransects.count(); i++) {
+        const QList<QGeoCoordinate>& transect = optimizedTransects[i];
+
+        int originalIndex = -1;
+        for (int j=0; j<originalTransects.count(); j++) {
+            const QList<QGeoCoordinate>& originalTransect = originalTransects[j];
+
+            if (used[j] || originalTransect.count() != transect.count()) {
+                continue;
+            }
+            if (transect == originalTransect) {
+                originalIndex = j;
+                break;
+            }
+
+            // Reversed transect must have swapped entry and exit with the interior flown backwards
+            bool reversed = true;
+            for (int k=0; k<transect.count(); k++) {
+                if (transect[k] != originalTransect[transect.count() - 1 - k]) {
+                    reversed = false;
+                    break;
+                }
+            }
+            if (reversed) {
+                originalIndex = j;
+                break;
+            }
+        }
+        QVERIFY(originalIndex != -1);
+        used[originalIndex] = true;
+    }
+}
+
+double TransectRouteOptimizerTest::_deadLegDistance(const QList<QList<QGeoCoordinate>>& transects)
+{
+    double distance = 0;
+
+    for (int i=1; i<transects.count(); i++) {
+        distance += transects[i - 1].last().distanceTo(transects[i].first());
+    }
+
+    return distance;
+}
+
+void TransectRouteOptimizerTest::_testAlreadyOptimal(void)
+{
+    QList<QList<QGeoCoordinate>> transects = _parallelTransects(10, false /* shuffle */);
+    QList<QList<QGeoCoordinate>> originalTransects = transects;
+
+    TransectRouteOptimizer::Stats_t stats = TransectRouteOptimizer::optimize(QGeoCoordinate(), transects, 100000);
+
+    QCOMPARE(stats.changed, false);
+    QCOMPARE(transects, originalTransects);
+}
+
+void TransectRouteOptimizerTest::_testShuffled(void)
+{
+    const int cTransects = 11;
+
+    QList<QList<QGeoCoordinate>> transects = _parallelTransects(cTransects, true /* shuffle */);
+    QList<QList<QGeoCoordinate>> originalTransects = transects;
+    QGeoCoordinate firstEntry = transects.first().first();
+    double originalDistance = _deadLegDistance(transects);
+
+    TransectRouteOptimizer::Stats_t stats = TransectRouteOptimizer::optimize(QGeoCoordinate(), transects, 100000);
+
+    QCOMPARE(stats.changed, true);
+    QVERIFY(stats.optimizedDistance < stats.originalDistance);
+    _verifyTransects(originalTransects, transects);
+
+    // First transect must be left as is when there is no start coordinate
+    QCOMPARE(transects.first().first(), firstEntry);
+
+    // Route should be close to the back and forth pattern, which is the shortest
+    double optimizedDistance = _deadLegDistance(transects);
+    QVERIFY(optimizedDistance < originalDistance);
+    QVERIFY(optimizedDistance < (cTransects + 1) * _transectSpacing * 1.5);
+}
+
+void TransectRouteOptimizerTest::_testStartCoordinate(void)
+{
+    QList<QList<QGeoCoordinate>> transects = _parallelTransects(10, false /* shuffle */);
+    QList<QList<QGeoCoordinate>> originalTransects = transects;
+
+    // Starting past the last transect should fly the transects in reverse order
+    QGeoCoordinate startCoord = transects.last().last().atDistanceAndAzimuth(_transectSpacing, 90);
+    TransectRouteOptimizer::Stats_t stats = TransectRouteOptimizer::optimize(startCoord, transects, 100000);
+
+    QCOMPARE(stats.changed, true);
+    QVERIFY(transects.first().first().distanceTo(startCoord) < _transectSpacing * 1.5);
+    _verifyTransects(originalTransects, transects);
+}
+
+/// Optimizes a large number of transects. The optimized route must never be longer than the input route.
+void TransectRouteOptimizerTest::_testSplitTransectsBenchmark(void)
+{
+    const int cTransects = 501;
+
+    QList<QList<QGeoCoordinate>> transects = _parallelTransects(cTransects, true /* shuffle */);
+    QList<QList<QGeoCoordinate>> originalTransects = transects;
+    double originalDistance = _deadLegDistance(transects);
+
+    TransectRouteOptimizer::Stats_t stats = TransectRouteOptimizer::optimize(QGeoCoordinate(), transects, 1000000);
+
+    QVERIFY(stats.optimizedDistance < stats.originalDistance);
+    QVERIFY(_deadLegDistance(transects) <= originalDistance);
+    _verifyTransects(originalTransects, transects);
+}
+
+/// The evaluation budget must bound refinement and give the same result on every run
+void TransectRouteOptimizerTest::_testEvaluationBudget(void)
+{
+    const int cTransects =      101;
+    const int maxEvaluations =  2000;
+
+    QList<QList<QGeoCoordinate>> transects1 = _parallelTransects(cTransects, true /* shuffle */);
+    QList<QList<QGeoCoordinate>> transects2 = transects1;
+
+    TransectRouteOptimizer::Stats_t stats1 = TransectRouteOptimizer::optimize(QGeoCoordinate(), transects1, maxEvaluations);
+    TransectRouteOptimizer::Stats_t stats2 = TransectRouteOptimizer::optimize(QGeoCoordinate(), transects2, maxEvaluations);
+
+    // Or-opt finishes the transect it is evaluating, which can go at most one route length over the budget
+    QVERIFY(stats1.evaluations <= maxEvaluations + cTransects);
+    QCOMPARE(stats1.evaluations, stats2.evaluations);
+    QCOMPARE(stats1.optimizedDistance, stats2.optimizedDistance);
+    QCOMPARE(transects1, transects2);
+    QVERIFY(_deadLegDistance(transects1) <= _deadLegDistance(_parallelTransects(cTransects, true /* shuffle */)));
+    _verifyTransects(_parallelTransects(cTransects, true /* shuffle */), transects1);
+}
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QGeoCoordinate>
+
+/// Unit test for TransectRouteOptimizer
+class TransectRouteOptimizerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testAlreadyOptimal(void);
+    void _testShuffled(void);
+    void _testStartCoordinate(void);
+    void _testSplitTransectsBenchmark(void);
+    void _testEvaluationBudget(void);
+
+private:
+    QList<QList<QGeoCoordinate>> _parallelTransects(int count, bool shuffle);
+    double _deadLegDistance(const QList<QList<QGeoCoordinate>>& transects);
+    void _verifyTransects(const QList<QList<QGeoCoordinate>>& originalTransects, const QList<QList<QGeoCoordinate>>& optimizedTransects);
+
+    static const double _transectSpacing;
+    static const double _transectLength;
+};
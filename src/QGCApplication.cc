@@ -24,6 +24,8 @@
 #include <QStyleFactory>
 #include <QAction>
 #include <QStringListModel>
+#include <QQuickWindow>
+#include <QElapsedTimer>
 
 #ifdef QGC_ENABLE_BLUETOOTH
 #include <QBluetoothLocalDevice>
@@ -57,6 +59,7 @@
 #include "FirmwarePluginManager.h"
 #include "MultiVehicleManager.h"
 #include "Vehicle.h"
+#include "TrajectoryPoints.h"
 #include "MavlinkQmlSingleton.h"
 #include "JoystickConfigController.h"
 #include "JoystickManager.h"
@@ -80,6 +83,7 @@
 #include "ParameterManager.h"
 #include "SettingsManager.h"
 #include "QGCCorePlugin.h"
+#include "QGCOptions.h"
 #include "QGCCameraManager.h"
 #include "CameraCalc.h"
 #include "VisualMissionItem.h"
@@ -168,6 +172,8 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     #endif
     , _toolbox(NULL)
     , _bluetoothAvailable(false)
+    , _lazyInit(false)
+    , _deferredInitComplete(false)
 {
     _app = this;
 
@@ -225,11 +231,14 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     bool fClearSettingsOptions = false; // Clear stored settings
     bool logging = false;               // Turn on logging
     QString loggingOptions;
+    bool startupTrace = false;          // Record startup timings
 
     CmdLineOpt_t rgCmdLineOptions[] = {
         { "--clear-settings",   &fClearSettingsOptions, NULL },
         { "--logging",          &logging,               &loggingOptions },
         { "--fake-mobile",      &_fakeMobile,           NULL },
+        { "--startup-trace",    &startupTrace,          &_startupTraceFile },
+        { "--lazy-init",        &_lazyInit,             NULL },
     #ifdef QT_DEBUG
         { "--test-high-dpi",    &_testHighDPI,          NULL },
     #endif
@@ -238,6 +247,10 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
 
     ParseCmdLineOptions(argc, argv, rgCmdLineOptions, sizeof(rgCmdLineOptions)/sizeof(rgCmdLineOptions[0]), false);
 
+    if (startupTrace) {
+        _startupTrace.enable();
+    }
+
     // Set up timer for delayed missing fact display
     _missingParamsDelayedDisplayTimer.setSingleShot(true);
     _missingParamsDelayedDisplayTimer.setInterval(_missingParamsDelayedDisplayTimerTimeout);
@@ -311,10 +324,14 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
 #endif
 
     // Initialize Video Streaming
+    QElapsedTimer traceTimer;
+    traceTimer.start();
     initializeVideoStreaming(argc, argv);
+    _startupTrace.record("initializeVideoStreaming", traceTimer);
 
     _toolbox = new QGCToolbox(this);
     _toolbox->setChildToolboxes();
+    _startupTrace.mark("Toolbox ready");
 }
 
 void QGCApplication::_shutdown(void)
@@ -360,6 +377,7 @@ void QGCApplication::_initCommon(void)
     qmlRegisterUncreatableType<ParameterManager>    ("QGroundControl.Vehicle",              1, 0, "ParameterManager",       "Reference only");
     qmlRegisterUncreatableType<QGCCameraManager>    ("QGroundControl.Vehicle",              1, 0, "QGCCameraManager",       "Reference only");
     qmlRegisterUncreatableType<QGCCameraControl>    ("QGroundControl.Vehicle",              1, 0, "QGCCameraControl",       "Reference only");
+    qmlRegisterUncreatableType<TrajectoryPoints>    ("QGroundControl.Vehicle",              1, 0, "TrajectoryPoints",       "Reference only");
     qmlRegisterUncreatableType<JoystickManager>     ("QGroundControl.JoystickManager",      1, 0, "JoystickManager",        "Reference only");
     qmlRegisterUncreatableType<Joystick>            ("QGroundControl.JoystickManager",      1, 0, "Joystick",               "Reference only");
     qmlRegisterUncreatableType<QGCPositionManager>  ("QGroundControl.QGCPositionManager",   1, 0, "QGCPositionManager",     "Reference only");
@@ -402,6 +420,8 @@ bool QGCApplication::_initForNormalAppBoot(void)
     // Exit main application when last window is closed
     connect(this, &QGCApplication::lastWindowClosed, this, QGCApplication::quit);
 
+    QElapsedTimer traceTimer;
+    traceTimer.start();
 #ifdef __mobile__
     _qmlAppEngine = toolbox()->corePlugin()->createRootWindow(this);
 #else
@@ -409,16 +429,35 @@ bool QGCApplication::_initForNormalAppBoot(void)
     MainWindow* mainWindow = MainWindow::_create();
     Q_CHECK_PTR(mainWindow);
 #endif
+    _startupTrace.record("Create root window", traceTimer);
 
-    // Now that main window is up check for lost log files
     connect(this, &QGCApplication::checkForLostLogFiles, toolbox()->mavlinkProtocol(), &MAVLinkProtocol::checkForLostLogFiles);
-    emit checkForLostLogFiles();
 
     // Load known link configurations
+    traceTimer.start();
     toolbox()->linkManager()->loadLinkConfigurationList();
+    _startupTrace.record("Load link configurations", traceTimer);
 
-    // Probe for joysticks
-    toolbox()->joystickManager()->init();
+    // Checking for lost log files, probing for joysticks and so forth is not needed to show the ui. With lazy initialization
+    // that work waits until the first frame has been shown.
+    _lazyInit |= toolbox()->corePlugin()->options()->lazyInit();
+    if (_lazyInit) {
+        QQuickWindow* rootWindow = NULL;
+#ifdef __mobile__
+        if (_qmlAppEngine && !_qmlAppEngine->rootObjects().isEmpty()) {
+            rootWindow = qobject_cast<QQuickWindow*>(_qmlAppEngine->rootObjects().first());
+        }
+#endif
+        if (rootWindow) {
+            // frameSwapped is signalled from the render thread
+            connect(rootWindow, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped, Qt::QueuedConnection);
+        } else {
+            // Widget based main window, run once the event loop has started
+            QTimer::singleShot(0, this, &QGCApplication::_firstFrameSwapped);
+        }
+    } else {
+        _deferredInit();
+    }
 
     if (_settingsUpgraded) {
         showMessage(tr("The format for QGroundControl saved settings has been modified. "
@@ -437,6 +476,36 @@ bool QGCApplication::_initForNormalAppBoot(void)
     return true;
 }
 
+void QGCApplication::_firstFrameSwapped(void)
+{
+    QQuickWindow* rootWindow = qobject_cast<QQuickWindow*>(sender());
+    if (rootWindow) {
+        disconnect(rootWindow, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped);
+    }
+
+    if (!_deferredInitComplete) {
+        _startupTrace.mark("First frame");
+        _deferredInit();
+    }
+}
+
+/// Initialization which is not needed to show the user interface
+void QGCApplication::_deferredInit(void)
+{
+    QElapsedTimer traceTimer;
+    traceTimer.start();
+
+    _deferredInitComplete = true;
+
+    emit checkForLostLogFiles();
+    _toolbox->deferredInit();
+
+    _startupTrace.record("Deferred init", traceTimer);
+    if (_startupTrace.enabled()) {
+        _startupTrace.save(_startupTraceFile.isEmpty() ? QGCStartupTrace::defaultFileName() : _startupTraceFile);
+    }
+}
+
 bool QGCApplication::_initForUnitTests(void)
 {
     return true;
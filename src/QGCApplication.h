@@ -33,6 +33,7 @@
 #include "AudioOutput.h"
 #include "UASMessageHandler.h"
 #include "FactSystem.h"
+#include "QGCStartupTrace.h"
 
 #ifdef QGC_RTLAB_ENABLED
 #include "OpalLink.h"
@@ -89,6 +90,9 @@ public:
     // Still working on getting rid of this and using dependency injection instead for everything
     QGCToolbox* toolbox(void) { return _toolbox; }
 
+    /// Startup timing trace, only records when --startup-trace is specified on the command line
+    QGCStartupTrace* startupTrace(void) { return &_startupTrace; }
+
     /// Do we have Bluetooth Support?
     bool isBluetoothAvailable() { return _bluetoothAvailable; }
 
@@ -149,9 +153,11 @@ public:
 
 private slots:
     void _missingParamsDisplay(void);
+    void _firstFrameSwapped(void);
 
 private:
     QObject* _rootQmlObject(void);
+    void _deferredInit(void);
 
 #ifdef __mobile__
     QQmlApplicationEngine* _qmlAppEngine;
@@ -175,6 +181,11 @@ private:
 
     bool _bluetoothAvailable;
 
+    QGCStartupTrace _startupTrace;
+    QString         _startupTraceFile;      ///< File to write startup trace to, empty for default location
+    bool            _lazyInit;              ///< true: Non-critical initialization is deferred until the first frame is shown
+    bool            _deferredInitComplete;
+
     static const char* _settingsVersionKey;             ///< Settings key which hold settings version
     static const char* _deleteAllSettingsKey;           ///< If this settings key is set on boot, all settings will be deleted
 
@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCStartupTrace.h"
+#include "QGCLoggingCategory.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSettings>
+#include <QTextStream>
+
+QGC_LOGGING_CATEGORY(StartupTraceLog, "StartupTraceLog")
+
+QGCStartupTrace::QGCStartupTrace(void)
+    : _enabled(false)
+{
+
+}
+
+void QGCStartupTrace::enable(void)
+{
+    _enabled = true;
+    _startupTimer.start();
+}
+
+void QGCStartupTrace::record(const QString& event, const QElapsedTimer& eventTimer)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    TraceEntry_t entry;
+    entry.event =           event;
+    entry.durationUsecs =   eventTimer.nsecsElapsed() / 1000;
+    entry.startUsecs =      (_startupTimer.nsecsElapsed() / 1000) - entry.durationUsecs;
+    _entries.append(entry);
+
+    qCDebug(StartupTraceLog) << event << "msecs:" << entry.durationUsecs / 1000.0;
+}
+
+void QGCStartupTrace::mark(const QString& event)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    TraceEntry_t entry;
+    entry.event =           event;
+    entry.durationUsecs =   0;
+    entry.startUsecs =      _startupTimer.nsecsElapsed() / 1000;
+    _entries.append(entry);
+
+    qCDebug(StartupTraceLog) << event << "at msecs:" << entry.startUsecs / 1000.0;
+}
+
+bool QGCStartupTrace::save(const QString& fileName) const
+{
+    if (!_enabled) {
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qCWarning(StartupTraceLog) << "Unable to write startup trace" << fileName << file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "# Start(ms)\tDuration(ms)\tEvent\n";
+    foreach (const TraceEntry_t& entry, _entries) {
+        stream << QString::number(entry.startUsecs / 1000.0, 'f', 3) << "\t"
+               << QString::number(entry.durationUsecs / 1000.0, 'f', 3) << "\t"
+               << entry.event << "\n";
+    }
+
+    qCDebug(StartupTraceLog) << "Startup trace saved to" << fileName;
+    return true;
+}
+
+QString QGCStartupTrace::defaultFileName(void)
+{
+    return QFileInfo(QSettings().fileName()).dir().filePath("StartupTrace.txt");
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(StartupTraceLog)
+
+/// Records the timing of each phase of application startup, such as tool construction and setToolbox calls. Turned on
+/// with the --startup-trace command line option. When not enabled all methods return immediately.
+class QGCStartupTrace
+{
+public:
+    QGCStartupTrace(void);
+
+    /// Enables tracing and starts the startup clock
+    void enable(void);
+
+    bool enabled(void) const { return _enabled; }
+
+    /// Records an event which has just finished
+    ///     @param event Name of event
+    ///     @param eventTimer Timer which was started at the beginning of the event
+    void record(const QString& event, const QElapsedTimer& eventTimer);
+
+    /// Records a point in time with no duration
+    void mark(const QString& event);
+
+    /// Writes the trace to the specified file. One line per event: start msecs, duration msecs, event name.
+    /// @return false: unable to write file
+    bool save(const QString& fileName) const;
+
+    /// @return Default trace file location, next to the settings file
+    static QString defaultFileName(void);
+
+private:
+    typedef struct {
+        QString event;
+        qint64  startUsecs;     ///< Time since startup clock was started
+        qint64  durationUsecs;
+    } TraceEntry_t;
+
+    bool                _enabled;
+    QElapsedTimer       _startupTimer;
+    QList<TraceEntry_t> _entries;
+};
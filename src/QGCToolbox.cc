@@ -30,6 +30,7 @@
 #include "QGCOptions.h"
 #include "SettingsManager.h"
 #include "QGCApplication.h"
+#include "QGCStartupTrace.h"
 
 #if defined(QGC_CUSTOM_BUILD)
 #include CUSTOMHEADER
@@ -58,54 +59,89 @@ QGCToolbox::QGCToolbox(QGCApplication* app)
     , _settingsManager(NULL)
 {
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager =          new SettingsManager(app, this);
+    _settingsManager =          _createTool<SettingsManager>        (app, "SettingsManager");
 
     //-- Scan and load plugins
+    QElapsedTimer pluginTimer;
+    pluginTimer.start();
     _scanAndLoadPlugins(app);
-    _audioOutput =              new AudioOutput             (app, this);
-    _factSystem =               new FactSystem              (app, this);
-    _firmwarePluginManager =    new FirmwarePluginManager   (app, this);
+    app->startupTrace()->record("QGCCorePlugin construct", pluginTimer);
+
+    _audioOutput =              _createTool<AudioOutput>            (app, "AudioOutput");
+    _factSystem =               _createTool<FactSystem>             (app, "FactSystem");
+    _firmwarePluginManager =    _createTool<FirmwarePluginManager>  (app, "FirmwarePluginManager");
 #ifndef __mobile__
-    _gpsManager =               new GPSManager              (app, this);
+    _gpsManager =               _createTool<GPSManager>             (app, "GPSManager");
 #endif
-    _imageProvider =            new QGCImageProvider        (app, this);
-    _joystickManager =          new JoystickManager         (app, this);
-    _linkManager =              new LinkManager             (app, this);
-    _mavlinkProtocol =          new MAVLinkProtocol         (app, this);
-    _missionCommandTree =       new MissionCommandTree      (app, this);
-    _multiVehicleManager =      new MultiVehicleManager     (app, this);
-    _mapEngineManager =         new QGCMapEngineManager     (app, this);
-    _uasMessageHandler =        new UASMessageHandler       (app, this);
-    _qgcPositionManager =       new QGCPositionManager      (app, this);
-    _followMe =                 new FollowMe                (app, this);
-    _videoManager =             new VideoManager            (app, this);
-    _mavlinkLogManager =        new MAVLinkLogManager       (app, this);
+    _imageProvider =            _createTool<QGCImageProvider>       (app, "QGCImageProvider");
+    _joystickManager =          _createTool<JoystickManager>        (app, "JoystickManager");
+    _linkManager =              _createTool<LinkManager>            (app, "LinkManager");
+    _mavlinkProtocol =          _createTool<MAVLinkProtocol>        (app, "MAVLinkProtocol");
+    _missionCommandTree =       _createTool<MissionCommandTree>     (app, "MissionCommandTree");
+    _multiVehicleManager =      _createTool<MultiVehicleManager>    (app, "MultiVehicleManager");
+    _mapEngineManager =         _createTool<QGCMapEngineManager>    (app, "QGCMapEngineManager");
+    _uasMessageHandler =        _createTool<UASMessageHandler>      (app, "UASMessageHandler");
+    _qgcPositionManager =       _createTool<QGCPositionManager>     (app, "QGCPositionManager");
+    _followMe =                 _createTool<FollowMe>               (app, "FollowMe");
+    _videoManager =             _createTool<VideoManager>           (app, "VideoManager");
+    _mavlinkLogManager =        _createTool<MAVLinkLogManager>      (app, "MAVLinkLogManager");
 }
 
 void QGCToolbox::setChildToolboxes(void)
 {
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager->setToolbox(this);
+    _setToolbox(_settingsManager,       "SettingsManager");
 
-    _corePlugin->setToolbox(this);
-    _audioOutput->setToolbox(this);
-    _factSystem->setToolbox(this);
-    _firmwarePluginManager->setToolbox(this);
+    _setToolbox(_corePlugin,            "QGCCorePlugin");
+    _setToolbox(_audioOutput,           "AudioOutput");
+    _setToolbox(_factSystem,            "FactSystem");
+    _setToolbox(_firmwarePluginManager, "FirmwarePluginManager");
 #ifndef __mobile__
-    _gpsManager->setToolbox(this);
+    _setToolbox(_gpsManager,            "GPSManager");
 #endif
-    _imageProvider->setToolbox(this);
-    _joystickManager->setToolbox(this);
-    _linkManager->setToolbox(this);
-    _mavlinkProtocol->setToolbox(this);
-    _missionCommandTree->setToolbox(this);
-    _multiVehicleManager->setToolbox(this);
-    _mapEngineManager->setToolbox(this);
-    _uasMessageHandler->setToolbox(this);
-    _followMe->setToolbox(this);
-    _qgcPositionManager->setToolbox(this);
-    _videoManager->setToolbox(this);
-    _mavlinkLogManager->setToolbox(this);
+    _setToolbox(_imageProvider,         "QGCImageProvider");
+    _setToolbox(_joystickManager,       "JoystickManager");
+    _setToolbox(_linkManager,           "LinkManager");
+    _setToolbox(_mavlinkProtocol,       "MAVLinkProtocol");
+    _setToolbox(_missionCommandTree,    "MissionCommandTree");
+    _setToolbox(_multiVehicleManager,   "MultiVehicleManager");
+    _setToolbox(_mapEngineManager,      "QGCMapEngineManager");
+    _setToolbox(_uasMessageHandler,     "UASMessageHandler");
+    _setToolbox(_followMe,              "FollowMe");
+    _setToolbox(_qgcPositionManager,    "QGCPositionManager");
+    _setToolbox(_videoManager,          "VideoManager");
+    _setToolbox(_mavlinkLogManager,     "MAVLinkLogManager");
+}
+
+void QGCToolbox::deferredInit(void)
+{
+    QGCStartupTrace* startupTrace = qgcApp()->startupTrace();
+
+    // Tools are parented to the toolbox, so this visits them in creation order
+    foreach (QGCTool* tool, findChildren<QGCTool*>(QString(), Qt::FindDirectChildrenOnly)) {
+        QElapsedTimer timer;
+        timer.start();
+        tool->deferredInit();
+        startupTrace->record(QStringLiteral("%1 deferredInit").arg(tool->metaObject()->className()), timer);
+    }
+}
+
+template <class T>
+T* QGCToolbox::_createTool(QGCApplication* app, const char* toolName)
+{
+    QElapsedTimer timer;
+    timer.start();
+    T* tool = new T(app, this);
+    app->startupTrace()->record(QStringLiteral("%1 construct").arg(toolName), timer);
+    return tool;
+}
+
+void QGCToolbox::_setToolbox(QGCTool* tool, const char* toolName)
+{
+    QElapsedTimer timer;
+    timer.start();
+    tool->setToolbox(this);
+    qgcApp()->startupTrace()->record(QStringLiteral("%1 setToolbox").arg(toolName), timer);
 }
 
 void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
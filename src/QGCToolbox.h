@@ -32,6 +32,7 @@ class VideoManager;
 class MAVLinkLogManager;
 class QGCCorePlugin;
 class SettingsManager;
+class QGCTool;
 
 /// This is used to manage all of our top level services/tools
 class QGCToolbox : public QObject {
@@ -61,10 +62,19 @@ public:
     GPSManager*                 gpsManager(void)                { return _gpsManager; }
 #endif
 
+    /// Calls QGCTool::deferredInit on all tools. Called by QGCApplication once the user interface is up.
+    void deferredInit(void);
+
 private:
     void setChildToolboxes(void);
     void _scanAndLoadPlugins(QGCApplication *app);
 
+    /// Constructs a tool and records the construction time in the startup trace
+    template <class T> T* _createTool(QGCApplication* app, const char* toolName);
+
+    /// Calls setToolbox on a tool and records the time in the startup trace
+    void _setToolbox(QGCTool* tool, const char* toolName);
+
 
     AudioOutput*                _audioOutput;
     FactSystem*                 _factSystem;
@@ -103,6 +113,10 @@ public:
     // If you override this method, you must call the base class.
     virtual void setToolbox(QGCToolbox* toolbox);
 
+    // Called once after all tools have been set up, for initialization which is not needed to show the user interface. When
+    // running with lazy initialization this is called after the first frame is shown. Not called when running unit tests.
+    virtual void deferredInit(void) { }
+
 protected:
     QGCApplication* _app;
     QGCToolbox*     _toolbox;
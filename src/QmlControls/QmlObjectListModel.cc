@@ -23,6 +23,9 @@ QmlObjectListModel::QmlObjectListModel(QObject* parent)
     : QAbstractListModel(parent)
     , _dirty(false)
     , _skipDirtyFirstItem(false)
+    , _batchUpdateDepth(0)
+    , _batchUpdateCountChanged(false)
+    , _batchUpdateDirty(false)
 {
 
 }
@@ -130,46 +133,89 @@ const QObject* QmlObjectListModel::operator[](int index) const
 
 void QmlObjectListModel::clear(void)
 {
-    while (rowCount()) {
-        removeAt(0);
-    }
+    removeRange(0, _objectList.count());
 }
 
 QObject* QmlObjectListModel::removeAt(int i)
 {
-    QObject* removedObject = _objectList[i];
-    if(removedObject) {
-        // Look for a dirtyChanged signal on the object
-        if (_objectList[i]->metaObject()->indexOfSignal(QMetaObject::normalizedSignature("dirtyChanged(bool)")) != -1) {
-            if (!_skipDirtyFirstItem || i != 0) {
-                QObject::disconnect(_objectList[i], SIGNAL(dirtyChanged(bool)), this, SLOT(_childDirtyChanged(bool)));
-            }
+    QList<QObject*> removedObjects = removeRange(i, 1);
+    return removedObjects.isEmpty() ? NULL : removedObjects.first();
+}
+
+QList<QObject*> QmlObjectListModel::removeRange(int first, int count)
+{
+    QList<QObject*> removedObjects;
+
+    if (count <= 0) {
+        return removedObjects;
+    }
+    if (first < 0 || first + count > _objectList.count()) {
+        qWarning() << "Invalid range first:count:listCount" << first << count << _objectList.count();
+        return removedObjects;
+    }
+
+    removedObjects = _objectList.mid(first, count);
+    for (int i=0; i<removedObjects.count(); i++) {
+        if (removedObjects[i]) {
+            _disconnectDirty(removedObjects[i], first + i);
         }
     }
-    removeRows(i, 1);
-    setDirty(true);
-    return removedObject;
+
+    if (_batchUpdateDepth == 0) {
+        beginRemoveRows(QModelIndex(), first, first + count - 1);
+    }
+    _objectList.erase(_objectList.begin() + first, _objectList.begin() + first + count);
+    if (_batchUpdateDepth == 0) {
+        endRemoveRows();
+    }
+
+    _listChanged();
+
+    return removedObjects;
 }
 
 void QmlObjectListModel::insert(int i, QObject* object)
 {
+    QList<QObject*> objects;
+
+    objects.append(object);
+    insert(i, objects);
+}
+
+void QmlObjectListModel::insert(int i, const QList<QObject*>& objects)
+{
+    if (objects.isEmpty()) {
+        return;
+    }
     if (i < 0 || i > _objectList.count()) {
         qWarning() << "Invalid index index:count" << i << _objectList.count();
+        return;
     }
-    
-    QQmlEngine::setObjectOwnership(object, QQmlEngine::CppOwnership);
-    
-    // Look for a dirtyChanged signal on the object
-    if (object->metaObject()->indexOfSignal(QMetaObject::normalizedSignature("dirtyChanged(bool)")) != -1) {
-        if (!_skipDirtyFirstItem || i != 0) {
-            QObject::connect(object, SIGNAL(dirtyChanged(bool)), this, SLOT(_childDirtyChanged(bool)));
-        }
+
+    for (int j=0; j<objects.count(); j++) {
+        QQmlEngine::setObjectOwnership(objects[j], QQmlEngine::CppOwnership);
+        _connectDirty(objects[j], i + j);
     }
 
-    _objectList.insert(i, object);
-    insertRows(i, 1);
-    
-    setDirty(true);
+    if (_batchUpdateDepth == 0) {
+        beginInsertRows(QModelIndex(), i, i + objects.count() - 1);
+    }
+    if (i == _objectList.count()) {
+        _objectList.append(objects);
+    } else {
+        QList<QObject*> newList;
+
+        newList.reserve(_objectList.count() + objects.count());
+        newList.append(_objectList.mid(0, i));
+        newList.append(objects);
+        newList.append(_objectList.mid(i));
+        _objectList = newList;
+    }
+    if (_batchUpdateDepth == 0) {
+        endInsertRows();
+    }
+
+    _listChanged();
 }
 
 void QmlObjectListModel::append(QObject* object)
@@ -177,16 +223,90 @@ void QmlObjectListModel::append(QObject* object)
     insert(_objectList.count(), object);
 }
 
+void QmlObjectListModel::append(const QList<QObject*>& objects)
+{
+    insert(_objectList.count(), objects);
+}
+
 QObjectList QmlObjectListModel::swapObjectList(const QObjectList& newlist)
 {
     QObjectList oldlist(_objectList);
-    beginResetModel();
+    if (_batchUpdateDepth == 0) {
+        beginResetModel();
+    }
     _objectList = newlist;
-    endResetModel();
-    emit countChanged(count());
+    if (_batchUpdateDepth == 0) {
+        endResetModel();
+        emit countChanged(count());
+    } else {
+        _batchUpdateCountChanged = true;
+    }
     return oldlist;
 }
 
+void QmlObjectListModel::beginBatchUpdate(void)
+{
+    if (_batchUpdateDepth++ == 0) {
+        _batchUpdateCountChanged = false;
+        _batchUpdateDirty = false;
+        beginResetModel();
+    }
+}
+
+void QmlObjectListModel::endBatchUpdate(void)
+{
+    if (_batchUpdateDepth == 0) {
+        qWarning() << "endBatchUpdate called without matching beginBatchUpdate";
+        return;
+    }
+
+    if (--_batchUpdateDepth == 0) {
+        endResetModel();
+        if (_batchUpdateCountChanged) {
+            emit countChanged(count());
+        }
+        if (_batchUpdateDirty) {
+            setDirty(true);
+        }
+    }
+}
+
+/// Signals count and dirty changes after objects are added or removed, or defers them to the end of the batch update
+void QmlObjectListModel::_listChanged(void)
+{
+    if (_batchUpdateDepth == 0) {
+        emit countChanged(count());
+        setDirty(true);
+    } else {
+        _batchUpdateCountChanged = true;
+        _batchUpdateDirty = true;
+    }
+}
+
+void QmlObjectListModel::_connectDirty(QObject* object, int index)
+{
+    static const QByteArray dirtyChangedSignature = QMetaObject::normalizedSignature("dirtyChanged(bool)");
+
+    // Look for a dirtyChanged signal on the object
+    if (object->metaObject()->indexOfSignal(dirtyChangedSignature) != -1) {
+        if (!_skipDirtyFirstItem || index != 0) {
+            QObject::connect(object, SIGNAL(dirtyChanged(bool)), this, SLOT(_childDirtyChanged(bool)));
+        }
+    }
+}
+
+void QmlObjectListModel::_disconnectDirty(QObject* object, int index)
+{
+    static const QByteArray dirtyChangedSignature = QMetaObject::normalizedSignature("dirtyChanged(bool)");
+
+    // Look for a dirtyChanged signal on the object
+    if (object->metaObject()->indexOfSignal(dirtyChangedSignature) != -1) {
+        if (!_skipDirtyFirstItem || index != 0) {
+            QObject::disconnect(object, SIGNAL(dirtyChanged(bool)), this, SLOT(_childDirtyChanged(bool)));
+        }
+    }
+}
+
 int QmlObjectListModel::count(void) const
 {
     return rowCount();
@@ -37,11 +37,28 @@ public:
     void setDirty(bool dirty);
     
     void append(QObject* object);
+
+    /// Appends all objects with a single model row insertion
+    void append(const QList<QObject*>& objects);
     QObjectList swapObjectList(const QObjectList& newlist);
     void clear(void);
     QObject* removeAt(int i);
     QObject* removeOne(QObject* object) { return removeAt(indexOf(object)); }
+
+    /// Removes count objects starting at index first with a single model row removal
+    ///     @return Removed objects
+    QList<QObject*> removeRange(int first, int count);
+
     void insert(int i, QObject* object);
+
+    /// Inserts all objects at index i with a single model row insertion
+    void insert(int i, const QList<QObject*>& objects);
+
+    /// Defers model notifications until the matching endBatchUpdate. The model is reset once at the end of the batch
+    /// and count/dirty are signalled once. Calls can be nested. Since a reset makes views rebuild all delegates only use
+    /// this for changes which touch a large part of the list.
+    void beginBatchUpdate(void);
+    void endBatchUpdate(void);
     QObject* operator[](int i);
     const QObject* operator[](int i) const;
     bool contains(QObject* object) { return _objectList.indexOf(object) != -1; }
@@ -62,6 +79,11 @@ private slots:
     void _childDirtyChanged(bool dirty);
     
 private:
+    void _connectDirty(QObject* object, int index);
+    void _disconnectDirty(QObject* object, int index);
+    void _listChanged(void);
+
+
     // Overrides from QAbstractListModel
     virtual int	rowCount(const QModelIndex & parent = QModelIndex()) const;
     virtual QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
@@ -75,6 +97,9 @@ private:
     
     bool _dirty;
     bool _skipDirtyFirstItem;
+    int  _batchUpdateDepth;         ///< > 0: Inside beginBatchUpdate/endBatchUpdate
+    bool _batchUpdateCountChanged;  ///< true: countChanged must be signalled at the end of the batch update
+    bool _batchUpdateDirty;         ///< true: Objects were added or removed during the batch update
         
     static const int ObjectRole;
     static const int TextRole;
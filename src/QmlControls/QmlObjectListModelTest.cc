@@ -0,0 +1,159 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QmlObjectListModelTest.h"
+#include "QmlObjectListModel.h"
+
+#include <QSignalSpy>
+
+QList<QObject*> QmlObjectListModelTest::_createObjects(int count, QObject* parent)
+{
+    QList<QObject*> objects;
+
+    for (int i=0; i<count; i++) {
+        objects.append(new QObject(parent));
+    }
+
+    return objects;
+}
+
+void QmlObjectListModelTest::_testRangeInsert(void)
+{
+    QmlObjectListModel  model;
+    QList<QObject*>     first =     _createObjects(3, &model);
+    QList<QObject*>     middle =    _createObjects(2, &model);
+
+    QSignalSpy rowsInsertedSpy(&model, &QmlObjectListModel::rowsInserted);
+    QSignalSpy countChangedSpy(&model, &QmlObjectListModel::countChanged);
+
+    model.append(first);
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(countChangedSpy.count(), 1);
+    QCOMPARE(model.dirty(), true);
+
+    model.insert(1, middle);
+    QCOMPARE(model.count(), 5);
+    QCOMPARE(rowsInsertedSpy.count(), 2);
+    QCOMPARE(rowsInsertedSpy.last()[1].toInt(), 1);
+    QCOMPARE(rowsInsertedSpy.last()[2].toInt(), 2);
+    QCOMPARE(model[0], first[0]);
+    QCOMPARE(model[1], middle[0]);
+    QCOMPARE(model[2], middle[1]);
+    QCOMPARE(model[3], first[1]);
+    QCOMPARE(model[4], first[2]);
+
+    // Empty insert does nothing
+    model.append(QList<QObject*>());
+    QCOMPARE(rowsInsertedSpy.count(), 2);
+}
+
+void QmlObjectListModelTest::_testRangeRemove(void)
+{
+    QmlObjectListModel  model;
+    QList<QObject*>     objects = _createObjects(6, &model);
+
+    model.append(objects);
+    model.setDirty(false);
+
+    QSignalSpy rowsRemovedSpy(&model, &QmlObjectListModel::rowsRemoved);
+    QSignalSpy countChangedSpy(&model, &QmlObjectListModel::countChanged);
+
+    QList<QObject*> removed = model.removeRange(1, 3);
+    QCOMPARE(removed.count(), 3);
+    QCOMPARE(removed[0], objects[1]);
+    QCOMPARE(removed[2], objects[3]);
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(model[1], objects[4]);
+    QCOMPARE(rowsRemovedSpy.count(), 1);
+    QCOMPARE(countChangedSpy.count(), 1);
+    QCOMPARE(model.dirty(), true);
+
+    // Out of range removal is rejected
+    QCOMPARE(model.removeRange(2, 5).count(), 0);
+    QCOMPARE(model.count(), 3);
+
+    // Clear is a single removal
+    model.clear();
+    QCOMPARE(model.count(), 0);
+    QCOMPARE(rowsRemovedSpy.count(), 2);
+}
+
+void QmlObjectListModelTest::_testBatchUpdate(void)
+{
+    QmlObjectListModel model;
+
+    QSignalSpy rowsInsertedSpy(&model, &QmlObjectListModel::rowsInserted);
+    QSignalSpy rowsRemovedSpy(&model, &QmlObjectListModel::rowsRemoved);
+    QSignalSpy modelResetSpy(&model, &QmlObjectListModel::modelReset);
+    QSignalSpy countChangedSpy(&model, &QmlObjectListModel::countChanged);
+    QSignalSpy dirtyChangedSpy(&model, &QmlObjectListModel::dirtyChanged);
+
+    model.beginBatchUpdate();
+    for (int i=0; i<100; i++) {
+        model.append(new QObject(&model));
+    }
+    model.beginBatchUpdate();
+    model.removeAt(0);
+    model.endBatchUpdate();
+    QCOMPARE(modelResetSpy.count(), 0);
+    QCOMPARE(countChangedSpy.count(), 0);
+    model.endBatchUpdate();
+
+    QCOMPARE(model.count(), 99);
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+    QCOMPARE(rowsRemovedSpy.count(), 0);
+    QCOMPARE(modelResetSpy.count(), 1);
+    QCOMPARE(countChangedSpy.count(), 1);
+    QCOMPARE(countChangedSpy.last()[0].toInt(), 99);
+    QCOMPARE(dirtyChangedSpy.count(), 1);
+    QCOMPARE(model.dirty(), true);
+}
+
+/// Appends 10000 objects one at a time, as a single range and inside a batch update. Only the first signals every append.
+void QmlObjectListModelTest::_testAppend10000Benchmark(void)
+{
+    const int cObjects = 10000;
+
+    {
+        QmlObjectListModel  model;
+        QList<QObject*>     objects = _createObjects(cObjects, &model);
+        QSignalSpy          countChangedSpy(&model, &QmlObjectListModel::countChanged);
+
+        for (int i=0; i<objects.count(); i++) {
+            model.append(objects[i]);
+        }
+        QCOMPARE(model.count(), cObjects);
+        QCOMPARE(countChangedSpy.count(), cObjects);
+    }
+
+    {
+        QmlObjectListModel  model;
+        QList<QObject*>     objects = _createObjects(cObjects, &model);
+        QSignalSpy          countChangedSpy(&model, &QmlObjectListModel::countChanged);
+
+        model.append(objects);
+        QCOMPARE(model.count(), cObjects);
+        QCOMPARE(countChangedSpy.count(), 1);
+    }
+
+    {
+        QmlObjectListModel  model;
+        QList<QObject*>     objects = _createObjects(cObjects, &model);
+        QSignalSpy          countChangedSpy(&model, &QmlObjectListModel::countChanged);
+
+        model.beginBatchUpdate();
+        for (int i=0; i<objects.count(); i++) {
+            model.append(objects[i]);
+        }
+        model.endBatchUpdate();
+        QCOMPARE(model.count(), cObjects);
+        QCOMPARE(countChangedSpy.count(), 1);
+    }
+}
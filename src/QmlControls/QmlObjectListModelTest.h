@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for QmlObjectListModel
+class QmlObjectListModelTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testRangeInsert(void);
+    void _testRangeRemove(void);
+    void _testBatchUpdate(void);
+    void _testAppend10000Benchmark(void);
+
+private:
+    QList<QObject*> _createObjects(int count, QObject* parent);
+};
@@ -26,6 +26,7 @@ const char* AppSettings::batteryPercentRemainingAnnounceSettingsName =  "battery
 const char* AppSettings::defaultMissionItemAltitudeSettingsName =       "DefaultMissionItemAltitude";
 const char* AppSettings::telemetrySaveName =                            "PromptFLightDataSave";
 const char* AppSettings::telemetrySaveNotArmedName =                    "PromptFLightDataSaveNotArmed";
+const char* AppSettings::linkMetricsSaveName =                          "LinkMetricsSave";
 const char* AppSettings::audioMutedName =                               "AudioMuted";
 const char* AppSettings::virtualJoystickName =                          "VirtualTabletJoystick";
 const char* AppSettings::appFontPointSizeName =                         "BaseDeviceFontPointSize";
@@ -65,6 +66,7 @@ AppSettings::AppSettings(QObject* parent)
     , _defaultMissionItemAltitudeFact(NULL)
     , _telemetrySaveFact(NULL)
     , _telemetrySaveNotArmedFact(NULL)
+    , _linkMetricsSaveFact(NULL)
     , _audioMutedFact(NULL)
     , _virtualJoystickFact(NULL)
     , _appFontPointSizeFact(NULL)
@@ -205,6 +207,15 @@ Fact* AppSettings::telemetrySaveNotArmed(void)
     return _telemetrySaveNotArmedFact;
 }
 
+Fact* AppSettings::linkMetricsSave(void)
+{
+    if (!_linkMetricsSaveFact) {
+        _linkMetricsSaveFact = _createSettingsFact(linkMetricsSaveName);
+    }
+
+    return _linkMetricsSaveFact;
+}
+
 Fact* AppSettings::audioMuted(void)
 {
     if (!_audioMutedFact) {
@@ -30,6 +30,7 @@ public:
     Q_PROPERTY(Fact* defaultMissionItemAltitude         READ defaultMissionItemAltitude         CONSTANT)
     Q_PROPERTY(Fact* telemetrySave                      READ telemetrySave                      CONSTANT)
     Q_PROPERTY(Fact* telemetrySaveNotArmed              READ telemetrySaveNotArmed              CONSTANT)
+    Q_PROPERTY(Fact* linkMetricsSave                    READ linkMetricsSave                    CONSTANT)
     Q_PROPERTY(Fact* audioMuted                         READ audioMuted                         CONSTANT)
     Q_PROPERTY(Fact* virtualJoystick                    READ virtualJoystick                    CONSTANT)
     Q_PROPERTY(Fact* appFontPointSize                   READ appFontPointSize                   CONSTANT)
@@ -65,6 +66,7 @@ public:
     Fact* defaultMissionItemAltitude        (void);
     Fact* telemetrySave                     (void);
     Fact* telemetrySaveNotArmed             (void);
+    Fact* linkMetricsSave                   (void);
     Fact* audioMuted                        (void);
     Fact* virtualJoystick                   (void);
     Fact* appFontPointSize                  (void);
@@ -97,6 +99,7 @@ public:
     static const char* defaultMissionItemAltitudeSettingsName;
     static const char* telemetrySaveName;
     static const char* telemetrySaveNotArmedName;
+    static const char* linkMetricsSaveName;
     static const char* audioMutedName;
     static const char* virtualJoystickName;
     static const char* appFontPointSizeName;
@@ -144,6 +147,7 @@ private:
     SettingsFact* _defaultMissionItemAltitudeFact;
     SettingsFact* _telemetrySaveFact;
     SettingsFact* _telemetrySaveNotArmedFact;
+    SettingsFact* _linkMetricsSaveFact;
     SettingsFact* _audioMutedFact;
     SettingsFact* _virtualJoystickFact;
     SettingsFact* _appFontPointSizeFact;
@@ -20,6 +20,7 @@
 #include <QNetworkReply>
 #include <QFile>
 #include <QFileInfo>
+#include <QThread>
 
 QGC_LOGGING_CATEGORY(MAVLinkLogManagerLog, "MAVLinkLogManagerLog")
 
@@ -113,14 +114,16 @@ MAVLinkLogFiles::setUploaded(bool uploaded)
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 MAVLinkLogProcessor::MAVLinkLogProcessor()
-    : _fd(NULL)
+    : _file(NULL)
     , _written(0)
     , _sequence(-1)
     , _numDrops(0)
+    , _sequenceGaps(0)
     , _gotHeader(false)
-    , _error(false)
-    , _record(NULL)
 {
+    //-- Allocated once, the same buffers are reused for every block of every log
+    _writeBlock.reserve(writeBlockSize);
+    _ulogMessage.reserve(4096);
 }
 
 //-----------------------------------------------------------------------------
@@ -129,40 +132,69 @@ MAVLinkLogProcessor::~MAVLinkLogProcessor()
     close();
 }
 
+//-----------------------------------------------------------------------------
+bool
+MAVLinkLogProcessor::open(const QString& fileName)
+{
+    close();
+    _fileName       = fileName;
+    _written        = 0;
+    _sequence       = -1;
+    _numDrops       = 0;
+    _sequenceGaps   = 0;
+    _gotHeader      = false;
+    _writeBlock.resize(0);
+    _ulogMessage.resize(0);
+    _file = new QFile(fileName, this);
+    //-- Data is already written in blocks. Unbuffered also makes write errors show up on the write that caused them.
+    if(!_file->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        qCWarning(MAVLinkLogManagerLog) << "Could not open MAVLink log file:" << fileName << _file->errorString();
+        _fail();
+        return false;
+    }
+    _flushTimer.start();
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogProcessor::close()
+MAVLinkLogProcessor::close(bool remove)
 {
-    if(_fd) {
-        fclose(_fd);
-        _fd = NULL;
+    if(!_file) {
+        return;
     }
+    if(!remove && !_flush()) {
+        //-- Log failed and was closed
+        return;
+    }
+    _file->close();
+    delete _file;
+    _file = NULL;
+    if(remove) {
+        QFile::remove(_fileName);
+    }
+    qCDebug(MAVLinkLogManagerLog) << "Log closed:" << _fileName << _written << "bytes" << _numDrops << "drops in" << _sequenceGaps << "gaps";
+    emit closed(_fileName, true);
 }
 
 //-----------------------------------------------------------------------------
-bool
-MAVLinkLogProcessor::valid()
+/// Closes the current log and stops the thread the processor runs on. Runs after all previously queued log data.
+void
+MAVLinkLogProcessor::_closeAndQuit()
 {
-    return (_fd != NULL) && (_record != NULL);
+    close();
+    thread()->quit();
 }
 
 //-----------------------------------------------------------------------------
-bool
-MAVLinkLogProcessor::create(MAVLinkLogManager* manager, const QString path, uint8_t id)
-{
-    _fileName.sprintf("%s/%03d-%s%s",
-                      path.toLatin1().data(),
-                      id,
-                      QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz").toLocal8Bit().data(),
-                      manager->logExtension().toLocal8Bit().data());
-    _fd = fopen(_fileName.toLocal8Bit().data(), "wb");
-    if(_fd) {
-        _record = new MAVLinkLogFiles(manager, _fileName, true);
-        _record->setWriting(true);
-        _sequence = -1;
-        return true;
-    }
-    return false;
+/// Closes the log after an error. Nothing more is written to it.
+void
+MAVLinkLogProcessor::_fail()
+{
+    delete _file;
+    _file = NULL;
+    emit failed(_fileName);
+    emit closed(_fileName, false);
 }
 
 //-----------------------------------------------------------------------------
@@ -185,113 +217,150 @@ MAVLinkLogProcessor::_checkSequence(uint16_t seq, int& num_drops)
             return false;
         }
         num_drops = seq - _sequence - 1;
-        _numDrops += num_drops;
-        _sequence = seq;
-        return true;
     } else {
-        if((_sequence - seq) > (1 << 15)) {
-            num_drops = (1 << 16) - _sequence - 1 + seq;
-            _numDrops += num_drops;
-            _sequence = seq;
-            return true;
+        if((_sequence - seq) <= (1 << 15)) {
+            return false;
         }
-        return false;
+        num_drops = (1 << 16) - _sequence - 1 + seq;
+    }
+    _numDrops += num_drops;
+    if(num_drops > 0) {
+        _sequenceGaps++;
+        emit dropStatsChanged(_fileName, _numDrops, _sequenceGaps);
     }
+    _sequence = seq;
+    return true;
 }
 
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogProcessor::_writeData(void* data, int len)
+MAVLinkLogProcessor::_writeData(const void* data, int len)
 {
-    if(!_error) {
-        _error = fwrite(data, 1, len, _fd) != (size_t)len;
-        if(!_error) {
-            _written += len;
-            if(_record) {
-                _record->setSize(_written);
-            }
-        } else {
-            qCDebug(MAVLinkLogManagerLog) << "File IO error:" << len << "bytes into" << _fileName;
-        }
+    if(!_file) {
+        return;
+    }
+    //-- Write out the block first if the data does not fit, so the block never grows past its preallocated size
+    if(_writeBlock.length() + len > writeBlockSize && !_flush()) {
+        return;
+    }
+    if(len > writeBlockSize) {
+        _writeFile((const char*)data, len);
+    } else {
+        _writeBlock.append((const char*)data, len);
     }
 }
 
 //-----------------------------------------------------------------------------
-QByteArray
-MAVLinkLogProcessor::_writeUlogMessage(QByteArray& data)
+/// Writes directly to the file, failing the log on error
+bool
+MAVLinkLogProcessor::_writeFile(const char* data, int len)
+{
+    if(_file->write(data, len) != len) {
+        qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << _fileName << _file->errorString();
+        _fail();
+        return false;
+    }
+    _written += len;
+    emit writtenChanged(_fileName, _written);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+/// Writes out the block and empties it for reuse
+///     @return false: write failed, the log has been closed
+bool
+MAVLinkLogProcessor::_flush()
+{
+    _flushTimer.restart();
+    if(_writeBlock.isEmpty()) {
+        return true;
+    }
+    bool success = _writeFile(_writeBlock.constData(), _writeBlock.length());
+    //-- The block was never shared and its capacity is reserved, so this keeps the allocation
+    _writeBlock.resize(0);
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+int
+MAVLinkLogProcessor::_writeUlogMessages(const char* data, int len)
 {
     //-- Write ulog data w/o integrity checking, assuming data starts with a
-    //   valid ulog message. returns the remaining data at the end.
-    while(data.length() > 2) {
-        uint8_t* ptr = (uint8_t*)data.data();
+    //   valid ulog message. Returns the number of bytes used by complete messages.
+    int used = 0;
+    while(len - used > 2) {
+        const uint8_t* ptr = (const uint8_t*)data + used;
         int message_length = ptr[0] + (ptr[1] * 256) + 3; // 3 = ULog msg header
-        if(message_length > data.length())
+        if(message_length > len - used)
             break;
-        _writeData(data.data(), message_length);
-        data.remove(0, message_length);
+        used += message_length;
     }
-    return data;
+    _writeData(data, used);
+    return used;
 }
 
 //-----------------------------------------------------------------------------
 bool
-MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, QByteArray data)
+MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray& data)
 {
+    if(!_file) {
+        return false;
+    }
     int num_drops = 0;
-    _error = false;
-    while(_checkSequence(sequence, num_drops)) {
-        //-- The first 16 bytes need special treatment (this sounds awfully brittle)
-        if(!_gotHeader) {
-            if(data.size() < 16) {
-                //-- Shouldn't happen but if it does, we might as well close shop.
-                qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
-                return false;
-            }
-            //-- Write header
-            _writeData(data.data(), 16);
-            data.remove(0, 16);
-            _gotHeader = true;
-            // What about data start offset now that we removed 16 bytes off the start?
-        }
-        if(_gotHeader && num_drops > 0) {
-            if(num_drops > 25) num_drops = 25;
-            //-- Hocus Pocus
-            //   Write a dropout message. We don't really know the actual duration,
-            //   so just use the number of drops * 10 ms
-            uint8_t bogus[] = {2, 0, 79, 0, 0};
-            bogus[3] = num_drops * 10;
-            _writeData(bogus, sizeof(bogus));
-        }
-        if(num_drops > 0) {
-            _writeUlogMessage(_ulogMessage);
-            _ulogMessage.clear();
-            //-- If no useful information in this message. Drop it.
-            if(first_message == 255) {
-                break;
-            }
-            if(first_message > 0) {
-                data.remove(0, first_message);
-                first_message = 0;
-            }
-        }
-        if(first_message == 255 && _ulogMessage.length() > 0) {
-            _ulogMessage.append(data);
-            break;
-        }
-        if(_ulogMessage.length()) {
-            _writeData(_ulogMessage.data(), _ulogMessage.length());
-            if(first_message) {
-                _writeData(data.left(first_message).data(), first_message);
-            }
-            _ulogMessage.clear();
+    if(!_checkSequence(sequence, num_drops)) {
+        return _file != NULL;
+    }
+    const char* ptr = data.constData();
+    int len = data.length();
+    //-- The first 16 bytes need special treatment (this sounds awfully brittle)
+    if(!_gotHeader) {
+        if(len < 16) {
+            //-- Shouldn't happen but if it does, we might as well close shop.
+            qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
+            _fail();
+            return false;
         }
-        if(first_message) {
-            data.remove(0, first_message);
+        //-- Write header
+        _writeData(ptr, 16);
+        ptr += 16;
+        len -= 16;
+        _gotHeader = true;
+        // What about data start offset now that we removed 16 bytes off the start?
+    }
+    if(num_drops > 0) {
+        if(num_drops > 25) num_drops = 25;
+        //-- Hocus Pocus
+        //   Write a dropout message. We don't really know the actual duration,
+        //   so just use the number of drops * 10 ms
+        uint8_t bogus[] = {2, 0, 79, 0, 0};
+        bogus[3] = num_drops * 10;
+        _writeData(bogus, sizeof(bogus));
+        _writeUlogMessages(_ulogMessage.constData(), _ulogMessage.length());
+        _ulogMessage.resize(0);
+        //-- If no useful information in this message. Drop it.
+        if(first_message == 255) {
+            return _file != NULL;
         }
-        _ulogMessage = _writeUlogMessage(data);
-        break;
     }
-    return !_error;
+    if(first_message == 255 && _ulogMessage.length() > 0) {
+        _ulogMessage.append(ptr, len);
+        return _file != NULL;
+    }
+    int start = qMin((int)first_message, len);
+    if(_ulogMessage.length()) {
+        //-- Complete the message continued from the previous LOGGING_DATA
+        _writeData(_ulogMessage.constData(), _ulogMessage.length());
+        _writeData(ptr, start);
+        _ulogMessage.resize(0);
+    }
+    ptr += start;
+    len -= start;
+    int used = _writeUlogMessages(ptr, len);
+    _ulogMessage.append(ptr + used, len - used);
+    if(_file && _flushTimer.elapsed() > flushMsecs) {
+        _flush();
+    }
+    return _file != NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -306,6 +375,10 @@ MAVLinkLogManager::MAVLinkLogManager(QGCApplication* app, QGCToolbox* toolbox)
     , _logRunning(false)
     , _loggingDisabled(false)
     , _logProcessor(NULL)
+    , _logThread(NULL)
+    , _logRecord(NULL)
+    , _droppedMessages(0)
+    , _sequenceGaps(0)
     , _deleteAfterUpload(false)
     , _windSpeed(-1)
     , _publicLog(false)
@@ -328,6 +401,12 @@ MAVLinkLogManager::MAVLinkLogManager(QGCApplication* app, QGCToolbox* toolbox)
 //-----------------------------------------------------------------------------
 MAVLinkLogManager::~MAVLinkLogManager()
 {
+    if(_logThread) {
+        //-- Queued behind any log data still on its way to the processor, so it all reaches the disk
+        QMetaObject::invokeMethod(_logProcessor, "_closeAndQuit", Qt::QueuedConnection);
+        _logThread->wait();
+        delete _logProcessor;
+    }
     _logFiles.clear();
 }
 
@@ -349,15 +428,28 @@ MAVLinkLogManager::setToolbox(QGCToolbox* toolbox)
         }
     }
     if(!_loggingDisabled) {
-        //-- Load current list of logs
+        qCDebug(MAVLinkLogManagerLog) << "MAVLink logs directory:" << _logPath;
+        connect(toolbox->multiVehicleManager(), &MultiVehicleManager::activeVehicleChanged, this, &MAVLinkLogManager::_activeVehicleChanged);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::deferredInit(void)
+{
+    if(!_loggingDisabled) {
+        //-- Load current list of logs. Log directory can be large so this is not done until the UI is up.
         QString filter = "*";
         filter += _ulogExtension;
         QDirIterator it(_logPath, QStringList() << filter, QDir::Files);
         while(it.hasNext()) {
-            _insertNewLog(new MAVLinkLogFiles(this, it.next()));
+            QString logFile = it.next();
+            //-- Logging may have started before the scan ran
+            if(!_logRecord || _logRecord->name() != QFileInfo(logFile).baseName()) {
+                _insertNewLog(new MAVLinkLogFiles(this, logFile));
+            }
         }
-        qCDebug(MAVLinkLogManagerLog) << "MAVLink logs directory:" << _logPath;
-        connect(toolbox->multiVehicleManager(), &MultiVehicleManager::activeVehicleChanged, this, &MAVLinkLogManager::_activeVehicleChanged);
+        emit logFilesChanged();
     }
 }
 
@@ -630,20 +722,9 @@ MAVLinkLogManager::stopLogging()
         //-- Tell vehicle to stop sending logs
         _vehicle->stopMavlinkLog();
     }
-    if(_logProcessor) {
-        _logProcessor->close();
-        if(_logProcessor->record()) {
-            _logProcessor->record()->setWriting(false);
-            if(_enableAutoUpload) {
-                //-- Queue log for auto upload (set selected flag)
-                _logProcessor->record()->setSelected(true);
-                if(!uploading()) {
-                    uploadLog();
-                }
-            }
-        }
-        delete _logProcessor;
-        _logProcessor = NULL;
+    if(_logRecord) {
+        //-- The log is queued for upload once the processor has closed it (see _logFileClosed)
+        _closeLog(false);
         _logRunning = false;
         emit logRunningChanged();
     }
@@ -858,15 +939,8 @@ MAVLinkLogManager::_activeVehicleChanged(Vehicle* vehicle)
 void
 MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, QByteArray data, bool /*acked*/)
 {
-    if(_logProcessor && _logProcessor->valid()) {
-        if(!_logProcessor->processStreamData(sequence, first_message, data)) {
-            qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << _logProcessor->fileName();
-            delete _logProcessor;
-            _logProcessor = NULL;
-            _logRunning = false;
-            _vehicle->stopMavlinkLog();
-            emit logRunningChanged();
-        }
+    if(_logRecord) {
+        emit _logDataOnThread(sequence, first_message, data);
     } else {
         qCWarning(MAVLinkLogManagerLog) << "MAVLink log data received when not expected.";
     }
@@ -900,13 +974,10 @@ void
 MAVLinkLogManager::_discardLog()
 {
     //-- Delete (empty) log file (and record)
-    if(_logProcessor) {
-        _logProcessor->close();
-        if(_logProcessor->record()) {
-            _deleteLog(_logProcessor->record());
-        }
-        delete _logProcessor;
-        _logProcessor = NULL;
+    if(_logRecord) {
+        MAVLinkLogFiles* record = _logRecord;
+        _closeLog(true /* remove */);
+        _deleteLog(record);
     }
     _logRunning = false;
     emit logRunningChanged();
@@ -916,20 +987,113 @@ MAVLinkLogManager::_discardLog()
 bool
 MAVLinkLogManager::_createNewLog()
 {
-    if(_logProcessor) {
-        delete _logProcessor;
-        _logProcessor = NULL;
+    if(_logRecord) {
+        _closeLog(false);
     }
-    _logProcessor = new MAVLinkLogProcessor;
-    if(_logProcessor->create(this, _logPath, _vehicle->id())) {
-        _insertNewLog(_logProcessor->record());
-        emit logFilesChanged();
-    } else {
-        qCWarning(MAVLinkLogManagerLog) << "Could not create MAVLink log file:" << _logProcessor->fileName();
-        delete _logProcessor;
-        _logProcessor = NULL;
+    if(!_logThread) {
+        _logThread = new QThread(this);
+        _logProcessor = new MAVLinkLogProcessor;
+        _logProcessor->moveToThread(_logThread);
+        connect(this, &MAVLinkLogManager::_openLogOnThread,  _logProcessor, &MAVLinkLogProcessor::open);
+        connect(this, &MAVLinkLogManager::_logDataOnThread,  _logProcessor, &MAVLinkLogProcessor::processStreamData);
+        connect(this, &MAVLinkLogManager::_closeLogOnThread, _logProcessor, &MAVLinkLogProcessor::close);
+        connect(_logProcessor, &MAVLinkLogProcessor::dropStatsChanged,  this, &MAVLinkLogManager::_logDropStatsChanged);
+        connect(_logProcessor, &MAVLinkLogProcessor::writtenChanged,    this, &MAVLinkLogManager::_logWrittenChanged);
+        connect(_logProcessor, &MAVLinkLogProcessor::failed,            this, &MAVLinkLogManager::_logFailed);
+        connect(_logProcessor, &MAVLinkLogProcessor::closed,            this, &MAVLinkLogManager::_logFileClosed);
+        _logThread->start();
+    }
+    QString fileName;
+    fileName.sprintf("%s/%03d-%s%s",
+                     _logPath.toLatin1().data(),
+                     _vehicle->id(),
+                     QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz").toLocal8Bit().data(),
+                     _ulogExtension.toLocal8Bit().data());
+    //-- Create the file here so failures are reported right away. The processor opens it on its own thread.
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(MAVLinkLogManagerLog) << "Could not create MAVLink log file:" << fileName;
+        return false;
+    }
+    file.close();
+    _logRecord = new MAVLinkLogFiles(this, fileName, true);
+    _logRecord->setWriting(true);
+    _droppedMessages = 0;
+    _sequenceGaps = 0;
+    emit dropStatsChanged();
+    _insertNewLog(_logRecord);
+    emit logFilesChanged();
+    emit _openLogOnThread(fileName);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::_closeLog(bool remove)
+{
+    _logRecord = NULL;
+    emit _closeLogOnThread(remove);
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::_logFileClosed(QString fileName, bool success)
+{
+    if(!success) {
+        qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << fileName;
+    }
+    for(int i = 0; i < _logFiles.count(); i++) {
+        MAVLinkLogFiles* f = qobject_cast<MAVLinkLogFiles*>(_logFiles.get(i));
+        if(f && _makeFilename(f->name()) == fileName) {
+            f->setWriting(false);
+            f->setSize((quint32)QFileInfo(fileName).size());
+            if(_enableAutoUpload && success) {
+                //-- Queue log for auto upload (set selected flag)
+                f->setSelected(true);
+                if(!uploading()) {
+                    uploadLog();
+                }
+            }
+            break;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::_logDropStatsChanged(QString fileName, int numDrops, int sequenceGaps)
+{
+    //-- Ignore stats from a log which has been closed since
+    if(_logRecord && _makeFilename(_logRecord->name()) == fileName) {
+        _droppedMessages = numDrops;
+        _sequenceGaps = sequenceGaps;
+        emit dropStatsChanged();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::_logWrittenChanged(QString fileName, quint32 written)
+{
+    if(_logRecord && _makeFilename(_logRecord->name()) == fileName) {
+        _logRecord->setSize(written);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogManager::_logFailed(QString fileName)
+{
+    qCWarning(MAVLinkLogManagerLog) << "MAVLink log failed:" << fileName;
+    if(_logRecord && _makeFilename(_logRecord->name()) == fileName) {
+        //-- The processor has already closed the log, stop the vehicle from sending more
+        _logRecord = NULL;
+        _logRunning = false;
+        if(_vehicle) {
+            _vehicle->stopMavlinkLog();
+        }
+        emit logRunningChanged();
     }
-    return _logProcessor != NULL;
 }
 
 //-----------------------------------------------------------------------------
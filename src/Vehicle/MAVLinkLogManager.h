@@ -12,6 +12,7 @@
 #define MAVLinkLogManager_H
 
 #include <QObject>
+#include <QElapsedTimer>
 
 #include "QmlObjectListModel.h"
 #include "QGCLoggingCategory.h"
@@ -21,6 +22,8 @@
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkLogManagerLog)
 
 class QNetworkAccessManager;
+class QFile;
+class QThread;
 class MAVLinkLogManager;
 
 //-----------------------------------------------------------------------------
@@ -73,31 +76,65 @@ private:
 };
 
 //-----------------------------------------------------------------------------
-class MAVLinkLogProcessor
+/// Re-assembles the ULog stream sent in LOGGING_DATA messages and writes it to disk. MAVLinkLogManager runs the
+/// processor on its own thread and feeds it through queued signals, so neither stream assembly nor file I/O happen
+/// on the GUI thread. Complete ULog messages are collected in a single preallocated block which is written out and
+/// reused once full. One log is processed at a time.
+class MAVLinkLogProcessor : public QObject
 {
+    Q_OBJECT
+
 public:
     MAVLinkLogProcessor();
     ~MAVLinkLogProcessor();
-    void                close       ();
-    bool                valid       ();
-    bool                create      (MAVLinkLogManager *manager, const QString path, uint8_t id);
-    MAVLinkLogFiles*    record      () { return _record; }
-    QString             fileName    () { return _fileName; }
-    bool                processStreamData(uint16_t _sequence, uint8_t first_message, QByteArray data);
+    /// Closes the current log (if any) and starts writing a new one
+    ///     @return false: The file could not be opened, failed has been signalled
+    bool                open        (const QString& fileName);
+    /// Writes out buffered data and closes the log
+    ///     @param remove true: delete the file once it is closed
+    void                close       (bool remove = false);
+    QString             fileName    () const { return _fileName; }
+    /// @return false: The log has failed or is not open
+    bool                processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray& data);
+    int                 numDrops    () const { return _numDrops; }      ///< LOGGING_DATA messages lost so far
+    int                 sequenceGaps() const { return _sequenceGaps; }  ///< Number of gaps the drops occurred in
+    quint32             written     () const { return _written; }       ///< Bytes written to the file so far
+
+    static const int    writeBlockSize = 64 * 1024; ///< Data is written to the file in blocks of up to this size
+    static const int    flushMsecs = 1000;          ///< Partial blocks are written after this long
+
+signals:
+    /// Signalled when LOGGING_DATA messages were lost
+    void                dropStatsChanged(QString fileName, int numDrops, int sequenceGaps);
+    /// Signalled each time data has been written to the file
+    void                writtenChanged  (QString fileName, quint32 written);
+    /// Signalled as soon as the file can not be written or the stream is corrupt. The log is closed, but not removed.
+    void                failed          (QString fileName);
+    /// Signalled once the log has been closed
+    ///     @param success false: The log failed prior to being closed
+    void                closed          (QString fileName, bool success);
+
+private slots:
+    void                _closeAndQuit   ();
+
 private:
     bool                _checkSequence(uint16_t seq, int &num_drops);
-    QByteArray          _writeUlogMessage(QByteArray &data);
-    void                _writeData(void* data, int len);
+    int                 _writeUlogMessages(const char* data, int len);
+    void                _writeData  (const void* data, int len);
+    bool                _writeFile  (const char* data, int len);
+    bool                _flush      ();
+    void                _fail       ();
 private:
-    FILE*               _fd;
+    QFile*              _file;          ///< NULL when no log is open
     quint32             _written;
     int                 _sequence;
     int                 _numDrops;
+    int                 _sequenceGaps;
     bool                _gotHeader;
-    bool                _error;
-    QByteArray          _ulogMessage;
+    QByteArray          _ulogMessage;   ///< Partial ULog message continued in the next LOGGING_DATA
+    QByteArray          _writeBlock;    ///< Complete ULog messages not yet written to the file
+    QElapsedTimer       _flushTimer;
     QString             _fileName;
-    MAVLinkLogFiles*    _record;
 };
 
 //-----------------------------------------------------------------------------
@@ -124,6 +161,8 @@ public:
     Q_PROPERTY(QmlObjectListModel*  logFiles            READ    logFiles                                        NOTIFY logFilesChanged)
     Q_PROPERTY(int                  windSpeed           READ    windSpeed           WRITE setWindSpeed          NOTIFY windSpeedChanged)
     Q_PROPERTY(QString              rating              READ    rating              WRITE setRating             NOTIFY ratingChanged)
+    Q_PROPERTY(int                  droppedMessages     READ    droppedMessages                                 NOTIFY dropStatsChanged)
+    Q_PROPERTY(int                  sequenceGaps        READ    sequenceGaps                                    NOTIFY dropStatsChanged)
 
     Q_INVOKABLE void uploadLog      ();
     Q_INVOKABLE void deleteLog      ();
@@ -146,6 +185,8 @@ public:
     int         windSpeed           () { return _windSpeed; }
     QString     rating              () { return _rating; }
     QString     logExtension        () { return _ulogExtension; }
+    int         droppedMessages     () { return _droppedMessages; }
+    int         sequenceGaps        () { return _sequenceGaps; }
 
     QmlObjectListModel* logFiles    () { return &_logFiles; }
 
@@ -163,6 +204,7 @@ public:
 
     // Override from QGCTool
     void        setToolbox          (QGCToolbox *toolbox);
+    void        deferredInit        (void);
 
 signals:
     void emailAddressChanged        ();
@@ -185,6 +227,12 @@ signals:
     void ratingChanged              ();
     void videoURLChanged            ();
     void publicLogChanged           ();
+    void dropStatsChanged           ();
+
+    // These signals are used to move calls over to the log processor thread
+    void _openLogOnThread           (QString fileName);
+    void _logDataOnThread           (uint16_t sequence, uint8_t first_message, QByteArray data);
+    void _closeLogOnThread          (bool remove);
 
 private slots:
     void _uploadFinished            ();
@@ -194,6 +242,10 @@ private slots:
     void _mavlinkLogData            (Vehicle* vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, QByteArray data, bool acked);
     void _armedChanged              (bool armed);
     void _mavCommandResult          (int vehicleId, int component, int command, int result, bool noReponseFromVehicle);
+    void _logFileClosed             (QString fileName, bool success);
+    void _logDropStatsChanged       (QString fileName, int numDrops, int sequenceGaps);
+    void _logWrittenChanged         (QString fileName, quint32 written);
+    void _logFailed                 (QString fileName);
 
 private:
     bool _sendLog                   (const QString& logFile);
@@ -203,6 +255,7 @@ private:
     void _insertNewLog              (MAVLinkLogFiles* newLog);
     void _deleteLog                 (MAVLinkLogFiles* log);
     void _discardLog                ();
+    void _closeLog                  (bool remove);
     QString _makeFilename           (const QString& baseName);
 
 private:
@@ -220,7 +273,11 @@ private:
     Vehicle*                _vehicle;
     bool                    _logRunning;
     bool                    _loggingDisabled;
-    MAVLinkLogProcessor*    _logProcessor;
+    MAVLinkLogProcessor*    _logProcessor;      ///< Runs on _logThread
+    QThread*                _logThread;
+    MAVLinkLogFiles*        _logRecord;         ///< Log currently being written, NULL if none
+    int                     _droppedMessages;   ///< LOGGING_DATA messages lost in the current (or last) log
+    int                     _sequenceGaps;      ///< Number of gaps _droppedMessages occurred in
     bool                    _deleteAfterUpload;
     int                     _windSpeed;
     QString                 _rating;
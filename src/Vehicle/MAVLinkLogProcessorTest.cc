@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkLogProcessorTest.h"
+#include "MAVLinkLogManager.h"
+
+#include <QDir>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+static const int        _loggingDataLength =    249;    ///< Size of LOGGING_DATA.data
+static const int        _ulogHeaderLength =     16;
+static const uint16_t   _firstSequence =        65500;  ///< Sequence numbers wrap around during the tests
+
+/// Builds a ULog stream: header followed by data messages of varying length, some of which span several LOGGING_DATA
+QByteArray MAVLinkLogProcessorTest::_makeULogStream(int messageCount)
+{
+    QByteArray stream;
+
+    const char header[_ulogHeaderLength] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35, 0x01, 0, 0, 0, 0, 0, 0, 0, 0 };
+    stream.append(header, _ulogHeaderLength);
+
+    for (int i=0; i<messageCount; i++) {
+        int payloadLength = 1 + ((i * 37) % 300);
+        stream.append((char)(payloadLength & 0xFF));
+        stream.append((char)(payloadLength >> 8));
+        stream.append('D');
+        stream.append(QByteArray(payloadLength, (char)(i & 0xFF)));
+    }
+
+    return stream;
+}
+
+/// Splits a ULog stream into LOGGING_DATA messages the way the vehicle sends them
+QList<MAVLinkLogProcessorTest::LoggingData> MAVLinkLogProcessorTest::_packetize(const QByteArray& stream)
+{
+    QList<LoggingData> packets;
+
+    int nextMessage = _ulogHeaderLength;
+    for (int chunkStart=0; chunkStart<stream.length(); chunkStart+=_loggingDataLength) {
+        int chunkEnd = qMin(chunkStart + _loggingDataLength, stream.length());
+
+        while (nextMessage < chunkStart) {
+            const uint8_t* message = (const uint8_t*)stream.constData() + nextMessage;
+            nextMessage += message[0] + (message[1] * 256) + 3;
+        }
+
+        LoggingData packet;
+        packet.sequence = _firstSequence + packets.count();
+        packet.data = stream.mid(chunkStart, chunkEnd - chunkStart);
+        if (nextMessage >= chunkEnd) {
+            packet.firstMessageOffset = 255;
+        } else if (chunkStart == 0) {
+            // The processor strips the header before applying the offset
+            packet.firstMessageOffset = nextMessage - _ulogHeaderLength;
+        } else {
+            packet.firstMessageOffset = nextMessage - chunkStart;
+        }
+        packets.append(packet);
+    }
+
+    return packets;
+}
+
+/// Runs the packets through the processor. The processor is used directly on the test thread.
+/// @return Contents of the log file written
+QByteArray MAVLinkLogProcessorTest::_process(const QList<LoggingData>& packets, MAVLinkLogProcessor* processor)
+{
+    QTemporaryDir   logDir;
+    QString         fileName = QDir(logDir.path()).filePath("test.ulg");
+    QSignalSpy      closedSpy(processor, &MAVLinkLogProcessor::closed);
+
+    if (!processor->open(fileName)) {
+        return QByteArray();
+    }
+
+    foreach (const LoggingData& packet, packets) {
+        if (!processor->processStreamData(packet.sequence, packet.firstMessageOffset, packet.data)) {
+            break;
+        }
+    }
+
+    processor->close();
+    if (closedSpy.count() != 1 || !closedSpy[0][1].toBool()) {
+        return QByteArray();
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+/// Checks that the log consists of the header followed by complete ULog messages
+///     @param dropoutCount Returns the number of dropout messages found
+bool MAVLinkLogProcessorTest::_validMessages(const QByteArray& log, int* dropoutCount)
+{
+    *dropoutCount = 0;
+
+    if (!log.startsWith(_makeULogStream(0))) {
+        return false;
+    }
+
+    int offset = _ulogHeaderLength;
+    while (log.length() - offset >= 3) {
+        const uint8_t* message = (const uint8_t*)log.constData() + offset;
+        if (message[2] == 'O') {
+            (*dropoutCount)++;
+        }
+        offset += message[0] + (message[1] * 256) + 3;
+    }
+
+    return offset == log.length();
+}
+
+void MAVLinkLogProcessorTest::_testReassembly(void)
+{
+    QByteArray          stream = _makeULogStream(2000);
+    MAVLinkLogProcessor processor;
+
+    QByteArray log = _process(_packetize(stream), &processor);
+
+    QCOMPARE(log.length(), stream.length());
+    QVERIFY(log == stream);
+    QCOMPARE(processor.numDrops(), 0);
+    QCOMPARE(processor.sequenceGaps(), 0);
+    QCOMPARE(processor.written(), (quint32)stream.length());
+}
+
+void MAVLinkLogProcessorTest::_testDropAccounting(void)
+{
+    QByteArray          stream = _makeULogStream(2000);
+    QList<LoggingData>  packets = _packetize(stream);
+    MAVLinkLogProcessor processor;
+
+    // A resent packet is ignored, lost packets are counted per gap
+    packets.insert(31, packets[30]);
+    packets.removeAt(22);
+    packets.removeAt(21);
+    packets.removeAt(20);
+    packets.removeAt(5);
+
+    QByteArray log = _process(packets, &processor);
+
+    int dropoutCount;
+    QVERIFY(_validMessages(log, &dropoutCount));
+    QCOMPARE(dropoutCount, 2);
+    QCOMPARE(processor.numDrops(), 4);
+    QCOMPARE(processor.sequenceGaps(), 2);
+    QVERIFY(log.length() < stream.length());
+}
+
+/// A stream of several MB must be written complete and in blocks no larger than the preallocated block
+void MAVLinkLogProcessorTest::_testThroughput(void)
+{
+    QByteArray          stream = _makeULogStream(40000);
+    MAVLinkLogProcessor processor;
+    QSignalSpy          writtenSpy(&processor, &MAVLinkLogProcessor::writtenChanged);
+
+    QByteArray log = _process(_packetize(stream), &processor);
+
+    QCOMPARE(log.length(), stream.length());
+    QVERIFY(log == stream);
+    QCOMPARE(processor.written(), (quint32)stream.length());
+
+    QVERIFY(writtenSpy.count() >= stream.length() / MAVLinkLogProcessor::writeBlockSize);
+    quint32 previousWritten = 0;
+    for (int i=0; i<writtenSpy.count(); i++) {
+        quint32 written = writtenSpy[i][1].toUInt();
+        QVERIFY(written > previousWritten);
+        QVERIFY(written - previousWritten <= (quint32)MAVLinkLogProcessor::writeBlockSize);
+        previousWritten = written;
+    }
+    QCOMPARE(previousWritten, (quint32)stream.length());
+}
+
+/// Failing to open the log must be reported right away and close the log
+void MAVLinkLogProcessorTest::_testOpenFailure(void)
+{
+    QTemporaryDir       logDir;
+    QString             fileName = QDir(logDir.path()).filePath("missing/test.ulg");
+    MAVLinkLogProcessor processor;
+    QSignalSpy          failedSpy(&processor, &MAVLinkLogProcessor::failed);
+    QSignalSpy          closedSpy(&processor, &MAVLinkLogProcessor::closed);
+
+    QCOMPARE(processor.open(fileName), false);
+    QCOMPARE(failedSpy.count(), 1);
+    QCOMPARE(failedSpy[0][0].toString(), fileName);
+    QCOMPARE(closedSpy.count(), 1);
+    QCOMPARE(closedSpy[0][1].toBool(), false);
+
+    // Data for a failed log is rejected
+    QCOMPARE(processor.processStreamData(0, 0, _makeULogStream(1)), false);
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QList>
+
+class MAVLinkLogProcessor;
+
+/// Unit test for MAVLinkLogProcessor. Feeds synthetic LOGGING_DATA into the processor and checks the ULog
+/// file it writes.
+class MAVLinkLogProcessorTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testReassembly(void);
+    void _testDropAccounting(void);
+    void _testThroughput(void);
+    void _testOpenFailure(void);
+
+private:
+    /// A single LOGGING_DATA message
+    struct LoggingData {
+        uint16_t    sequence;
+        uint8_t     firstMessageOffset;
+        QByteArray  data;
+    };
+
+    QByteArray          _makeULogStream(int messageCount);
+    QList<LoggingData>  _packetize(const QByteArray& stream);
+    QByteArray          _process(const QList<LoggingData>& packets, MAVLinkLogProcessor* processor);
+    bool                _validMessages(const QByteArray& log, int* dropoutCount);
+};
@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryPoints.h"
+#include "QGCGeo.h"
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QtMath>
+
+QGC_LOGGING_CATEGORY(TrajectoryPointsLog, "TrajectoryPointsLog")
+
+#ifdef __mobile__
+const int       TrajectoryPoints::_defaultCapacity =        1000;
+#else
+const int       TrajectoryPoints::_defaultCapacity =        5000;
+#endif
+const int       TrajectoryPoints::_unsimplifiedCount =      100;
+const double    TrajectoryPoints::_initialTolerance =       1.0;
+const int       TrajectoryPoints::_maxTolerancePasses =     8;
+
+TrajectoryPoints::TrajectoryPoints(QObject* parent)
+    : QObject   (parent)
+    , _buffer   (_defaultCapacity)
+    , _head     (0)
+    , _count    (0)
+    , _tolerance(_initialTolerance)
+{
+
+}
+
+QVariantList TrajectoryPoints::list(void) const
+{
+    QVariantList path;
+
+    path.reserve(_count);
+    for (int i=0; i<_count; i++) {
+        path.append(QVariant::fromValue(at(i)));
+    }
+
+    return path;
+}
+
+void TrajectoryPoints::append(const QGeoCoordinate& coordinate)
+{
+    if (_count > 0 && at(_count - 1) == coordinate) {
+        // Vehicle has not moved
+        return;
+    }
+
+    if (_count == _buffer.count()) {
+        _compact();
+    }
+    if (_count == _buffer.count()) {
+        // Compaction could not free any space, overwrite the oldest point
+        _head = (_head + 1) % _buffer.count();
+        _count--;
+    }
+
+    _buffer[(_head + _count) % _buffer.count()] = coordinate;
+    _count++;
+
+    emit pointAdded(coordinate);
+}
+
+void TrajectoryPoints::clear(void)
+{
+    _head = 0;
+    _count = 0;
+    _tolerance = _initialTolerance;
+    emit pointsCleared();
+}
+
+void TrajectoryPoints::setCapacity(int capacity)
+{
+    _buffer.resize(qMax(capacity, 2));
+    clear();
+}
+
+/// Simplifies all but the most recent points of the track, doubling the tolerance for up to _maxTolerancePasses passes
+/// until the track fits in three quarters of the buffer. If it still does not fit the oldest remaining points are
+/// dropped. Nothing is changed if there are fewer than three points to simplify.
+void TrajectoryPoints::_compact(void)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int capacity =          _buffer.count();
+    int targetCount =       (capacity * 3) / 4;
+    int unsimplifiedCount = qMin(_unsimplifiedCount, targetCount / 2);
+
+    // Simplification always keeps its end points, so the simplified part stays joined to the unsimplified part
+    int simplifyCount = _count - unsimplifiedCount;
+    if (simplifyCount < 3) {
+        return;
+    }
+
+    // Simplify in a local tangent plane so distances are in meters
+    QGeoCoordinate      tangentOrigin = at(0);
+    QVector<QPointF>    points;
+    points.reserve(simplifyCount);
+    for (int i=0; i<simplifyCount; i++) {
+        double x, y, z;
+        convertGeoToNed(at(i), tangentOrigin, &x, &y, &z);
+        points.append(QPointF(x, y));
+    }
+
+    QVector<bool>   keep;
+    int             keptCount = 0;
+    for (int pass=0; pass<_maxTolerancePasses; pass++) {
+        _simplify(points, _tolerance, keep);
+        keptCount = keep.count(true);
+        if (keptCount + _count - simplifyCount <= targetCount) {
+            break;
+        }
+        _tolerance *= 2;
+    }
+
+    QVector<QGeoCoordinate> compacted;
+    compacted.reserve(keptCount + _count - simplifyCount);
+    for (int i=0; i<simplifyCount; i++) {
+        if (keep[i]) {
+            compacted.append(at(i));
+        }
+    }
+    for (int i=simplifyCount; i<_count; i++) {
+        compacted.append(at(i));
+    }
+
+    // Drop the oldest points if simplification alone was not enough
+    int dropCount = qMax(0, compacted.count() - targetCount);
+
+    _head = 0;
+    _count = compacted.count() - dropCount;
+    for (int i=0; i<_count; i++) {
+        _buffer[i] = compacted[i + dropCount];
+    }
+
+    qCDebug(TrajectoryPointsLog) << "_compact kept:dropped:tolerance:msecs" << _count << dropCount << _tolerance << timer.elapsed();
+
+    emit pointsReplaced();
+}
+
+/// Douglas-Peucker line simplification. Uses an explicit stack so long tracks can not overflow the call stack.
+///     @param[out] keep true for each point which is kept
+void TrajectoryPoints::_simplify(const QVector<QPointF>& points, double tolerance, QVector<bool>& keep)
+{
+    keep.fill(false, points.count());
+    if (points.count() < 3) {
+        keep.fill(true);
+        return;
+    }
+    keep[0] = true;
+    keep[points.count() - 1] = true;
+
+    QVector<QPair<int, int>> ranges;
+    ranges.append(qMakePair(0, points.count() - 1));
+    while (!ranges.isEmpty()) {
+        QPair<int, int> range = ranges.takeLast();
+
+        int     farthestIndex =     -1;
+        double  farthestDistance =  0;
+        for (int i=range.first+1; i<range.second; i++) {
+            double distance = _distanceToSegment(points[i], points[range.first], points[range.second]);
+            if (distance > farthestDistance) {
+                farthestIndex =     i;
+                farthestDistance =  distance;
+            }
+        }
+
+        if (farthestIndex != -1 && farthestDistance > tolerance) {
+            keep[farthestIndex] = true;
+            ranges.append(qMakePair(range.first, farthestIndex));
+            ranges.append(qMakePair(farthestIndex, range.second));
+        }
+    }
+}
+
+double TrajectoryPoints::_distanceToSegment(const QPointF& point, const QPointF& segmentStart, const QPointF& segmentEnd)
+{
+    QPointF segment =       segmentEnd - segmentStart;
+    double  lengthSquared = QPointF::dotProduct(segment, segment);
+
+    QPointF closest = segmentStart;
+    if (lengthSquared > 0) {
+        double t = qBound(0.0, QPointF::dotProduct(point - segmentStart, segment) / lengthSquared, 1.0);
+        closest = segmentStart + (segment * t);
+    }
+
+    QPointF delta = point - closest;
+    return qSqrt(QPointF::dotProduct(delta, delta));
+}
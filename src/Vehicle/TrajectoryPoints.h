@@ -0,0 +1,73 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+
+#include <QObject>
+#include <QGeoCoordinate>
+#include <QPointF>
+#include <QVariantList>
+#include <QVector>
+
+Q_DECLARE_LOGGING_CATEGORY(TrajectoryPointsLog)
+
+/// Vehicle track shown on the map as a single polyline.
+///
+/// Points are held in a fixed capacity ring buffer. When the buffer fills, all but the most recent points are
+/// simplified with Douglas-Peucker, so memory and polyline size stay bounded however long the flight is. The
+/// simplification tolerance is doubled whenever a pass does not free enough space. If the track still does not fit,
+/// the oldest points are dropped.
+class TrajectoryPoints : public QObject
+{
+    Q_OBJECT
+
+public:
+    TrajectoryPoints(QObject* parent = NULL);
+
+    /// @return Full track as a list of QGeoCoordinate, suitable for a MapPolyline path
+    Q_INVOKABLE QVariantList list(void) const;
+
+    int             count       (void) const { return _count; }
+    int             capacity    (void) const { return _buffer.count(); }
+    QGeoCoordinate  at          (int index) const { return _buffer[(_head + index) % _buffer.count()]; }
+    double          tolerance   (void) const { return _tolerance; }
+
+    void append     (const QGeoCoordinate& coordinate);
+    void clear      (void);
+
+    /// Changes the maximum number of points held. Clears the track.
+    void setCapacity(int capacity);
+
+signals:
+    /// A point was added to the end of the track
+    void pointAdded(QGeoCoordinate coordinate);
+
+    /// The track was simplified, the full track must be reloaded with list()
+    void pointsReplaced(void);
+
+    void pointsCleared(void);
+
+private:
+    void _compact(void);
+
+    static void     _simplify               (const QVector<QPointF>& points, double tolerance, QVector<bool>& keep);
+    static double   _distanceToSegment      (const QPointF& point, const QPointF& segmentStart, const QPointF& segmentEnd);
+
+    QVector<QGeoCoordinate> _buffer;
+    int                     _head;          ///< Index in _buffer of the oldest point
+    int                     _count;
+    double                  _tolerance;     ///< Current simplification tolerance in meters
+
+    static const int    _defaultCapacity;
+    static const int    _unsimplifiedCount;     ///< Number of most recent points which are never simplified
+    static const double _initialTolerance;
+    static const int    _maxTolerancePasses;    ///< Maximum simplification passes before the oldest points are dropped
+};
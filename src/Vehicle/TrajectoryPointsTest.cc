@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryPointsTest.h"
+#include "TrajectoryPoints.h"
+
+#include <QSignalSpy>
+
+void TrajectoryPointsTest::_testAppendSignals(void)
+{
+    TrajectoryPoints    trajectory;
+    QGeoCoordinate      coord(47.6, 8.5, 50);
+
+    QSignalSpy pointAddedSpy(&trajectory, &TrajectoryPoints::pointAdded);
+    QSignalSpy pointsClearedSpy(&trajectory, &TrajectoryPoints::pointsCleared);
+
+    trajectory.append(coord);
+    trajectory.append(coord.atDistanceAndAzimuth(10, 0));
+    QCOMPARE(trajectory.count(), 2);
+    QCOMPARE(pointAddedSpy.count(), 2);
+
+    // A vehicle which has not moved does not add a point
+    trajectory.append(coord.atDistanceAndAzimuth(10, 0));
+    QCOMPARE(trajectory.count(), 2);
+    QCOMPARE(pointAddedSpy.count(), 2);
+
+    QVariantList path = trajectory.list();
+    QCOMPARE(path.count(), 2);
+    QCOMPARE(path[0].value<QGeoCoordinate>(), coord);
+
+    trajectory.clear();
+    QCOMPARE(trajectory.count(), 0);
+    QCOMPARE(pointsClearedSpy.count(), 1);
+}
+
+void TrajectoryPointsTest::_testStraightLineSimplified(void)
+{
+    TrajectoryPoints    trajectory;
+    QGeoCoordinate      coord(47.6, 8.5, 50);
+
+    trajectory.setCapacity(500);
+    QSignalSpy pointsReplacedSpy(&trajectory, &TrajectoryPoints::pointsReplaced);
+
+    for (int i=0; i<trajectory.capacity() + 1; i++) {
+        trajectory.append(coord.atDistanceAndAzimuth(i * 5, 45));
+    }
+
+    // The simplified part of a straight line collapses to its end points
+    QCOMPARE(pointsReplacedSpy.count(), 1);
+    QVERIFY(trajectory.count() < trajectory.capacity() / 2);
+    QCOMPARE(trajectory.at(0), coord);
+    QCOMPARE(trajectory.at(trajectory.count() - 1), coord.atDistanceAndAzimuth(trajectory.capacity() * 5, 45));
+}
+
+void TrajectoryPointsTest::_testCornersKept(void)
+{
+    TrajectoryPoints    trajectory;
+    QGeoCoordinate      coord(47.6, 8.5, 50);
+    QGeoCoordinate      corner;
+
+    trajectory.setCapacity(500);
+
+    // Fly out and back along a square so the corners must survive simplification
+    QList<QGeoCoordinate> corners;
+    for (int i=0; i<trajectory.capacity() + 1; i++) {
+        int leg =       (i / 100) % 4;
+        int legStep =   i % 100;
+        if (legStep == 0) {
+            corners.append(coord);
+        }
+        trajectory.append(coord);
+        coord = coord.atDistanceAndAzimuth(5, leg * 90);
+    }
+
+    QVERIFY(trajectory.count() < trajectory.capacity());
+    QVariantList path = trajectory.list();
+    for (int i=0; i<corners.count(); i++) {
+        corner = corners[i];
+        bool found = false;
+        for (int j=0; j<path.count(); j++) {
+            if (path[j].value<QGeoCoordinate>().distanceTo(corner) < 0.01) {
+                found = true;
+                break;
+            }
+        }
+        QVERIFY(found);
+    }
+}
+
+/// Simulates a ten hour flight at one point per second and checks the track stays within capacity
+void TrajectoryPointsTest::_testLongFlightBounded(void)
+{
+    const int cPoints = 10 * 60 * 60;
+
+    TrajectoryPoints    trajectory;
+    QGeoCoordinate      coord(47.6, 8.5, 50);
+
+    for (int i=0; i<cPoints; i++) {
+        // Meander so simplification has something to keep
+        coord = coord.atDistanceAndAzimuth(10, (i * 7) % 360);
+        trajectory.append(coord);
+        QVERIFY(trajectory.count() <= trajectory.capacity());
+    }
+
+    // Most recent point is always the last one appended
+    QCOMPARE(trajectory.at(trajectory.count() - 1), coord);
+}
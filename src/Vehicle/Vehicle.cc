@@ -20,7 +20,6 @@
 #include "PlanMasterController.h"
 #include "GeoFenceManager.h"
 #include "RallyPointManager.h"
-#include "CoordinateVector.h"
 #include "ParameterManager.h"
 #include "QGCApplication.h"
 #include "QGCImageProvider.h"
@@ -245,6 +244,12 @@ Vehicle::Vehicle(LinkInterface*             link,
     _mapTrajectoryTimer.setInterval(_mapTrajectoryMsecsBetweenPoints);
     connect(&_mapTrajectoryTimer, &QTimer::timeout, this, &Vehicle::_addNewMapTrajectoryPoint);
 
+    // Round trip time measurement for the link metrics
+    _timesyncClock.start();
+    _timesyncTimer.setInterval(_timesyncIntervalMSecs);
+    connect(&_timesyncTimer, &QTimer::timeout, this, &Vehicle::_sendTimesync);
+    _timesyncTimer.start();
+
     // Create camera manager instance
     _cameras = _firmwarePlugin->createCameraManager(this);
     emit dynamicCamerasChanged();
@@ -588,6 +593,9 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     case MAVLINK_MSG_ID_RADIO_STATUS:
         _handleRadioStatus(message);
         break;
+    case MAVLINK_MSG_ID_TIMESYNC:
+        _handleTimesync(link, message);
+        break;
     case MAVLINK_MSG_ID_RC_CHANNELS:
         _handleRCChannels(message);
         break;
@@ -1139,6 +1147,50 @@ void Vehicle::_handleHeartbeat(mavlink_message_t& message)
     }
 }
 
+void Vehicle::_sendTimesync(void)
+{
+    // Each link gets its own request with a distinct timestamp, so a response can only be credited to the link it was sent on
+    foreach (LinkInterface* link, _links) {
+        qint64 ts1 = _timesyncClock.nsecsElapsed();
+        while (_timesyncPending.contains(ts1)) {
+            ts1++;
+        }
+        _timesyncPending[ts1] = link;
+
+        mavlink_message_t msg;
+        mavlink_msg_timesync_pack_chan(_mavlink->getSystemId(),
+                                       _mavlink->getComponentId(),
+                                       link->mavlinkChannel(),
+                                       &msg,
+                                       0,           // tc1 0 marks a request
+                                       ts1);
+        sendMessageOnLink(link, msg);
+    }
+
+    // Drop the oldest requests which never got a response
+    while (_timesyncPending.count() > _timesyncMaxPending * qMax(_links.count(), 1)) {
+        _timesyncPending.erase(_timesyncPending.begin());
+    }
+}
+
+void Vehicle::_handleTimesync(LinkInterface* link, mavlink_message_t& message)
+{
+    mavlink_timesync_t timesync;
+    mavlink_msg_timesync_decode(&message, &timesync);
+
+    // Only responses to our own requests, the vehicle may also be syncing with someone else. A response which comes
+    // back over a different link than the request went out on does not measure either link.
+    if (timesync.tc1 == 0 || _timesyncPending.value(timesync.ts1, NULL) != link) {
+        return;
+    }
+
+    // Duplicated or forwarded copies of the response are not counted again
+    _timesyncPending.remove(timesync.ts1);
+
+    qint64 roundTripNsecs = _timesyncClock.nsecsElapsed() - timesync.ts1;
+    link->metrics()->roundTripMeasured(roundTripNsecs / 1000);
+}
+
 void Vehicle::_handleRadioStatus(mavlink_message_t& message)
 {
 
@@ -1854,15 +1906,9 @@ void Vehicle::_rallyPointManagerError(int errorCode, const QString& errorMsg)
 void Vehicle::_addNewMapTrajectoryPoint(void)
 {
     if (_mapTrajectoryHaveFirstCoordinate) {
-        // Keep three minutes of trajectory on mobile due to perf impact of lines
-#ifdef __mobile__
-        if (_mapTrajectoryList.count() * _mapTrajectoryMsecsBetweenPoints > 3 * 1000 * 60) {
-            _mapTrajectoryList.removeAt(0)->deleteLater();
-        }
-#endif
-        _mapTrajectoryList.append(new CoordinateVector(_mapTrajectoryLastCoordinate, _coordinate, this));
         _flightDistanceFact.setRawValue(_flightDistanceFact.rawValue().toDouble() + _mapTrajectoryLastCoordinate.distanceTo(_coordinate));
     }
+    _trajectoryPoints.append(_coordinate);
     _mapTrajectoryHaveFirstCoordinate = true;
     _mapTrajectoryLastCoordinate = _coordinate;
     _flightTimeFact.setRawValue((double)_flightTimer.elapsed() / 1000.0);
@@ -1870,7 +1916,7 @@ void Vehicle::_addNewMapTrajectoryPoint(void)
 
 void Vehicle::_clearTrajectoryPoints(void)
 {
-    _mapTrajectoryList.clearAndDeleteContents();
+    _trajectoryPoints.clear();
 }
 
 void Vehicle::_clearCameraTriggerPoints(void)
@@ -20,6 +20,7 @@
 #include "MAVLinkProtocol.h"
 #include "UASMessageHandler.h"
 #include "SettingsFact.h"
+#include "TrajectoryPoints.h"
 
 class UAS;
 class UASInterface;
@@ -250,7 +251,7 @@ public:
     Q_PROPERTY(QStringList          flightModes             READ flightModes                                            CONSTANT)
     Q_PROPERTY(QString              flightMode              READ flightMode             WRITE setFlightMode             NOTIFY flightModeChanged)
     Q_PROPERTY(bool                 hilMode                 READ hilMode                WRITE setHilMode                NOTIFY hilModeChanged)
-    Q_PROPERTY(QmlObjectListModel*  trajectoryPoints        READ trajectoryPoints                                       CONSTANT)
+    Q_PROPERTY(TrajectoryPoints*    trajectoryPoints        READ trajectoryPoints                                       CONSTANT)
     Q_PROPERTY(QmlObjectListModel*  cameraTriggerPoints     READ cameraTriggerPoints                                    CONSTANT)
     Q_PROPERTY(float                latitude                READ latitude                                               NOTIFY coordinateChanged)
     Q_PROPERTY(float                longitude               READ longitude                                              NOTIFY coordinateChanged)
@@ -531,7 +532,7 @@ public:
     QString prearmError(void) const { return _prearmError; }
     void setPrearmError(const QString& prearmError);
 
-    QmlObjectListModel* trajectoryPoints(void) { return &_mapTrajectoryList; }
+    TrajectoryPoints* trajectoryPoints(void) { return &_trajectoryPoints; }
     QmlObjectListModel* cameraTriggerPoints(void) { return &_cameraTriggerPoints; }
     QmlObjectListModel* adsbVehicles(void) { return &_adsbVehicles; }
 
@@ -813,6 +814,7 @@ private slots:
     void _sendMessageOnLink(LinkInterface* link, mavlink_message_t message);
     void _sendMessageMultipleNext(void);
     void _addNewMapTrajectoryPoint(void);
+    void _sendTimesync(void);
     void _parametersReady(bool parametersReady);
     void _remoteControlRSSIChanged(uint8_t rssi);
     void _handleFlightModeChanged(const QString& flightMode);
@@ -852,6 +854,7 @@ private:
     void _handleHomePosition(mavlink_message_t& message);
     void _handleHeartbeat(mavlink_message_t& message);
     void _handleRadioStatus(mavlink_message_t& message);
+    void _handleTimesync(LinkInterface* link, mavlink_message_t& message);
     void _handleRCChannels(mavlink_message_t& message);
     void _handleRCChannelsRaw(mavlink_message_t& message);
     void _handleBatteryStatus(mavlink_message_t& message);
@@ -1010,11 +1013,18 @@ private:
 
     QTime               _flightTimer;
     QTimer              _mapTrajectoryTimer;
-    QmlObjectListModel  _mapTrajectoryList;
+    TrajectoryPoints    _trajectoryPoints;
     QGeoCoordinate      _mapTrajectoryLastCoordinate;
     bool                _mapTrajectoryHaveFirstCoordinate;
     static const int    _mapTrajectoryMsecsBetweenPoints = 1000;
 
+    // TIMESYNC requests used to measure the round trip time of each link for the link metrics
+    QTimer              _timesyncTimer;
+    QElapsedTimer       _timesyncClock;
+    QMap<qint64, LinkInterface*> _timesyncPending;      ///< Requests still waiting for a response, link each was sent on by timestamp
+    static const int    _timesyncIntervalMSecs = 5000;
+    static const int    _timesyncMaxPending = 4;        ///< Maximum requests waiting for a response per link
+
     QmlObjectListModel  _cameraTriggerPoints;
 
     QmlObjectListModel              _adsbVehicles;
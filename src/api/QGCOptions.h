@@ -90,6 +90,10 @@ public:
     /// the Advanced options.
     virtual QString firmwareUpgradeSingleURL        () const { return QString(); }
 
+    /// By returning true tool initialization which is not needed to show the user interface (joystick probing, log file
+    /// scans, ...) is deferred until the first frame has been shown. Same as the --lazy-init command line option.
+    virtual bool    lazyInit                        () const { return false; }
+
 signals:
     void showSensorCalibrationCompassChanged    (bool show);
     void showSensorCalibrationGyroChanged       (bool show);
@@ -20,6 +20,7 @@
 
 #include "QGCMAVLink.h"
 #include "LinkConfiguration.h"
+#include "LinkMetrics.h"
 
 class LinkManager;
 
@@ -78,14 +79,6 @@ public:
     /// @return true: This link is replaying a log file, false: Normal two-way communication link
     virtual bool isLogReplay(void) { return false; }
 
-    /**
-     * @Enable/Disable data rate collection
-     **/
-    void enableDataRate(bool enable)
-    {
-        _enableRateCollection = enable;
-    }
-
     /**
      * @Brief Get the current incoming data rate.
      *
@@ -96,7 +89,7 @@ public:
      **/
     qint64 getCurrentInputDataRate() const
     {
-        return _getCurrentDataRate(_inDataIndex, _inDataWriteTimes, _inDataWriteAmounts);
+        return _metrics.dataRate(true, QDateTime::currentMSecsSinceEpoch());
     }
 
     /**
@@ -109,8 +102,11 @@ public:
      **/
     qint64 getCurrentOutputDataRate() const
     {
-        return _getCurrentDataRate(_outDataIndex, _outDataWriteTimes, _outDataWriteAmounts);
+        return _metrics.dataRate(false, QDateTime::currentMSecsSinceEpoch());
     }
+
+    /// Bandwidth and latency metrics of this link, can be read from any thread
+    LinkMetrics* metrics(void) { return &_metrics; }
     
     /// mavlink channel to use for this link, as used by mavlink_parse_char. The mavlink channel is only
     /// set into the link when it is added to LinkManager
@@ -189,14 +185,14 @@ protected:
     // Links are only created by LinkManager so constructor is not public
     LinkInterface(SharedLinkConfigurationPointer& config);
 
-    /// This function logs the send times and amounts of datas for input. Data is used for calculating
-    /// the transmission rate.
+    /// This function logs the receive times and amounts of data for input. Data is used for the link
+    /// metrics and the transmission rate.
     ///     @param byteCount Number of bytes received
     ///     @param time Time in ms send occurred
     void _logInputDataRate(quint64 byteCount, qint64 time);
     
-    /// This function logs the send times and amounts of datas for output. Data is used for calculating
-    /// the transmission rate.
+    /// This function logs the send times and amounts of data for output. Data is used for the link
+    /// metrics and the transmission rate.
     ///     @param byteCount Number of bytes sent
     ///     @param time Time in ms receive occurred
     void _logOutputDataRate(quint64 byteCount, qint64 time);
@@ -204,35 +200,6 @@ protected:
     SharedLinkConfigurationPointer _config;
     
 private:
-    /**
-     * @brief logDataRateToBuffer Stores transmission times/amounts for statistics
-     *
-     * This function logs the send times and amounts of datas to the given circular buffers.
-     * This data is used for calculating the transmission rate.
-     *
-     * @param bytesBuffer[out] The buffer to write the bytes value into.
-     * @param timeBuffer[out] The buffer to write the time value into
-     * @param writeIndex[out] The write index used for this buffer.
-     * @param bytes The amount of bytes transmit.
-     * @param time The time (in ms) this transmission occurred.
-     */
-    void _logDataRateToBuffer(quint64 *bytesBuffer, qint64 *timeBuffer, int *writeIndex, quint64 bytes, qint64 time);
-
-    /**
-     * @brief getCurrentDataRate Get the current data rate given a data rate buffer.
-     *
-     * This function attempts to use the times and number of bytes transmit into a current data rate
-     * estimation. Since it needs to use timestamps to get the timeperiods over when the data was sent,
-     * this is effectively a global data rate over the last _dataRateBufferSize - 1 data points. Also note
-     * that data points older than NOW - dataRateCurrentTimespan are ignored.
-     *
-     * @param index The first valid sample in the data rate buffer. Refers to the oldest time sample.
-     * @param dataWriteTimes The time, in ms since epoch, that each data sample took place.
-     * @param dataWriteAmounts The amount of data (in bits) that was transferred.
-     * @return The bits per second of data transferrence of the interface over the last [-statsCurrentTimespan, 0] timespan.
-     */
-    qint64 _getCurrentDataRate(int index, const qint64 dataWriteTimes[], const quint64 dataWriteAmounts[]) const;
-
     /**
      * @brief Connect this interface logically
      *
@@ -248,26 +215,9 @@ private:
     bool _mavlinkChannelSet;    ///< true: _mavlinkChannel has been set
     uint8_t _mavlinkChannel;    ///< mavlink channel to use for this link, as used by mavlink_parse_char
     
-    static const int _dataRateBufferSize = 20; ///< Specify how many data points to capture for data rate calculations.
-    
-    static const qint64 _dataRateCurrentTimespan = 500; ///< Set the maximum age of samples to use for data calculations (ms).
-    
-    // Implement a simple circular buffer for storing when and how much data was received.
-    // Used for calculating the incoming data rate. Use with *StatsBuffer() functions.
-    int     _inDataIndex;
-    quint64 _inDataWriteAmounts[_dataRateBufferSize]; // In bytes
-    qint64  _inDataWriteTimes[_dataRateBufferSize]; // in ms
-    
-    // Implement a simple circular buffer for storing when and how much data was transmit.
-    // Used for calculating the outgoing data rate. Use with *StatsBuffer() functions.
-    int     _outDataIndex;
-    quint64 _outDataWriteAmounts[_dataRateBufferSize]; // In bytes
-    qint64  _outDataWriteTimes[_dataRateBufferSize]; // in ms
-    
-    mutable QMutex _dataRateMutex; // Mutex for accessing the data rate member variables
+    LinkMetrics _metrics;
 
     bool _active;                       ///< true: link is actively receiving mavlink messages
-    bool _enableRateCollection;
     bool _decodedFirstMavlinkPacket;    ///< true: link has correctly decoded it's first mavlink packet
 };
 
@@ -10,7 +10,9 @@
 #include <QList>
 #include <QApplication>
 #include <QDebug>
+#include <QDir>
 #include <QSignalSpy>
+#include <QTextStream>
 
 #ifndef NO_SERIAL_LINK
 #include "QGCSerialPortInfo.h"
@@ -77,6 +79,8 @@ void LinkManager::setToolbox(QGCToolbox *toolbox)
     connect(&_portListTimer, &QTimer::timeout, this, &LinkManager::_updateAutoConnectLinks);
     _portListTimer.start(_autoconnectUpdateTimerMSecs); // timeout must be long enough to get past bootloader on second pass
 
+    connect(&_linkMetricsTimer, &QTimer::timeout, this, &LinkManager::_saveLinkMetrics);
+    _linkMetricsTimer.start(_linkMetricsIntervalMSecs);
 }
 
 // This should only be used by Qml code
@@ -627,6 +631,8 @@ void LinkManager::shutdown(void)
 {
     setConnectionsSuspended(tr("Shutdown"));
     disconnectAll();
+    _linkMetricsTimer.stop();
+    _linkMetricsFile.close();
 }
 
 QStringList LinkManager::linkTypeStrings(void) const
@@ -934,6 +940,118 @@ QList<LinkInterface*> LinkManager::links(void)
     return rawLinks;
 }
 
+QVariantList LinkManager::linkMetrics(void)
+{
+    QVariantList metricsList;
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    for (int i=0; i<_sharedLinks.count(); i++) {
+        LinkInterface* link = _sharedLinks[i].data();
+        LinkMetrics::Snapshot_t snapshot = link->metrics()->snapshot(now);
+
+        QVariantList histogram;
+        for (int bin=0; bin<snapshot.inputHistogram.count(); bin++) {
+            histogram.append(snapshot.inputHistogram[bin]);
+        }
+
+        QVariantMap metrics;
+        metrics["name"]                 = link->getName();
+        metrics["bytesReceived"]        = snapshot.bytesReceived;
+        metrics["bytesSent"]            = snapshot.bytesSent;
+        metrics["inputDataRate"]        = snapshot.inputDataRate;
+        metrics["outputDataRate"]       = snapshot.outputDataRate;
+        metrics["messagesReceived"]     = snapshot.messagesReceived;
+        metrics["messagesLost"]         = snapshot.messagesLost;
+        metrics["decodeQueueBytes"]     = snapshot.decodeQueueBytes;
+        metrics["decodeQueueBytesMax"]  = snapshot.decodeQueueBytesMax;
+        metrics["jitterUsecs"]          = snapshot.jitterUsecs;
+        metrics["roundTripUsecs"]       = snapshot.roundTripUsecs;
+        metrics["roundTripMinUsecs"]    = snapshot.roundTripMinUsecs;
+        metrics["roundTripMaxUsecs"]    = snapshot.roundTripMaxUsecs;
+        metrics["roundTripAvgUsecs"]    = snapshot.roundTripAvgUsecs;
+        metrics["roundTripCount"]       = snapshot.roundTripCount;
+        metrics["inputHistogram"]       = histogram;
+        metricsList.append(metrics);
+    }
+
+    return metricsList;
+}
+
+void LinkManager::_saveLinkMetrics(void)
+{
+    Fact* linkMetricsSave = _toolbox->settingsManager()->appSettings()->linkMetricsSave();
+
+    if (!linkMetricsSave->rawValue().toBool() || _sharedLinks.count() == 0) {
+        // A new file is started the next time metrics are saved
+        if (_linkMetricsFile.isOpen()) {
+            _linkMetricsFile.close();
+        }
+        return;
+    }
+
+    if (!_linkMetricsFile.isOpen()) {
+        QString saveDirPath = _toolbox->settingsManager()->appSettings()->telemetrySavePath();
+        if (saveDirPath.isEmpty()) {
+            qgcApp()->showMessage(tr("Unable to save link metrics. Application save directory is not set."));
+            linkMetricsSave->setRawValue(false);
+            return;
+        }
+        QDir saveDir(saveDirPath);
+        if (!saveDir.exists()) {
+            qgcApp()->showMessage(tr("Unable to save link metrics. Telemetry save directory \"%1\" does not exist.").arg(saveDirPath));
+            linkMetricsSave->setRawValue(false);
+            return;
+        }
+        QString fileName = QStringLiteral("%1.linkmetrics.csv").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh-mm-ss"));
+        _linkMetricsFile.setFileName(saveDir.absoluteFilePath(fileName));
+        if (!_linkMetricsFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qgcApp()->showMessage(tr("Unable to save link metrics to '%1': %2").arg(_linkMetricsFile.fileName()).arg(_linkMetricsFile.errorString()));
+            linkMetricsSave->setRawValue(false);
+            return;
+        }
+
+        QTextStream header(&_linkMetricsFile);
+        header << "time,link,bytes_received,bytes_sent,input_bps,output_bps,messages_received,messages_lost,"
+                  "decode_queue_bytes,decode_queue_bytes_max,jitter_us,rtt_us,rtt_min_us,rtt_max_us,rtt_avg_us,rtt_count";
+        for (int bin=0; bin<LinkMetrics::histogramBins; bin++) {
+            header << ",histogram_" << bin;
+        }
+        header << "\n";
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QTextStream stream(&_linkMetricsFile);
+
+    for (int i=0; i<_sharedLinks.count(); i++) {
+        LinkInterface* link = _sharedLinks[i].data();
+        LinkMetrics::Snapshot_t snapshot = link->metrics()->snapshot(now);
+        QString name = link->getName();
+
+        stream << now << ",\"" << name.replace("\"", "\"\"") << "\","
+               << snapshot.bytesReceived << ","
+               << snapshot.bytesSent << ","
+               << snapshot.inputDataRate << ","
+               << snapshot.outputDataRate << ","
+               << snapshot.messagesReceived << ","
+               << snapshot.messagesLost << ","
+               << snapshot.decodeQueueBytes << ","
+               << snapshot.decodeQueueBytesMax << ","
+               << snapshot.jitterUsecs << ","
+               << snapshot.roundTripUsecs << ","
+               << snapshot.roundTripMinUsecs << ","
+               << snapshot.roundTripMaxUsecs << ","
+               << snapshot.roundTripAvgUsecs << ","
+               << snapshot.roundTripCount;
+        for (int bin=0; bin<snapshot.inputHistogram.count(); bin++) {
+            stream << "," << snapshot.inputHistogram[bin];
+        }
+        stream << "\n";
+    }
+
+    stream.flush();
+    _linkMetricsFile.flush();
+}
+
 void LinkManager::startAutoConnectedLinks(void)
 {
     SharedLinkConfigurationPointer conf;
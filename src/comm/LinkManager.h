@@ -14,6 +14,7 @@
 #ifndef _LINKMANAGER_H_
 #define _LINKMANAGER_H_
 
+#include <QFile>
 #include <QList>
 #include <QMultiMap>
 #include <QMutex>
@@ -81,6 +82,10 @@ public:
     bool isBluetoothAvailable       (void);
 
     QList<LinkInterface*> links                 (void);
+
+    /// @return Bandwidth and latency metrics of all links, one map of LinkMetrics::Snapshot_t values per link
+    Q_INVOKABLE QVariantList linkMetrics        (void);
+
     QStringList         linkTypeStrings         (void) const;
     QStringList         serialBaudRates         (void);
     QStringList         serialPortStrings       (void);
@@ -191,6 +196,7 @@ private slots:
 #ifndef NO_SERIAL_LINK
     void _activeLinkCheck(void);
 #endif
+    void _saveLinkMetrics(void);
 
 private:
     QmlObjectListModel* _qmlLinkConfigurations  (void) { return &_qmlConfigurations; }
@@ -230,6 +236,10 @@ private:
     static const int    _activeLinkCheckTimeoutMSecs = 15000;   ///< Amount of time to wait for a heatbeat. Keep in mind ArduPilot stack heartbeat is slow to come.
 #endif
 
+    QTimer              _linkMetricsTimer;                      ///< Periodically appends the link metrics to _linkMetricsFile
+    QFile               _linkMetricsFile;                       ///< Open while link metrics are being saved
+    static const int    _linkMetricsIntervalMSecs = 1000;
+
     static const char*  _defaultUPDLinkName;
     static const int    _autoconnectUpdateTimerMSecs;
     static const int    _autoconnectConnectDelayMSecs;
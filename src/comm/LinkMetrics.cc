@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LinkMetrics.h"
+
+#include <QtGlobal>
+
+LinkMetrics::LinkMetrics()
+    : _lastArrivalNsecs(-1)
+    , _lastIntervalNsecs(-1)
+    , _jitterNsecs(0)
+{
+    Direction_t* directions[] = { &_in, &_out };
+    for (size_t i=0; i<sizeof(directions)/sizeof(directions[0]); i++) {
+        for (int j=0; j<_bucketCount; j++) {
+            directions[i]->buckets[j].epoch.store(-1);
+            directions[i]->buckets[j].bytes.store(0);
+        }
+        directions[i]->total.store(0);
+        directions[i]->lastEpoch = -1;
+    }
+    for (int i=0; i<histogramBins; i++) {
+        _histogram[i].store(0);
+    }
+
+    _bytesDecoded.store(0);
+    _decodeQueueMax.store(0);
+    _messagesReceived.store(0);
+    _messagesLost.store(0);
+    _jitterUsecs.store(0);
+    _roundTripUsecs.store(-1);
+    _roundTripMinUsecs.store(-1);
+    _roundTripMaxUsecs.store(-1);
+    _roundTripSumUsecs.store(0);
+    _roundTripCount.store(0);
+
+    _arrivalClock.start();
+}
+
+void LinkMetrics::_atomicMax(QAtomicInteger<quint64>& value, quint64 candidate)
+{
+    quint64 current = value.loadAcquire();
+    while (candidate > current && !value.testAndSetOrdered(current, candidate)) {
+        current = value.loadAcquire();
+    }
+}
+
+void LinkMetrics::_account(Direction_t& direction, quint64 byteCount, qint64 time, bool histogram)
+{
+    qint64 epoch = time / bucketMsecs;
+
+    if (epoch != direction.lastEpoch) {
+        if (histogram && direction.lastEpoch >= 0 && epoch > direction.lastEpoch) {
+            // The last bucket is complete, add it and the idle buckets since to the histogram
+            quint64 bytesPerSecond = direction.buckets[direction.lastEpoch & (_bucketCount - 1)].bytes.loadAcquire() * (1000 / bucketMsecs);
+            int bin = 0;
+            while (bytesPerSecond && bin < histogramBins - 1) {
+                bytesPerSecond >>= 1;
+                bin++;
+            }
+            _histogram[bin].fetchAndAddRelaxed(1);
+            _histogram[0].fetchAndAddRelaxed((quint32)qMin(epoch - direction.lastEpoch - 1, (qint64)_bucketCount));
+        }
+
+        // Buckets are reused every _bucketCount intervals, readers check the epoch before using one
+        Bucket_t& bucket = direction.buckets[epoch & (_bucketCount - 1)];
+        bucket.epoch.storeRelease(-1);
+        bucket.bytes.storeRelease(0);
+        bucket.epoch.storeRelease(epoch);
+        direction.lastEpoch = epoch;
+    }
+
+    direction.buckets[epoch & (_bucketCount - 1)].bytes.fetchAndAddRelease(byteCount);
+    direction.total.fetchAndAddRelease(byteCount);
+}
+
+void LinkMetrics::bytesReceived(quint64 byteCount, qint64 time)
+{
+    _account(_in, byteCount, time, true);
+
+    quint64 received = _in.total.loadAcquire();
+    quint64 decoded = _bytesDecoded.loadAcquire();
+    if (received > decoded) {
+        _atomicMax(_decodeQueueMax, received - decoded);
+    }
+}
+
+void LinkMetrics::bytesSent(quint64 byteCount, qint64 time)
+{
+    _account(_out, byteCount, time, false);
+}
+
+void LinkMetrics::bytesDecoded(quint64 byteCount)
+{
+    _bytesDecoded.fetchAndAddRelease(byteCount);
+}
+
+void LinkMetrics::messageDecoded(void)
+{
+    _messagesReceived.fetchAndAddRelaxed(1);
+
+    qint64 now = _arrivalClock.nsecsElapsed();
+    if (_lastArrivalNsecs >= 0) {
+        qint64 interval = now - _lastArrivalNsecs;
+        if (_lastIntervalNsecs >= 0) {
+            // Interarrival jitter estimator from RFC 3550, section 6.4.1
+            double difference = qAbs(interval - _lastIntervalNsecs);
+            _jitterNsecs += (difference - _jitterNsecs) / 16.0;
+            _jitterUsecs.storeRelease((qint64)(_jitterNsecs / 1000.0));
+        }
+        _lastIntervalNsecs = interval;
+    }
+    _lastArrivalNsecs = now;
+}
+
+void LinkMetrics::messagesLost(int count)
+{
+    if (count > 0) {
+        _messagesLost.fetchAndAddRelaxed(count);
+    }
+}
+
+void LinkMetrics::roundTripMeasured(qint64 usecs)
+{
+    qint64 min = _roundTripMinUsecs.loadAcquire();
+    qint64 max = _roundTripMaxUsecs.loadAcquire();
+
+    _roundTripUsecs.storeRelease(usecs);
+    if (min < 0 || usecs < min) {
+        _roundTripMinUsecs.storeRelease(usecs);
+    }
+    if (usecs > max) {
+        _roundTripMaxUsecs.storeRelease(usecs);
+    }
+    _roundTripSumUsecs.fetchAndAddRelaxed(usecs);
+    _roundTripCount.fetchAndAddRelease(1);
+}
+
+qint64 LinkMetrics::_dataRate(const Direction_t& direction, qint64 time) const
+{
+    // Only use complete buckets
+    qint64 lastEpoch = time / bucketMsecs - 1;
+    qint64 epochCount = rateMsecs / bucketMsecs;
+
+    quint64 bytes = 0;
+    for (qint64 epoch = lastEpoch - epochCount + 1; epoch <= lastEpoch; epoch++) {
+        const Bucket_t& bucket = direction.buckets[epoch & (_bucketCount - 1)];
+        if (bucket.epoch.loadAcquire() == epoch) {
+            bytes += bucket.bytes.loadAcquire();
+        }
+    }
+
+    // bits / s
+    return (qint64)(bytes * 8 * 1000 / (epochCount * bucketMsecs));
+}
+
+qint64 LinkMetrics::dataRate(bool input, qint64 time) const
+{
+    return _dataRate(input ? _in : _out, time);
+}
+
+LinkMetrics::Snapshot_t LinkMetrics::snapshot(qint64 time) const
+{
+    Snapshot_t snapshot;
+
+    quint64 decoded = _bytesDecoded.loadAcquire();
+
+    snapshot.bytesReceived =        _in.total.loadAcquire();
+    snapshot.bytesSent =            _out.total.loadAcquire();
+    snapshot.inputDataRate =        _dataRate(_in, time);
+    snapshot.outputDataRate =       _dataRate(_out, time);
+    snapshot.messagesReceived =     _messagesReceived.loadAcquire();
+    snapshot.messagesLost =         _messagesLost.loadAcquire();
+    snapshot.decodeQueueBytes =     snapshot.bytesReceived > decoded ? snapshot.bytesReceived - decoded : 0;
+    snapshot.decodeQueueBytesMax =  _decodeQueueMax.loadAcquire();
+    snapshot.jitterUsecs =          _jitterUsecs.loadAcquire();
+    snapshot.roundTripUsecs =       _roundTripUsecs.loadAcquire();
+    snapshot.roundTripMinUsecs =    _roundTripMinUsecs.loadAcquire();
+    snapshot.roundTripMaxUsecs =    _roundTripMaxUsecs.loadAcquire();
+    snapshot.roundTripCount =       _roundTripCount.loadAcquire();
+    snapshot.roundTripAvgUsecs =    snapshot.roundTripCount ? _roundTripSumUsecs.loadAcquire() / snapshot.roundTripCount : -1;
+
+    snapshot.inputHistogram.resize(histogramBins);
+    for (int i=0; i<histogramBins; i++) {
+        snapshot.inputHistogram[i] = _histogram[i].loadAcquire();
+    }
+
+    return snapshot;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QVector>
+
+/// Bandwidth and latency metrics of one link. Each metric is fed from a single thread:
+///     - byte counts by the link itself when it reads or writes
+///     - decoded bytes, message arrivals and sequence losses by MAVLinkProtocol
+///     - round trip times by Vehicle, from TIMESYNC exchanges
+/// Everything is published through atomics, so snapshot() can be called from any thread without blocking
+/// the writers.
+class LinkMetrics
+{
+public:
+    LinkMetrics();
+
+    static const int    histogramBins = 24;     ///< Throughput histogram bins, see snapshot()
+    static const qint64 bucketMsecs = 100;      ///< Throughput is accumulated in buckets of this length
+    static const qint64 rateMsecs = 500;        ///< Current data rates are computed over this timespan
+
+    typedef struct {
+        quint64 bytesReceived;
+        quint64 bytesSent;
+        qint64  inputDataRate;                  ///< bits/s over the last rateMsecs
+        qint64  outputDataRate;                 ///< bits/s over the last rateMsecs
+        quint64 messagesReceived;               ///< Decoded MAVLink messages
+        quint64 messagesLost;                   ///< Messages missing according to the sequence numbers
+        quint64 decodeQueueBytes;               ///< Bytes received by the link but not yet decoded
+        quint64 decodeQueueBytesMax;            ///< Largest decode queue seen
+        qint64  jitterUsecs;                    ///< Smoothed message inter-arrival jitter (RFC 3550 estimator)
+        qint64  roundTripUsecs;                 ///< Last round trip time, -1 if none was measured yet
+        qint64  roundTripMinUsecs;
+        qint64  roundTripMaxUsecs;
+        qint64  roundTripAvgUsecs;
+        quint32 roundTripCount;
+        /// Number of bucketMsecs intervals by received throughput. Bin 0 counts intervals without data,
+        /// bin n counts throughputs from 2^(n-1) up to 2^n bytes/s, the last bin everything above.
+        QVector<quint32> inputHistogram;
+    } Snapshot_t;
+
+    /// Account for bytes read from the link. Called from the link's thread.
+    ///     @param time Time in ms since epoch the read occurred
+    void bytesReceived(quint64 byteCount, qint64 time);
+
+    /// Account for bytes written to the link. Called from the link's thread.
+    ///     @param time Time in ms since epoch the write occurred
+    void bytesSent(quint64 byteCount, qint64 time);
+
+    /// Account for bytes which went through the MAVLink parser
+    void bytesDecoded(quint64 byteCount);
+
+    /// Account for a decoded message, used for the message count and inter-arrival jitter
+    void messageDecoded(void);
+
+    /// Account for messages missing in the sequence numbers
+    void messagesLost(int count);
+
+    /// Account for a measured round trip time
+    void roundTripMeasured(qint64 usecs);
+
+    /// @return Current values of all metrics
+    ///     @param time Current time in ms since epoch
+    Snapshot_t snapshot(qint64 time) const;
+
+    /// @return Current data rate in bits/s of the received (input true) or sent data
+    qint64 dataRate(bool input, qint64 time) const;
+
+private:
+    static const int _bucketCount = 64;     ///< Must be a power of two
+
+    typedef struct {
+        QAtomicInteger<qint64>  epoch;      ///< time / bucketMsecs the bucket accumulates
+        QAtomicInteger<quint64> bytes;
+    } Bucket_t;
+
+    typedef struct {
+        Bucket_t                buckets[_bucketCount];
+        QAtomicInteger<quint64> total;
+        qint64                  lastEpoch;  ///< Writer only
+    } Direction_t;
+
+    void _account(Direction_t& direction, quint64 byteCount, qint64 time, bool histogram);
+    qint64 _dataRate(const Direction_t& direction, qint64 time) const;
+    static void _atomicMax(QAtomicInteger<quint64>& value, quint64 candidate);
+
+    Direction_t _in;
+    Direction_t _out;
+
+    QAtomicInteger<quint32>     _histogram[histogramBins];
+
+    QAtomicInteger<quint64>     _bytesDecoded;
+    QAtomicInteger<quint64>     _decodeQueueMax;
+    QAtomicInteger<quint64>     _messagesReceived;
+    QAtomicInteger<quint64>     _messagesLost;
+
+    QElapsedTimer               _arrivalClock;
+    qint64                      _lastArrivalNsecs;  ///< Writer only
+    qint64                      _lastIntervalNsecs; ///< Writer only
+    double                      _jitterNsecs;       ///< Writer only
+    QAtomicInteger<qint64>      _jitterUsecs;
+
+    QAtomicInteger<qint64>      _roundTripUsecs;
+    QAtomicInteger<qint64>      _roundTripMinUsecs;
+    QAtomicInteger<qint64>      _roundTripMaxUsecs;
+    QAtomicInteger<qint64>      _roundTripSumUsecs;
+    QAtomicInteger<quint32>     _roundTripCount;
+};
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkMessageStatistics.h"
+#include "QGC.h"
+
+#include <string.h>
+
+MAVLinkMessageStatistics::MAVLinkMessageStatistics()
+{
+
+}
+
+MAVLinkMessageStatistics::~MAVLinkMessageStatistics()
+{
+    qDeleteAll(_entries);
+}
+
+int MAVLinkMessageStatistics::wireLength(const mavlink_message_t& message)
+{
+    if (message.magic == MAVLINK_STX_MAVLINK1) {
+        // stx + core header + checksum
+        return message.len + MAVLINK_CORE_HEADER_MAVLINK1_LEN + 3;
+    }
+
+    int length = message.len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+    if (message.incompat_flags & MAVLINK_IFLAG_SIGNED) {
+        length += MAVLINK_SIGNATURE_BLOCK_LEN;
+    }
+    return length;
+}
+
+MAVLinkMessageStatistics::Entry_t* MAVLinkMessageStatistics::_findEntry(const mavlink_message_t& message)
+{
+    quint64 key = ((quint64)message.msgid << 16) | ((quint64)message.sysid << 8) | message.compid;
+
+    Entry_t* entry = _updateEntries.value(key, NULL);
+    if (!entry) {
+        entry = new Entry_t;
+        entry->sysid = message.sysid;
+        entry->compid = message.compid;
+        entry->msgid = message.msgid;
+        entry->count.store(0);
+        entry->bytes.store(0);
+        entry->lastReceived.store(0);
+        entry->messageSequence.store(0);
+        memset(&entry->message, 0, sizeof(entry->message));
+
+        _updateEntries.insert(key, entry);
+
+        QMutexLocker lock(&_entriesMutex);
+        _entries.append(entry);
+    }
+
+    return entry;
+}
+
+void MAVLinkMessageStatistics::update(const mavlink_message_t& message)
+{
+    Entry_t* entry = _findEntry(message);
+
+    // The message snapshot is guarded by a sequence count, readers retry if it changed while they copied
+    entry->messageSequence.fetchAndAddOrdered(1);
+    memcpy(&entry->message, &message, sizeof(message));
+    entry->messageSequence.fetchAndAddOrdered(1);
+
+    entry->lastReceived.storeRelease(QGC::groundTimeMilliseconds());
+    entry->bytes.fetchAndAddRelaxed(wireLength(message));
+    entry->count.fetchAndAddRelease(1);
+}
+
+QList<MAVLinkMessageStatistics::Sample_t> MAVLinkMessageStatistics::sample(int sysid, int compid, bool withMessage) const
+{
+    QVector<Entry_t*> entries;
+    {
+        QMutexLocker lock(&_entriesMutex);
+        entries = _entries;
+    }
+
+    QList<Sample_t> samples;
+    foreach (Entry_t* entry, entries) {
+        if ((sysid != 0 && entry->sysid != sysid) || (compid != 0 && entry->compid != compid)) {
+            continue;
+        }
+
+        Sample_t sample;
+        sample.sysid = entry->sysid;
+        sample.compid = entry->compid;
+        sample.msgid = entry->msgid;
+        sample.count = entry->count.loadAcquire();
+        if (sample.count == 0) {
+            continue;
+        }
+        sample.bytes = entry->bytes.load();
+        sample.lastReceived = entry->lastReceived.loadAcquire();
+
+        if (withMessage) {
+            int sequence;
+            do {
+                sequence = entry->messageSequence.loadAcquire();
+                memcpy(&sample.message, &entry->message, sizeof(sample.message));
+            } while ((sequence & 1) || entry->messageSequence.fetchAndAddOrdered(0) != sequence);
+        }
+
+        samples.append(sample);
+    }
+
+    return samples;
+}
+
+void MAVLinkMessageStatistics::clear(void)
+{
+    QMutexLocker lock(&_entriesMutex);
+
+    foreach (Entry_t* entry, _entries) {
+        entry->count.store(0);
+        entry->bytes.store(0);
+    }
+}
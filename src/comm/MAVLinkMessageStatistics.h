@@ -0,0 +1,72 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+
+#include "QGCMAVLink.h"
+
+/// Traffic statistics per system, component and message id. The counters are updated from the MAVLink decode
+/// path with atomics only, and any thread can sample them at its own cadence. Rates are left to the sampler,
+/// which computes them from the count differences between two samples.
+class MAVLinkMessageStatistics
+{
+public:
+    MAVLinkMessageStatistics();
+    ~MAVLinkMessageStatistics();
+
+    /// Snapshot of the statistics of one system/component/message id
+    typedef struct {
+        uint8_t             sysid;
+        uint8_t             compid;
+        uint32_t            msgid;
+        quint32             count;          ///< Messages received
+        quint64             bytes;          ///< Bytes received, including framing and signature
+        quint64             lastReceived;   ///< Ground time of the last message in msecs
+        mavlink_message_t   message;        ///< Last message received, only filled in if requested
+    } Sample_t;
+
+    /// Accounts for a received message. Must always be called from the same thread.
+    void update(const mavlink_message_t& message);
+
+    /// Takes a snapshot of the statistics. Can be called from any thread.
+    ///     @param sysid Only return entries of this system, 0 for all
+    ///     @param compid Only return entries of this component, 0 for all
+    ///     @param withMessage true: copy the last message of each entry into the sample
+    QList<Sample_t> sample(int sysid = 0, int compid = 0, bool withMessage = true) const;
+
+    /// Resets all counters. Entries which received nothing since are left out of samples.
+    void clear(void);
+
+    /// @return Number of bytes the message occupied on the link
+    static int wireLength(const mavlink_message_t& message);
+
+private:
+    typedef struct {
+        uint8_t                 sysid;
+        uint8_t                 compid;
+        uint32_t                msgid;
+        QAtomicInteger<quint32> count;
+        QAtomicInteger<quint64> bytes;
+        QAtomicInteger<quint64> lastReceived;
+        QAtomicInt              messageSequence;    ///< Odd while message is being written
+        mavlink_message_t       message;
+    } Entry_t;
+
+    Entry_t* _findEntry(const mavlink_message_t& message);
+
+    QHash<quint64, Entry_t*>    _updateEntries;     ///< Lookup for the updating thread only
+    mutable QMutex              _entriesMutex;      ///< Protects _entries
+    QVector<Entry_t*>           _entries;           ///< All entries, never deleted before the destructor
+};
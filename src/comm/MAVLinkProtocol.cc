@@ -185,6 +185,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
     mavlink_status_t status;
 
     int mavlinkChannel = link->mavlinkChannel();
+    LinkMetrics* metrics = link->metrics();
 
     static int nonmavlinkCount = 0;
     static bool checkedUserNonMavlink = false;
@@ -297,6 +298,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
             // Increase receive counter
             totalReceiveCounter[mavlinkChannel]++;
             currReceiveCounter[mavlinkChannel]++;
+            metrics->messageDecoded();
 
             // Determine what the next expected sequence number is, accounting for
             // never having seen a message for this system/component pair.
@@ -319,6 +321,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
                 // And log how many were lost for all time and just this timestep
                 totalLossCounter[mavlinkChannel] += lostMessages;
                 currLossCounter[mavlinkChannel] += lostMessages;
+                metrics->messagesLost(lostMessages);
             }
 
             // And update the last sequence number for this system/component pair
@@ -337,12 +340,16 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
                 emit receiveLossTotalChanged(message.sysid, totalLossCounter[mavlinkChannel]);
             }
 
+            _messageStatistics.update(message);
+
             // The packet is emitted as a whole, as it is only 255 - 261 bytes short
             // kind of inefficient, but no issue for a groundstation pc.
             // It buys as reentrancy for the whole code over all threads
             emit messageReceived(link, message);
         }
     }
+
+    metrics->bytesDecoded(b.size());
 }
 
 /**
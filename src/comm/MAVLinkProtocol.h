@@ -23,6 +23,7 @@
 #include "QGCMAVLink.h"
 #include "QGC.h"
 #include "QGCTemporaryFile.h"
+#include "MAVLinkMessageStatistics.h"
 #include "QGCToolbox.h"
 
 class LinkManager;
@@ -86,6 +87,8 @@ public:
     qint32 getDroppedPacketCount(const LinkInterface *link) const {
         return totalLossCounter[link->mavlinkChannel()];
     }
+    /// Per message traffic statistics of all links, can be sampled from any thread
+    MAVLinkMessageStatistics* messageStatistics(void) { return &_messageStatistics; }
     /**
      * Reset the counters for all metadata for this link.
      */
@@ -189,6 +192,8 @@ private:
 
     LinkManager*            _linkMgr;
     MultiVehicleManager*    _multiVehicleManager;
+
+    MAVLinkMessageStatistics _messageStatistics;
 };
 
 #endif // MAVLINKPROTOCOL_H_
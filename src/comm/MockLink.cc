@@ -64,6 +64,7 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
     , _vehicleLongitude                     (_defaultVehicleLongitude + ((_vehicleSystemId - 128) * 0.0001))
     , _vehicleAltitude                      (_defaultVehicleAltitude)
     , _fileServer                           (NULL)
+    , _radioLink                            (NULL)
     , _sendStatusText                       (false)
     , _apmSendHomePositionOnEmptyList       (false)
     , _failureMode                          (MockConfiguration::FailNone)
@@ -71,8 +72,13 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
     , _sendGPSPositionDelayCount            (100)   // No gps lock for 5 seconds
     , _currentParamRequestListComponentIndex(-1)
     , _currentParamRequestListParamIndex    (-1)
+    , _paramSetCount                        (0)
+    , _stallComponentParamIndex             (0)
+    , _logDownloadFileSize                  (1000)
     , _logDownloadCurrentOffset             (0)
     , _logDownloadBytesRemaining            (0)
+    , _logDownloadPacketsPerTick            (1)
+    , _logDownloadLossPercent               (0)
     , _adsbAngle                            (0)
 {
     MockConfiguration* mockConfig = qobject_cast<MockConfiguration*>(_config.data());
@@ -80,6 +86,7 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
     _vehicleType = mockConfig->vehicleType();
     _sendStatusText = mockConfig->sendStatusText();
     _failureMode = mockConfig->failureMode();
+    _radioLink = mockConfig->radioLink();
 
     union px4_custom_mode   px4_cm;
 
@@ -92,6 +99,11 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
 
     moveToThread(this);
 
+    if (_radioLink) {
+        // Everything QGC sends over the shared radio reaches this vehicle as well
+        QObject::connect(_radioLink, &LinkInterface::_invokeWriteBytes, this, &MockLink::_writeBytes);
+    }
+
     _loadParams();
 
     _adsbVehicleCoordinate = QGeoCoordinate(_vehicleLatitude, _vehicleLongitude).atDistanceAndAzimuth(1000, _adsbAngle);
@@ -275,6 +287,14 @@ void MockLink::_loadParams(void)
         _mapParamName2Value[_vehicleComponentId][paramName] = paramValue;
         _mapParamName2MavParamType[paramName] = static_cast<MAV_PARAM_TYPE>(paramType);
     }
+
+    if (_failureMode == MockConfiguration::FailParamComponentStall) {
+        // The second component gets a copy of the first autopilot params
+        QList<QString> paramNames = _mapParamName2Value[_vehicleComponentId].keys();
+        for (int i=0; i<stallComponentParamCount; i++) {
+            _mapParamName2Value[stallComponentId][paramNames[i]] = _mapParamName2Value[_vehicleComponentId][paramNames[i]];
+        }
+    }
 }
 
 void MockLink::_sendHeartBeat(void)
@@ -319,7 +339,11 @@ void MockLink::respondWithMavlinkMessage(const mavlink_message_t& msg)
 
     int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
     QByteArray bytes((char *)buffer, cBuffer);
-    emit bytesReceived(this, bytes);
+    if (_radioLink) {
+        emit _radioLink->bytesReceived(_radioLink, bytes);
+    } else {
+        emit bytesReceived(this, bytes);
+    }
 }
 
 /// @brief Called when QGC wants to write bytes to the MAV
@@ -373,6 +397,12 @@ void MockLink::_handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes)
             continue;
         }
 
+        int targetSystem = _targetSystem(msg);
+        if (targetSystem != 0 && targetSystem != _vehicleSystemId) {
+            // Meant for another vehicle sharing the radio
+            continue;
+        }
+
         if (_missionItemHandler.handleMessage(msg)) {
             continue;
         }
@@ -424,6 +454,47 @@ void MockLink::_handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes)
     }
 }
 
+/// @return Target system of the messages MockLink handles, 0 for a broadcast or a message without a target
+int MockLink::_targetSystem(const mavlink_message_t& msg)
+{
+    switch (msg.msgid) {
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+        return mavlink_msg_mission_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+        return mavlink_msg_mission_request_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+        return mavlink_msg_mission_item_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        return mavlink_msg_mission_count_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_ACK:
+        return mavlink_msg_mission_ack_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_SET_CURRENT:
+        return mavlink_msg_mission_set_current_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+        return mavlink_msg_mission_clear_all_get_target_system(&msg);
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+        return mavlink_msg_param_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_SET_MODE:
+        return mavlink_msg_set_mode_get_target_system(&msg);
+    case MAVLINK_MSG_ID_PARAM_SET:
+        return mavlink_msg_param_set_get_target_system(&msg);
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+        return mavlink_msg_param_request_read_get_target_system(&msg);
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+        return mavlink_msg_file_transfer_protocol_get_target_system(&msg);
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+        return mavlink_msg_command_long_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MANUAL_CONTROL:
+        return mavlink_msg_manual_control_get_target(&msg);
+    case MAVLINK_MSG_ID_LOG_REQUEST_LIST:
+        return mavlink_msg_log_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+        return mavlink_msg_log_request_data_get_target_system(&msg);
+    default:
+        return 0;
+    }
+}
+
 void MockLink::_handleHeartBeat(const mavlink_message_t& msg)
 {
     Q_UNUSED(msg);
@@ -595,49 +666,69 @@ void MockLink::_handleParamRequestList(const mavlink_message_t& msg)
     // Start the worker routine
     _currentParamRequestListComponentIndex = 0;
     _currentParamRequestListParamIndex = 0;
+    _stallComponentParamIndex = 0;
 }
 
-/// Sends the next parameter to the vehicle
-void MockLink::_paramRequestListWorker(void)
+/// Sends the PARAM_VALUE for the specified parameter index
+void MockLink::_sendParamValue(int componentId, int paramIndex)
 {
-    if (_currentParamRequestListComponentIndex == -1) {
-        // Initial request complete
-        return;
-    }
-
-    int componentId = _mapParamName2Value.keys()[_currentParamRequestListComponentIndex];
     int cParameters = _mapParamName2Value[componentId].count();
-    QString paramName = _mapParamName2Value[componentId].keys()[_currentParamRequestListParamIndex];
+    QString paramName = _mapParamName2Value[componentId].keys()[paramIndex];
 
     if ((_failureMode == MockConfiguration::FailMissingParamOnInitialReqest || _failureMode == MockConfiguration::FailMissingParamOnAllRequests) && paramName == _failParam) {
         qCDebug(MockLinkLog) << "Skipping param send:" << paramName;
-    } else {
+        return;
+    }
 
-        char paramId[MAVLINK_MSG_ID_PARAM_VALUE_LEN];
-        mavlink_message_t responseMsg;
+    char paramId[MAVLINK_MSG_ID_PARAM_VALUE_LEN];
+    mavlink_message_t responseMsg;
 
-        Q_ASSERT(_mapParamName2Value[componentId].contains(paramName));
-        Q_ASSERT(_mapParamName2MavParamType.contains(paramName));
+    Q_ASSERT(_mapParamName2Value[componentId].contains(paramName));
+    Q_ASSERT(_mapParamName2MavParamType.contains(paramName));
 
-        MAV_PARAM_TYPE paramType = _mapParamName2MavParamType[paramName];
+    MAV_PARAM_TYPE paramType = _mapParamName2MavParamType[paramName];
 
-        Q_ASSERT(paramName.length() <= MAVLINK_MSG_ID_PARAM_VALUE_LEN);
-        strncpy(paramId, paramName.toLocal8Bit().constData(), MAVLINK_MSG_ID_PARAM_VALUE_LEN);
+    Q_ASSERT(paramName.length() <= MAVLINK_MSG_ID_PARAM_VALUE_LEN);
+    strncpy(paramId, paramName.toLocal8Bit().constData(), MAVLINK_MSG_ID_PARAM_VALUE_LEN);
 
-        qCDebug(MockLinkLog) << "Sending msg_param_value" << componentId << paramId << paramType << _mapParamName2Value[componentId][paramId];
+    qCDebug(MockLinkLog) << "Sending msg_param_value" << componentId << paramId << paramType << _mapParamName2Value[componentId][paramId];
 
-        mavlink_msg_param_value_pack_chan(_vehicleSystemId,
-                                          componentId,                                   // component id
-                                          _mavlinkChannel,
-                                          &responseMsg,                                  // Outgoing message
-                                          paramId,                                       // Parameter name
-                                          _floatUnionForParam(componentId, paramName),   // Parameter value
-                                          paramType,                                     // MAV_PARAM_TYPE
-                                          cParameters,                                   // Total number of parameters
-                                          _currentParamRequestListParamIndex);           // Index of this parameter
-        respondWithMavlinkMessage(responseMsg);
+    mavlink_msg_param_value_pack_chan(_vehicleSystemId,
+                                      componentId,                                   // component id
+                                      _mavlinkChannel,
+                                      &responseMsg,                                  // Outgoing message
+                                      paramId,                                       // Parameter name
+                                      _floatUnionForParam(componentId, paramName),   // Parameter value
+                                      paramType,                                     // MAV_PARAM_TYPE
+                                      cParameters,                                   // Total number of parameters
+                                      paramIndex);                                   // Index of this parameter
+    respondWithMavlinkMessage(responseMsg);
+}
+
+/// Sends the next parameter to the vehicle
+void MockLink::_paramRequestListWorker(void)
+{
+    if (_currentParamRequestListComponentIndex == -1) {
+        // Initial request complete
+        return;
+    }
+
+    if (_failureMode == MockConfiguration::FailParamComponentStall) {
+        // The stall component streams alongside the autopilot until it stops part way through
+        if (_stallComponentParamIndex < _stallComponentStreamCount) {
+            _sendParamValue(stallComponentId, _stallComponentParamIndex++);
+        }
+        if (_mapParamName2Value.keys()[_currentParamRequestListComponentIndex] == stallComponentId) {
+            _currentParamRequestListComponentIndex = -1;
+            return;
+        }
     }
 
+    int componentId = _mapParamName2Value.keys()[_currentParamRequestListComponentIndex];
+    int cParameters = _mapParamName2Value[componentId].count();
+
+    _sendParamValue(componentId, _currentParamRequestListParamIndex);
+
     // Move to next param index
     if (++_currentParamRequestListParamIndex >= cParameters) {
         // We've sent the last parameter for this component, move to next component
@@ -669,6 +760,13 @@ void MockLink::_handleParamSet(const mavlink_message_t& msg)
     Q_ASSERT(_mapParamName2Value[componentId].contains(paramId));
     Q_ASSERT(request.param_type == _mapParamName2MavParamType[paramId]);
 
+    if (_failureMode == MockConfiguration::FailParamSetAckLoss && !_paramSetDroppedNames.contains(paramId) && (_paramSetCount++ % 10) == 0) {
+        // Drop the first PARAM_SET for this parameter as if it was lost on the link
+        qCDebug(MockLinkLog) << "_handleParamSet dropping" << paramId;
+        _paramSetDroppedNames.insert(paramId);
+        return;
+    }
+
     // Save the new value
     _setParamFloatUnionIntoMap(componentId, paramId, request.param_value);
 
@@ -716,6 +814,13 @@ void MockLink::_handleParamRequestRead(const mavlink_message_t& msg)
 
     Q_ASSERT(_mapParamName2Value.contains(componentId));
 
+    if (componentId == stallComponentId) {
+        _stallComponentReadCount.ref();
+        if (_currentParamRequestListComponentIndex != -1) {
+            _stallComponentReadDuringListCount.ref();
+        }
+    }
+
     char paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN + 1];
     paramId[0] = 0;
 
@@ -909,7 +1014,7 @@ void MockLink::_respondWithAutopilotVersion(void)
                                             (uint8_t *)&customVersion,       // os_custom_version,
                                             0,                               // vendor_id,
                                             0,                               // product_id,
-                                            0);                              // uid
+                                            0x4D4F434B00000000ULL | _vehicleSystemId);  // uid, non-zero so vehicles can be told apart by uid
     respondWithMavlinkMessage(msg);
 }
 
@@ -1008,6 +1113,7 @@ MockConfiguration::MockConfiguration(const QString& name)
     , _vehicleType(MAV_TYPE_QUADROTOR)
     , _sendStatusText(false)
     , _failureMode(FailNone)
+    , _radioLink(NULL)
 {
 
 }
@@ -1019,6 +1125,7 @@ MockConfiguration::MockConfiguration(MockConfiguration* source)
     _vehicleType =      source->_vehicleType;
     _sendStatusText =   source->_sendStatusText;
     _failureMode =      source->_failureMode;
+    _radioLink =        source->_radioLink;
 }
 
 void MockConfiguration::copyFrom(LinkConfiguration *source)
@@ -1035,6 +1142,7 @@ void MockConfiguration::copyFrom(LinkConfiguration *source)
     _vehicleType =      usource->_vehicleType;
     _sendStatusText =   usource->_sendStatusText;
     _failureMode =      usource->_failureMode;
+    _radioLink =        usource->_radioLink;
 }
 
 void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
@@ -1140,6 +1248,17 @@ MockLink*  MockLink::startAPMArduSubMockLink(bool sendStatusText, MockConfigurat
     return _startMockLink(mockConfig);
 }
 
+MockLink*  MockLink::startPX4MockLinkOnRadio(MockLink* radioLink)
+{
+    MockConfiguration* mockConfig = new MockConfiguration("PX4 MockLink On Radio");
+
+    mockConfig->setFirmwareType(MAV_AUTOPILOT_PX4);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setRadioLink(radioLink);
+
+    return _startMockLink(mockConfig);
+}
+
 void MockLink::_sendRCChannels(void)
 {
     mavlink_message_t   msg;
@@ -1256,25 +1375,31 @@ void MockLink::_logDownloadWorker(void)
         if (file.open(QIODevice::ReadOnly)) {
             uint8_t buffer[MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN];
 
-            qint64 bytesToRead = qMin(_logDownloadBytesRemaining, (uint32_t)MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
             Q_ASSERT(file.seek(_logDownloadCurrentOffset));
-            Q_ASSERT(file.read((char *)buffer, bytesToRead) == bytesToRead);
-
-            qDebug() << "MockLink::_logDownloadWorker" << _logDownloadCurrentOffset << _logDownloadBytesRemaining;
-
-            mavlink_message_t responseMsg;
-            mavlink_msg_log_data_pack_chan(_vehicleSystemId,
-                                           _vehicleComponentId,
-                                           _mavlinkChannel,
-                                           &responseMsg,
-                                           _logDownloadLogId,
-                                           _logDownloadCurrentOffset,
-                                           bytesToRead,
-                                           &buffer[0]);
-            respondWithMavlinkMessage(responseMsg);
-
-            _logDownloadCurrentOffset += bytesToRead;
-            _logDownloadBytesRemaining -= bytesToRead;
+            for (int i=0; i<_logDownloadPacketsPerTick && _logDownloadBytesRemaining != 0; i++) {
+                qint64 bytesToRead = qMin(_logDownloadBytesRemaining, (uint32_t)MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+                Q_ASSERT(file.read((char *)buffer, bytesToRead) == bytesToRead);
+
+                qCDebug(MockLinkVerboseLog) << "MockLink::_logDownloadWorker" << _logDownloadCurrentOffset << _logDownloadBytesRemaining;
+
+                if (_logDownloadLossPercent > 0 && (qrand() % 100) < _logDownloadLossPercent) {
+                    qCDebug(MockLinkLog) << "MockLink::_logDownloadWorker dropping LOG_DATA" << _logDownloadCurrentOffset;
+                } else {
+                    mavlink_message_t responseMsg;
+                    mavlink_msg_log_data_pack_chan(_vehicleSystemId,
+                                                   _vehicleComponentId,
+                                                   _mavlinkChannel,
+                                                   &responseMsg,
+                                                   _logDownloadLogId,
+                                                   _logDownloadCurrentOffset,
+                                                   bytesToRead,
+                                                   &buffer[0]);
+                    respondWithMavlinkMessage(responseMsg);
+                }
+
+                _logDownloadCurrentOffset += bytesToRead;
+                _logDownloadBytesRemaining -= bytesToRead;
+            }
 
             file.close();
         } else {
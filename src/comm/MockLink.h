@@ -12,6 +12,8 @@
 #define MOCKLINK_H
 
 #include <QMap>
+#include <QSet>
+#include <QAtomicInt>
 #include <QLoggingCategory>
 #include <QGeoCoordinate>
 
@@ -23,6 +25,8 @@
 Q_DECLARE_LOGGING_CATEGORY(MockLinkLog)
 Q_DECLARE_LOGGING_CATEGORY(MockLinkVerboseLog)
 
+class MockLink;
+
 class MockConfiguration : public LinkConfiguration
 {
     Q_OBJECT
@@ -57,10 +61,16 @@ public:
         FailParamNoReponseToRequestList,    // Do no respond to PARAM_REQUEST_LIST
         FailMissingParamOnInitialReqest,    // Not all params are sent on initial request, should still succeed since QGC will re-query missing params
         FailMissingParamOnAllRequests,      // Not all params are sent on initial request, QGC retries will fail as well
+        FailParamSetAckLoss,                // First PARAM_SET for every tenth parameter is dropped, should still succeed since QGC will resend
+        FailParamComponentStall,            // A second component stops streaming part way through PARAM_REQUEST_LIST while the autopilot keeps streaming, should still succeed since QGC will re-request its missing params
     } FailureMode_t;
     FailureMode_t failureMode(void) { return _failureMode; }
     void setFailureMode(FailureMode_t failureMode) { _failureMode = failureMode; }
 
+    /// @param radioLink Vehicle shares the radio of this link, so all of its traffic goes over radioLink instead of its own link. Not saved to settings.
+    MockLink* radioLink(void) { return _radioLink; }
+    void setRadioLink(MockLink* radioLink) { _radioLink = radioLink; }
+
     // Overrides from LinkConfiguration
     LinkType    type            (void) { return LinkConfiguration::TypeMock; }
     void        copyFrom        (LinkConfiguration* source);
@@ -79,6 +89,7 @@ private:
     MAV_TYPE        _vehicleType;
     bool            _sendStatusText;
     FailureMode_t   _failureMode;
+    MockLink*       _radioLink;
 
     static const char* _firmwareTypeKey;
     static const char* _vehicleTypeKey;
@@ -142,15 +153,44 @@ public:
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
     void resetMissionItemHandler(void) { _missionItemHandler.reset(); }
 
+    /// Simulates a slow and lossy link for mission item transfers
+    void setMissionItemLinkSimulation(int latencyMsecs, int readItemLossPercent) { _missionItemHandler.setLinkSimulation(latencyMsecs, readItemLossPercent); }
+
+    /// Returns the number of MISSION_REQUESTs received since the mission item handler was last reset
+    int missionItemReadRequestCount(void) const { return _missionItemHandler.readRequestCount(); }
+
+    /// Returns the maximum number of MISSION_REQUESTs waiting on a response at the same time during the last mission read
+    int missionItemMaxReadRequestsOutstanding(void) const { return _missionItemHandler.maxReadRequestsOutstanding(); }
+
     /// Returns the filename for the simulated log file. Only available after a download is requested.
     QString logDownloadFile(void) { return _logDownloadFilename; }
 
+    /// Sets the size of the simulated log file. Must be called before the log list is requested.
+    void setLogDownloadFileSize(uint32_t fileSize) { _logDownloadFileSize = fileSize; }
+
+    /// Simulates a faster and/or lossy link for log downloads
+    ///     @param packetsPerTick Number of LOG_DATA messages sent per 500hz worker tick
+    ///     @param lossPercent Percentage of LOG_DATA messages which are dropped
+    void setLogDownloadLinkSimulation(int packetsPerTick, int lossPercent) { _logDownloadPacketsPerTick = packetsPerTick; _logDownloadLossPercent = lossPercent; }
+
+    /// Number of PARAM_REQUEST_READs received for stallComponentId
+    int stallComponentReadCount(void) const { return _stallComponentReadCount.loadAcquire(); }
+
+    /// Number of PARAM_REQUEST_READs received for stallComponentId while the PARAM_REQUEST_LIST stream was still in progress
+    int stallComponentReadDuringListCount(void) const { return _stallComponentReadDuringListCount.loadAcquire(); }
+
+    static const int stallComponentId = MAV_COMP_ID_CAMERA; ///< Component which stops streaming with FailParamComponentStall
+    static const int stallComponentParamCount = 50;         ///< Number of params of stallComponentId
+
     static MockLink* startPX4MockLink            (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startGenericMockLink        (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduCopterMockLink  (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduPlaneMockLink   (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduSubMockLink     (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
 
+    /// Starts a PX4 vehicle which shares the radio of radioLink. QGC sees both vehicles on radioLink.
+    static MockLink* startPX4MockLinkOnRadio     (MockLink* radioLink);
+
 private slots:
     virtual void _writeBytes(const QByteArray bytes);
 
@@ -171,6 +211,7 @@ private:
     void _sendHeartBeat(void);
     void _handleIncomingNSHBytes(const char* bytes, int cBytes);
     void _handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes);
+    int _targetSystem(const mavlink_message_t& msg);
     void _loadParams(void);
     void _handleHeartBeat(const mavlink_message_t& msg);
     void _handleSetMode(const mavlink_message_t& msg);
@@ -192,6 +233,7 @@ private:
     void _respondWithAutopilotVersion(void);
     void _sendRCChannels(void);
     void _paramRequestListWorker(void);
+    void _sendParamValue(int componentId, int paramIndex);
     void _logDownloadWorker(void);
     void _sendADSBVehicles(void);
     void _moveADSBVehicle(void);
@@ -224,6 +266,7 @@ private:
     double              _vehicleAltitude;
 
     MockLinkFileServer* _fileServer;
+    MockLink*           _radioLink;     ///< Link whose radio this vehicle shares, NULL to use this link
 
     bool _sendStatusText;
     bool _apmSendHomePositionOnEmptyList;
@@ -235,12 +278,22 @@ private:
     int _currentParamRequestListComponentIndex; // Current component index for param request list workflow, -1 for no request in progress
     int _currentParamRequestListParamIndex;     // Current parameter index for param request list workflow
 
+    int             _paramSetCount;             // PARAM_SETs (resends included) seen for parameters not yet dropped, FailParamSetAckLoss drops every tenth
+    QSet<QString>   _paramSetDroppedNames;      // Parameters which have already had a PARAM_SET dropped by FailParamSetAckLoss
+
+    int             _stallComponentParamIndex;              // Next param index streamed for stallComponentId by FailParamComponentStall
+    QAtomicInt      _stallComponentReadCount;
+    QAtomicInt      _stallComponentReadDuringListCount;
+    static const int _stallComponentStreamCount = 10;       // Number of params streamed for stallComponentId before it stalls
+
     static const uint16_t _logDownloadLogId = 0;        ///< Id of siumulated log file
-    static const uint32_t _logDownloadFileSize = 1000;  ///< Size of simulated log file
 
     QString _logDownloadFilename;           ///< Filename for log download which is in progress
+    uint32_t    _logDownloadFileSize;       ///< Size of simulated log file
     uint32_t    _logDownloadCurrentOffset;  ///< Current offset we are sending from
     uint32_t    _logDownloadBytesRemaining; ///< Number of bytes still to send, 0 = send inactive
+    int         _logDownloadPacketsPerTick; ///< Number of LOG_DATA messages sent per worker tick
+    int         _logDownloadLossPercent;    ///< Percentage of LOG_DATA messages which are dropped
 
     QGeoCoordinate  _adsbVehicleCoordinate;
     double          _adsbAngle;
@@ -11,6 +11,8 @@
 #include "MockLinkFileServer.h"
 #include "MockLink.h"
 
+#include <QTimer>
+
 const MockLinkFileServer::ErrorMode_t MockLinkFileServer::rgFailureModes[] = {
     MockLinkFileServer::errModeNoResponse,
     MockLinkFileServer::errModeNakResponse,
@@ -29,6 +31,8 @@ const MockLinkFileServer::FileTestCase MockLinkFileServer::rgFileTestCases[MockL
     { "multi.qgc",      sizeof(((FileManager::Request*)0)->data) + 1,     2,    false },
 };
 
+const char* MockLinkFileServer::largeFileName = "large.qgc";
+
 // We only support a single fixed session
 const uint8_t MockLinkFileServer::_sessionId = 1;
 
@@ -39,7 +43,11 @@ MockLinkFileServer::MockLinkFileServer(uint8_t systemIdServer, uint8_t component
     _mockLink(mockLink),
     _lastReplyValid(false),
     _lastReplySequence(0),
-    _randomDropsEnabled(false)
+    _randomDropsEnabled(false),
+    _latencyMsecs(0),
+    _readCommandCount(0),
+    _delayedResponseCount(0),
+    _maxDelayedResponseCount(0)
 {
     srand(0); // make sure unit tests are deterministic
 }
@@ -135,6 +143,10 @@ void MockLinkFileServer::_openCommand(uint8_t senderSystemId, uint8_t senderComp
             break;
         }
     }
+    if (path == largeFileName) {
+        found = true;
+        _readFileLength = largeFileLength;
+    }
     if (!found) {
         _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdOpenFileRO);
         return;
@@ -156,6 +168,8 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
     FileManager::Request	response;
     uint16_t				outgoingSeqNumber = _nextSeqNumber(seqNumber);
 
+    _readCommandCount++;
+
     if (request->hdr.session != _sessionId) {
 		_sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdReadFile);
         return;
@@ -208,14 +222,15 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
         return;
     }
     
-    uint32_t readOffset = 0;	// offset into file for reading
-    uint32_t ackOffset = 0;     // offset for ack
-    uint8_t cDataAck;           // number of bytes in ack
+    // A burst is restarted at the offset the client has reached
+    uint32_t readOffset = request->hdr.offset;  // offset into file for reading
+    uint32_t ackOffset = readOffset;            // offset for ack
+    uint8_t cDataAck;                           // number of bytes in ack
     
     while (readOffset < _readFileLength) {
         cDataAck = 0;
         
-        if (readOffset != 0) {
+        if (readOffset != request->hdr.offset) {
             // If we get here it means the client is requesting additional data past the first request
             if (_errMode == errModeNakSecondResponse) {
                 // Nak error all subsequent requests
@@ -240,6 +255,7 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
         response.hdr.offset = ackOffset;
         response.hdr.opcode = FileManager::kRspAck;
         response.hdr.req_opcode = FileManager::kCmdBurstReadFile;
+        response.hdr.burstComplete = 0;
         
         _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
         
@@ -250,6 +266,55 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
     _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
 }
 
+/// @brief Handles Create command requests. Any path is accepted, an existing file is truncated.
+void MockLinkFileServer::_createCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
+{
+    FileManager::Request    response;
+    uint16_t                outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    ensureNullTemination(request);
+
+    _writeFilePath = (char *)request->data;
+    _uploadedFiles[_writeFilePath] = QByteArray();
+
+    response.hdr.opcode = FileManager::kRspAck;
+    response.hdr.req_opcode = FileManager::kCmdCreateFile;
+    response.hdr.session = _sessionId;
+    response.hdr.size = 0;
+
+    _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
+}
+
+/// @brief Handles Write command requests. Writes may arrive out of order, so data is placed at the offset requested.
+void MockLinkFileServer::_writeCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
+{
+    FileManager::Request    response;
+    uint16_t                outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    if (request->hdr.session != _sessionId || _writeFilePath.isEmpty()) {
+        _sendNak(senderSystemId, senderComponentId, FileManager::kErrInvalidSession, outgoingSeqNumber, FileManager::kCmdWriteFile);
+        return;
+    }
+
+    QByteArray& file = _uploadedFiles[_writeFilePath];
+    uint32_t writeEnd = request->hdr.offset + request->hdr.size;
+    if ((uint32_t)file.size() < writeEnd) {
+        file.resize(writeEnd);
+    }
+    file.replace(request->hdr.offset, request->hdr.size, (const char*)request->data, request->hdr.size);
+
+    response.hdr.opcode = FileManager::kRspAck;
+    response.hdr.req_opcode = FileManager::kCmdWriteFile;
+    response.hdr.session = _sessionId;
+    response.hdr.offset = request->hdr.offset;
+
+    // Data contains number of bytes written
+    response.hdr.size = sizeof(uint32_t);
+    response.writeFileLength = request->hdr.size;
+
+    _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
+}
+
 void MockLinkFileServer::_terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
@@ -268,6 +333,7 @@ void MockLinkFileServer::_resetCommand(uint8_t senderSystemId, uint8_t senderCom
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
     
+    _writeFilePath.clear();
     _sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, FileManager::kCmdResetSessions);
     
     emit resetCommandReceived();
@@ -348,6 +414,14 @@ void MockLinkFileServer::handleFTPMessage(const mavlink_message_t& message)
             _streamCommand(message.sysid, message.compid, request, incomingSeqNumber);
             break;
 
+        case FileManager::kCmdCreateFile:
+            _createCommand(message.sysid, message.compid, request, incomingSeqNumber);
+            break;
+
+        case FileManager::kCmdWriteFile:
+            _writeCommand(message.sysid, message.compid, request, incomingSeqNumber);
+            break;
+
         case FileManager::kCmdTerminateSession:
             _terminateCommand(message.sysid, message.compid, request, incomingSeqNumber);
             break;
@@ -413,7 +487,16 @@ void MockLinkFileServer::_sendResponse(uint8_t targetSystemId, uint8_t targetCom
 	    }
 	}
     
-    _mockLink->respondWithMavlinkMessage(_lastReply);
+    if (_latencyMsecs > 0) {
+        mavlink_message_t reply = _lastReply;
+        _maxDelayedResponseCount = qMax(_maxDelayedResponseCount, ++_delayedResponseCount);
+        QTimer::singleShot(_latencyMsecs, this, [this, reply] {
+            _delayedResponseCount--;
+            _mockLink->respondWithMavlinkMessage(reply);
+        });
+    } else {
+        _mockLink->respondWithMavlinkMessage(_lastReply);
+    }
 }
 
 /// @brief Generates the next sequence number given an incoming sequence number. Handles generating
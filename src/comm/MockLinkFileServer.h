@@ -17,6 +17,7 @@
 #include "FileManager.h"
 
 #include <QStringList>
+#include <QMap>
 
 class MockLink;
 
@@ -69,9 +70,29 @@ public:
     
     /// @brief The set of files supported by the mock server for testing purposes. Each one represents a different edge case for testing.
     static const FileTestCase rgFileTestCases[cFileTestCases];
+
+    /// @brief File which spans many burst packets, used to test recovery of parts dropped from a burst. Same contents
+    /// as the test case files.
+    static const char*      largeFileName;
+    static const uint32_t   largeFileLength = 10 * 1024;
     
     void enableRandromDrops(bool enable) { _randomDropsEnabled = enable; }
 
+    /// @brief Delays all responses by the specified amount to simulate the round trip time of a radio link.
+    /// Also restarts counting maxDelayedResponseCount.
+    ///     @param latencyMsecs Response delay, 0 for immediate responses
+    void setLinkSimulation(int latencyMsecs) { _latencyMsecs = latencyMsecs; _delayedResponseCount = 0; _maxDelayedResponseCount = 0; }
+
+    /// @brief Returns the largest number of delayed responses on their way to the client at once since
+    /// setLinkSimulation was called. This is the number of requests the client had in flight.
+    int maxDelayedResponseCount(void) const { return _maxDelayedResponseCount; }
+
+    /// @brief Returns the contents of a file which was uploaded to the server using the Create and Write commands.
+    QByteArray uploadedFile(const QString& path) const { return _uploadedFiles.value(path); }
+
+    /// @brief Returns the number of Read commands received, burst downloads only use them to fill in dropped parts.
+    int readCommandCount(void) const { return _readCommandCount; }
+
 signals:
     /// You can connect to this signal to be notified when the server receives a Terminate command.
     void terminateCommandReceived(void);
@@ -87,6 +108,8 @@ private:
     void _openCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _readCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
 	void _streamCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
+    void _createCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
+    void _writeCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _resetCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     uint16_t _nextSeqNumber(uint16_t seqNumber);
@@ -97,7 +120,7 @@ private:
     QStringList _fileList;  ///< List of files returned by List command
     
     static const uint8_t    _sessionId;
-    uint8_t                 _readFileLength;    ///< Length of active file being read
+    uint32_t                _readFileLength;    ///< Length of active file being read
     ErrorMode_t             _errMode;           ///< Currently set error mode, as specified by setErrorMode
     const uint8_t           _systemIdServer;    ///< System ID for server
     const uint8_t           _componentIdServer; ///< Component ID for server
@@ -108,6 +131,13 @@ private:
     mavlink_message_t _lastReply;
 
     bool _randomDropsEnabled;
+    int  _latencyMsecs;
+    int  _readCommandCount;
+    int  _delayedResponseCount;
+    int  _maxDelayedResponseCount;
+
+    QString                     _writeFilePath;     ///< Path of file open for writing
+    QMap<QString, QByteArray>   _uploadedFiles;     ///< Files written by the client, keyed by path
 };
 
 #endif
@@ -24,6 +24,11 @@ MockLinkMissionItemHandler::MockLinkMissionItemHandler(MockLink* mockLink, MAVLi
     , _failReadRequestListFirstResponse(true)
     , _failReadRequest1FirstResponse(true)
     , _failWriteMissionCountFirstResponse(true)
+    , _linkLatencyMsecs(0)
+    , _readItemLossPercent(0)
+    , _readRequestCount(0)
+    , _readRequestsOutstanding(0)
+    , _maxReadRequestsOutstanding(0)
 {
     Q_ASSERT(mockLink);
 }
@@ -119,6 +124,8 @@ void MockLinkMissionItemHandler::_handleMissionRequestList(const mavlink_message
     qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequestList read sequence";
     
     _failReadRequest1FirstResponse = true;
+    _readRequestsOutstanding = 0;
+    _maxReadRequestsOutstanding = 0;
 
     if (_failureMode == FailReadRequestListNoResponse) {
         qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequestList not responding due to failure mode FailReadRequestListNoResponse";
@@ -163,7 +170,7 @@ void MockLinkMissionItemHandler::_handleMissionRequestList(const mavlink_message
                                             msg.compid,                 // Target is original sender
                                             itemCount,                  // Number of mission items
                                             _requestType);
-        _mockLink->respondWithMavlinkMessage(responseMsg);
+        _respondWithMavlinkMessage(responseMsg);
     }
 }
 
@@ -177,6 +184,9 @@ void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t&
     
     Q_ASSERT(request.target_system == _mockLink->vehicleId());
 
+    _readRequestCount++;
+    _maxReadRequestsOutstanding = qMax(_maxReadRequestsOutstanding, ++_readRequestsOutstanding);
+
     if (_failureMode == FailReadRequest0NoResponse && request.seq == 0) {
         qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequest not responding due to failure mode FailReadRequest0NoResponse";
     } else if (_failureMode == FailReadRequest1NoResponse && request.seq == 1) {
@@ -237,7 +247,12 @@ void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t&
                                                item.param1, item.param2, item.param3, item.param4,
                                                item.x, item.y, item.z,
                                                _requestType);
-            _mockLink->respondWithMavlinkMessage(responseMsg);
+            if (_readItemLossPercent > 0 && (qrand() % 100) < _readItemLossPercent) {
+                qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionRequest dropping response due to link simulation" << request.seq;
+                _readRequestsOutstanding--;
+            } else {
+                _respondWithMavlinkMessage(responseMsg, true /* readResponse */);
+            }
         }
     }
 }
@@ -317,7 +332,7 @@ void MockLinkMissionItemHandler::_requestNextMissionItem(int sequenceNumber)
                                                   _mavlinkProtocol->getComponentId(),
                                                   sequenceNumber,
                                                   _requestType);
-            _mockLink->respondWithMavlinkMessage(message);
+            _respondWithMavlinkMessage(message);
 
             // If response with Mission Item doesn't come before timer fires it's an error
             _startMissionItemResponseTimer();
@@ -339,7 +354,7 @@ void MockLinkMissionItemHandler::_sendAck(MAV_MISSION_RESULT ackType)
                                       _mavlinkProtocol->getComponentId(),
                                       ackType,
                                       _requestType);
-    _mockLink->respondWithMavlinkMessage(message);
+    _respondWithMavlinkMessage(message);
 }
 
 void MockLinkMissionItemHandler::_handleMissionItem(const mavlink_message_t& msg)
@@ -420,3 +435,27 @@ void MockLinkMissionItemHandler::shutdown(void)
         delete _missionItemResponseTimer;
     }
 }
+
+void MockLinkMissionItemHandler::setLinkSimulation(int latencyMsecs, int readItemLossPercent)
+{
+    _linkLatencyMsecs = latencyMsecs;
+    _readItemLossPercent = readItemLossPercent;
+}
+
+void MockLinkMissionItemHandler::_respondWithMavlinkMessage(const mavlink_message_t& msg, bool readResponse)
+{
+    if (_linkLatencyMsecs > 0) {
+        // Timers with the same interval fire in the order they were started, so message order is preserved
+        QTimer::singleShot(_linkLatencyMsecs, this, [this, msg, readResponse]() {
+            if (readResponse) {
+                _readRequestsOutstanding--;
+            }
+            _mockLink->respondWithMavlinkMessage(msg);
+        });
+    } else {
+        if (readResponse) {
+            _readRequestsOutstanding--;
+        }
+        _mockLink->respondWithMavlinkMessage(msg);
+    }
+}
@@ -76,10 +76,22 @@ public:
     void sendUnexpectedMissionRequest(void);
     
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
-    void reset(void) { _missionItems.clear(); }
+    void reset(void) { _missionItems.clear(); _readRequestCount = 0; }
 
     void setSendHomePositionOnEmptyList(bool sendHomePositionOnEmptyList) { _sendHomePositionOnEmptyList = sendHomePositionOnEmptyList; }
 
+    /// Simulates a slow and lossy link for benchmarking mission transfers
+    ///     @param latencyMsecs Delay added to every message sent back to QGC. Must stay well below the 500 msec write
+    ///                         sequence response timeout.
+    ///     @param readItemLossPercent Percentage of MISSION_ITEM responses to read requests which are dropped
+    void setLinkSimulation(int latencyMsecs, int readItemLossPercent);
+
+    /// @return Number of MISSION_REQUESTs received from QGC since the last reset
+    int readRequestCount(void) const { return _readRequestCount; }
+
+    /// @return Maximum number of MISSION_REQUESTs which were waiting on a response at the same time during the last read
+    int maxReadRequestsOutstanding(void) const { return _maxReadRequestsOutstanding; }
+
 private slots:
     void _missionItemResponseTimeout(void);
 
@@ -92,6 +104,7 @@ private:
     void _requestNextMissionItem(int sequenceNumber);
     void _sendAck(MAV_MISSION_RESULT ackType);
     void _startMissionItemResponseTimer(void);
+    void _respondWithMavlinkMessage(const mavlink_message_t& msg, bool readResponse = false);
 
 private:
     MockLink* _mockLink;
@@ -113,6 +126,11 @@ private:
     bool                _failReadRequestListFirstResponse;
     bool                _failReadRequest1FirstResponse;
     bool                _failWriteMissionCountFirstResponse;
+    int                 _linkLatencyMsecs;
+    int                 _readItemLossPercent;
+    int                 _readRequestCount;
+    int                 _readRequestsOutstanding;       ///< MISSION_REQUESTs not yet answered in the current read
+    int                 _maxReadRequestsOutstanding;
 };
 
 #endif
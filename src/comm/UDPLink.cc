@@ -77,10 +77,17 @@ UDPLink::UDPLink(SharedLinkConfigurationPointer& config)
     , _socket(NULL)
     , _udpConfig(qobject_cast<UDPConfiguration*>(config.data()))
     , _connectState(false)
+    , _knownSendersGeneration(-1)
 {
     if (!_udpConfig) {
         qWarning() << "Internal error";
     }
+    for (int i = 0; i < _receiveBufferCount; i++) {
+        // Reserved capacity keeps resize from reallocating when a buffer is cut to the size of a batch
+        QByteArray buffer;
+        buffer.reserve(_receiveBufferSize);
+        _receiveBuffers.append(buffer);
+    }
     moveToThread(this);
 }
 
@@ -175,30 +182,77 @@ void UDPLink::_writeBytes(const QByteArray data)
  **/
 void UDPLink::readBytes()
 {
-    QByteArray databuffer;
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
     while (_socket->hasPendingDatagrams())
     {
-        QByteArray datagram;
-        datagram.resize(_socket->pendingDatagramSize());
-        QHostAddress sender;
-        quint16 senderPort;
-        _socket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-        databuffer.append(datagram);
-        //-- Wait a bit before sending it over
-        if(databuffer.size() > 10 * 1024) {
-            emit bytesReceived(this, databuffer);
-            databuffer.clear();
+        // Batches are handed to the parser in a pool buffer it no longer holds on to, so they are passed on without a copy
+        QByteArray* buffer = NULL;
+        for (int i = 0; i < _receiveBuffers.count(); i++) {
+            if (_receiveBuffers[i].isDetached()) {
+                buffer = &_receiveBuffers[i];
+                break;
+            }
+        }
+        bool pooled = buffer != NULL;
+        if (!pooled) {
+            buffer = &_receiveBuffer;
+        }
+        buffer->resize(_receiveBufferSize);
+
+        // Read as many pending datagrams as fit back to back, so they reach the parser in one piece
+        int used = 0;
+        while (_socket->hasPendingDatagrams() && _socket->pendingDatagramSize() <= _receiveBufferSize - used)
+        {
+            QHostAddress sender;
+            quint16 senderPort;
+            qint64 length = _socket->readDatagram(buffer->data() + used, _receiveBufferSize - used, &sender, &senderPort);
+            if (length < 0) {
+                break;
+            }
+            used += length;
+            _addSender(sender, senderPort);
+        }
+
+        if (used == 0) {
+            break;
         }
-        _logInputDataRate(datagram.length(), QDateTime::currentMSecsSinceEpoch());
+        _logInputDataRate(used, now);
+        if (pooled) {
+            buffer->resize(used);
+            emit bytesReceived(this, *buffer);
+        } else {
+            // The parser is lagging behind and holds every pool buffer. Hand it a right sized copy rather than
+            // pinning another full size buffer until it catches up.
+            emit bytesReceived(this, QByteArray(buffer->constData(), used));
+        }
+    }
+}
+
+/// Add the sender of a datagram to the host list if not yet present, or update its port
+void UDPLink::_addSender(const QHostAddress& sender, quint16 senderPort)
+{
+    // Hosts added or removed by anyone else invalidate what we know
+    int generation = _udpConfig->hostListGeneration();
+    if (generation != _knownSendersGeneration) {
+        _knownSenders.clear();
+        _knownSendersGeneration = generation;
+    }
+
+    // The socket is bound to an IPv4 address so all senders are IPv4. The host list holds one port per host,
+    // so a sender coming back from a new port must update its entry.
+    quint32 address = sender.toIPv4Address();
+    QHash<quint32, quint16>::const_iterator it = _knownSenders.constFind(address);
+    if (it == _knownSenders.constEnd() || it.value() != senderPort) {
         // TODO This doesn't validade the sender. Anything sending UDP packets to this port gets
         // added to the list and will start receiving datagrams from here. Even a port scanner
         // would trigger this.
-        // Add host to broadcast list if not yet present, or update its port
         _udpConfig->addHost(sender.toString(), (int)senderPort);
-    }
-    //-- Send whatever is left
-    if(databuffer.size()) {
-        emit bytesReceived(this, databuffer);
+        _knownSenders[address] = senderPort;
+        // Our own change leaves the rest of what we know valid, anything beyond it does not
+        if (_udpConfig->hostListGeneration() == generation + 1) {
+            _knownSendersGeneration = generation + 1;
+        }
     }
 }
 
@@ -360,6 +414,7 @@ void UDPConfiguration::copyFrom(LinkConfiguration *source)
     if (usource) {
         _localPort = usource->localPort();
         _hosts.clear();
+        _hostListGeneration.fetchAndAddOrdered(1);
         QString host;
         int port;
         if(usource->firstHost(host, port)) {
@@ -538,6 +593,7 @@ void UDPConfiguration::updateSettings()
 
 void UDPConfiguration::_updateHostList()
 {
+    _hostListGeneration.fetchAndAddOrdered(1);
     _hostList.clear();
     QMap<QString, int>::const_iterator it = _hosts.begin();
     while(it != _hosts.end()) {
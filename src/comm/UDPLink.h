@@ -26,6 +26,8 @@
 #include <QMutexLocker>
 #include <QQueue>
 #include <QByteArray>
+#include <QHash>
+#include <QAtomicInt>
 
 #if defined(QGC_ZEROCONF_ENABLED)
 #include <dns_sd.h>
@@ -127,6 +129,11 @@ public:
      */
     QStringList hostList    () { return _hostList; }
 
+    /*!
+     * @brief Get a number which changes whenever the list of target hosts changes
+     */
+    int hostListGeneration  () const { return _hostListGeneration.loadAcquire(); }
+
     /// From LinkConfiguration
     LinkType    type                 () { return LinkConfiguration::TypeUdp; }
     void        copyFrom             (LinkConfiguration* source);
@@ -148,6 +155,7 @@ private:
     QMap<QString, int>::iterator _it;
     QMap<QString, int> _hosts;  ///< ("host", port)
     QStringList _hostList;      ///< Exposed to QML
+    QAtomicInt _hostListGeneration;
     quint16 _localPort;
 };
 
@@ -199,6 +207,7 @@ private:
     void _restartConnection();
 
     void _registerZeroconf(uint16_t port, const std::string& regType);
+    void _addSender(const QHostAddress& sender, quint16 senderPort);
     void _deregisterZeroconf();
 
 #if defined(QGC_ZEROCONF_ENABLED)
@@ -209,6 +218,14 @@ private:
     QUdpSocket*         _socket;
     UDPConfiguration*   _udpConfig;
     bool                _connectState;
+
+    QList<QByteArray>       _receiveBuffers;            ///< Batches are read into these and handed to the parser as is
+    QByteArray              _receiveBuffer;             ///< Used while the parser holds every pool buffer, the parser gets a copy
+    QHash<quint32, quint16> _knownSenders;              ///< Senders already in the host list, IPv4 address to port
+    int                     _knownSendersGeneration;    ///< UDPConfiguration::hostListGeneration _knownSenders is valid for
+
+    static const int        _receiveBufferSize = 64 * 1024; ///< Holds the largest possible datagram
+    static const int        _receiveBufferCount = 4;        ///< Number of batches the parser can hold before we copy
 };
 
 #endif // UDPLINK_H
@@ -40,12 +40,17 @@ private slots:
     void _ackTest(void);
     void _noAckTest(void);
     void _listTest(void);
+    void _uploadTest(void);
+    void _uploadWindowTest(void);
+    void _burstDownloadTest(void);
 	
     // Connected to FileManager listEntry signal
     void listEntry(const QString& entry);
     
 private:
     void _validateFileContents(const QString& filePath, uint8_t length);
+    bool _uploadFile(const QString& localFile, const QString& toPath);
+    bool _burstDownloadFile(const QString& fromPath, const QByteArray& expectedContents);
 
     enum {
         listEntrySignalIndex = 0,
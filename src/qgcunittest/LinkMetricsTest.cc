@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LinkMetricsTest.h"
+#include "LinkMetrics.h"
+
+void LinkMetricsTest::_testThroughput(void)
+{
+    LinkMetrics metrics;
+    const qint64 start = 10000;
+
+    // 100 bytes in each of ten consecutive buckets: 1000 bytes/s
+    for (int i=0; i<10; i++) {
+        metrics.bytesReceived(100, start + i * LinkMetrics::bucketMsecs);
+    }
+    metrics.bytesSent(50, start);
+
+    // Only the last rateMsecs worth of complete buckets count
+    qint64 now = start + 10 * LinkMetrics::bucketMsecs;
+    QCOMPARE(metrics.dataRate(true, now), (qint64)8000);
+    QCOMPARE(metrics.dataRate(false, now), (qint64)0);
+    QCOMPARE(metrics.dataRate(false, start + LinkMetrics::bucketMsecs), (qint64)(50 * 8 * 1000 / LinkMetrics::rateMsecs));
+
+    // Data rates drop to zero once the buckets are older than rateMsecs
+    QCOMPARE(metrics.dataRate(true, now + LinkMetrics::rateMsecs), (qint64)0);
+
+    // Ten idle buckets after the last one with data
+    metrics.bytesReceived(1, start + 20 * LinkMetrics::bucketMsecs);
+
+    LinkMetrics::Snapshot_t snapshot = metrics.snapshot(now);
+    QCOMPARE(snapshot.bytesReceived, (quint64)1001);
+    QCOMPARE(snapshot.bytesSent, (quint64)50);
+    QCOMPARE(snapshot.inputHistogram.count(), LinkMetrics::histogramBins);
+    for (int bin=0; bin<LinkMetrics::histogramBins; bin++) {
+        // 1000 bytes/s falls into the bin of 512 up to 1024 bytes/s
+        quint32 expected = bin == 0 ? 10 : (bin == 10 ? 10 : 0);
+        QCOMPARE(snapshot.inputHistogram[bin], expected);
+    }
+}
+
+void LinkMetricsTest::_testCounters(void)
+{
+    LinkMetrics metrics;
+
+    LinkMetrics::Snapshot_t snapshot = metrics.snapshot(0);
+    QCOMPARE(snapshot.roundTripUsecs, (qint64)-1);
+    QCOMPARE(snapshot.roundTripAvgUsecs, (qint64)-1);
+    QCOMPARE(snapshot.roundTripCount, (quint32)0);
+
+    metrics.bytesReceived(300, 0);
+    metrics.bytesReceived(200, 0);
+    metrics.bytesDecoded(400);
+    metrics.messagesLost(3);
+    metrics.messagesLost(-1);
+    for (int i=0; i<5; i++) {
+        metrics.messageDecoded();
+    }
+    metrics.roundTripMeasured(2000);
+    metrics.roundTripMeasured(1000);
+    metrics.roundTripMeasured(3000);
+
+    snapshot = metrics.snapshot(0);
+    QCOMPARE(snapshot.decodeQueueBytes, (quint64)100);
+    QCOMPARE(snapshot.decodeQueueBytesMax, (quint64)500);
+    QCOMPARE(snapshot.messagesReceived, (quint64)5);
+    QCOMPARE(snapshot.messagesLost, (quint64)3);
+    QVERIFY(snapshot.jitterUsecs >= 0);
+    QCOMPARE(snapshot.roundTripUsecs, (qint64)3000);
+    QCOMPARE(snapshot.roundTripMinUsecs, (qint64)1000);
+    QCOMPARE(snapshot.roundTripMaxUsecs, (qint64)3000);
+    QCOMPARE(snapshot.roundTripAvgUsecs, (qint64)2000);
+    QCOMPARE(snapshot.roundTripCount, (quint32)3);
+}
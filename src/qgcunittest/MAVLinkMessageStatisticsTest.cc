@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkMessageStatisticsTest.h"
+#include "MAVLinkMessageStatistics.h"
+
+#include <QtConcurrent>
+
+#include <string.h>
+
+/// Builds a message with all payload bytes set to fill
+static mavlink_message_t _message(uint8_t sysid, uint8_t compid, uint32_t msgid, uint8_t len, uint8_t fill)
+{
+    mavlink_message_t message;
+
+    memset(&message, 0, sizeof(message));
+    message.magic = MAVLINK_STX;
+    message.sysid = sysid;
+    message.compid = compid;
+    message.msgid = msgid;
+    message.len = len;
+    memset(message.payload64, fill, len);
+
+    return message;
+}
+
+void MAVLinkMessageStatisticsTest::_testCounters(void)
+{
+    MAVLinkMessageStatistics statistics;
+
+    mavlink_message_t heartbeat1 = _message(1, 1, MAVLINK_MSG_ID_HEARTBEAT, 9, 0);
+    mavlink_message_t heartbeat2 = _message(2, 1, MAVLINK_MSG_ID_HEARTBEAT, 9, 0);
+    mavlink_message_t attitude = _message(1, 1, MAVLINK_MSG_ID_ATTITUDE, 28, 7);
+    mavlink_message_t v1 = _message(1, 50, MAVLINK_MSG_ID_ATTITUDE, 28, 7);
+    v1.magic = MAVLINK_STX_MAVLINK1;
+
+    for (int i=0; i<10; i++) {
+        statistics.update(heartbeat1);
+        statistics.update(attitude);
+    }
+    statistics.update(heartbeat2);
+    statistics.update(v1);
+
+    QList<MAVLinkMessageStatistics::Sample_t> samples = statistics.sample();
+    QCOMPARE(samples.count(), 4);
+    foreach (const MAVLinkMessageStatistics::Sample_t& sample, samples) {
+        if (sample.sysid == 1 && sample.compid == 1) {
+            QCOMPARE(sample.count, (quint32)10);
+            if (sample.msgid == MAVLINK_MSG_ID_ATTITUDE) {
+                QCOMPARE(sample.bytes, (quint64)10 * (28 + MAVLINK_NUM_NON_PAYLOAD_BYTES));
+                QCOMPARE(memcmp(sample.message.payload64, attitude.payload64, attitude.len), 0);
+            }
+        } else if (sample.compid == 50) {
+            // MAVLink 1 framing: stx, 5 header bytes and the checksum
+            QCOMPARE(sample.bytes, (quint64)28 + 8);
+        } else {
+            QCOMPARE(sample.sysid, (uint8_t)2);
+            QCOMPARE(sample.count, (quint32)1);
+        }
+    }
+
+    // Filtering by system and component
+    QCOMPARE(statistics.sample(2).count(), 1);
+    QCOMPARE(statistics.sample(1).count(), 3);
+    QCOMPARE(statistics.sample(1, 50).count(), 1);
+
+    // Cleared entries only show up again once a message is received
+    statistics.clear();
+    QCOMPARE(statistics.sample().count(), 0);
+    statistics.update(attitude);
+    samples = statistics.sample();
+    QCOMPARE(samples.count(), 1);
+    QCOMPARE(samples[0].count, (quint32)1);
+}
+
+void MAVLinkMessageStatisticsTest::_testConcurrentSample(void)
+{
+    MAVLinkMessageStatistics    statistics;
+    const int                   updateCount = 200000;
+
+    // Sample from another thread while updating, snapshots must never contain a partially copied message
+    QAtomicInt done(0);
+    QFuture<bool> reader = QtConcurrent::run([&statistics, &done]() {
+        quint32 lastCount = 0;
+        while (!done.loadAcquire()) {
+            foreach (const MAVLinkMessageStatistics::Sample_t& sample, statistics.sample()) {
+                const uint8_t* payload = (const uint8_t*)sample.message.payload64;
+                for (int i=1; i<sample.message.len; i++) {
+                    if (payload[i] != payload[0]) {
+                        return false;
+                    }
+                }
+                if (sample.count < lastCount) {
+                    return false;
+                }
+                lastCount = sample.count;
+            }
+        }
+        return true;
+    });
+
+    for (int i=0; i<updateCount; i++) {
+        statistics.update(_message(1, 1, MAVLINK_MSG_ID_ATTITUDE, 28, i & 0xFF));
+    }
+    done.storeRelease(1);
+
+    QVERIFY(reader.result());
+    QCOMPARE(statistics.sample()[0].count, (quint32)updateCount);
+}
@@ -12,6 +12,7 @@
 // ones are enabled/disabled
 
 #include "FactSystemTestGeneric.h"
+#include "FactGroupTest.h"
 #include "FactSystemTestPX4.h"
 #include "FileDialogTest.h"
 #include "FlightGearTest.h"
@@ -38,6 +39,14 @@
 #include "PlanMasterControllerTest.h"
 #include "MissionSettingsTest.h"
 #include "QGCMapPolygonTest.h"
+#include "PolygonLineClipperTest.h"
+#include "TransectRouteOptimizerTest.h"
+#include "QmlObjectListModelTest.h"
+#include "TrajectoryPointsTest.h"
+#include "MAVLinkLogProcessorTest.h"
+#include "TimeSeriesDataTest.h"
+#include "MAVLinkMessageStatisticsTest.h"
+#include "LinkMetricsTest.h"
 #include "AudioOutputTest.h"
 
 UT_REGISTER_TEST(FactSystemTestGeneric)
@@ -64,7 +73,16 @@ UT_REGISTER_TEST(SpeedSectionTest)
 UT_REGISTER_TEST(PlanMasterControllerTest)
 UT_REGISTER_TEST(MissionSettingsTest)
 UT_REGISTER_TEST(QGCMapPolygonTest)
+UT_REGISTER_TEST(PolygonLineClipperTest)
+UT_REGISTER_TEST(TransectRouteOptimizerTest)
+UT_REGISTER_TEST(QmlObjectListModelTest)
+UT_REGISTER_TEST(TrajectoryPointsTest)
+UT_REGISTER_TEST(MAVLinkLogProcessorTest)
+UT_REGISTER_TEST(TimeSeriesDataTest)
+UT_REGISTER_TEST(MAVLinkMessageStatisticsTest)
+UT_REGISTER_TEST(LinkMetricsTest)
 UT_REGISTER_TEST(AudioOutputTest)
+UT_REGISTER_TEST(FactGroupTest)
 
 // List of unit test which are currently disabled.
 // If disabling a new test, include reason in comment.
@@ -27,6 +27,9 @@ FileManager::FileManager(QObject* parent, Vehicle* vehicle)
     , _vehicle(vehicle)
     , _dedicatedLink(NULL)
     , _activeSession(0)
+    , _writeAckedBytes(0)
+    , _windowSize(defaultWindowSize)
+    , _windowRequestCount(0)
     , _missingDownloadedBytes(0)
     , _downloadingMissingParts(false)
     , _systemIdQGC(0)
@@ -72,35 +75,85 @@ void FileManager::_openAckResponse(Request* openAck)
     _sendRequest(&request);
 }
 
-/// request the next missing part of a (partially) downloaded file
+/// Requests the missing parts of a (partially) downloaded file, keeping up to _windowSize reads in flight
 void FileManager::_requestMissingData()
 {
-    if (_missingData.empty()) {
+    if (_missingData.empty() && _readInFlight.isEmpty()) {
         _downloadingMissingParts = false;
-        _missingDownloadedBytes = 0;
-        // there might be more data missing at the end
-        if ((uint32_t)_readFileAccumulator.length() != _downloadFileSize) {
-            _downloadOffset = _readFileAccumulator.length();
-            qCDebug(FileManagerLog) << QString("_requestMissingData: missing parts done, downloadOffset(%1) downloadFileSize(%2)")
-                    .arg(_downloadOffset).arg(_downloadFileSize);
-        } else {
-            _closeDownloadSession(true);
-            return;
+        _closeDownloadSession(true);
+        return;
+    }
+
+    _currentOperation = kCORead;
+
+    while (_readInFlight.count() < _windowSize && !_missingData.empty()) {
+        MissingData& missingData = _missingData.head();
+        uint32_t size = qMin(missingData.size, (uint32_t)sizeof(((Request*)0)->data));
+
+        qCDebug(FileManagerLog) << QString("_requestMissingData: offset(%1) size(%2)").arg(missingData.offset).arg(size);
+
+        _readInFlight[missingData.offset] = size;
+        _sendMissingDataRequest(missingData.offset, size);
+
+        missingData.offset += size;
+        missingData.size -= size;
+        if (missingData.size == 0) {
+            _missingData.pop_front();
         }
-    } else {
-        qCDebug(FileManagerLog) << QString("_requestMissingData: offset(%1) size(%2)").arg(_missingData.head().offset).arg(_missingData.head().size);
+    }
 
-        _downloadOffset = _missingData.head().offset;
+    if (!_ackTimer.isActive()) {
+        _setupAckTimeout();
     }
+}
 
+void FileManager::_sendMissingDataRequest(uint32_t offset, uint32_t size)
+{
     Request request;
-    _currentOperation = kCORead;
     request.hdr.session = _activeSession;
     request.hdr.opcode = kCmdReadFile;
-    request.hdr.offset = _downloadOffset;
-    request.hdr.size = sizeof(request.data);
+    request.hdr.offset = offset;
+    request.hdr.size = size;
 
-    _sendRequest(&request);
+    _sendWindowedRequest(&request);
+}
+
+/// Respond to the Ack of a read which fills in a part missing from a burst download. These reads are
+/// windowed, so they are matched to their request by offset.
+void FileManager::_missingDataAckResponse(Request* readAck)
+{
+    uint32_t offset = readAck->hdr.offset;
+
+    if (!_readInFlight.contains(offset)) {
+        // Response to a read which was resent after a timeout and has already been answered
+        qCDebug(FileManagerLog) << QString("_missingDataAckResponse: ignoring duplicate offset(%1)").arg(offset);
+        _setupAckTimeout();
+        return;
+    }
+
+    uint32_t requestedSize = _readInFlight.take(offset);
+    uint32_t size = qMin((uint32_t)readAck->hdr.size, requestedSize);
+    if (offset + size > (uint32_t)_readFileAccumulator.length()) {
+        _closeDownloadSession(false /* failure */);
+        _emitErrorMessage(tr("Download: Offset returned (%1) is past the end of the file").arg(offset));
+        return;
+    }
+
+    _readFileAccumulator.replace(offset, size, (const char*)readAck->data, size);
+    _missingDownloadedBytes -= size;
+    if (size < requestedSize) {
+        // Short read, ask for the rest again
+        MissingData missingData;
+        missingData.offset = offset + size;
+        missingData.size = requestedSize - size;
+        _missingData.push_front(missingData);
+    }
+
+    if (_downloadFileSize != 0) {
+        emit commandProgress(100 * ((float)(_readFileAccumulator.length() - _missingDownloadedBytes) / (float)_downloadFileSize));
+    }
+
+    _requestMissingData();
 }
 
 /// Closes out a download session by writing the file and doing cleanup.
@@ -113,9 +166,19 @@ void FileManager::_closeDownloadSession(bool success)
     
     if (success) {
         if (_missingDownloadedBytes > 0 || (uint32_t)_readFileAccumulator.length() < _downloadFileSize) {
-            // we're not done yet: request the missing parts individually (either we had missing parts or
+            // we're not done yet: request the missing parts (either we had missing parts or
             // the last (few) packets right before the EOF got dropped)
+            if ((uint32_t)_readFileAccumulator.length() < _downloadFileSize) {
+                MissingData missingData;
+                missingData.offset = _readFileAccumulator.length();
+                missingData.size = _downloadFileSize - missingData.offset;
+                _missingData.push_back(missingData);
+                _missingDownloadedBytes += missingData.size;
+                _readFileAccumulator.resize(_downloadFileSize);
+            }
             _downloadingMissingParts = true;
+            _readInFlight.clear();
+            _startWindow();
             _requestMissingData();
             return;
         }
@@ -173,6 +236,11 @@ void FileManager::_downloadAckResponse(Request* readAck, bool readFile)
         return;
     }
 
+    if (_downloadingMissingParts) {
+        _missingDataAckResponse(readAck);
+        return;
+    }
+
     if (readAck->hdr.offset != _downloadOffset) {
         if (readFile) {
             _closeDownloadSession(false /* failure */);
@@ -197,28 +265,14 @@ void FileManager::_downloadAckResponse(Request* readAck, bool readFile)
     
     qCDebug(FileManagerLog) << QString("_downloadAckResponse: offset(%1) size(%2) burstComplete(%3)").arg(readAck->hdr.offset).arg(readAck->hdr.size).arg(readAck->hdr.burstComplete);
 
-    if (_downloadingMissingParts) {
-        Q_ASSERT(_missingData.head().offset == _downloadOffset);
-        _missingDownloadedBytes -= readAck->hdr.size;
-        _readFileAccumulator.replace(_downloadOffset, readAck->hdr.size, (const char*)readAck->data, readAck->hdr.size);
-        if (_missingData.head().size <= readAck->hdr.size) {
-            _missingData.pop_front();
-        } else {
-            _missingData.head().size -= readAck->hdr.size;
-            _missingData.head().offset += readAck->hdr.size;
-        }
-    } else {
-        _downloadOffset += readAck->hdr.size;
-        _readFileAccumulator.append((const char*)readAck->data, readAck->hdr.size);
-    }
+    _downloadOffset += readAck->hdr.size;
+    _readFileAccumulator.append((const char*)readAck->data, readAck->hdr.size);
     
     if (_downloadFileSize != 0) {
         emit commandProgress(100 * ((float)(_readFileAccumulator.length() - _missingDownloadedBytes) / (float)_downloadFileSize));
     }
 
-    if (_downloadingMissingParts) {
-        _requestMissingData();
-    } else if (readFile || readAck->hdr.burstComplete) {
+    if (readFile || readAck->hdr.burstComplete) {
         // Possibly still more data to read, send next read request
 
         Request request;
@@ -305,28 +359,27 @@ void FileManager::_createAckResponse(Request* createAck)
     // Start the sequence of write commands from the beginning of the file
 
     _writeOffset = 0;
-    _writeSize = 0;
+    _writeAckedBytes = 0;
+    _writeInFlight.clear();
+    _startWindow();
     
     _writeFileDatablock();
 }
 
-/// @brief Respond to the Ack associated with the write command.
+/// @brief Respond to the Ack associated with the write command. Writes are windowed, so acks are matched
+/// to their request by offset.
 void FileManager::_writeAckResponse(Request* writeAck)
 {
-    if(_writeOffset + _writeSize >= _writeFileSize){
-        _closeUploadSession(true /* success */);
-        return;
-    }
-
     if (writeAck->hdr.session != _activeSession) {
         _closeUploadSession(false /* failure */);
         _emitErrorMessage(tr("Write: Incorrect session returned"));
         return;
     }
 
-    if (writeAck->hdr.offset != _writeOffset) {
-        _closeUploadSession(false /* failure */);
-        _emitErrorMessage(tr("Write: Offset returned (%1) differs from offset requested (%2)").arg(writeAck->hdr.offset).arg(_writeOffset));
+    if (!_writeInFlight.contains(writeAck->hdr.offset)) {
+        // Ack for a block which was resent after a timeout and has already been acked
+        qCDebug(FileManagerLog) << QString("_writeAckResponse: ignoring duplicate offset(%1)").arg(writeAck->hdr.offset);
+        _setupAckTimeout();
         return;
     }
 
@@ -336,41 +389,78 @@ void FileManager::_writeAckResponse(Request* writeAck)
         return;
     }
 
-
-    if( writeAck->writeFileLength !=_writeSize) {
+    uint32_t writeSize = _writeInFlight.take(writeAck->hdr.offset);
+    if (writeAck->writeFileLength != writeSize) {
         _closeUploadSession(false /* failure */);
-        _emitErrorMessage(tr("Write: Size returned (%1) differs from size requested (%2)").arg(writeAck->writeFileLength).arg(_writeSize));
+        _emitErrorMessage(tr("Write: Size returned (%1) differs from size requested (%2)").arg(writeAck->writeFileLength).arg(writeSize));
         return;
     }
 
+    _writeAckedBytes += writeSize;
+    emit commandProgress(100 * ((float)_writeAckedBytes / (float)_writeFileSize));
+
     _writeFileDatablock();
 }
 
-/// @brief Send next write file data block.
+/// @brief Send write file data blocks until the window is full.
 void FileManager::_writeFileDatablock(void)
 {
-    if (_writeOffset + _writeSize >= _writeFileSize){
+    if (_writeInFlight.isEmpty() && _writeOffset >= _writeFileSize) {
         _closeUploadSession(true /* success */);
         return;
     }
 
-    _writeOffset += _writeSize;
+    while (_writeInFlight.count() < _windowSize && _writeOffset < _writeFileSize) {
+        uint32_t writeSize = qMin(_writeFileSize - _writeOffset, (uint32_t)sizeof(((Request*)0)->data));
 
+        _writeInFlight[_writeOffset] = writeSize;
+        _sendWriteRequest(_writeOffset, writeSize);
+        _writeOffset += writeSize;
+    }
+
+    if (!_ackTimer.isActive()) {
+        _setupAckTimeout();
+    }
+}
+
+void FileManager::_sendWriteRequest(uint32_t offset, uint32_t size)
+{
     Request request;
     request.hdr.session = _activeSession;
     request.hdr.opcode = kCmdWriteFile;
-    request.hdr.offset = _writeOffset;
+    request.hdr.offset = offset;
+    request.hdr.size = size;
 
-    if(_writeFileSize -_writeOffset > sizeof(request.data) )
-        _writeSize = sizeof(request.data);
-    else
-        _writeSize = _writeFileSize - _writeOffset;
+    memcpy(request.data, &_writeFileAccumulator.data()[offset], size);
 
-    request.hdr.size = _writeSize;
+    _sendWindowedRequest(&request);
+}
 
-    memcpy(request.data, &_writeFileAccumulator.data()[_writeOffset], _writeSize);
+/// @brief Returns true if the current operation has multiple requests in flight
+bool FileManager::_windowedTransfer(void) const
+{
+    return _currentOperation == kCOWrite || (_currentOperation == kCORead && _downloadingMissingParts);
+}
 
-    _sendRequest(&request);
+/// @brief Marks the start of a windowed transfer. Responses to recent requests sent from here on are accepted
+/// until the transfer completes.
+void FileManager::_startWindow(void)
+{
+    _windowRequestCount = 0;
+}
+
+/// @brief Resends all requests of a windowed transfer which have not been answered yet
+void FileManager::_resendWindow(void)
+{
+    if (_currentOperation == kCOWrite) {
+        for (QMap<uint32_t, uint32_t>::const_iterator it = _writeInFlight.constBegin(); it != _writeInFlight.constEnd(); ++it) {
+            _sendWriteRequest(it.key(), it.value());
+        }
+    } else {
+        for (QMap<uint32_t, uint32_t>::const_iterator it = _readInFlight.constBegin(); it != _readInFlight.constEnd(); ++it) {
+            _sendMissingDataRequest(it.key(), it.value());
+        }
+    }
 }
 
 void FileManager::receiveMessage(mavlink_message_t message)
@@ -393,55 +483,72 @@ void FileManager::receiveMessage(mavlink_message_t message)
 
     uint16_t incomingSeqNumber = request->hdr.seqNumber;
     
-    // Make sure we have a good sequence number
-    uint16_t expectedSeqNumber = _lastOutgoingRequest.hdr.seqNumber + 1;
+    if (_windowedTransfer()) {
+        // Several requests are in flight, so accept a response to any request sent during this transfer.
+        // The response is matched to its request by offset. Sequence numbers wrap around during long
+        // transfers, so only requests within the most recent half of the sequence number space count.
+        uint16_t window = qMin(_windowRequestCount, (uint32_t)(std::numeric_limits<uint16_t>::max() / 2));
+        uint16_t windowFirstSeqNumber = _lastOutgoingRequest.hdr.seqNumber - window + 1;
+        uint16_t requestSeqNumber = incomingSeqNumber - 1;
+        if ((uint16_t)(requestSeqNumber - windowFirstSeqNumber) >= window) {
+            qCDebug(FileManagerLog) << "Received packet outside of window: first seq:" << windowFirstSeqNumber << "got:" << incomingSeqNumber;
+            return;
+        }
 
-    // ignore old/reordered packets (handle wrap-around properly)
-    if ((uint16_t)((expectedSeqNumber - 1) - incomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
-        qDebug() << "Received old packet: expected seq:" << expectedSeqNumber << "got:" << incomingSeqNumber;
-        return;
-    }
+        _clearAckTimeout();
 
-    _clearAckTimeout();
-    
-	qCDebug(FileManagerLog) << "receiveMessage" << request->hdr.opcode;
-	
-    if (incomingSeqNumber != expectedSeqNumber) {
-        bool doAbort = true;
-        switch (_currentOperation) {
-            case kCOBurst: // burst download drops are handled in _downloadAckResponse()
-                doAbort = false;
-                break;
-            case kCORead:
-                _closeDownloadSession(false /* failure */);
-                break;
+        qCDebug(FileManagerLog) << "receiveMessage windowed" << request->hdr.opcode;
+    } else {
+        // Make sure we have a good sequence number
+        uint16_t expectedSeqNumber = _lastOutgoingRequest.hdr.seqNumber + 1;
+
+        // ignore old/reordered packets (handle wrap-around properly)
+        if ((uint16_t)((expectedSeqNumber - 1) - incomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
+            qDebug() << "Received old packet: expected seq:" << expectedSeqNumber << "got:" << incomingSeqNumber;
+            return;
+        }
+
+        _clearAckTimeout();
+
+        qCDebug(FileManagerLog) << "receiveMessage" << request->hdr.opcode;
+
+        if (incomingSeqNumber != expectedSeqNumber) {
+            bool doAbort = true;
+            switch (_currentOperation) {
+                case kCOBurst: // burst download drops are handled in _downloadAckResponse()
+                    doAbort = false;
+                    break;
+                case kCORead:
+                    _closeDownloadSession(false /* failure */);
+                    break;
             
-            case kCOWrite:
-                _closeUploadSession(false /* failure */);
-                break;
+                case kCOWrite:
+                    _closeUploadSession(false /* failure */);
+                    break;
                 
-            case kCOOpenRead:
-            case kCOOpenBurst:
-            case kCOCreate:
-                // We could have an open session hanging around
-                _currentOperation = kCOIdle;
-                _sendResetCommand();
-                break;
+                case kCOOpenRead:
+                case kCOOpenBurst:
+                case kCOCreate:
+                    // We could have an open session hanging around
+                    _currentOperation = kCOIdle;
+                    _sendResetCommand();
+                    break;
                 
-            default:
-                // Don't need to do anything special
-                _currentOperation = kCOIdle;
-                break;
-        }
+                default:
+                    // Don't need to do anything special
+                    _currentOperation = kCOIdle;
+                    break;
+            }
         
-        if (doAbort) {
-            _emitErrorMessage(tr("Bad sequence number on received message: expected(%1) received(%2)").arg(expectedSeqNumber).arg(incomingSeqNumber));
-            return;
+            if (doAbort) {
+                _emitErrorMessage(tr("Bad sequence number on received message: expected(%1) received(%2)").arg(expectedSeqNumber).arg(incomingSeqNumber));
+                return;
+            }
         }
+
+        // Move past the incoming sequence number for next request
+        _lastOutgoingRequest.hdr.seqNumber = incomingSeqNumber;
     }
-    
-    // Move past the incoming sequence number for next request
-    _lastOutgoingRequest.hdr.seqNumber = incomingSeqNumber;
 
     if (request->hdr.opcode == kRspAck) {
         switch (request->hdr.req_opcode) {
@@ -487,6 +594,11 @@ void FileManager::receiveMessage(mavlink_message_t message)
             // This is not an error, just the end of the list loop
             emit commandComplete();
             return;
+        } else if (request->hdr.req_opcode == kCmdReadFile && errorCode == kErrEOF && _downloadingMissingParts) {
+            // Missing parts are all within the file length reported on open
+            _closeDownloadSession(false /* failure */);
+            _emitErrorMessage(tr("Download: File ended before the length reported on open"));
+            return;
         } else if ((request->hdr.req_opcode == kCmdReadFile || request->hdr.req_opcode == kCmdBurstReadFile) && errorCode == kErrEOF) {
             // This is not an error, just the end of the download loop
             _closeDownloadSession(true /* success */);
@@ -781,6 +893,8 @@ void FileManager::_ackTimeout(void)
             request.hdr.seqNumber = ++_lastOutgoingRequest.hdr.seqNumber;
 
             _sendRequestNoAck(&request);
+        } else if (_windowedTransfer()) {
+            _resendWindow();
         } else {
             _sendRequestNoAck(&_lastOutgoingRequest);
         }
@@ -870,6 +984,21 @@ void FileManager::_sendRequest(Request* request)
     _sendRequestNoAck(request);
 }
 
+/// @brief Sends the next Request of a windowed transfer out to the UAS. The ack timeout is shared by all
+/// requests in the window, so it is left to the caller.
+void FileManager::_sendWindowedRequest(Request* request)
+{
+    request->hdr.seqNumber = ++_lastOutgoingRequest.hdr.seqNumber;
+    _windowRequestCount++;
+
+    qCDebug(FileManagerLog) << "_sendWindowedRequest opcode:" << request->hdr.opcode << "seqNumber:" << request->hdr.seqNumber << "offset:" << request->hdr.offset;
+
+    if (_systemIdQGC == 0) {
+        _systemIdQGC = qgcApp()->toolbox()->mavlinkProtocol()->getSystemId();
+    }
+    _sendRequestNoAck(request);
+}
+
 /// @brief Sends the specified Request out to the UAS, without ack timeout handling
 void FileManager::_sendRequestNoAck(Request* request)
 {
@@ -15,6 +15,7 @@
 #include <QDir>
 #include <QTimer>
 #include <QQueue>
+#include <QMap>
 
 #include "UASInterface.h"
 #include "QGCLoggingCategory.h"
@@ -47,6 +48,14 @@ public:
 
     static const int ackTimerMaxRetries = 6;
 
+    /// Default number of requests kept in flight by windowed transfers
+    static const int defaultWindowSize = 8;
+
+    /// Sets the maximum number of write requests (uploads) or gap reads (burst downloads) in flight at once.
+    /// A window size of 1 gives stop-and-wait behavior.
+    void setWindowSize(int windowSize) { _windowSize = qMax(windowSize, 1); }
+    int windowSize(void) const { return _windowSize; }
+
 	/// Downloads the specified file.
 	///     @param from File to download from UAS, fully qualified path
 	///     @param downloadDir Local directory to download file to
@@ -197,6 +206,13 @@ private:
     void _createAckResponse(Request* createAck);
     void _writeAckResponse(Request* writeAck);
     void _writeFileDatablock(void);
+    void _sendWriteRequest(uint32_t offset, uint32_t size);
+    void _sendMissingDataRequest(uint32_t offset, uint32_t size);
+    void _missingDataAckResponse(Request* readAck);
+    void _resendWindow(void);
+    void _startWindow(void);
+    bool _windowedTransfer(void) const;
+    void _sendWindowedRequest(Request* request);
     void _sendListCommand(void);
     void _sendResetCommand(void);
     void _closeDownloadSession(bool success);
@@ -222,10 +238,14 @@ private:
     
     uint32_t    _readOffset;                ///< current read offset
     
-    uint32_t    _writeOffset;               ///< current write offset
-    uint32_t    _writeSize;                 ///< current write data size
+    uint32_t    _writeOffset;               ///< offset of the next block to send
+    uint32_t    _writeAckedBytes;           ///< number of bytes the server has acked
     uint32_t    _writeFileSize;             ///< Size of file being uploaded
     QByteArray  _writeFileAccumulator;      ///< Holds file being uploaded
+    QMap<uint32_t, uint32_t> _writeInFlight;///< offset -> size of write requests waiting for an ack
+
+    int         _windowSize;                ///< Maximum number of requests in flight for windowed transfers
+    uint32_t    _windowRequestCount;        ///< Number of requests sent by the current windowed transfer
     
     struct MissingData {
         uint32_t offset;
@@ -235,6 +255,7 @@ private:
     uint32_t    _missingDownloadedBytes;    ///< number of missing bytes for burst download
     QQueue<MissingData> _missingData;       ///< missing chunks of downloaded file (for burst downloads)
     bool        _downloadingMissingParts;   ///< true if we are currently downloading missing parts
+    QMap<uint32_t, uint32_t> _readInFlight; ///< offset -> size of missing part reads waiting for an ack
     QByteArray  _readFileAccumulator;       ///< Holds file being downloaded
     QDir        _readFileDownloadDir;       ///< Directory to download file to
     QString     _readFileDownloadFilename;  ///< Filename (no path) for download file
@@ -3,8 +3,43 @@
 
 #include <QDebug>
 
+/**
+ * @brief Read one element of a field
+ * The variant types match the ones the values were always emitted with.
+ **/
+static QVariant fieldValue(const uint8_t* data, uint8_t type, unsigned int index)
+{
+    switch (type)
+    {
+    case MAVLINK_TYPE_CHAR:
+        return QVariant((int)((const char*)data)[index]);
+    case MAVLINK_TYPE_UINT8_T:
+        return QVariant((int)data[index]);
+    case MAVLINK_TYPE_INT8_T:
+        return QVariant((int)((const int8_t*)data)[index]);
+    case MAVLINK_TYPE_UINT16_T:
+        return QVariant((int)((const uint16_t*)data)[index]);
+    case MAVLINK_TYPE_INT16_T:
+        return QVariant((int)((const int16_t*)data)[index]);
+    case MAVLINK_TYPE_UINT32_T:
+        return QVariant((uint)((const uint32_t*)data)[index]);
+    case MAVLINK_TYPE_INT32_T:
+        return QVariant((int)((const int32_t*)data)[index]);
+    case MAVLINK_TYPE_FLOAT:
+        return QVariant(((const float*)data)[index]);
+    case MAVLINK_TYPE_DOUBLE:
+        return QVariant(((const double*)data)[index]);
+    case MAVLINK_TYPE_UINT64_T:
+        return QVariant((quint64)((const uint64_t*)data)[index]);
+    case MAVLINK_TYPE_INT64_T:
+        return QVariant((qint64)((const int64_t*)data)[index]);
+    default:
+        return QVariant();
+    }
+}
+
 MAVLinkDecoder::MAVLinkDecoder(MAVLinkProtocol* protocol) :
-    QThread(), creationThread(QThread::currentThread())
+    QThread(), subscriptionGeneration(0), creationThread(QThread::currentThread())
 {
     // We're doing it wrong - because the Qt folks got the API wrong:
     // http://blog.qt.digia.com/blog/2010/06/17/youre-doing-it-wrong/
@@ -40,6 +75,8 @@ MAVLinkDecoder::MAVLinkDecoder(MAVLinkProtocol* protocol) :
     textMessageFilter.insert(MAVLINK_MSG_ID_NAMED_VALUE_INT, false);
 //    textMessageFilter.insert(MAVLINK_MSG_ID_HIGHRES_IMU, false);
 
+    qRegisterMetaType<MAVLinkDecoderValues>("MAVLinkDecoderValues");
+
     connect(protocol, &MAVLinkProtocol::messageReceived, this, &MAVLinkDecoder::receiveMessage);
     connect(this, &MAVLinkDecoder::finish, this, &QThread::quit);
 
@@ -61,13 +98,13 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link,mavlink_message_t messag
     Q_UNUSED(link);
 
     uint32_t msgid = message.msgid;
-    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&message);
-    if(!msgInfo) {
+    const MessagePlan* plan = getMessagePlan(message);
+    if(!plan) {
         qWarning() << "Invalid MAVLink message received. ID:" << msgid;
         return;
     }
 
-    msgDict[message.msgid] = message;
+    uint8_t* m = (uint8_t*)(message.payload64);
 
     // Store an arrival time for this message. This value ends up being calculated later.
     quint64 time = 0;
@@ -80,37 +117,342 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link,mavlink_message_t messag
         sysDict[msgid].onboardTimeOffset = (timebase.time_unix_usec+500)/1000 - timebase.time_boot_ms;
         sysDict[msgid].onboardToGCSUnixTimeOffsetAndDelay  = static_cast<qint64>(QGC::groundTimeMilliseconds() - (timebase.time_unix_usec+500)/1000);
     }
-    else
+    else if (plan->timeOffset >= 0)
     {
-
-        // See if first value is a time value and if it is, use that as the arrival time for this data.
-        uint8_t fieldid = 0;
-        uint8_t* m = (uint8_t*)(msgDict[msgid].payload64);
-
-        if (QString(msgInfo->fields[fieldid].name) == QString("time_boot_ms") && msgInfo->fields[fieldid].type == MAVLINK_TYPE_UINT32_T)
+        // The first field is a time value, use that as the arrival time for this data.
+        if (plan->timeUsec)
         {
-            time = *((quint32*)(m+msgInfo->fields[fieldid].wire_offset));
+            time = *((quint64*)(m+plan->timeOffset));
+            time = (time+500)/1000; // Scale to milliseconds, round up/down correctly
         }
-        else if (QString(msgInfo->fields[fieldid].name).contains("usec") && msgInfo->fields[fieldid].type == MAVLINK_TYPE_UINT64_T)
+        else
         {
-            time = *((quint64*)(m+msgInfo->fields[fieldid].wire_offset));
-            time = (time+500)/1000; // Scale to milliseconds, round up/down correctly
+            time = *((quint32*)(m+plan->timeOffset));
         }
     }
 
     // Align UAS time to global time
     time = getUnixTimeFromMs(message.sysid, time);
 
-    // Send out all field values for this message
-    for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+    bool multiComponentSourceDetected = detectMultiComponent(message);
+    if (plan->filtered) return;
+
+    NameTable& names = getNameTable(*plan, message, multiComponentSourceDetected);
+
+    // Values nobody subscribed to are only sent now and then, so they show up in the curve lists
+    quint64 now = QGC::groundTimeMilliseconds();
+    bool emitAll = now - names.lastUnsubscribedEmit >= unsubscribedIntervalMsecs;
+    if (!emitAll && names.subscribedCount == 0 && !plan->hasText) return;
+    if (emitAll) names.lastUnsubscribedEmit = now;
+
+    MAVLinkDecoderValues values;
+    values.reserve(emitAll ? names.names.count() : names.subscribedCount);
+
+    int index = 0;
+    foreach (const FieldPlan& field, plan->fields)
     {
-        emitFieldValue(&message, i, time);
+        uint8_t* data = m+field.offset;
+
+        if (field.type == MAVLINK_TYPE_CHAR && field.arrayLength > 0)
+        {
+            if (!textMessageFilter.contains(msgid))
+            {
+                char* str = (char*)data;
+                // Enforce null termination
+                str[field.arrayLength-1] = '\0';
+                emit textMessageReceived(message.sysid, message.compid, MAV_SEVERITY_INFO, names.names[index] + ": " + str);
+            }
+            index++;
+            continue;
+        }
+
+        unsigned int count = field.arrayLength > 0 ? field.arrayLength : 1;
+        for (unsigned int j = 0; j < count; ++j, ++index)
+        {
+            if (emitAll || names.subscribed[index])
+            {
+                MAVLinkDecoderValue value;
+                value.name = names.names[index];
+                value.unit = names.units[index];
+                value.value = fieldValue(data, field.type, j);
+                values.append(value);
+            }
+        }
+    }
+
+    if (!values.isEmpty())
+    {
+        emit valuesChanged(message.sysid, values, time);
     }
 
     // Send out combined math expressions
     // FIXME XXX TODO
 }
 
+/**
+ * @brief Source prefix of all value names, e.g. "M1:" or "M1:C50:"
+ **/
+static QString namePrefix(const mavlink_message_t& message, bool multiComponent)
+{
+    QString prefix = QString("M%1:").arg(message.sysid);
+    if (multiComponent)
+    {
+        prefix += QString("C%1:").arg(message.compid);
+    }
+    return prefix;
+}
+
+/**
+ * @brief Resolve field offsets, types and the time field of a message id once
+ **/
+const MAVLinkDecoder::MessagePlan* MAVLinkDecoder::getMessagePlan(const mavlink_message_t& message)
+{
+    QHash<uint32_t, MessagePlan>::const_iterator it = messagePlans.constFind(message.msgid);
+    if (it != messagePlans.constEnd()) {
+        return &it.value();
+    }
+
+    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&message);
+    if (!msgInfo) {
+        return NULL;
+    }
+
+    MessagePlan plan;
+    plan.info = msgInfo;
+    plan.timeOffset = -1;
+    plan.timeUsec = false;
+    plan.filtered = messageFilter.contains(message.msgid);
+    plan.hasText = false;
+
+    // See if first value is a time value. DEBUG_VECT sends its name ahead of the time.
+    const mavlink_field_info_t* timeField = msgInfo->num_fields > 0 ? &msgInfo->fields[0] : NULL;
+    if (message.msgid == MAVLINK_MSG_ID_DEBUG_VECT)
+    {
+        for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+        {
+            if (strcmp(msgInfo->fields[i].name, "time_usec") == 0)
+            {
+                timeField = &msgInfo->fields[i];
+            }
+        }
+    }
+    if (timeField)
+    {
+        if (strcmp(timeField->name, "time_boot_ms") == 0 && timeField->type == MAVLINK_TYPE_UINT32_T)
+        {
+            plan.timeOffset = timeField->wire_offset;
+        }
+        else if (strstr(timeField->name, "usec") && timeField->type == MAVLINK_TYPE_UINT64_T)
+        {
+            plan.timeOffset = timeField->wire_offset;
+            plan.timeUsec = true;
+        }
+    }
+
+    for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+    {
+        const mavlink_field_info_t& info = msgInfo->fields[i];
+
+        FieldPlan field;
+        field.offset = info.wire_offset;
+        field.type = info.type;
+        field.arrayLength = info.array_length;
+        field.name = info.name;
+
+        switch (info.type)
+        {
+        case MAVLINK_TYPE_CHAR:
+            // Char arrays are sent as text, single chars report the array length as unit
+            field.unit = QString("char[%1]").arg(info.array_length);
+            plan.hasText |= info.array_length > 0;
+            break;
+        case MAVLINK_TYPE_UINT8_T:  field.unit = "uint8_t";     break;
+        case MAVLINK_TYPE_INT8_T:   field.unit = "int8_t";      break;
+        case MAVLINK_TYPE_UINT16_T: field.unit = "uint16_t";    break;
+        case MAVLINK_TYPE_INT16_T:  field.unit = "int16_t";     break;
+        case MAVLINK_TYPE_UINT32_T: field.unit = "uint32_t";    break;
+        case MAVLINK_TYPE_INT32_T:  field.unit = "int32_t";     break;
+        case MAVLINK_TYPE_FLOAT:    field.unit = "float";       break;
+        case MAVLINK_TYPE_DOUBLE:   field.unit = "double";      break;
+        case MAVLINK_TYPE_UINT64_T: field.unit = "uint64_t";    break;
+        case MAVLINK_TYPE_INT64_T:  field.unit = "int64_t";     break;
+        default:
+            qDebug() << "WARNING: UNKNOWN MAVLINK TYPE" << msgInfo->name << info.name;
+            continue;
+        }
+        if (info.type != MAVLINK_TYPE_CHAR && info.array_length > 0)
+        {
+            field.unit = QString("%1[%2]").arg(field.unit).arg(info.array_length);
+        }
+
+        plan.fields.append(field);
+    }
+
+    return &messagePlans.insert(message.msgid, plan).value();
+}
+
+/**
+ * @brief Get the value names for a message
+ * Names depend on the sending system and component and, for some messages, on the payload. They are
+ * built the first time a message arrives from a source, so regular messages only cost a hash lookup.
+ **/
+MAVLinkDecoder::NameTable& MAVLinkDecoder::getNameTable(const MessagePlan& plan, const mavlink_message_t& message, bool multiComponent)
+{
+    // Debug messages carry their value names in the payload
+    QString debugName;
+    bool perField = true;
+    if (message.msgid == MAVLINK_MSG_ID_DEBUG_VECT)
+    {
+        char buf[11];
+        mavlink_msg_debug_vect_get_name(&message, buf);
+        buf[10] = '\0';
+        debugName = namePrefix(message, multiComponent) + buf;
+    }
+    else if (message.msgid == MAVLINK_MSG_ID_DEBUG)
+    {
+        debugName = namePrefix(message, multiComponent) + QString("debug.%1").arg(mavlink_msg_debug_get_ind(&message));
+        perField = false;
+    }
+    else if (message.msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT || message.msgid == MAVLINK_MSG_ID_NAMED_VALUE_INT)
+    {
+        char buf[11];
+        if (message.msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT) {
+            mavlink_msg_named_value_float_get_name(&message, buf);
+        } else {
+            mavlink_msg_named_value_int_get_name(&message, buf);
+        }
+        buf[10] = '\0';
+        debugName = namePrefix(message, multiComponent) + buf;
+        perField = false;
+    }
+
+    if (!debugName.isEmpty())
+    {
+        // Different debug messages may use the same name, but not the same values
+        NameTable& table = debugNameTables[qMakePair((uint32_t)message.msgid, debugName)];
+        if (table.names.isEmpty()) {
+            buildNameTable(table, plan, debugName, perField);
+        }
+        updateSubscriptions(table);
+        return table;
+    }
+
+    // XXX this is really ugly, but we do not know a better way to do this
+    int port = -1;
+    if (message.msgid == MAVLINK_MSG_ID_RC_CHANNELS_RAW)
+    {
+        port = mavlink_msg_rc_channels_raw_get_port(&message);
+    }
+    else if (message.msgid == MAVLINK_MSG_ID_RC_CHANNELS_SCALED)
+    {
+        port = mavlink_msg_rc_channels_scaled_get_port(&message);
+    }
+    else if (message.msgid == MAVLINK_MSG_ID_SERVO_OUTPUT_RAW)
+    {
+        port = mavlink_msg_servo_output_raw_get_port(&message);
+    }
+
+    quint64 key = ((quint64)message.msgid << 40) | ((quint64)message.sysid << 32)
+            | ((quint64)(multiComponent ? 0x100 | message.compid : 0) << 16) | (quint64)(port + 1);
+    QHash<quint64, NameTable>::iterator it = nameTables.find(key);
+    if (it == nameTables.end())
+    {
+        QString prefix = namePrefix(message, multiComponent);
+        if (port >= 0)
+        {
+            prefix += QString("port%1_").arg(port);
+        }
+        it = nameTables.insert(key, NameTable());
+        buildNameTable(it.value(), plan, prefix + plan.info->name, true);
+    }
+    updateSubscriptions(it.value());
+    return it.value();
+}
+
+void MAVLinkDecoder::buildNameTable(NameTable& table, const MessagePlan& plan, const QString& baseName, bool perField)
+{
+    table.subscribedCount = 0;
+    table.generation = -1;
+    table.lastUnsubscribedEmit = 0;
+
+    foreach (const FieldPlan& field, plan.fields)
+    {
+        QString name = perField ? QString("%1.%2").arg(baseName).arg(field.name) : baseName;
+
+        if (field.arrayLength > 0 && field.type != MAVLINK_TYPE_CHAR)
+        {
+            for (unsigned int j = 0; j < field.arrayLength; ++j)
+            {
+                table.names.append(QString("%1.%2").arg(name).arg(j));
+                table.units.append(field.unit);
+            }
+        }
+        else
+        {
+            table.names.append(name);
+            table.units.append(field.unit);
+        }
+    }
+    table.subscribed.fill(false, table.names.count());
+}
+
+void MAVLinkDecoder::updateSubscriptions(NameTable& table)
+{
+    if (table.generation == subscriptionGeneration) {
+        return;
+    }
+    table.generation = subscriptionGeneration;
+    table.subscribedCount = 0;
+    for (int i = 0; i < table.names.count(); ++i)
+    {
+        table.subscribed[i] = subscriptions.contains(table.names[i] + table.units[i]);
+        if (table.subscribed[i]) {
+            table.subscribedCount++;
+        }
+    }
+}
+
+void MAVLinkDecoder::setSubscribed(const QString& curveId, bool subscribed)
+{
+    if (subscribed)
+    {
+        if (subscriptions[curveId]++ == 0) {
+            subscriptionGeneration++;
+        }
+    }
+    else if (subscriptions.contains(curveId))
+    {
+        if (--subscriptions[curveId] == 0) {
+            subscriptions.remove(curveId);
+            subscriptionGeneration++;
+        }
+    }
+}
+
+bool MAVLinkDecoder::detectMultiComponent(const mavlink_message_t& message)
+{
+    uint32_t msgid = message.msgid;
+
+    // create new system data if it wasn't dectected yet
+    SystemData& system = sysDict[msgid];
+
+    // Store component ID
+    if (system.componentID == -1)
+    {
+        system.componentID = message.compid;
+    }
+    else
+    {
+        // Got this message already
+        if (system.componentID != message.compid)
+        {
+            system.componentMulti = true;
+        }
+    }
+
+    return system.componentMulti;
+}
+
 quint64 MAVLinkDecoder::getUnixTimeFromMs(int systemID, quint64 time)
 {
     quint64 ret = 0;
@@ -188,319 +530,3 @@ quint64 MAVLinkDecoder::getUnixTimeFromMs(int systemID, quint64 time)
 
     return ret;
 }
-
-void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time)
-{
-    bool multiComponentSourceDetected = false;
-    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(msg);
-
-    uint32_t msgid = msg->msgid;
-
-    // create new system data if it wasn't dectected yet
-    if (!(sysDict.keys().contains(msgid))) {
-        sysDict[msgid] = SystemData();
-    }
-
-    // Store component ID
-    if (sysDict[msgid].componentID == -1)
-    {
-        sysDict[msgid].componentID = msg->compid;
-    }
-    else
-    {
-        // Got this message already
-        if (sysDict[msgid].componentID != msg->compid)
-        {
-            sysDict[msgid].componentMulti = true;
-        }
-    }
-
-    if (sysDict[msgid].componentMulti == true) {
-        multiComponentSourceDetected = true;
-    }
-
-    // Add field tree widget item
-    if (messageFilter.contains(msgid)) return;
-    QString fieldName(msgInfo->fields[fieldid].name);
-    QString fieldType;
-    uint8_t* m = (uint8_t*)(msgDict[msgid].payload64);
-    QString name("%1.%2");
-    QString unit("");
-
-    // Debug vector messages
-    if (msgid == MAVLINK_MSG_ID_DEBUG_VECT)
-    {
-        mavlink_debug_vect_t debug;
-        mavlink_msg_debug_vect_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString("%1.%2").arg(buf).arg(fieldName);
-        time = getUnixTimeFromMs(msg->sysid, (debug.time_usec+500)/1000); // Scale to milliseconds, round up/down correctly
-    }
-    else if (msgid == MAVLINK_MSG_ID_DEBUG)
-    {
-        mavlink_debug_t debug;
-        mavlink_msg_debug_decode(msg, &debug);
-        name = name.arg(QString("debug")).arg(debug.ind);
-        time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
-    }
-    else if (msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT)
-    {
-        mavlink_named_value_float_t debug;
-        mavlink_msg_named_value_float_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString(buf);
-        time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
-    }
-    else if (msgid == MAVLINK_MSG_ID_NAMED_VALUE_INT)
-    {
-        mavlink_named_value_int_t debug;
-        mavlink_msg_named_value_int_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString(buf);
-        time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
-    }
-    else if (msgid == MAVLINK_MSG_ID_RC_CHANNELS_RAW)
-    {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_rc_channels_raw_t raw;
-        mavlink_msg_rc_channels_raw_decode(msg, &raw);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(raw.port));
-    }
-    else if (msgid == MAVLINK_MSG_ID_RC_CHANNELS_SCALED)
-    {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_rc_channels_scaled_t scaled;
-        mavlink_msg_rc_channels_scaled_decode(msg, &scaled);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(scaled.port));
-    }
-    else if (msgid == MAVLINK_MSG_ID_SERVO_OUTPUT_RAW)
-    {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_servo_output_raw_t servo;
-        mavlink_msg_servo_output_raw_decode(msg, &servo);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(servo.port));
-    }
-    else
-    {
-        name = name.arg(msgInfo->name).arg(fieldName);
-    }
-
-    if (multiComponentSourceDetected)
-    {
-        name = name.prepend(QString("C%1:").arg(msg->compid));
-    }
-
-    name = name.prepend(QString("M%1:").arg(msg->sysid));
-
-    switch (msgInfo->fields[fieldid].type)
-    {
-    case MAVLINK_TYPE_CHAR:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            char* str = (char*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            str[msgInfo->fields[fieldid].array_length-1] = '\0';
-            QString string(name + ": " + str);
-            if (!textMessageFilter.contains(msgid)) emit textMessageReceived(msg->sysid, msg->compid, MAV_SEVERITY_INFO, string);
-        }
-        else
-        {
-            // Single char
-            char b = *((char*)(m+msgInfo->fields[fieldid].wire_offset));
-            unit = QString("char[%1]").arg(msgInfo->fields[fieldid].array_length);
-            emit valueChanged(msg->sysid, name, unit, b, time);
-        }
-        break;
-    case MAVLINK_TYPE_UINT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint8_t* nums = m+msgInfo->fields[fieldid].wire_offset;
-            fieldType = QString("uint8_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint8_t u = *(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = "uint8_t";
-            emit valueChanged(msg->sysid, name, fieldType, u, time);
-        }
-        break;
-    case MAVLINK_TYPE_INT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int8_t* nums = (int8_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int8_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int8_t n = *((int8_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int8_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
-        }
-        break;
-    case MAVLINK_TYPE_UINT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint16_t* nums = (uint16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint16_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint16_t n = *((uint16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint16_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
-        }
-        break;
-    case MAVLINK_TYPE_INT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int16_t* nums = (int16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int16_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int16_t n = *((int16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int16_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
-        }
-        break;
-    case MAVLINK_TYPE_UINT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint32_t* nums = (uint32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint32_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint32_t n = *((uint32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint32_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
-        }
-        break;
-    case MAVLINK_TYPE_INT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int32_t* nums = (int32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int32_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int32_t n = *((int32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int32_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
-        }
-        break;
-    case MAVLINK_TYPE_FLOAT:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            float* nums = (float*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("float[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (float)(nums[j]), time);
-            }
-        }
-        else
-        {
-            // Single value
-            float f = *((float*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "float";
-            emit valueChanged(msg->sysid, name, fieldType, f, time);
-        }
-        break;
-    case MAVLINK_TYPE_DOUBLE:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            double* nums = (double*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("double[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            double f = *((double*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "double";
-            emit valueChanged(msg->sysid, name, fieldType, f, time);
-        }
-        break;
-    case MAVLINK_TYPE_UINT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint64_t* nums = (uint64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint64_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (quint64) nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint64_t n = *((uint64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint64_t";
-            emit valueChanged(msg->sysid, name, fieldType, (quint64) n, time);
-        }
-        break;
-    case MAVLINK_TYPE_INT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int64_t* nums = (int64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int64_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (qint64) nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int64_t n = *((int64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int64_t";
-            emit valueChanged(msg->sysid, name, fieldType, (qint64) n, time);
-        }
-        break;
-    default:
-        qDebug() << "WARNING: UNKNOWN MAVLINK TYPE";
-    }
-}
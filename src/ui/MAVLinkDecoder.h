@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QHash>
+#include <QVector>
+#include <QStringList>
 
 #include "MAVLinkProtocol.h"
 
@@ -24,6 +26,15 @@ struct SystemData {
     quint64 firstOnboardTime;   ///< First seen onboard time
 };
 
+/// One decoded scalar field value
+struct MAVLinkDecoderValue {
+    QString     name;   ///< Full field name, e.g. "M1:ATTITUDE.roll"
+    QString     unit;   ///< Field type, e.g. "float" or "uint16_t[8]"
+    QVariant    value;
+};
+typedef QVector<MAVLinkDecoderValue> MAVLinkDecoderValues;
+Q_DECLARE_METATYPE(MAVLinkDecoderValues)
+
 class MAVLinkDecoder : public QThread
 {
     Q_OBJECT
@@ -32,23 +43,75 @@ public:
 
     void run();
 
+    static const quint64 unsubscribedIntervalMsecs = 1000; ///< Values nobody subscribed to are emitted at most this often
+
 signals:
     void textMessageReceived(int uasid, int componentid, int severity, const QString& text);
-    void valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
+    /** @brief Values of one message, all with the same timestamp */
+    void valuesChanged(int uasId, const MAVLinkDecoderValues& values, quint64 msec);
     void finish(); ///< Trigger a thread safe shutdown
 
 public slots:
     /** @brief Receive one message from the protocol and decode it */
     void receiveMessage(LinkInterface* link,mavlink_message_t message);
+    /**
+     * @brief Add or release a subscription to a value
+     * Subscribed values are emitted with every message, all others only every unsubscribedIntervalMsecs
+     * so they can still be listed and displayed.
+     * @param curveId Value name followed by its unit, as used for the linechart curve ids
+     */
+    void setSubscribed(const QString& curveId, bool subscribed);
+
 protected:
-    /** @brief Emit the value of one message field */
-    void emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time);
+    /// Field of a message, resolved once from the MAVLink message info
+    struct FieldPlan {
+        unsigned int    offset;         ///< Offset of the field in the payload
+        uint8_t         type;           ///< MAVLINK_TYPE_*
+        unsigned int    arrayLength;    ///< 0 for single values
+        QString         name;           ///< Field name
+        QString         unit;           ///< Field type name, reported as unit
+    };
+
+    /// Extraction plan for one message id
+    struct MessagePlan {
+        const mavlink_message_info_t* info;
+        int                 timeOffset; ///< Payload offset of the time field, -1 if the message has none
+        bool                timeUsec;   ///< true: time field is in microseconds, false: milliseconds
+        bool                filtered;   ///< Message is in messageFilter, no values are emitted
+        bool                hasText;    ///< Message has char array fields which are sent as text messages
+        QVector<FieldPlan>  fields;
+    };
+
+    /// Names of the scalar values of one message from one source, built once per source
+    struct NameTable {
+        QStringList     names;              ///< One entry per scalar value (per char array for text), in plan order
+        QStringList     units;
+        QVector<bool>   subscribed;
+        int             subscribedCount;
+        int             generation;         ///< subscriptionGeneration the subscribed flags were computed for
+        quint64         lastUnsubscribedEmit; ///< Last time all values were emitted, in ms
+    };
+
+    /** @brief Get the extraction plan for a message id, NULL if the message is unknown */
+    const MessagePlan* getMessagePlan(const mavlink_message_t& message);
+    /** @brief Get the value names for a message, building them on first use */
+    NameTable& getNameTable(const MessagePlan& plan, const mavlink_message_t& message, bool multiComponent);
+    /** @brief Fill a name table for all values of a message */
+    void buildNameTable(NameTable& table, const MessagePlan& plan, const QString& baseName, bool perField);
+    /** @brief Recompute the subscribed flags of a name table if the subscriptions changed */
+    void updateSubscriptions(NameTable& table);
+    /** @brief Track which components send a message, returns true if more than one does */
+    bool detectMultiComponent(const mavlink_message_t& message);
     /** @brief Shift a timestamp in Unix time if necessary */
     quint64 getUnixTimeFromMs(int systemID, quint64 time);
 
     QMap<uint16_t, bool> messageFilter;                     ///< Message/field names not to emit
     QMap<uint16_t, bool> textMessageFilter;                 ///< Message/field names not to emit in text mode
-    QHash<int, mavlink_message_t> msgDict; ///< dictionary of all mavlink messages
+    QHash<uint32_t, MessagePlan> messagePlans;              ///< Extraction plans by message id
+    QHash<quint64, NameTable> nameTables;                   ///< Value names by message id, system, component and port
+    QHash<QPair<uint32_t, QString>, NameTable> debugNameTables; ///< Value names of debug messages, by message id and name sent in the payload
+    QHash<QString, int> subscriptions;                      ///< Subscription count by curve id
+    int subscriptionGeneration;                             ///< Incremented whenever the set of subscribed curve ids changes
     QHash<int, SystemData> sysDict; ///< dictionary of all systmes
     QThread* creationThread;                                ///< QThread on which the object is created
 };
@@ -298,7 +298,6 @@ MAVLinkDecoder* MainWindow::_mavLinkDecoderInstance(void)
 {
     if (!_mavlinkDecoder) {
         _mavlinkDecoder = new MAVLinkDecoder(qgcApp()->toolbox()->mavlinkProtocol());
-        connect(_mavlinkDecoder, &MAVLinkDecoder::valueChanged, this, &MainWindow::valueChanged);
     }
 
     return _mavlinkDecoder;
@@ -17,6 +17,7 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(const QString& title, QAction* action,
     _protocol(protocol),
     selectedSystemID(0),
     selectedComponentID(0),
+    clearTime(0),
     ui(new Ui::QGCMAVLinkInspector)
 {
     ui->setupUi(this);
@@ -42,11 +43,12 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(const QString& title, QAction* action,
 
     // Connect external connections
     connect(qgcApp()->toolbox()->multiVehicleManager(), &MultiVehicleManager::vehicleAdded, this, &QGCMAVLinkInspector::_vehicleAdded);
-    connect(protocol, &MAVLinkProtocol::messageReceived, this, &QGCMAVLinkInspector::receiveMessage);
 
-    // Attach the UI's refresh rate to a timer.
+    // Attach the UI's refresh rate to a timer. The messages and their counts are sampled from the protocol's
+    // statistics, so nothing is done for each received message here.
     connect(&updateTimer, &QTimer::timeout, this, &QGCMAVLinkInspector::refreshView);
     updateTimer.start(updateInterval);
+    refreshTime.start();
     
     loadSettings();
 }
@@ -107,14 +109,6 @@ void QGCMAVLinkInspector::addComponent(int uas, int component, const QString& na
  */
 void QGCMAVLinkInspector::clearView()
 {
-    QMap<int, mavlink_message_t* >::iterator ite;
-    for(ite=uasMessageStorage.begin(); ite!=uasMessageStorage.end();++ite)
-    {
-        delete ite.value();
-        ite.value() = NULL;
-    }
-    uasMessageStorage.clear();
-
     QMap<int, QMap<int, QTreeWidgetItem*>* >::iterator iteMsg;
     for (iteMsg=uasMsgTreeItems.begin(); iteMsg!=uasMsgTreeItems.end();++iteMsg)
     {
@@ -137,135 +131,133 @@ void QGCMAVLinkInspector::clearView()
     }
     uasTreeWidgetItems.clear();
     
-    QMap<int, QMap<int, float>* >::iterator iteHz;
-    for (iteHz=uasMessageHz.begin(); iteHz!=uasMessageHz.end();++iteHz)
-    {
-
-        iteHz.value()->clear();
-        delete iteHz.value();
-        iteHz.value() = NULL;
-    }
-    uasMessageHz.clear();
-
-    QMap<int, QMap<int, unsigned int>* >::iterator iteCount;
-    for(iteCount=uasMessageCount.begin(); iteCount!=uasMessageCount.end();++iteCount)
-    {
-        iteCount.value()->clear();
-        delete iteCount.value();
-        iteCount.value() = NULL;
-    }
-    uasMessageCount.clear();
-
-    QMap<int, QMap<int, quint64>* >::iterator iteLast;
-    for(iteLast=uasLastMessageUpdate.begin(); iteLast!=uasLastMessageUpdate.end();++iteLast)
-    {
-        iteLast.value()->clear();
-        delete iteLast.value();
-        iteLast.value() = NULL;
-    }
-    uasLastMessageUpdate.clear();
+    messageRates.clear();
 
-    onboardMessageInterval.clear();
+    // Only show messages which are received again
+    clearTime = QGC::groundTimeMilliseconds();
 
     ui->treeWidget->clear();
 }
 
+void QGCMAVLinkInspector::updateRate(const MAVLinkMessageStatistics::Sample_t& sample, float elapsed, MessageRate_t& rate)
+{
+    // Counters go back to zero if the statistics are cleared
+    quint32 count = sample.count >= rate.count ? sample.count - rate.count : sample.count;
+    quint64 bytes = sample.bytes >= rate.bytes ? sample.bytes - rate.bytes : sample.bytes;
+
+    // Compute the new low-pass filtered frequency
+    rate.hz = (1.0f-updateHzLowpass)*rate.hz + updateHzLowpass*count/elapsed;
+    rate.bytesPerSecond = (1.0f-updateHzLowpass)*rate.bytesPerSecond + updateHzLowpass*bytes/elapsed;
+    rate.count = sample.count;
+    rate.bytes = sample.bytes;
+}
+
 void QGCMAVLinkInspector::refreshView()
 {
-    QMap<int, mavlink_message_t* >::const_iterator ite;
+    /// One row of the tree: a message of one system, summed up over the components sending it
+    typedef struct {
+        float   hz;
+        float   bytesPerSecond;
+        const MAVLinkMessageStatistics::Sample_t* sample;    ///< Most recently received sample
+    } MessageRow_t;
+
+    float elapsed = refreshTime.restart() / 1000.0f;
+    if (elapsed <= 0.0f) {
+        elapsed = (float)updateInterval/1000.0f;
+    }
+
+    QList<MAVLinkMessageStatistics::Sample_t> samples = _protocol->messageStatistics()->sample(selectedSystemID, selectedComponentID);
 
-    for(ite=uasMessageStorage.constBegin(); ite!=uasMessageStorage.constEnd();++ite)
+    QMap<int, QMap<int, MessageRow_t> > rows;
+    for (int i = 0; i < samples.count(); i++)
     {
-        mavlink_message_t* msg = ite.value();
-        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(msg);
+        const MAVLinkMessageStatistics::Sample_t& sample = samples[i];
 
-        if (!msgInfo) {
-            qWarning() << QStringLiteral("QGCMAVLinkInspector::refreshView NULL msgInfo msgid(%1)").arg(msg->msgid);
-            continue;
-        }
+        if (sample.lastReceived < clearTime) continue;
 
         // Ignore NULL values
-        if (msg->msgid == 0xFF) continue;
-
-        // Update the message frenquency
-
-        // Get the previous frequency for low-pass filtering
-        float msgHz = 0.0f;
-        QMap<int, QMap<int, float>* >::const_iterator iteHz = uasMessageHz.find(msg->sysid);
-        QMap<int, float>* uasMsgHz = iteHz.value();
+        if (sample.msgid == 0xFF) continue;
 
-        while((iteHz != uasMessageHz.end()) && (iteHz.key() == msg->sysid))
+        // Update the message frequency, the first sample only sets the starting counts
+        quint64 key = ((quint64)sample.msgid << 16) | ((quint64)sample.sysid << 8) | sample.compid;
+        QHash<quint64, MessageRate_t>::iterator rate = messageRates.find(key);
+        if (rate == messageRates.end())
         {
-            if(iteHz.value()->contains(msg->msgid))
-            {
-                uasMsgHz = iteHz.value();
-                msgHz = iteHz.value()->value(msg->msgid);
-                break;
-            }
-            ++iteHz;
+            MessageRate_t newRate = { sample.count, sample.bytes, 0.0f, 0.0f };
+            rate = messageRates.insert(key, newRate);
         }
-
-        // Get the number of message received
-        float msgCount = 0;
-        QMap<int, QMap<int, unsigned int> * >::const_iterator iter = uasMessageCount.find(msg->sysid);
-        QMap<int, unsigned int>* uasMsgCount = iter.value();
-
-        while((iter != uasMessageCount.end()) && (iter.key()==msg->sysid))
+        else
         {
-            if(iter.value()->contains(msg->msgid))
-            {
-                msgCount = (float) iter.value()->value(msg->msgid);
-                uasMsgCount = iter.value();
-                break;
-            }
-            ++iter;
+            updateRate(sample, elapsed, rate.value());
         }
 
-        // Compute the new low-pass filtered frequency and update the message count
-        msgHz = (1.0f-updateHzLowpass)* msgHz + updateHzLowpass*msgCount/((float)updateInterval/1000.0f);
-        uasMsgHz->insert(msg->msgid,msgHz);
-        uasMsgCount->insert(msg->msgid,(unsigned int) 0);
+        MessageRow_t& row = rows[sample.sysid][sample.msgid];
+        row.hz += rate.value().hz;
+        row.bytesPerSecond += rate.value().bytesPerSecond;
+        if (!row.sample || sample.lastReceived >= row.sample->lastReceived)
+        {
+            row.sample = &sample;
+        }
+    }
 
-        // Update the tree view
-        QString messageName("%1 (%2 Hz, #%3)");
-        messageName = messageName.arg(msgInfo->name).arg(msgHz, 3, 'f', 1).arg(msg->msgid);
+    QMap<int, QMap<int, MessageRow_t> >::const_iterator iteSys;
+    for (iteSys = rows.constBegin(); iteSys != rows.constEnd(); ++iteSys)
+    {
+        int sysid = iteSys.key();
 
-        addUAStoTree(msg->sysid);
+        addUAStoTree(sysid);
 
         // Look for the tree for the UAS sysid
-        QMap<int, QTreeWidgetItem*>* msgTreeItems = uasMsgTreeItems.value(msg->sysid);
+        QMap<int, QTreeWidgetItem*>* msgTreeItems = uasMsgTreeItems.value(sysid);
         if (!msgTreeItems)
         {
             // The UAS tree has not been created yet, no update
-            return;
+            continue;
         }
 
-        // Add the message with msgid to the tree if not done yet
-        if(!msgTreeItems->contains(msg->msgid))
+        QMap<int, MessageRow_t>::const_iterator iteRow;
+        for (iteRow = iteSys.value().constBegin(); iteRow != iteSys.value().constEnd(); ++iteRow)
         {
-            QStringList fields;
-            fields << messageName;
-            QTreeWidgetItem* widget = new QTreeWidgetItem();
-            for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+            const MessageRow_t& row = iteRow.value();
+
+            // Work on a copy, updateField enforces null termination of strings
+            mavlink_message_t msg = row.sample->message;
+            const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&msg);
+
+            if (!msgInfo) {
+                qWarning() << QStringLiteral("QGCMAVLinkInspector::refreshView NULL msgInfo msgid(%1)").arg(msg.msgid);
+                continue;
+            }
+
+            // Update the tree view
+            QString messageName("%1 (%2 Hz, %3 B/s, #%4)");
+            messageName = messageName.arg(msgInfo->name).arg(row.hz, 3, 'f', 1).arg(row.bytesPerSecond, 0, 'f', 0).arg(msg.msgid);
+
+            // Add the message with msgid to the tree if not done yet
+            if(!msgTreeItems->contains(msg.msgid))
             {
-                QTreeWidgetItem* field = new QTreeWidgetItem();
-                widget->addChild(field);
+                QTreeWidgetItem* widget = new QTreeWidgetItem();
+                for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+                {
+                    QTreeWidgetItem* field = new QTreeWidgetItem();
+                    widget->addChild(field);
+                }
+                msgTreeItems->insert(msg.msgid,widget);
+                QList<int> groupKeys = msgTreeItems->uniqueKeys();
+                int insertIndex = groupKeys.indexOf(msg.msgid);
+                uasTreeWidgetItems.value(sysid)->insertChild(insertIndex,widget);
             }
-            msgTreeItems->insert(msg->msgid,widget);
-            QList<int> groupKeys = msgTreeItems->uniqueKeys();
-            int insertIndex = groupKeys.indexOf(msg->msgid);
-            uasTreeWidgetItems.value(msg->sysid)->insertChild(insertIndex,widget);
-        }
 
-        // Update the message
-        QTreeWidgetItem* message = msgTreeItems->value(msg->msgid);
-        if(message)
-        {
-            message->setFirstColumnSpanned(true);
-            message->setData(0, Qt::DisplayRole, QVariant(messageName));
-            for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+            // Update the message
+            QTreeWidgetItem* message = msgTreeItems->value(msg.msgid);
+            if(message)
             {
-                updateField(msg, msgInfo, i, message->child(i));
+                message->setFirstColumnSpanned(true);
+                message->setData(0, Qt::DisplayRole, QVariant(messageName));
+                for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+                {
+                    updateField(&msg, msgInfo, i, message->child(i));
+                }
             }
         }
     }
@@ -291,129 +283,6 @@ void QGCMAVLinkInspector::addUAStoTree(int sysId)
     }
 }
 
-void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t message)
-{
-    Q_UNUSED(link);
-
-    quint64 receiveTime;
-    
-    if (selectedSystemID != 0 && selectedSystemID != message.sysid) return;
-    if (selectedComponentID != 0 && selectedComponentID != message.compid) return;
-
-    // Create dynamically an array to store the messages for each UAS
-    if (!uasMessageStorage.contains(message.sysid))
-    {
-        mavlink_message_t* msg = new mavlink_message_t;
-        *msg = message;
-        uasMessageStorage.insertMulti(message.sysid,msg);
-    }
-
-    bool msgFound = false;
-    QMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(message.sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == message.sysid))
-    {
-        if (iteMsg.value()->msgid == message.msgid)
-        {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
-        }
-        ++iteMsg;
-    }
-    if (!msgFound)
-    {
-        mavlink_message_t* msgIdMessage = new mavlink_message_t;
-        *msgIdMessage = message;
-        uasMessageStorage.insertMulti(message.sysid,msgIdMessage);
-    }
-    else
-    {
-        *uasMessage = message;
-    }
-
-    // Looking if this message has already been received once
-    msgFound = false;
-    QMap<int, QMap<int, quint64>* >::const_iterator ite = uasLastMessageUpdate.find(message.sysid);
-    QMap<int, quint64>* lastMsgUpdate = ite.value();
-    while((ite != uasLastMessageUpdate.end()) && (ite.key() == message.sysid))
-    {   
-        if(ite.value()->contains(message.msgid))
-        {
-            msgFound = true;
-
-            // Point to the found message
-            lastMsgUpdate = ite.value();
-            break;
-        }
-        ++ite;
-    }
-
-    receiveTime = QGC::groundTimeMilliseconds();
-
-    // If the message doesn't exist, create a map for the frequency, message count and time of reception
-    if(!msgFound)
-    {
-        // Create a map for the message frequency
-        QMap<int, float>* messageHz = new QMap<int,float>;
-        messageHz->insert(message.msgid,0.0f);
-        uasMessageHz.insertMulti(message.sysid,messageHz);
-
-        // Create a map for the message count
-        QMap<int, unsigned int>* messagesCount = new QMap<int, unsigned int>;
-        messagesCount->insert(message.msgid,0);
-        uasMessageCount.insertMulti(message.sysid,messagesCount);
-
-        // Create a map for the time of reception of the message
-        QMap<int, quint64>* lastMessage = new QMap<int, quint64>;
-        lastMessage->insert(message.msgid,receiveTime);
-        uasLastMessageUpdate.insertMulti(message.sysid,lastMessage);
-
-        // Point to the created message
-        lastMsgUpdate = lastMessage;
-    }
-    else
-    {
-        // The message has been found/created
-        if ((lastMsgUpdate->contains(message.msgid))&&(uasMessageCount.contains(message.sysid)))
-        {
-            // Looking for and updating the message count
-            unsigned int count = 0;
-            QMap<int, QMap<int, unsigned int>* >::const_iterator iter = uasMessageCount.find(message.sysid);
-            QMap<int, unsigned int> * uasMsgCount = iter.value();
-            while((iter != uasMessageCount.end()) && (iter.key() == message.sysid))
-            {
-                if(iter.value()->contains(message.msgid))
-                {
-                    uasMsgCount = iter.value();
-                    count = uasMsgCount->value(message.msgid,0);
-                    uasMsgCount->insert(message.msgid,count+1);
-                    break;
-                }
-                ++iter;
-            }
-        }
-        lastMsgUpdate->insert(message.msgid,receiveTime);
-    }
-
-    if (selectedSystemID == 0 || selectedComponentID == 0)
-    {
-        return;
-    }
-
-    switch (message.msgid)
-    {
-        case MAVLINK_MSG_ID_DATA_STREAM:
-            {
-                mavlink_data_stream_t stream;
-                mavlink_msg_data_stream_decode(&message, &stream);
-                onboardMessageInterval.insert(stream.stream_id, stream.message_rate);
-            }
-            break;
-
-    }
-}
-
 QGCMAVLinkInspector::~QGCMAVLinkInspector()
 {
     clearView();
@@ -424,27 +293,8 @@ void QGCMAVLinkInspector::updateField(mavlink_message_t* msg, const mavlink_mess
 {
     // Add field tree widget item
     item->setData(0, Qt::DisplayRole, QVariant(msgInfo->fields[fieldid].name));
-    
-    bool msgFound = false;
-    QMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(msg->sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == msg->sysid))
-    {
-        if (iteMsg.value()->msgid == msg->msgid)
-        {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
-        }
-        ++iteMsg;
-    }
-
-    if (!msgFound)
-    {
-        return;
-    }
 
-    uint8_t* m = (uint8_t*)&uasMessage->payload64[0];
+    uint8_t* m = (uint8_t*)&msg->payload64[0];
 
     switch (msgInfo->fields[fieldid].type)
     {
@@ -2,7 +2,9 @@
 #define QGCMAVLINKINSPECTOR_H
 
 #include <QMap>
+#include <QHash>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "QGCDockWidget.h"
 #include "MAVLinkProtocol.h"
@@ -24,7 +26,6 @@ public:
     ~QGCMAVLinkInspector();
 
 public slots:
-    void receiveMessage(LinkInterface* link,mavlink_message_t message);
     /** @brief Clear all messages */
     void clearView();
     /** @brief Update view */
@@ -37,26 +38,32 @@ public slots:
     void selectDropDownMenuComponent(int dropdownid);
 
 protected:
+    /// Rates of one system/component/message id, computed from the differences between statistics samples
+    typedef struct {
+        quint32 count;              ///< Message count at the last refresh
+        quint64 bytes;              ///< Byte count at the last refresh
+        float   hz;                 ///< Low-pass filtered message rate
+        float   bytesPerSecond;     ///< Low-pass filtered byte rate
+    } MessageRate_t;
+
     MAVLinkProtocol *_protocol;     ///< MAVLink instance
     int selectedSystemID;          ///< Currently selected system
     int selectedComponentID;       ///< Currently selected component
     QMap<int, int> systems;     ///< Already observed systems
     QMap<int, int> components; ///< Already observed components
-    QMap<int, float> onboardMessageInterval; ///< Stores the onboard selected data rate
     QTimer updateTimer; ///< Only update at 1 Hz to not overload the GUI
+    QElapsedTimer refreshTime; ///< Time since the last refresh, for the rate computation
+    quint64 clearTime; ///< Messages last received before this ground time are not shown
 
     QMap<int, QTreeWidgetItem* > uasTreeWidgetItems; ///< Tree of available uas with their widget
     QMap<int, QMap<int, QTreeWidgetItem*>* > uasMsgTreeItems; ///< Stores the widget of the received message for each UAS
 
-    QMap<int, mavlink_message_t* > uasMessageStorage; ///< Stores the messages for every UAS
-
-    QMap<int, QMap<int, float>* > uasMessageHz; ///< Stores the frequency of each message of each UAS
-    QMap<int, QMap<int, unsigned int>* > uasMessageCount; ///< Stores the message count of each message of each UAS
-
-    QMap<int, QMap<int, quint64>* > uasLastMessageUpdate; ///< Stores the time of the last message for each message of each UAS
+    QHash<quint64, MessageRate_t> messageRates; ///< Rates by system, component and message id
 
     /* @brief Update one message field */
     void updateField(mavlink_message_t* msg, const mavlink_message_info_t* msgInfo, int fieldid, QTreeWidgetItem* item);
+    /* @brief Update the rates of a statistics entry with a new sample */
+    void updateRate(const MAVLinkMessageStatistics::Sample_t& sample, float elapsed, MessageRate_t& rate);
     /** @brief Rebuild the list of components */
     void rebuildComponentList();
     /* @brief Create a new tree for a new UAS */
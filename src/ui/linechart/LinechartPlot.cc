@@ -191,6 +191,9 @@ void LinechartPlot::removeTimedOutCurves()
             // Remove this curve
             // Delete curves
             QwtPlotCurve* curve = _curves.take(key);
+            if (curve && curve->isVisible()) {
+                emit curveVisibilityChanged(key, false);
+            }
             // Delete the object
             delete curve;
             // Set the pointer null
@@ -228,9 +231,6 @@ void LinechartPlot::setZeroValue(QString id, double zeroValue)
 
 void LinechartPlot::appendData(QString dataname, quint64 ms, double value)
 {
-    /* Lock resource to ensure data integrity */
-    datalock.lock();
-
     /* Check if dataset identifier already exists */
     if(!data.contains(dataname)) {
         addCurve(dataname);
@@ -275,13 +275,9 @@ void LinechartPlot::appendData(QString dataname, quint64 ms, double value)
     if (value > maxValue) maxValue = value;
     valueInterval = maxValue - minValue;
 
-    // Assign dataset to curve
-    QwtPlotCurve* curve = _curves.value(dataname);
-    curve->setRawSamples(dataset->getPlotX(), dataset->getPlotY(), dataset->getPlotCount());
+    // The curve reads the dataset in place, it picks up the new value on the next replot
 
     //    qDebug() << "mintime" << minTime << "maxtime" << maxTime << "last max time" << "window position" << getWindowPosition();
-
-    datalock.unlock();
 }
 
 /**
@@ -330,6 +326,7 @@ void LinechartPlot::addCurve(QString id)
     //    curve->setRenderHint(QwtPlotItem::RenderAntialiased);
 
     curve->attach(this);
+    emit curveVisibilityChanged(id, true);
     //@TODO Color differentiation between the curves will be necessary
 
     /* Create symbol for datapoints on curve */
@@ -348,6 +345,9 @@ void LinechartPlot::addCurve(QString id)
     // Add dataset to list
     data.insert(id, dataset);
 
+    // Bind the dataset to the curve once, the curve takes ownership of the adapter
+    curve->setData(new TimeSeriesCurveData(dataset));
+
     // Notify connected components about new curve
     emit curveAdded(id);
 }
@@ -415,6 +415,9 @@ void LinechartPlot::setScaling(int scaling)
 void LinechartPlot::setVisibleById(QString id, bool visible)
 {
     if(_curves.contains(id)) {
+        if (_curves.value(id)->isVisible() != visible) {
+            emit curveVisibilityChanged(id, visible);
+        }
         _curves.value(id)->setVisible(visible);
         if(visible)
         {
@@ -699,13 +702,15 @@ void LinechartPlot::paintRealtime()
  **/
 void LinechartPlot::removeAllData()
 {
-    datalock.lock();
     // Delete curves
     QMap<QString, QwtPlotCurve*>::iterator i;
     for(i = _curves.begin(); i != _curves.end(); ++i)
     {
         // Remove from curve list
         QwtPlotCurve* curve = _curves.take(i.key());
+        if (curve && curve->isVisible()) {
+            emit curveVisibilityChanged(i.key(), false);
+        }
         // Delete the object
         delete curve;
         // Set the pointer null
@@ -726,21 +731,27 @@ void LinechartPlot::removeAllData()
         // Set the pointer null
         d = NULL;
     }
-    datalock.unlock();
     replot();
 }
 
 
-TimeSeriesData::TimeSeriesData(QwtPlot* plot, QString friendlyName, quint64 plotInterval, quint64 maxInterval, double zeroValue):
+TimeSeriesData::TimeSeriesData(QwtPlot* plot, QString friendlyName, quint64 plotInterval, quint64 maxInterval, double zeroValue, int capacity):
+    lastValue(0),
     minValue(DBL_MAX),
     maxValue(DBL_MIN),
     zeroValue(0),
     count(0),
+    firstSample(0),
+    plotFirstSample(0),
     mean(0.0),
     median(0.0),
     variance(0.0),
-    averageWindow(50)
+    m2(0.0),
+    averageWindow(50),
+    statCount(0)
 {
+    Q_ASSERT(capacity > 1 && (capacity & (capacity - 1)) == 0);
+
     this->plot = plot;
     this->friendlyName = friendlyName;
     this->maxInterval = maxInterval;
@@ -750,8 +761,14 @@ TimeSeriesData::TimeSeriesData(QwtPlot* plot, QString friendlyName, quint64 plot
     /* initialize time */
     startTime = QUINT64_MAX;
     stopTime = QUINT64_MIN;
-
-    plotCount = 0;
+    interval = 0;
+
+    /* start small, the ring buffer grows as samples come in */
+    maxCapacity = capacity;
+    capacityMask = qMin(capacity, (int)INITIAL_CAPACITY) - 1;
+    ms.resize(capacityMask + 1);
+    value.resize(capacityMask + 1);
+    resizePyramid();
 }
 
 TimeSeriesData::~TimeSeriesData()
@@ -762,11 +779,15 @@ TimeSeriesData::~TimeSeriesData()
 void TimeSeriesData::setInterval(quint64 ms)
 {
     plotInterval = ms;
+    // The interval may have grown, start over from the oldest sample within it
+    plotFirstSample = (stopTime > plotInterval) ? lowerBound(stopTime - plotInterval) : firstSample;
 }
 
 void TimeSeriesData::setAverageWindowSize(int windowSize)
 {
-    this->averageWindow = windowSize;
+    // The sample leaving the window must still be in the ring buffer
+    this->averageWindow = qBound(1, windowSize, getCapacity() - 1);
+    recomputeStatistics();
 }
 
 /**
@@ -777,72 +798,280 @@ void TimeSeriesData::setAverageWindowSize(int windowSize)
  **/
 void TimeSeriesData::append(quint64 ms, double value)
 {
-    dataMutex.lock();
-    // Qt will automatically use a smart growth strategy: http://doc.qt.io/qt-5/containers.html#growth-strategies
-    this->ms.append(ms);
-    this->value.append(value);
+    // Grow the ring buffer rather than overwrite a sample which is still retained or still in the averaging window
+    if (count > capacityMask && (int)capacityMask + 1 < maxCapacity
+            && (count - firstSample > capacityMask || averageWindow > capacityMask)) {
+        grow();
+    }
+
+    quint64 index = count;
+    this->ms[index & capacityMask] = ms;
+    this->value[index & capacityMask] = value;
     this->lastValue = value;
-    this->mean = 0;
-    //QList<double> medianList = QList<double>();
-    for (unsigned int i = 0; (i < averageWindow) && (((int)count - (int)i) >= 0); ++i) {
-        this->mean += this->value[count-i];
-        //medianList.append(this->value[count-i]);
-    }
-    this->mean = mean / static_cast<double>(qMin(averageWindow,static_cast<unsigned int>(count)));
-
-    this->variance = 0;
-    for (unsigned int i = 0; (i < averageWindow) && (((int)count - (int)i) >= 0); ++i) {
-        this->variance += (this->value[count-i] - mean) * (this->value[count-i] - mean);
-    }
-    this->variance = this->variance / static_cast<double>(qMin(averageWindow,static_cast<unsigned int>(count)));
-
-//    qSort(medianList);
-
-//    if (medianList.count() > 2)
-//    {
-//        if (medianList.count() % 2 == 0)
-//        {
-//            median = (medianList.at(medianList.count()/2) + medianList.at(medianList.count()/2+1)) / 2.0;
-//        }
-//        else
-//        {
-//            median = medianList.at(medianList.count()/2+1);
-//        }
-//    }
+    count++;
+
+    // Oldest sample is overwritten once the ring buffer is full
+    if (count - firstSample > capacityMask + 1) {
+        firstSample = count - (capacityMask + 1);
+    }
+
+    updatePyramid(index);
+    updateStatistics(value);
 
     // Update statistical values
     if(ms < startTime) startTime = ms;
     if(ms > stopTime) stopTime = ms;
     interval = stopTime - startTime;
 
-    if (interval > plotInterval) {
-        while (this->ms[count - plotCount] < stopTime - plotInterval) {
-            plotCount--;
-        }
-    }
-
-    count++;
-    plotCount++;
-
     if(minValue > value) minValue = value;
     if(maxValue < value) maxValue = value;
 
     // Trim dataset if necessary
-    if(maxInterval > 0) {
+    if(maxInterval > 0 && stopTime > maxInterval) {
         // maxInterval = 0 means infinite
+        double minTime = stopTime - maxInterval;
+        while (firstSample < index && timeAt(firstSample) < minTime) {
+            firstSample++;
+        }
+    }
 
-        if(interval > maxInterval && !this->ms.isEmpty() && !this->value.isEmpty()) {
-            // The time at which this time series should be cut
-            double minTime = stopTime - maxInterval;
-            // Delete elements from the start of the list as long the time
-            // value of this elements is before the cut time
-            while(this->ms.first() < minTime) {
-                this->ms.pop_front();
-                this->value.pop_front();
+    // Move the start of the plot interval along, this only ever moves forward
+    if (plotFirstSample < firstSample) {
+        plotFirstSample = firstSample;
+    }
+    if (stopTime > plotInterval) {
+        double plotStartTime = stopTime - plotInterval;
+        while (plotFirstSample < index && timeAt(plotFirstSample) < plotStartTime) {
+            plotFirstSample++;
+        }
+    }
+}
+
+/**
+ * @brief Update the mean and variance over the averaging window with a new sample
+ *
+ * Uses Welford's algorithm. Once the window is full the sample leaving the window is removed in the same step.
+ **/
+void TimeSeriesData::updateStatistics(double value)
+{
+    if (statCount < averageWindow) {
+        statCount++;
+        double delta = value - mean;
+        mean += delta / statCount;
+        m2 += delta * (value - mean);
+    } else {
+        double oldValue = valueAt(count - 1 - averageWindow);
+        double oldMean = mean;
+        mean += (value - oldValue) / statCount;
+        m2 += (value - oldValue) * (value - mean + oldValue - oldMean);
+    }
+    // Guard against rounding errors accumulating below zero
+    if (m2 < 0) {
+        m2 = 0;
+    }
+    variance = m2 / statCount;
+}
+
+/**
+ * @brief Recompute the statistics from scratch after the averaging window changed
+ **/
+void TimeSeriesData::recomputeStatistics()
+{
+    quint64 first = count - qMin((quint64)averageWindow, count - firstSample);
+
+    mean = 0;
+    m2 = 0;
+    statCount = 0;
+    for (quint64 index = first; index < count; index++) {
+        double sample = valueAt(index);
+        statCount++;
+        double delta = sample - mean;
+        mean += delta / statCount;
+        m2 += delta * (sample - mean);
+    }
+    variance = statCount ? m2 / statCount : 0;
+}
+
+/**
+ * @brief Double the size of the ring buffer
+ *
+ * Only called once the ring buffer is full, so every slot holds a sample. The samples are moved to their slots
+ * in the larger buffer and the min/max pyramid is rebuilt over them. Doubling keeps this O(1) amortized.
+ **/
+void TimeSeriesData::grow()
+{
+    quint64 newCapacityMask = (capacityMask << 1) | 1;
+    quint64 first = count - (capacityMask + 1);
+
+    QVector<double> newMs(newCapacityMask + 1);
+    QVector<double> newValue(newCapacityMask + 1);
+    for (quint64 index = first; index < count; index++) {
+        newMs[index & newCapacityMask] = ms[index & capacityMask];
+        newValue[index & newCapacityMask] = value[index & capacityMask];
+    }
+    ms.swap(newMs);
+    value.swap(newValue);
+    capacityMask = newCapacityMask;
+
+    // Buckets reaching back before the first moved sample come out wrong, but they also reach back before
+    // firstSample and are never used
+    resizePyramid();
+    for (quint64 index = first; index < count; index++) {
+        updatePyramid(index);
+    }
+}
+
+/**
+ * @brief Allocate one level of the min/max pyramid per power of 2 up to the ring buffer size
+ **/
+void TimeSeriesData::resizePyramid()
+{
+    pyramid.clear();
+    for (int bucketCount = (capacityMask + 1) / 2; bucketCount > 0; bucketCount /= 2) {
+        pyramid.append(QVector<MinMaxBucket>(bucketCount));
+    }
+}
+
+/**
+ * @brief Add a new sample to the min/max pyramid
+ *
+ * A sample completes a bucket on each level where its index + 1 is a multiple of the bucket size. Each of
+ * those buckets is combined from the two buckets below it, so appending is O(1) amortized.
+ **/
+void TimeSeriesData::updatePyramid(quint64 index)
+{
+    for (int level = 1; level <= pyramid.count() && ((index + 1) & ((Q_UINT64_C(1) << level) - 1)) == 0; level++) {
+        quint64 bucket = index >> level;
+        MinMaxBucket combined;
+
+        if (level == 1) {
+            quint64 left = bucket * 2;
+            combined.minIndex = valueAt(index) < valueAt(left) ? index : left;
+            combined.maxIndex = valueAt(index) > valueAt(left) ? index : left;
+        } else {
+            const MinMaxBucket& left = bucketAt(level - 1, bucket * 2);
+            const MinMaxBucket& right = bucketAt(level - 1, bucket * 2 + 1);
+            combined.minIndex = valueAt(right.minIndex) < valueAt(left.minIndex) ? right.minIndex : left.minIndex;
+            combined.maxIndex = valueAt(right.maxIndex) > valueAt(left.maxIndex) ? right.maxIndex : left.maxIndex;
+        }
+
+        const QVector<MinMaxBucket>& buckets = pyramid[level - 1];
+        pyramid[level - 1][bucket & (buckets.count() - 1)] = combined;
+    }
+}
+
+const TimeSeriesData::MinMaxBucket& TimeSeriesData::bucketAt(int level, quint64 bucket) const
+{
+    const QVector<MinMaxBucket>& buckets = pyramid[level - 1];
+    return buckets[bucket & (buckets.count() - 1)];
+}
+
+void TimeSeriesData::rangeMinMax(quint64 first, quint64 end, double& min, double& max) const
+{
+    min = DBL_MAX;
+    max = -DBL_MAX;
+
+    quint64 index = first;
+    while (index < end) {
+        // Use the largest complete bucket which starts here and does not reach past the end
+        int level = 0;
+        while (level < pyramid.count()) {
+            quint64 bucketSize = Q_UINT64_C(1) << (level + 1);
+            if ((index & (bucketSize - 1)) != 0 || index + bucketSize > end) {
+                break;
             }
+            level++;
         }
+
+        if (level == 0) {
+            min = qMin(min, valueAt(index));
+            max = qMax(max, valueAt(index));
+            index++;
+        } else {
+            const MinMaxBucket& bucket = bucketAt(level, index >> level);
+            min = qMin(min, valueAt(bucket.minIndex));
+            max = qMax(max, valueAt(bucket.maxIndex));
+            index += Q_UINT64_C(1) << level;
+        }
+    }
+}
+
+void TimeSeriesData::decimate(quint64 first, quint64 end, int maxPoints, QVector<quint64>& indices) const
+{
+    indices.clear();
+
+    // Each bucket contributes up to two points
+    int level = 0;
+    while (level < pyramid.count() && ((end - first) >> level) > (quint64)maxPoints / 2) {
+        level++;
+    }
+
+    // Partial buckets at either end are added as raw samples
+    quint64 firstBucket = (first + (Q_UINT64_C(1) << level) - 1) >> level;
+    quint64 endBucket = end >> level;
+    if (level == 0 || firstBucket >= endBucket) {
+        for (quint64 index = first; index < end; index++) {
+            indices.append(index);
+        }
+        return;
+    }
+
+    for (quint64 index = first; index < (firstBucket << level); index++) {
+        indices.append(index);
+    }
+    for (quint64 bucket = firstBucket; bucket < endBucket; bucket++) {
+        const MinMaxBucket& minMax = bucketAt(level, bucket);
+        if (minMax.minIndex == minMax.maxIndex) {
+            indices.append(minMax.minIndex);
+        } else {
+            // Keep the points in time order
+            indices.append(qMin(minMax.minIndex, minMax.maxIndex));
+            indices.append(qMax(minMax.minIndex, minMax.maxIndex));
+        }
+    }
+    for (quint64 index = endBucket << level; index < end; index++) {
+        indices.append(index);
     }
-    dataMutex.unlock();
+}
+
+quint64 TimeSeriesData::lowerBound(double ms) const
+{
+    quint64 low = firstSample;
+    quint64 high = count;
+    while (low < high) {
+        quint64 middle = low + (high - low) / 2;
+        if (timeAt(middle) < ms) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+double TimeSeriesData::timeAt(quint64 index) const
+{
+    return ms[index & capacityMask];
+}
+
+double TimeSeriesData::valueAt(quint64 index) const
+{
+    return value[index & capacityMask];
+}
+
+quint64 TimeSeriesData::firstIndex() const
+{
+    return firstSample;
+}
+
+quint64 TimeSeriesData::endIndex() const
+{
+    return count;
+}
+
+quint64 TimeSeriesData::plotFirstIndex() const
+{
+    return plotFirstSample;
 }
 
 /**
@@ -927,7 +1156,7 @@ void TimeSeriesData::setZeroValue(double zeroValue)
 }
 
 /**
- * @brief Get the number of points in the dataset
+ * @brief Get the number of points appended to the dataset
  *
  * @return The number of points
  **/
@@ -943,48 +1172,115 @@ int TimeSeriesData::getCount() const
  **/
 int TimeSeriesData::getPlotCount() const
 {
-    return plotCount;
+    return count - plotFirstSample;
 }
 
 /**
- * @brief Get the data array size
- * The data array size is \e NOT equal to the number of items in the data set, as
- * array space is pre-allocated. Use getCount() to get the number of data points.
+ * @brief Get the number of points currently stored
+ * This is at most getCapacity(), older points are dropped.
  *
- * @return The data array size
+ * @return The number of stored points
  * @see getCount()
  **/
 int TimeSeriesData::size() const
 {
-    return ms.size();
+    return count - firstSample;
 }
 
 /**
- * @brief Get the X (time) values
- *
- * @return The x values
+ * @brief Get the maximum number of points stored
  **/
-const double* TimeSeriesData::getX() const
+int TimeSeriesData::getCapacity() const
 {
-    return ms.data();
+    return maxCapacity;
 }
 
-const double* TimeSeriesData::getPlotX() const
+/**
+ * @brief Get the number of points the ring buffer currently has room for
+ * This grows up to getCapacity() as points are appended.
+ **/
+int TimeSeriesData::getAllocated() const
 {
-    return ms.data() + (count - plotCount);
+    return capacityMask + 1;
+}
+
+TimeSeriesCurveData::TimeSeriesCurveData(const TimeSeriesData* series) :
+    series(series),
+    viewValid(false),
+    viewCount(0),
+    viewFirst(0),
+    viewEnd(0),
+    viewDecimated(false)
+{
+
+}
+
+void TimeSeriesCurveData::setRectOfInterest(const QRectF& rect)
+{
+    rectOfInterest = rect;
+    viewValid = false;
 }
 
 /**
- * @brief Get the Y (data) values
- *
- * @return The y values
+ * @brief Rebuild the list of samples handed to the curve
+ * The view covers the rectangle of interest (the visible x range) plus one sample on either side so lines
+ * run to the edge of the canvas. Without a rectangle of interest it covers the plot interval.
  **/
-const double* TimeSeriesData::getY() const
+void TimeSeriesCurveData::updateView() const
 {
-    return value.data();
+    if (viewValid && viewCount == series->endIndex()) {
+        return;
+    }
+    viewValid = true;
+    viewCount = series->endIndex();
+
+    quint64 first = series->plotFirstIndex();
+    quint64 end = series->endIndex();
+    if (rectOfInterest.width() > 0) {
+        first = series->lowerBound(rectOfInterest.left());
+        end = series->lowerBound(rectOfInterest.right());
+        if (first > series->firstIndex()) {
+            first--;
+        }
+        if (end < series->endIndex()) {
+            end++;
+        }
+    }
+
+    viewFirst = first;
+    viewEnd = end;
+    viewDecimated = (end - first) > (quint64)MAX_PLOT_POINTS;
+    if (viewDecimated) {
+        series->decimate(first, end, MAX_PLOT_POINTS, viewIndices);
+    } else {
+        viewIndices.clear();
+    }
+}
+
+size_t TimeSeriesCurveData::size() const
+{
+    updateView();
+    return viewDecimated ? viewIndices.count() : viewEnd - viewFirst;
+}
+
+QPointF TimeSeriesCurveData::sample(size_t i) const
+{
+    quint64 index = viewDecimated ? viewIndices[i] : viewFirst + i;
+    return QPointF(series->timeAt(index), series->valueAt(index));
 }
 
-const double* TimeSeriesData::getPlotY() const
+/**
+ * @brief Bounding rectangle of the plot interval, used for autoscaling
+ **/
+QRectF TimeSeriesCurveData::boundingRect() const
 {
-    return value.data() + (count - plotCount);
+    quint64 first = series->plotFirstIndex();
+    quint64 end = series->endIndex();
+    if (first >= end) {
+        return QRectF(0.0, 0.0, -1.0, -1.0);
+    }
+
+    double min, max;
+    series->rangeMinMax(first, end, min, max);
+    return QRectF(series->timeAt(first), min, series->timeAt(end - 1) - series->timeAt(first), max - min);
 }
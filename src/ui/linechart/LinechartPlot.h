@@ -33,6 +33,7 @@
 #include <qwt_scale_widget.h>
 #include <qwt_scale_engine.h>
 #include <qwt_plot.h>
+#include <qwt_series_data.h>
 #include "ChartPlot.h"
 #include "MG.h"
 
@@ -58,26 +59,46 @@ class QwtPlotCurve;
 /**
  * @brief Container class for the time series data
  *
+ * Samples are kept in a ring buffer which starts out small and doubles whenever it is full, up to a fixed
+ * capacity. A curve only pays for the samples it holds, and the memory used per curve is bounded. Mean and
+ * variance over the averaging window are updated incrementally (Welford) as samples come in. A min/max
+ * pyramid over the ring buffer allows decimating the visible range for rendering and finding the value
+ * range of any interval without visiting every sample.
  **/
 class TimeSeriesData
 {
 public:
 
-    TimeSeriesData(QwtPlot* plot, QString friendlyName = "data", quint64 plotInterval = 10000, quint64 maxInterval = 0, double zeroValue = 0);
+    TimeSeriesData(QwtPlot* plot, QString friendlyName = "data", quint64 plotInterval = 10000, quint64 maxInterval = 0, double zeroValue = 0, int capacity = DEFAULT_CAPACITY);
     ~TimeSeriesData();
 
+    static const int DEFAULT_CAPACITY = 1 << 15;    ///< Default number of samples kept per curve, must be a power of 2
+    static const int INITIAL_CAPACITY = 1 << 8;     ///< Number of samples allocated for a new curve, must be a power of 2
+
     void append(quint64 ms, double value);
 
     QwtScaleMap* getScaleMap();
 
     int getCount() const;
     int size() const;
-    const double* getX() const;
-    const double* getY() const;
-
-    const double* getPlotX() const;
-    const double* getPlotY() const;
     int getPlotCount() const;
+    int getCapacity() const;
+    int getAllocated() const;
+
+    /** @brief Absolute index of the oldest sample still stored */
+    quint64 firstIndex() const;
+    /** @brief Absolute index one past the newest sample */
+    quint64 endIndex() const;
+    /** @brief Absolute index of the oldest sample within the plot interval */
+    quint64 plotFirstIndex() const;
+    /** @brief Absolute index of the first stored sample at or after the specified time */
+    quint64 lowerBound(double ms) const;
+    double timeAt(quint64 index) const;
+    double valueAt(quint64 index) const;
+    /** @brief Get the smallest and largest value of the samples [first, end) */
+    void rangeMinMax(quint64 first, quint64 end, double& min, double& max) const;
+    /** @brief Reduce the samples [first, end) to roughly maxPoints samples which keep the minimum and maximum of each bucket */
+    void decimate(quint64 first, quint64 end, int maxPoints, QVector<quint64>& indices) const;
 
     int getID();
     QString getFriendlyName();
@@ -104,7 +125,6 @@ protected:
     quint64 plotInterval;
     quint64 maxInterval;
     int id;
-    quint64 plotCount;
     QString friendlyName;
 
     double lastValue; ///< The last inserted value
@@ -112,22 +132,69 @@ protected:
     double maxValue;  ///< The largest value in the dataset
     double zeroValue; ///< The expected value in the dataset
 
-    QMutex dataMutex;
-
     QwtScaleMap* scaleMap;
 
     void updateScaleMap();
 
 private:
-    quint64 count;
-    QVector<double> ms;
-    QVector<double> value;
+    /** @brief Smallest and largest sample of a bucket of the min/max pyramid */
+    struct MinMaxBucket {
+        quint64 minIndex;
+        quint64 maxIndex;
+    };
+
+    void grow();
+    void resizePyramid();
+    void updatePyramid(quint64 index);
+    void updateStatistics(double value);
+    void recomputeStatistics();
+    const MinMaxBucket& bucketAt(int level, quint64 bucket) const;
+
+    quint64 count;          ///< Number of samples appended so far, also the absolute index of the next sample
+    quint64 firstSample;    ///< Absolute index of the oldest retained sample
+    quint64 plotFirstSample;///< Absolute index of the oldest sample within the plot interval
+    quint64 capacityMask;   ///< Allocated ring buffer size - 1
+    int maxCapacity;        ///< Size the ring buffer grows to at most
+    QVector<double> ms;     ///< Ring buffer of sample times
+    QVector<double> value;  ///< Ring buffer of sample values
+    QVector< QVector<MinMaxBucket> > pyramid; ///< pyramid[l - 1] holds the buckets of 2^l samples
     double mean;
     double median;
     double variance;
+    double m2;              ///< Sum of squared differences from the mean over the averaging window
     unsigned int averageWindow;
-    QVector<double> outputMs;
-    QVector<double> outputValue;
+    unsigned int statCount; ///< Number of samples in the averaging window so far
+};
+
+/**
+ * @brief Exposes a TimeSeriesData to a QwtPlotCurve
+ *
+ * The curve reads the samples in place. Once the visible range holds more than MAX_PLOT_POINTS samples
+ * only the minimum and maximum of each bucket are drawn, which keeps the outline of the curve intact.
+ **/
+class TimeSeriesCurveData : public QwtSeriesData<QPointF>
+{
+public:
+    TimeSeriesCurveData(const TimeSeriesData* series);
+
+    static const int MAX_PLOT_POINTS = 4096; ///< Number of points drawn per curve before decimating
+
+    virtual size_t size() const;
+    virtual QPointF sample(size_t i) const;
+    virtual QRectF boundingRect() const;
+    virtual void setRectOfInterest(const QRectF& rect);
+
+private:
+    void updateView() const;
+
+    const TimeSeriesData* series;
+    QRectF rectOfInterest;
+    mutable bool viewValid;
+    mutable quint64 viewCount;      ///< Sample count of the series when the view was built
+    mutable quint64 viewFirst;      ///< First sample of the view if it is not decimated
+    mutable quint64 viewEnd;
+    mutable bool viewDecimated;
+    mutable QVector<quint64> viewIndices; ///< Samples of the view if it is decimated
 };
 
 
@@ -255,7 +322,6 @@ protected:
     quint64 plotInterval;
     quint64 plotPosition;
     QTimer* updateTimer;
-    QMutex datalock;
     QMutex windowLock;
     quint64 timeScaleStep;
     bool automaticScrollActive;
@@ -288,6 +354,13 @@ signals:
          * @param name The id-string of the curve
          **/
     void curveRemoved(QString name);
+    /**
+         * @brief This signal is emitted when a curve is shown or hidden
+         *
+         * @param name The id-string of the curve
+         * @param visible True if the curve is now shown
+         **/
+    void curveVisibilityChanged(QString name, bool visible);
     /**
          * @brief This signal is emitted when the plot window position changes
          *
@@ -281,6 +281,7 @@ void LinechartWidget::createLayout()
     // Update scrollbar when plot window changes (via translator method setPlotWindowPosition()
 //    connect(activePlot, SIGNAL(windowPositionChanged(quint64)), this, SLOT(setPlotWindowPosition(quint64)));
     connect(activePlot, &LinechartPlot::curveRemoved, this, &LinechartWidget::removeCurve);
+    connect(activePlot, &LinechartPlot::curveVisibilityChanged, this, &LinechartWidget::curveVisibilityChanged);
 
     // Update plot when scrollbar is moved (via translator method setPlotWindowPosition()
     //TODO: impossible to
@@ -366,6 +367,13 @@ void LinechartWidget::appendData(int uasId, const QString& curve, const QString&
     }
 }
 
+void LinechartWidget::appendValues(int uasId, const MAVLinkDecoderValues& values, quint64 usec)
+{
+    foreach (const MAVLinkDecoderValue& value, values) {
+        appendData(uasId, value.name, value.unit, value.value, usec);
+    }
+}
+
 void LinechartWidget::refresh()
 {
     setUpdatesEnabled(false);
@@ -38,6 +38,7 @@
 
 #include "LinechartPlot.h"
 #include "UASInterface.h"
+#include "MAVLinkDecoder.h"
 #include "ui_Linechart.h"
 
 #include "LogCompressor.h"
@@ -66,6 +67,8 @@ public slots:
     void setShortNames(bool enable);
     /** @brief Append data to the given curve. */
     void appendData(int uasId, const QString& curve, const QString& unit, const QVariant& value, quint64 usec);
+    /** @brief Append all values decoded from one message */
+    void appendValues(int uasId, const MAVLinkDecoderValues& values, quint64 usec);
     /** @brief Hide curves which do not match the filter pattern */
     void filterCurves(const QString &filter);
 
@@ -171,6 +174,13 @@ signals:
          * @param curve The removed plot curve
          **/
     void curveRemoved(QString curve);
+    /**
+         * @brief This signal is emitted if a curve is shown or hidden in the plot
+         *
+         * @param curve The curve id
+         * @param visible True if the curve is now shown
+         **/
+    void curveVisibilityChanged(QString curve, bool visible);
 
     /**
          * @brief This signal is emitted if a curve has been moved or added
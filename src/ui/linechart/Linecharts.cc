@@ -22,7 +22,9 @@ QWidget* Linecharts::_newVehicleWidget(Vehicle* vehicle, QWidget* parent)
     connect(vehicle->uas(), &UAS::valueChanged, widget, &LinechartWidget::appendData);
 
     // Connect decoder
-    connect(_mavlinkDecoder, &MAVLinkDecoder::valueChanged, widget, &LinechartWidget::appendData);
+    connect(_mavlinkDecoder, &MAVLinkDecoder::valuesChanged, widget, &LinechartWidget::appendValues);
+    // Only decode the fields which are plotted at full rate
+    connect(widget, &LinechartWidget::curveVisibilityChanged, _mavlinkDecoder, &MAVLinkDecoder::setSubscribed);
 
     // Select system
     widget->setActive(true);
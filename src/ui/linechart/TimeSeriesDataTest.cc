@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TimeSeriesDataTest.h"
+#include "LinechartPlot.h"
+
+#include <QtMath>
+
+#include <float.h>
+
+/// Mean and population variance of the last windowSize values, computed the slow way
+static void _windowStatistics(const QVector<double>& values, int windowSize, double& mean, double& variance)
+{
+    int first = qMax(0, values.count() - windowSize);
+    int n = values.count() - first;
+
+    mean = 0;
+    for (int i=first; i<values.count(); i++) {
+        mean += values[i];
+    }
+    mean /= n;
+
+    variance = 0;
+    for (int i=first; i<values.count(); i++) {
+        variance += (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= n;
+}
+
+void TimeSeriesDataTest::_testStatistics(void)
+{
+    TimeSeriesData      series(NULL, "test", 10000, 0, 0, 1024);
+    QVector<double>     values;
+    double              mean, variance;
+
+    series.setAverageWindowSize(50);
+
+    // Window filling up, then sliding over a signal with an offset so rounding errors would show
+    for (int i=0; i<500; i++) {
+        double value = 1000.0 + qSin(i * 0.3) * 10.0 + (i % 7);
+        values.append(value);
+        series.append(i * 20, value);
+
+        _windowStatistics(values, 50, mean, variance);
+        QVERIFY(qAbs(series.getMean() - mean) < 1e-9);
+        QVERIFY(qAbs(series.getVariance() - variance) < 1e-6);
+    }
+    QCOMPARE(series.getCurrentValue(), values.last());
+
+    // Changing the window size recomputes from the stored samples
+    series.setAverageWindowSize(200);
+    _windowStatistics(values, 200, mean, variance);
+    QVERIFY(qAbs(series.getMean() - mean) < 1e-9);
+    QVERIFY(qAbs(series.getVariance() - variance) < 1e-6);
+}
+
+void TimeSeriesDataTest::_testBoundedCapacity(void)
+{
+    const int           capacity = 1024;
+    TimeSeriesData      series(NULL, "test", 10000, 0, 0, capacity);
+
+    for (int i=0; i<5000; i++) {
+        series.append(i, (i * 7919) % 1000);
+    }
+
+    QCOMPARE(series.getCount(), 5000);
+    QCOMPARE(series.size(), capacity);
+    QCOMPARE(series.firstIndex(), (quint64)(5000 - capacity));
+    QCOMPARE(series.timeAt(series.firstIndex()), (double)(5000 - capacity));
+
+    // Plot interval is 10 seconds at 1 sample per ms, so it is limited by the capacity
+    QCOMPARE(series.getPlotCount(), capacity);
+
+    // Min/max from the pyramid matches a scan over arbitrary ranges
+    quint64 ranges[][2] = { { series.firstIndex(), series.endIndex() }, { 4100, 4101 }, { 4001, 4999 }, { 4096, 4608 } };
+    for (size_t i=0; i<sizeof(ranges)/sizeof(ranges[0]); i++) {
+        double min, max;
+        double expectedMin = DBL_MAX;
+        double expectedMax = -DBL_MAX;
+        for (quint64 index=ranges[i][0]; index<ranges[i][1]; index++) {
+            expectedMin = qMin(expectedMin, series.valueAt(index));
+            expectedMax = qMax(expectedMax, series.valueAt(index));
+        }
+        series.rangeMinMax(ranges[i][0], ranges[i][1], min, max);
+        QCOMPARE(min, expectedMin);
+        QCOMPARE(max, expectedMax);
+    }
+
+    QCOMPARE(series.lowerBound(4500.5), (quint64)4501);
+}
+
+void TimeSeriesDataTest::_testGrowth(void)
+{
+    TimeSeriesData      series(NULL, "test");
+    QVector<double>     values;
+
+    // A new curve only allocates room for a few samples
+    QVERIFY(series.getAllocated() < series.getCapacity());
+    series.append(0, 0);
+    values.append(0);
+    QCOMPARE(series.getAllocated(), (int)TimeSeriesData::INITIAL_CAPACITY);
+
+    // The ring buffer doubles as it fills, keeping every sample and the min/max pyramid intact
+    for (int i=1; i<3000; i++) {
+        double value = (i * 7919) % 1000;
+        values.append(value);
+        series.append(i, value);
+    }
+    QCOMPARE(series.getAllocated(), 4096);
+    QCOMPARE(series.size(), 3000);
+    for (int i=0; i<values.count(); i++) {
+        QCOMPARE(series.valueAt(i), values[i]);
+    }
+    quint64 ranges[][2] = { { 0, 3000 }, { 200, 300 }, { 255, 257 }, { 511, 2049 } };
+    for (size_t i=0; i<sizeof(ranges)/sizeof(ranges[0]); i++) {
+        double min, max;
+        double expectedMin = DBL_MAX;
+        double expectedMax = -DBL_MAX;
+        for (quint64 index=ranges[i][0]; index<ranges[i][1]; index++) {
+            expectedMin = qMin(expectedMin, values[index]);
+            expectedMax = qMax(expectedMax, values[index]);
+        }
+        series.rangeMinMax(ranges[i][0], ranges[i][1], min, max);
+        QCOMPARE(min, expectedMin);
+        QCOMPARE(max, expectedMax);
+    }
+
+    // A curve trimmed to a time window stops growing once it holds the window
+    TimeSeriesData      trimmed(NULL, "test", 10000, 500);
+    for (int i=0; i<5000; i++) {
+        trimmed.append(i, i);
+    }
+    QCOMPARE(trimmed.getAllocated(), 512);
+    QCOMPARE(trimmed.size(), 501);
+}
+
+void TimeSeriesDataTest::_testDecimation(void)
+{
+    TimeSeriesData      series(NULL, "test", 100000);
+    const int           sampleCount = 30000;
+    const quint64       spikeIndex = 12345;
+
+    for (int i=0; i<sampleCount; i++) {
+        series.append(i, (quint64)i == spikeIndex ? 100.0 : qSin(i * 0.01));
+    }
+
+    QVector<quint64> indices;
+    series.decimate(series.firstIndex(), series.endIndex(), 1000, indices);
+
+    // Roughly the requested number of points, in time order, and the spike survives
+    QVERIFY(indices.count() <= 1000 + 64);
+    QVERIFY(indices.count() >= 1000 / 4);
+    for (int i=1; i<indices.count(); i++) {
+        QVERIFY(indices[i] > indices[i - 1]);
+    }
+    QVERIFY(indices.contains(spikeIndex));
+    QCOMPARE(indices.first(), series.firstIndex());
+    QCOMPARE(indices.last(), series.endIndex() - 1);
+
+    // The curve adapter decimates once the visible range holds too many points
+    TimeSeriesCurveData curveData(&series);
+    QVERIFY(curveData.size() <= (size_t)TimeSeriesCurveData::MAX_PLOT_POINTS + 64);
+    QCOMPARE(curveData.boundingRect().bottom(), 100.0);
+
+    curveData.setRectOfInterest(QRectF(1000, -1, 100, 2));
+    QCOMPARE(curveData.size(), (size_t)102);
+    QCOMPARE(curveData.sample(0).x(), 999.0);
+}
@@ -0,0 +1,24 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for TimeSeriesData
+class TimeSeriesDataTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testStatistics(void);
+    void _testBoundedCapacity(void);
+    void _testGrowth(void);
+    void _testDecimation(void);
+};
@@ -268,6 +268,14 @@ QGCView {
                             property Fact _telemetrySaveNotArmed: QGroundControl.settingsManager.appSettings.telemetrySaveNotArmed
                         }
                         //-----------------------------------------------------------------
+                        //-- Save link metrics
+                        FactCheckBox {
+                            text:       qsTr("Save link bandwidth and latency metrics")
+                            fact:       _linkMetricsSave
+                            visible:    _linkMetricsSave.visible
+                            property Fact _linkMetricsSave: QGroundControl.settingsManager.appSettings.linkMetricsSave
+                        }
+                        //-----------------------------------------------------------------
                         //-- Clear settings
                         QGCCheckBox {
                             id:         clearCheck